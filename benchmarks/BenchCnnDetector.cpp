@@ -0,0 +1,119 @@
+#include "Core/Config.h"
+#include "Vision/CnnDetector.h"
+#include "Vision/QuantizedCnn.h"
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int kIterations = 200;
+    constexpr int kSequenceFrames = 15;
+    constexpr double kBudgetMicroseconds = 3000.0; ///< Per-ROI budget at the check-burst frame rate
+
+    using SH3DS::Vision::QuantizedCnn;
+
+    QuantizedCnn::Layer CreateLayer(cv::RNG &rng, QuantizedCnn::LayerType type, int inputs, int outputs, bool relu)
+    {
+        QuantizedCnn::Layer layer;
+        layer.type = type;
+        layer.outChannels = outputs;
+        layer.relu = relu;
+        layer.weights.resize(static_cast<std::size_t>(inputs) * static_cast<std::size_t>(outputs));
+        for (auto &weight : layer.weights)
+        {
+            weight = static_cast<int8_t>(rng.uniform(-127, 128));
+        }
+        layer.bias.assign(static_cast<std::size_t>(outputs), 0);
+        layer.multiplier.assign(static_cast<std::size_t>(outputs), 0.001f);
+        return layer;
+    }
+
+    /// Representative sprite classifier: three conv blocks on an 80x48 input, then a global pool and a dense head.
+    QuantizedCnn CreateModel()
+    {
+        cv::RNG rng(42);
+        QuantizedCnn::Layer pool;
+        pool.type = QuantizedCnn::LayerType::MaxPool2x2;
+        QuantizedCnn::Layer gap;
+        gap.type = QuantizedCnn::LayerType::GlobalAveragePool;
+
+        std::vector<QuantizedCnn::Layer> layers;
+        layers.push_back(CreateLayer(rng, QuantizedCnn::LayerType::Conv3x3, 9 * 3, 8, true));
+        layers.push_back(pool);
+        layers.push_back(CreateLayer(rng, QuantizedCnn::LayerType::Conv3x3, 9 * 8, 16, true));
+        layers.push_back(pool);
+        layers.push_back(CreateLayer(rng, QuantizedCnn::LayerType::Conv3x3, 9 * 16, 32, true));
+        layers.push_back(gap);
+        layers.push_back(CreateLayer(rng, QuantizedCnn::LayerType::Dense, 32, 2, false));
+        return QuantizedCnn(80, 48, std::move(layers));
+    }
+
+    template<typename Fn>
+    double MeasureMicroseconds(Fn &&fn)
+    {
+        volatile double sink = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            sink = sink + fn();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() / kIterations;
+    }
+} // namespace
+
+int main()
+{
+    const QuantizedCnn model = CreateModel();
+    const auto path = (std::filesystem::temp_directory_path() / "sh3ds_bench_cnn.bin").string();
+    model.Save(path);
+
+    SH3DS::Core::DetectionMethodConfig config;
+    config.method = "cnn";
+    config.modelPath = path;
+    const SH3DS::Vision::CnnDetector detector(config, "bench");
+    std::filesystem::remove(path);
+
+    cv::RNG rng(7);
+    std::vector<cv::Mat> rois;
+    for (int i = 0; i < kSequenceFrames; ++i)
+    {
+        rois.emplace_back(96, 160, CV_8UC3);
+        rng.fill(rois.back(), cv::RNG::UNIFORM, 0, 256);
+    }
+
+    const double singleUs = MeasureMicroseconds([&] { return detector.Detect(rois.front()).confidence; });
+    const double sequenceUs = MeasureMicroseconds([&] { return detector.DetectSequence(rois).confidence; });
+
+    std::printf("CnnDetector benchmark, %d iterations, ROI %dx%d -> input %dx%d, %llu MACs per ROI\n",
+        kIterations,
+        rois.front().cols,
+        rois.front().rows,
+        model.InputWidth(),
+        model.InputHeight(),
+        static_cast<unsigned long long>(model.MacsPerInference()));
+    std::printf("%-32s %9.2f us   (budget %.0f us)\n", "Detect (single ROI)", singleUs, kBudgetMicroseconds);
+    std::printf("%-32s %9.2f us   %9.2f us per ROI\n",
+        "DetectSequence (15 ROIs)",
+        sequenceUs,
+        sequenceUs / kSequenceFrames);
+
+    // Non-zero exit so a scripted run catches a regression past the budget.
+    const double worstUs = std::max(singleUs, sequenceUs / kSequenceFrames);
+    if (worstUs > kBudgetMicroseconds)
+    {
+        std::fprintf(stderr, "OVER BUDGET: %.2f us per ROI > %.0f us\n", worstUs, kBudgetMicroseconds);
+        return 1;
+    }
+    std::printf("Within budget: %.2f us per ROI <= %.0f us\n", worstUs, kBudgetMicroseconds);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "Core/HotLog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    using SH3DS::Core::HotLogger;
+    using SH3DS::Core::HotLogLevel;
+
+    constexpr int kIterations = 5000;
+    constexpr int kCandidateRules = 6;                       ///< FSM rules evaluated per frame
+    constexpr int kStatementsPerFrame = 8 + kCandidateRules; ///< Statements LogFrame() issues
+
+    template<typename Fn>
+    double MeasureMicroseconds(Fn &&fn)
+    {
+        volatile double sink = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            sink = sink + fn(i);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() / kIterations;
+    }
+
+    /// Sink standing in for a file logger: writes every message to a temporary file.
+    HotLogger::Sink FileSink(std::FILE *file)
+    {
+        return [file](HotLogLevel, std::string_view message) {
+            std::fwrite(message.data(), 1, message.size(), file);
+            std::fputc('\n', file);
+            std::fflush(file);
+        };
+    }
+
+    /**
+     * @brief Issues the statements of one orchestrator tick: orchestrator bookkeeping, then one FSM line per rule.
+     * @return Dummy value so the loop is not optimised away.
+     */
+    double LogFrame(HotLogger &logger, int frame)
+    {
+        const std::string roi = "pokemon_sprite";
+        const auto log = [&logger]<typename... Args>(HotLogLevel level, const char *format, const Args &...args) {
+            if (logger.ShouldLog(level))
+            {
+                logger.Log(level, format, args...);
+            }
+        };
+
+        log(HotLogLevel::Trace, "Orchestrator: tick {} started", frame);
+        log(HotLogLevel::Debug, "Orchestrator: frame {} captured ({}x{})", frame, 400, 480);
+        log(HotLogLevel::Debug, "Orchestrator: preprocess took {:.2f} ms", 0.42);
+        log(HotLogLevel::Debug, "Orchestrator: FSM state '{}' ({} frames)", "encounter", frame % 90);
+        for (int rule = 0; rule < kCandidateRules; ++rule)
+        {
+            log(HotLogLevel::Debug,
+                "FSM: Evaluating Rule '{}' on {} ROI: confidence={:.3f} threshold={:.3f}",
+                roi,
+                "top",
+                0.1 * rule,
+                0.8);
+        }
+        log(HotLogLevel::Debug, "Orchestrator: shiny check skipped (state '{}')", "encounter");
+        log(HotLogLevel::Debug, "Orchestrator: buttons=0x{:04X} hold={} ms", 0x0A, 50);
+        log(HotLogLevel::Debug, "Orchestrator: debug frame queued={}", frame % 2 == 0);
+        log(HotLogLevel::Info, "Orchestrator: tick {} done", frame);
+        return frame;
+    }
+} // namespace
+
+int main()
+{
+    constexpr HotLogLevel kLevels[] = { HotLogLevel::Trace, HotLogLevel::Debug, HotLogLevel::Info };
+    constexpr const char *kLevelNames[] = { "trace", "debug", "info" };
+
+    std::printf("HotLogger per-frame benchmark, %d frames, %d statements per frame, file sink\n",
+        kIterations,
+        kStatementsPerFrame);
+
+    // SH3DS_HOT_LOG_LEVEL=off: the statements are not compiled in at all.
+    const double strippedUs = MeasureMicroseconds([](int frame) { return static_cast<double>(frame); });
+    std::printf("stripped             %9.3f us/frame\n", strippedUs);
+
+    for (std::size_t i = 0; i < std::size(kLevels); ++i)
+    {
+        std::FILE *syncFile = std::tmpfile();
+        std::FILE *asyncFile = std::tmpfile();
+        if (syncFile == nullptr || asyncFile == nullptr)
+        {
+            std::fprintf(stderr, "tmpfile() failed\n");
+            return 1;
+        }
+
+        HotLogger syncLogger(FileSink(syncFile));
+        syncLogger.SetLevel(kLevels[i]);
+        const double syncUs = MeasureMicroseconds([&](int frame) { return LogFrame(syncLogger, frame); });
+
+        // Sized for the whole run so the timing covers every record; a real run paces frames at 30 fps.
+        HotLogger asyncLogger(FileSink(asyncFile), static_cast<std::size_t>(kIterations) * kStatementsPerFrame);
+        asyncLogger.SetLevel(kLevels[i]);
+        asyncLogger.StartAsync();
+        const double asyncUs = MeasureMicroseconds([&](int frame) { return LogFrame(asyncLogger, frame); });
+        asyncLogger.Stop();
+
+        std::printf("level %-6s   sync %9.3f us/frame   async %9.3f us/frame   dropped %llu\n",
+            kLevelNames[i],
+            syncUs,
+            asyncUs,
+            static_cast<unsigned long long>(asyncLogger.DroppedRecords()));
+
+        std::fclose(syncFile);
+        std::fclose(asyncFile);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "Vision/TemplateMatcher.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+    constexpr int kIterations = 2000;
+
+    /// The pre-cache implementation: resize the template to the region every call, then matchTemplate.
+    double LegacyMatch(const cv::Mat &region, const cv::Mat &tmpl)
+    {
+        cv::Mat resized;
+        if (tmpl.size() != region.size())
+        {
+            cv::resize(tmpl, resized, region.size());
+        }
+        else
+        {
+            resized = tmpl;
+        }
+        cv::Mat result;
+        cv::matchTemplate(region, resized, result, cv::TM_CCORR_NORMED);
+        double maxVal;
+        cv::minMaxLoc(result, nullptr, &maxVal);
+        return maxVal;
+    }
+
+    template<typename Fn>
+    double MeasureMicroseconds(Fn &&fn)
+    {
+        volatile double sink = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            sink = sink + fn();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() / kIterations;
+    }
+
+    void RunCase(const char *label, const cv::Mat &region, const cv::Mat &tmpl)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / "sh3ds_bench_template.png").string();
+        cv::imwrite(path, tmpl);
+
+        SH3DS::Vision::TemplateMatcher matcher;
+        matcher.Match(region, path); // warm the cache
+
+        const double legacyUs = MeasureMicroseconds([&] { return LegacyMatch(region, tmpl); });
+        const double cachedUs = MeasureMicroseconds([&] { return matcher.Match(region, path); });
+
+        std::printf("%-32s legacy %9.2f us   cached %9.2f us   speedup %6.2fx   (scores %.6f / %.6f)\n",
+            label,
+            legacyUs,
+            cachedUs,
+            legacyUs / cachedUs,
+            LegacyMatch(region, tmpl),
+            matcher.Match(region, path));
+
+        std::filesystem::remove(path);
+    }
+} // namespace
+
+int main()
+{
+    cv::RNG rng(42);
+    cv::Mat region(240, 400, CV_8UC3);
+    rng.fill(region, cv::RNG::UNIFORM, 0, 256);
+
+    cv::Mat largeTemplate(480, 800, CV_8UC3);
+    rng.fill(largeTemplate, cv::RNG::UNIFORM, 0, 256);
+    cv::Mat equalTemplate = region.clone();
+
+    std::printf("TemplateMatcher benchmark, %d iterations per case, region %dx%d\n",
+        kIterations,
+        region.cols,
+        region.rows);
+    RunCase("equal size (400x240)", region, equalTemplate);
+    RunCase("larger template (800x480)", region, largeTemplate);
+    return 0;
+}
@@ -15,13 +15,15 @@ if(GIT_FOUND AND EXISTS "${PROJECT_SOURCE_DIR}/.git")
     endif()
 endif()
 
-# Verify kappa-core submodule exists
-if(NOT EXISTS "${PROJECT_SOURCE_DIR}/external/kappa-core/CMakeLists.txt")
-    message(FATAL_ERROR "kappa-core submodule not found. Run: git submodule update --init --recursive")
-else()
-    set(CMAKE_FOLDER "Externals")
-    add_subdirectory(external/kappa-core)
-    unset(CMAKE_FOLDER)
+# Verify kappa-core submodule exists (debug GUI only)
+if(SH3DS_BUILD_GUI)
+    if(NOT EXISTS "${PROJECT_SOURCE_DIR}/external/kappa-core/CMakeLists.txt")
+        message(FATAL_ERROR "kappa-core submodule not found. Run: git submodule update --init --recursive")
+    else()
+        set(CMAKE_FOLDER "Externals")
+        add_subdirectory(external/kappa-core)
+        unset(CMAKE_FOLDER)
+    endif()
 endif()
 
 # Verify CXXStateTree submodule exists
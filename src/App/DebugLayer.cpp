@@ -1,16 +1,42 @@
 #include "DebugLayer.h"
 
-#include "Kappa/Logger.h"
-#include "TextureUploader.h"
-#include "Vision/ColorImprovement.h"
+#include "Core/Logger.h"
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 
 #include <imgui_impl_opengl3.h>
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+
 namespace SH3DS::App
 {
+    namespace
+    {
+        constexpr float kTimelineHeight = 24.0f; ///< Height of the state timeline strip (pixels)
+
+        /**
+         * @brief Picks a stable, well-spread colour for a state on the timeline.
+         */
+        ImU32 StateColor(Core::StateId state)
+        {
+            if (state == Core::kInvalidStateId)
+            {
+                return IM_COL32(90, 90, 90, 255);
+            }
+
+            // Golden-ratio hue stepping keeps neighbouring state IDs visually distinct.
+            const float hue = std::fmod(static_cast<float>(state) * 0.618034f, 1.0f);
+            float r = 0.0f;
+            float g = 0.0f;
+            float b = 0.0f;
+            ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.85f, r, g, b);
+            return ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f));
+        }
+    } // namespace
+
     DebugLayer::DebugLayer(GLFWwindow *window,
         std::unique_ptr<Capture::FrameSource> source,
         std::shared_ptr<Capture::FrameSeeker> seeker,
@@ -22,14 +48,15 @@ namespace SH3DS::App
         std::string shinyCheckState,
         size_t totalFrames,
         float targetFps)
-        : source(std::move(source)),
-          seeker(seeker),
-          screenDetector(std::move(screenDetector)),
-          preprocessor(std::move(preprocessor)),
-          fsm(std::move(fsm)),
-          detector(std::move(detector)),
-          shinyRoi(std::move(shinyRoi)),
-          shinyCheckState(std::move(shinyCheckState)),
+        : worker(std::make_unique<FrameAnalysisWorker>(std::move(source),
+              std::move(seeker),
+              std::move(screenDetector),
+              std::move(preprocessor),
+              std::move(fsm),
+              std::move(detector),
+              std::move(shinyRoi),
+              std::move(shinyCheckState),
+              totalFrames)),
           playback(totalFrames, targetFps)
     {
         // Initialize ImGui
@@ -45,34 +72,31 @@ namespace SH3DS::App
         ImGui_ImplOpenGL3_Init("#version 430");
 
         // Create textures
-        rawFrameTexture = TextureUploader::CreateTexture();
-        topScreenTexture = TextureUploader::CreateTexture();
-        bottomScreenTexture = TextureUploader::CreateTexture();
+        rawFrameTexture = std::make_unique<TextureUploader>();
+        topScreenTexture = std::make_unique<TextureUploader>();
+        bottomScreenTexture = std::make_unique<TextureUploader>();
+        topThumbnailTexture = std::make_unique<TextureUploader>();
+        bottomThumbnailTexture = std::make_unique<TextureUploader>();
 
-        // Process first frame
-        ProcessCurrentFrame();
+        // Request first frame
+        RequestCurrentFrame();
 
         LOG_INFO("DebugLayer initialized ({} frames, {:.1f} FPS)", totalFrames, targetFps);
     }
 
     DebugLayer::~DebugLayer()
     {
+        worker.reset(); // join the pipeline thread before tearing down the GUI
+
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
 
-        if (rawFrameTexture != 0)
-        {
-            glDeleteTextures(1, &rawFrameTexture);
-        }
-        if (topScreenTexture != 0)
-        {
-            glDeleteTextures(1, &topScreenTexture);
-        }
-        if (bottomScreenTexture != 0)
-        {
-            glDeleteTextures(1, &bottomScreenTexture);
-        }
+        rawFrameTexture.reset();
+        topScreenTexture.reset();
+        bottomScreenTexture.reset();
+        topThumbnailTexture.reset();
+        bottomThumbnailTexture.reset();
     }
 
     void DebugLayer::OnUpdate(float deltaTime)
@@ -80,8 +104,11 @@ namespace SH3DS::App
         bool advanced = playback.Update(deltaTime);
         if (advanced)
         {
-            ProcessCurrentFrame();
+            RequestCurrentFrame();
         }
+
+        UploadFinishedFrame();
+        currentEntry = worker->GetTimelineEntry(playback.GetCurrentFrameIndex());
     }
 
     void DebugLayer::OnRender()
@@ -117,9 +144,15 @@ namespace SH3DS::App
         ImGui::End();
 
         // Image panels
-        RenderImagePanel("Raw Camera", rawFrameTexture, rawWidth, rawHeight);
-        RenderImagePanel("Top Screen", topScreenTexture, topWidth, topHeight);
-        RenderImagePanel("Bottom Screen", bottomScreenTexture, bottomWidth, bottomHeight);
+        RenderImagePanel("Raw Camera", rawFrameTexture->GetTextureId(), rawWidth, rawHeight);
+        RenderImagePanel("Top Screen",
+            (showTopThumbnail ? topThumbnailTexture : topScreenTexture)->GetTextureId(),
+            topWidth,
+            topHeight);
+        RenderImagePanel("Bottom Screen",
+            (showBottomThumbnail ? bottomThumbnailTexture : bottomScreenTexture)->GetTextureId(),
+            bottomWidth,
+            bottomHeight);
 
         // State info panel
         RenderStatePanel();
@@ -131,96 +164,62 @@ namespace SH3DS::App
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     }
 
-    // TODO: move pipeline processing to a background thread for live sources (v0.2.0)
-    void DebugLayer::ProcessCurrentFrame()
+    void DebugLayer::RequestCurrentFrame()
     {
         size_t frameIndex = playback.GetCurrentFrameIndex();
-        if (frameIndex == lastProcessedFrame)
-        {
-            return;
-        }
-
-        seeker->Seek(frameIndex);
-
-        auto frame = source->Grab();
-        if (!frame)
+        if (frameIndex == lastRequestedFrame)
         {
             return;
         }
 
-        currentRawFrame = frame->image.clone();
-        rawWidth = currentRawFrame.cols;
-        rawHeight = currentRawFrame.rows;
-
-        TextureUploader::Upload(currentRawFrame, rawFrameTexture);
-
-        if (screenDetector)
-        {
-            screenDetector->ApplyTo(*preprocessor, frame->image);
-        }
-
-        auto dualScreenResult = preprocessor->ProcessDualScreen(frame->image);
-        if (!dualScreenResult)
-        {
-            lastProcessedFrame = frameIndex;
-            return;
-        }
+        worker->RequestFrame(frameIndex, applyColorImprovementToDisplay);
+        lastRequestedFrame = frameIndex;
 
-        // Apply color correction to the full warped top image before ROI extraction so that
-        // Gray World WB has the complete scene to compute balanced gains. Bottom screen is
-        // LCD-rendered UI — WB correction is not applied.
-        if (!dualScreenResult->warpedTop.empty())
-        {
-            dualScreenResult->warpedTop = Vision::ImproveFrameColors(dualScreenResult->warpedTop);
-            preprocessor->ReextractRois(*dualScreenResult);
-        }
-        if (applyColorImprovementToDisplay && !dualScreenResult->warpedBottom.empty())
+        // Frames the timeline pass has reached show the nearest sampled thumbnail at once; full resolution follows.
+        currentEntry = worker->GetTimelineEntry(frameIndex);
+        if (currentEntry)
         {
-            dualScreenResult->warpedBottom = Vision::ImproveFrameColors(dualScreenResult->warpedBottom);
+            if (!currentEntry->topThumbnail.empty())
+            {
+                showTopThumbnail = topThumbnailTexture->Upload(currentEntry->topThumbnail);
+            }
+            if (!currentEntry->bottomThumbnail.empty())
+            {
+                showBottomThumbnail = bottomThumbnailTexture->Upload(currentEntry->bottomThumbnail);
+            }
         }
+    }
 
-        if (!dualScreenResult->warpedTop.empty())
+    void DebugLayer::UploadFinishedFrame()
+    {
+        auto images = worker->TakeFrameImages();
+        if (!images || images->frameIndex != playback.GetCurrentFrameIndex())
         {
-            currentTopScreen = dualScreenResult->warpedTop;
-            topWidth = currentTopScreen.cols;
-            topHeight = currentTopScreen.rows;
-            TextureUploader::Upload(currentTopScreen, topScreenTexture);
+            return; // nothing new, or superseded by a later scrub
         }
 
-        if (!dualScreenResult->warpedBottom.empty())
+        if (!images->rawFrame.empty())
         {
-            currentBottomScreen = dualScreenResult->warpedBottom;
-            bottomWidth = currentBottomScreen.cols;
-            bottomHeight = currentBottomScreen.rows;
-            TextureUploader::Upload(currentBottomScreen, bottomScreenTexture);
+            rawWidth = images->rawFrame.cols;
+            rawHeight = images->rawFrame.rows;
+            rawFrameTexture->Upload(images->rawFrame);
         }
 
-        if (!dualScreenResult->topRois.empty() || !dualScreenResult->bottomRois.empty())
+        if (!images->topScreen.empty())
         {
-            fsm->Update(dualScreenResult->topRois, dualScreenResult->bottomRois);
-
-            const std::string newState = fsm->GetCurrentState();
-            if (newState != currentStateName)
-            {
-                currentShinyResult = std::nullopt; // clear stale result on state change
-                currentStateName = newState;
-            }
-
-            auto ms = fsm->GetTimeInCurrentState();
-            timeInState = static_cast<float>(ms.count()) / 1000.0f;
+            topWidth = images->topScreen.cols;
+            topHeight = images->topScreen.rows;
+            topScreenTexture->Upload(images->topScreen);
+            showTopThumbnail = false;
         }
 
-        if (detector && !dualScreenResult->topRois.empty() && !shinyRoi.empty()
-            && (shinyCheckState.empty() || currentStateName == shinyCheckState))
+        if (!images->bottomScreen.empty())
         {
-            auto it = dualScreenResult->topRois.find(shinyRoi);
-            if (it != dualScreenResult->topRois.end() && !it->second.empty())
-            {
-                currentShinyResult = detector->Detect(it->second);
-            }
+            bottomWidth = images->bottomScreen.cols;
+            bottomHeight = images->bottomScreen.rows;
+            bottomScreenTexture->Upload(images->bottomScreen);
+            showBottomThumbnail = false;
         }
-
-        lastProcessedFrame = frameIndex;
     }
 
     void DebugLayer::RenderImagePanel(const char *title, GLuint textureId, int width, int height)
@@ -260,16 +259,28 @@ namespace SH3DS::App
 
         if (ImGui::Checkbox("Color Correction (display)", &applyColorImprovementToDisplay))
         {
-            lastProcessedFrame = SIZE_MAX; // force re-process with new setting
+            lastRequestedFrame = SIZE_MAX; // force re-request with new setting
+            RequestCurrentFrame();
         }
 
         ImGui::Separator();
 
-        ImGui::Text("FSM State: %s", currentStateName.c_str());
-        ImGui::Text("Time in State: %.1f s", static_cast<double>(timeInState));
+        if (!currentEntry)
+        {
+            ImGui::TextDisabled(
+                "Analysing... (timeline at frame %zu / %zu)", worker->AnalysedFrames(), playback.GetTotalFrames());
+            ImGui::End();
+            return;
+        }
+
+        const size_t framesInState = playback.GetCurrentFrameIndex() - currentEntry->stateEnteredFrame;
+        const double timeInState = static_cast<double>(framesInState) / static_cast<double>(playback.GetTargetFps());
+        ImGui::Text("FSM State: %s", worker->GetStateRegistry()->Name(currentEntry->state).c_str());
+        ImGui::Text("Time in State: %.1f s", timeInState);
 
         ImGui::Separator();
 
+        const auto &currentShinyResult = currentEntry->shinyResult;
         if (currentShinyResult)
         {
             const char *verdictStr = "Unknown";
@@ -293,11 +304,14 @@ namespace SH3DS::App
 
             ImGui::TextColored(color, "Verdict: %s", verdictStr);
             ImGui::Text("Confidence: %.2f%%", currentShinyResult->confidence * 100.0);
-            ImGui::Text("Method: %s", currentShinyResult->method.c_str());
+            ImGui::Text("Method: %.*s",
+                static_cast<int>(currentShinyResult->method.size()),
+                currentShinyResult->method.data());
 
-            if (!currentShinyResult->details.empty())
+            const std::string details = currentShinyResult->Details();
+            if (!details.empty())
             {
-                ImGui::TextWrapped("Details: %s", currentShinyResult->details.c_str());
+                ImGui::TextWrapped("Details: %s", details.c_str());
             }
         }
         else
@@ -316,7 +330,7 @@ namespace SH3DS::App
         if (ImGui::Button("<<"))
         {
             playback.StepBackward();
-            ProcessCurrentFrame();
+            RequestCurrentFrame();
         }
         ImGui::SameLine();
 
@@ -339,7 +353,7 @@ namespace SH3DS::App
         if (ImGui::Button(">>"))
         {
             playback.StepForward();
-            ProcessCurrentFrame();
+            RequestCurrentFrame();
         }
 
         // Frame scrubber
@@ -354,9 +368,11 @@ namespace SH3DS::App
         if (ImGui::SliderInt("##frame", &frameIdx, 0, maxFrame, "Frame %d"))
         {
             playback.SetFrameIndex(static_cast<size_t>(frameIdx));
-            ProcessCurrentFrame();
+            RequestCurrentFrame();
         }
 
+        RenderTimeline();
+
         // Speed control
         float speed = playback.GetPlaybackSpeed();
         ImGui::SetNextItemWidth(200);
@@ -370,4 +386,74 @@ namespace SH3DS::App
         ImGui::End();
     }
 
+    void DebugLayer::RenderTimeline()
+    {
+        worker->CollectTimelineStates(timelineStates);
+
+        const size_t totalFrames = playback.GetTotalFrames();
+        const float width = ImGui::GetContentRegionAvail().x;
+        if (totalFrames == 0 || width <= 0.0f)
+        {
+            return;
+        }
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImGui::InvisibleButton("##timeline", ImVec2(width, kTimelineHeight));
+        const bool hovered = ImGui::IsItemHovered();
+        const bool active = ImGui::IsItemActive();
+
+        const float framesPerPixel = static_cast<float>(totalFrames) / width;
+        const auto frameAtMouse = [&]() {
+            const float x = std::clamp(ImGui::GetIO().MousePos.x - origin.x, 0.0f, width - 1.0f);
+            return std::min(static_cast<size_t>(x * framesPerPixel), totalFrames - 1);
+        };
+        const auto frameToX = [&](size_t frame) {
+            return origin.x + static_cast<float>(frame) / framesPerPixel;
+        };
+
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(
+            origin, ImVec2(origin.x + width, origin.y + kTimelineHeight), IM_COL32(40, 40, 40, 255));
+
+        // One rectangle per run of identical states
+        size_t runStart = 0;
+        for (size_t i = 1; i <= timelineStates.size(); ++i)
+        {
+            if (i == timelineStates.size() || timelineStates[i] != timelineStates[runStart])
+            {
+                drawList->AddRectFilled(ImVec2(frameToX(runStart), origin.y),
+                    ImVec2(frameToX(i), origin.y + kTimelineHeight),
+                    StateColor(timelineStates[runStart]));
+                runStart = i;
+            }
+        }
+
+        const float playheadX = frameToX(playback.GetCurrentFrameIndex());
+        drawList->AddLine(ImVec2(playheadX, origin.y),
+            ImVec2(playheadX, origin.y + kTimelineHeight),
+            IM_COL32(255, 255, 255, 255),
+            2.0f);
+
+        if (hovered)
+        {
+            const size_t frame = frameAtMouse();
+            const char *stateName = frame < timelineStates.size()
+                                        ? worker->GetStateRegistry()->Name(timelineStates[frame]).c_str()
+                                        : "not analysed yet";
+            ImGui::SetTooltip("Frame %zu: %s", frame + 1, stateName);
+        }
+
+        if (active)
+        {
+            const size_t frame = frameAtMouse();
+            if (frame != playback.GetCurrentFrameIndex())
+            {
+                playback.SetFrameIndex(frame);
+                RequestCurrentFrame();
+            }
+        }
+
+        ImGui::Text("Timeline: %zu / %zu frames analysed", timelineStates.size(), totalFrames);
+    }
+
 } // namespace SH3DS::App
@@ -7,13 +7,16 @@
 #include "Core/Constants.h"
 #include "Core/Types.h"
 #include "FSM/GameStateFSM.h"
+#include "FrameAnalysisWorker.h"
 #include "Kappa/Layer.h"
 #include "PlaybackController.h"
+#include "TextureUploader.h"
 #include "Vision/ShinyDetector.h"
 
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 // clang-format off
 #include <glad/glad.h>
@@ -24,6 +27,9 @@ namespace SH3DS::App
 {
     /**
      * @brief ImGui debug GUI layer for offline frame replay and pipeline visualization.
+     *
+     * The pipeline runs on a FrameAnalysisWorker; the render loop only posts requests and uploads finished images,
+     * so scrubbing never blocks the UI.
      */
     class DebugLayer : public Kappa::Layer
     {
@@ -33,6 +39,7 @@ namespace SH3DS::App
          * @param window GLFW window handle for ImGui initialization.
          * @param source Frame source for streaming.
          * @param seeker Non-owning seek interface (same object as source).
+         * @param screenDetector Automatic screen detection (may be null).
          * @param preprocessor Frame preprocessor for perspective warp.
          * @param fsm Game state FSM.
          * @param detector Shiny detector (may be null).
@@ -61,9 +68,14 @@ namespace SH3DS::App
 
     private:
         /**
-         * @brief Processes the current frame through the pipeline.
+         * @brief Requests the current frame from the worker, showing cached thumbnails until it arrives.
          */
-        void ProcessCurrentFrame();
+        void RequestCurrentFrame();
+
+        /**
+         * @brief Uploads images the worker has finished for the current frame.
+         */
+        void UploadFinishedFrame();
 
         /**
          * @brief Renders an image panel with ImGui::Image.
@@ -84,37 +96,33 @@ namespace SH3DS::App
          */
         void RenderPlaybackControls();
 
-        // Pipeline components
-        std::unique_ptr<Capture::FrameSource> source;             ///< Frame source (streaming)
-        std::shared_ptr<Capture::FrameSeeker> seeker = nullptr;   ///< Non-owning seek interface
-        std::unique_ptr<Capture::ScreenDetector> screenDetector;  ///< Automatic screen detection
-        std::unique_ptr<Capture::FramePreprocessor> preprocessor; ///< Perspective warp
-        std::unique_ptr<FSM::GameStateFSM> fsm;                   ///< Game state FSM
-        std::unique_ptr<Vision::ShinyDetector> detector;          ///< Shiny detector
-        std::string shinyRoi;                                     ///< ROI name for shiny detection
-        std::string shinyCheckState;                              ///< FSM state in which shiny detection runs
+        /**
+         * @brief Renders the full-recording FSM state timeline (click or drag to seek).
+         */
+        void RenderTimeline();
+
+        // Pipeline
+        std::unique_ptr<FrameAnalysisWorker> worker; ///< Background pipeline and timeline cache
 
         // Playback
         PlaybackController playback; ///< Playback state controller
 
-        // OpenGL textures
-        GLuint rawFrameTexture = 0;     ///< Texture for raw camera frame
-        GLuint topScreenTexture = 0;    ///< Texture for warped top screen
-        GLuint bottomScreenTexture = 0; ///< Texture for warped bottom screen
-
-        // Current frame data
-        cv::Mat currentRawFrame;     ///< Current raw camera frame
-        cv::Mat currentTopScreen;    ///< Current warped top screen
-        cv::Mat currentBottomScreen; ///< Current warped bottom screen
+        // OpenGL textures (one per image size, so switching between thumbnail and full frame never reallocates)
+        std::unique_ptr<TextureUploader> rawFrameTexture;        ///< Texture for raw camera frame
+        std::unique_ptr<TextureUploader> topScreenTexture;       ///< Texture for warped top screen
+        std::unique_ptr<TextureUploader> bottomScreenTexture;    ///< Texture for warped bottom screen
+        std::unique_ptr<TextureUploader> topThumbnailTexture;    ///< Texture for cached top screen thumbnails
+        std::unique_ptr<TextureUploader> bottomThumbnailTexture; ///< Texture for cached bottom screen thumbnails
+        bool showTopThumbnail = false;                           ///< Top panel shows its thumbnail texture
+        bool showBottomThumbnail = false;                        ///< Bottom panel shows its thumbnail texture
 
         // Display options
         bool applyColorImprovementToDisplay = false; ///< Whether to apply color correction to displayed warped frames
 
         // State info
-        std::string currentStateName = "unknown";            ///< Current FSM state
-        float timeInState = 0.0f;                            ///< Time in current state (seconds)
-        std::optional<Core::ShinyResult> currentShinyResult; ///< Latest shiny detection result
-        size_t lastProcessedFrame = SIZE_MAX;                ///< Last processed frame index
+        std::optional<TimelineEntry> currentEntry; ///< Cached analysis of the current frame (if reached)
+        std::vector<Core::StateId> timelineStates; ///< Per-frame states analysed so far
+        size_t lastRequestedFrame = SIZE_MAX;      ///< Last frame requested from the worker
 
         // Frame dimensions (for display)
         int rawWidth = 0;                             ///< Raw frame width
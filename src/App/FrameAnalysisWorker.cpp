@@ -0,0 +1,323 @@
+#include "FrameAnalysisWorker.h"
+
+#include "Core/Logger.h"
+#include "Vision/ColorImprovement.h"
+#include "Vision/FrameStatistics.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace SH3DS::App
+{
+    namespace
+    {
+        cv::Mat MakeThumbnail(const cv::Mat &screen)
+        {
+            cv::Mat thumbnail;
+            if (!screen.empty())
+            {
+                cv::resize(screen,
+                    thumbnail,
+                    cv::Size(),
+                    FrameAnalysisWorker::kThumbnailScale,
+                    FrameAnalysisWorker::kThumbnailScale,
+                    cv::INTER_AREA);
+            }
+            return thumbnail;
+        }
+    } // namespace
+
+    FrameAnalysisWorker::FrameAnalysisWorker(std::unique_ptr<Capture::FrameSource> source,
+        std::shared_ptr<Capture::FrameSeeker> seeker,
+        std::unique_ptr<Capture::ScreenDetector> screenDetector,
+        std::unique_ptr<Capture::FramePreprocessor> preprocessor,
+        std::unique_ptr<FSM::GameStateFSM> fsm,
+        std::unique_ptr<Vision::ShinyDetector> detector,
+        std::string shinyRoi,
+        std::string shinyCheckState,
+        size_t totalFrames,
+        size_t maxThumbnails)
+        : source(std::move(source)),
+          seeker(std::move(seeker)),
+          screenDetector(std::move(screenDetector)),
+          preprocessor(std::move(preprocessor)),
+          fsm(std::move(fsm)),
+          detector(std::move(detector)),
+          shinyRoi(std::move(shinyRoi)),
+          checkEveryState(shinyCheckState.empty()),
+          registry(this->fsm->GetStateRegistry()),
+          maxThumbnails(std::max<size_t>(maxThumbnails, 2)),
+          timeline(totalFrames)
+    {
+        thumbnails.reserve(this->maxThumbnails);
+
+        if (!checkEveryState)
+        {
+            shinyCheckStateId = registry->Find(shinyCheckState);
+        }
+
+        thread = std::thread(&FrameAnalysisWorker::Run, this);
+    }
+
+    FrameAnalysisWorker::~FrameAnalysisWorker()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        thread.join();
+    }
+
+    void FrameAnalysisWorker::RequestFrame(size_t frameIndex, bool correctBottom)
+    {
+        {
+            std::lock_guard lock(mutex);
+            pending = FrameRequest{ .frameIndex = frameIndex, .correctBottom = correctBottom };
+        }
+        wake.notify_one();
+    }
+
+    std::optional<FrameImages> FrameAnalysisWorker::TakeFrameImages()
+    {
+        std::lock_guard lock(mutex);
+        return std::exchange(completed, std::nullopt);
+    }
+
+    std::optional<TimelineEntry> FrameAnalysisWorker::GetTimelineEntry(size_t frameIndex) const
+    {
+        std::lock_guard lock(mutex);
+        if (frameIndex >= analysedFrames)
+        {
+            return std::nullopt;
+        }
+
+        const FrameVerdict &verdict = timeline[frameIndex];
+        TimelineEntry entry;
+        entry.state = verdict.state;
+        entry.stateEnteredFrame = verdict.stateEnteredFrame;
+        entry.shinyResult = verdict.shinyResult;
+
+        // Every sampled frame up to analysedFrames has been stored, so the nearest one at or before is cached
+        const size_t sample = frameIndex / thumbnailStride;
+        entry.thumbnailFrame = sample * thumbnailStride;
+        entry.topThumbnail = thumbnails[sample].top;
+        entry.bottomThumbnail = thumbnails[sample].bottom;
+        return entry;
+    }
+
+    void FrameAnalysisWorker::CollectTimelineStates(std::vector<Core::StateId> &states) const
+    {
+        std::lock_guard lock(mutex);
+        for (size_t i = states.size(); i < analysedFrames; ++i)
+        {
+            states.push_back(timeline[i].state);
+        }
+    }
+
+    size_t FrameAnalysisWorker::AnalysedFrames() const
+    {
+        std::lock_guard lock(mutex);
+        return analysedFrames;
+    }
+
+    std::shared_ptr<const Core::StateRegistry> FrameAnalysisWorker::GetStateRegistry() const
+    {
+        return registry;
+    }
+
+    void FrameAnalysisWorker::Run()
+    {
+        std::unique_lock lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [this] { return stopping || pending || analysedFrames < timeline.size(); });
+            if (stopping)
+            {
+                return;
+            }
+
+            // Display requests take priority over the timeline pass: at most one timeline frame delays a scrub.
+            if (pending)
+            {
+                const FrameRequest request = *pending;
+                pending.reset();
+                lock.unlock();
+
+                std::optional<FrameImages> images;
+                try
+                {
+                    images = RenderRequest(request);
+                }
+                catch (const std::exception &e)
+                {
+                    LOG_ERROR("Frame {}: processing failed: {}", request.frameIndex, e.what());
+                }
+
+                lock.lock();
+                if (images)
+                {
+                    completed = std::move(images);
+                }
+                continue;
+            }
+
+            const size_t frameIndex = analysedFrames;
+            lock.unlock();
+
+            TimelineEntry entry;
+            try
+            {
+                entry = AnalyseTimelineFrame(frameIndex);
+            }
+            catch (const std::exception &e)
+            {
+                LOG_ERROR("Frame {}: timeline analysis failed: {}", frameIndex, e.what());
+                entry.state = timelineState;
+                entry.stateEnteredFrame = stateEnteredFrame;
+            }
+
+            lock.lock();
+            StoreTimelineEntry(frameIndex, std::move(entry));
+            if (analysedFrames == timeline.size())
+            {
+                LOG_INFO("Timeline analysis complete ({} frames)", analysedFrames);
+            }
+        }
+    }
+
+    std::optional<Core::Frame> FrameAnalysisWorker::GrabFrame(size_t frameIndex)
+    {
+        if (seeker && sourcePosition != frameIndex)
+        {
+            seeker->Seek(frameIndex);
+        }
+
+        auto frame = source->Grab();
+        sourcePosition = frame ? frameIndex + 1 : SIZE_MAX;
+        return frame;
+    }
+
+    std::optional<Capture::DualScreenResult> FrameAnalysisWorker::AnalyseScreens(const cv::Mat &image)
+    {
+        if (screenDetector)
+        {
+            screenDetector->ApplyTo(*preprocessor, image);
+        }
+
+        auto screens = preprocessor->ProcessDualScreen(image);
+        if (!screens)
+        {
+            return std::nullopt;
+        }
+
+        // Apply color correction to the full warped top image before ROI extraction so that
+        // Gray World WB has the complete scene to compute balanced gains. Bottom screen is
+        // LCD-rendered UI — WB correction is not applied.
+        if (!screens->warpedTop.empty())
+        {
+            Vision::ComputeFrameStatistics(screens->warpedTop, screens->topStatistics);
+            screens->warpedTop = Vision::ImproveFrameColors(screens->warpedTop, screens->topStatistics);
+            preprocessor->ReextractRois(*screens);
+        }
+        return screens;
+    }
+
+    FrameImages FrameAnalysisWorker::RenderRequest(const FrameRequest &request)
+    {
+        FrameImages images;
+        images.frameIndex = request.frameIndex;
+
+        auto frame = GrabFrame(request.frameIndex);
+        if (!frame)
+        {
+            return images;
+        }
+        images.rawFrame = frame->image.clone(); // the source may reuse its buffer on the next Grab()
+
+        auto screens = AnalyseScreens(frame->image);
+        if (!screens)
+        {
+            return images;
+        }
+
+        images.topScreen = screens->warpedTop;
+        images.bottomScreen = screens->warpedBottom;
+        if (request.correctBottom && !images.bottomScreen.empty())
+        {
+            images.bottomScreen = Vision::ImproveFrameColors(images.bottomScreen);
+        }
+        return images;
+    }
+
+    TimelineEntry FrameAnalysisWorker::AnalyseTimelineFrame(size_t frameIndex)
+    {
+        TimelineEntry entry;
+        auto frame = GrabFrame(frameIndex);
+        auto screens = frame ? AnalyseScreens(frame->image) : std::nullopt;
+
+        if (screens && (!screens->topRois.empty() || !screens->bottomRois.empty()))
+        {
+            fsm->SetFrameStatistics(screens->topStatistics);
+            fsm->Update(screens->topRois, screens->bottomRois);
+
+            const Core::StateId newState = fsm->GetCurrentState();
+            if (newState != timelineState)
+            {
+                timelineShinyResult = std::nullopt; // clear stale result on state change
+                timelineState = newState;
+                stateEnteredFrame = frameIndex;
+            }
+        }
+
+        if (screens && detector && !screens->topRois.empty() && !shinyRoi.empty()
+            && (checkEveryState || timelineState == shinyCheckStateId))
+        {
+            auto it = screens->topRois.find(shinyRoi);
+            if (it != screens->topRois.end() && !it->second.empty())
+            {
+                timelineShinyResult = detector->Detect(it->second);
+            }
+        }
+
+        entry.state = timelineState;
+        entry.stateEnteredFrame = stateEnteredFrame;
+        entry.shinyResult = timelineShinyResult;
+        if (screens && frameIndex % thumbnailStride == 0)
+        {
+            entry.topThumbnail = MakeThumbnail(screens->warpedTop);
+            entry.bottomThumbnail = MakeThumbnail(screens->warpedBottom);
+        }
+        return entry;
+    }
+
+    void FrameAnalysisWorker::StoreTimelineEntry(size_t frameIndex, TimelineEntry entry)
+    {
+        timeline[frameIndex] = FrameVerdict{ .state = entry.state,
+            .stateEnteredFrame = entry.stateEnteredFrame,
+            .shinyResult = std::move(entry.shinyResult) };
+        ++analysedFrames;
+
+        if (frameIndex % thumbnailStride != 0)
+        {
+            return;
+        }
+        thumbnails.push_back(
+            Thumbnails{ .top = std::move(entry.topThumbnail), .bottom = std::move(entry.bottomThumbnail) });
+
+        // Keep the even samples and double the stride: the cache stays within maxThumbnails and spread evenly
+        // over the recording, and the next sampled frame lands at index thumbnails.size() again.
+        if (thumbnails.size() == maxThumbnails)
+        {
+            for (size_t i = 1; 2 * i < thumbnails.size(); ++i)
+            {
+                thumbnails[i] = std::move(thumbnails[2 * i]);
+            }
+            thumbnails.resize((thumbnails.size() + 1) / 2);
+            thumbnailStride *= 2;
+        }
+    }
+} // namespace SH3DS::App
@@ -0,0 +1,243 @@
+#pragma once
+
+#include "Capture/FramePreprocessor.h"
+#include "Capture/FrameSeeker.h"
+#include "Capture/FrameSource.h"
+#include "Capture/ScreenDetector.h"
+#include "Core/StateRegistry.h"
+#include "Core/Types.h"
+#include "FSM/GameStateFSM.h"
+#include "Vision/ShinyDetector.h"
+
+#include <opencv2/core.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SH3DS::App
+{
+    /**
+     * @brief Analysis of one recording frame from the in-order timeline pass.
+     *
+     * State and shiny result are kept for every frame. Thumbnails are only kept for sampled frames, so the
+     * thumbnails of an entry show @ref thumbnailFrame, the nearest sampled frame at or before it.
+     */
+    struct TimelineEntry
+    {
+        Core::StateId state = Core::kInvalidStateId;  ///< FSM state after this frame
+        size_t stateEnteredFrame = 0;                 ///< Frame at which @ref state was entered
+        std::optional<Core::ShinyResult> shinyResult; ///< Latest shiny result in this state
+        size_t thumbnailFrame = 0;                    ///< Frame the thumbnails were taken from
+        cv::Mat topThumbnail;                         ///< Downscaled corrected top screen (empty if not warped)
+        cv::Mat bottomThumbnail;                      ///< Downscaled bottom screen (empty if not warped)
+    };
+
+    /**
+     * @brief Full-resolution images of a requested frame, ready for display.
+     */
+    struct FrameImages
+    {
+        size_t frameIndex = 0; ///< Frame the images belong to
+        cv::Mat rawFrame;      ///< Camera frame
+        cv::Mat topScreen;     ///< Warped, colour-corrected top screen (empty if not warped)
+        cv::Mat bottomScreen;  ///< Warped bottom screen (empty if not warped)
+    };
+
+    /**
+     * @brief Runs the replay pipeline on a background thread for the debug GUI.
+     *
+     * Two jobs share the thread. Display requests (seek, decode, warp, correct) are served first, and a newer
+     * request replaces one that has not started yet, so scrubbing never queues up stale work. While no request
+     * is pending, the worker walks the recording from the first frame, runs the FSM and shiny detector on every
+     * frame and caches the result in a timeline. The FSM's debounce is frame-based, so this in-order pass gives
+     * the same states the live pipeline would, regardless of where the user scrubs.
+     *
+     * All pipeline components are owned by and only touched from the worker thread; the public methods are safe
+     * to call from the GUI thread.
+     */
+    class FrameAnalysisWorker
+    {
+    public:
+        static constexpr double kThumbnailScale = 0.25; ///< Size of cached thumbnails relative to the warp
+        static constexpr size_t kMaxThumbnails = 1024;  ///< Default cap on cached thumbnail pairs
+
+        /**
+         * @brief Starts the worker thread.
+         * @param source Frame source for streaming.
+         * @param seeker Seek interface (same object as source).
+         * @param screenDetector Automatic screen detection (may be null).
+         * @param preprocessor Frame preprocessor for perspective warp.
+         * @param fsm Game state FSM.
+         * @param detector Shiny detector (may be null).
+         * @param shinyRoi ROI name for shiny detection.
+         * @param shinyCheckState FSM state in which shiny detection runs (empty: every state).
+         * @param totalFrames Number of frames in the recording (0 disables the timeline pass).
+         * @param maxThumbnails Cap on cached thumbnail pairs (at least 2). Thumbnails start out on every frame;
+         *        whenever the cap is reached, every other one is dropped and the sampling stride doubles, so the
+         *        cache covers the whole recording evenly within a fixed budget.
+         */
+        FrameAnalysisWorker(std::unique_ptr<Capture::FrameSource> source,
+            std::shared_ptr<Capture::FrameSeeker> seeker,
+            std::unique_ptr<Capture::ScreenDetector> screenDetector,
+            std::unique_ptr<Capture::FramePreprocessor> preprocessor,
+            std::unique_ptr<FSM::GameStateFSM> fsm,
+            std::unique_ptr<Vision::ShinyDetector> detector,
+            std::string shinyRoi,
+            std::string shinyCheckState,
+            size_t totalFrames,
+            size_t maxThumbnails = kMaxThumbnails);
+
+        /**
+         * @brief Stops the worker thread after the frame it is currently processing.
+         */
+        ~FrameAnalysisWorker();
+
+        FrameAnalysisWorker(const FrameAnalysisWorker &) = delete;
+        FrameAnalysisWorker &operator=(const FrameAnalysisWorker &) = delete;
+
+        /**
+         * @brief Requests full-resolution images of a frame, replacing any request not yet started.
+         * @param frameIndex Zero-based frame index.
+         * @param correctBottom Whether to colour-correct the bottom screen for display.
+         */
+        void RequestFrame(size_t frameIndex, bool correctBottom);
+
+        /**
+         * @brief Takes the images of the most recently completed request, if any arrived since the last call.
+         * @return The images, or std::nullopt.
+         */
+        std::optional<FrameImages> TakeFrameImages();
+
+        /**
+         * @brief Returns the cached analysis of a frame.
+         * @param frameIndex Zero-based frame index.
+         * @return The entry, or std::nullopt if the timeline pass has not reached the frame yet.
+         */
+        std::optional<TimelineEntry> GetTimelineEntry(size_t frameIndex) const;
+
+        /**
+         * @brief Appends the states of frames analysed since the previous call.
+         * @param states Per-frame states gathered so far; extended in place.
+         */
+        void CollectTimelineStates(std::vector<Core::StateId> &states) const;
+
+        /**
+         * @brief Returns the number of frames the timeline pass has analysed.
+         * @return Frames in [0, totalFrames].
+         */
+        size_t AnalysedFrames() const;
+
+        /**
+         * @brief Returns the FSM's state registry (for state names).
+         * @return The registry.
+         */
+        std::shared_ptr<const Core::StateRegistry> GetStateRegistry() const;
+
+    private:
+        /**
+         * @brief A pending display request.
+         */
+        struct FrameRequest
+        {
+            size_t frameIndex = 0;      ///< Requested frame
+            bool correctBottom = false; ///< Whether to colour-correct the bottom screen
+        };
+
+        /**
+         * @brief What the timeline keeps for every frame.
+         */
+        struct FrameVerdict
+        {
+            Core::StateId state = Core::kInvalidStateId;  ///< FSM state after this frame
+            size_t stateEnteredFrame = 0;                 ///< Frame at which @ref state was entered
+            std::optional<Core::ShinyResult> shinyResult; ///< Latest shiny result in this state
+        };
+
+        /**
+         * @brief Thumbnails of one sampled frame.
+         */
+        struct Thumbnails
+        {
+            cv::Mat top;    ///< Downscaled corrected top screen (empty if not warped)
+            cv::Mat bottom; ///< Downscaled bottom screen (empty if not warped)
+        };
+
+        /**
+         * @brief Worker thread body.
+         */
+        void Run();
+
+        /**
+         * @brief Grabs a frame, seeking only if the source is not already positioned on it.
+         * @param frameIndex Zero-based frame index.
+         * @return The frame, or std::nullopt on a decode failure.
+         */
+        std::optional<Core::Frame> GrabFrame(size_t frameIndex);
+
+        /**
+         * @brief Warps a camera frame and colour-corrects the top screen.
+         * @param image Camera frame.
+         * @return The screens with ROIs and top-screen statistics, or std::nullopt if the warp failed.
+         */
+        std::optional<Capture::DualScreenResult> AnalyseScreens(const cv::Mat &image);
+
+        /**
+         * @brief Produces display images for a request.
+         * @param request The request.
+         * @return The images (only rawFrame is set if the warp failed).
+         */
+        FrameImages RenderRequest(const FrameRequest &request);
+
+        /**
+         * @brief Runs the FSM and detector on the next timeline frame.
+         * @param frameIndex Zero-based frame index (the next unanalysed frame).
+         * @return The frame's timeline entry; thumbnails only if the frame is sampled.
+         */
+        TimelineEntry AnalyseTimelineFrame(size_t frameIndex);
+
+        /**
+         * @brief Appends a frame's entry to the timeline, thinning the thumbnails when the cap is reached.
+         * @param frameIndex Zero-based frame index (the next unanalysed frame).
+         * @param entry The frame's timeline entry.
+         */
+        void StoreTimelineEntry(size_t frameIndex, TimelineEntry entry);
+
+        // Pipeline components (worker thread only)
+        std::unique_ptr<Capture::FrameSource> source;             ///< Frame source (streaming)
+        std::shared_ptr<Capture::FrameSeeker> seeker;             ///< Seek interface
+        std::unique_ptr<Capture::ScreenDetector> screenDetector;  ///< Automatic screen detection
+        std::unique_ptr<Capture::FramePreprocessor> preprocessor; ///< Perspective warp
+        std::unique_ptr<FSM::GameStateFSM> fsm;                   ///< Game state FSM
+        std::unique_ptr<Vision::ShinyDetector> detector;          ///< Shiny detector
+        std::string shinyRoi;                                     ///< ROI name for shiny detection
+        Core::StateId shinyCheckStateId = Core::kInvalidStateId;  ///< Resolved shinyCheckState
+        bool checkEveryState = true;                              ///< shinyCheckState was empty
+        std::shared_ptr<const Core::StateRegistry> registry;      ///< FSM state names
+
+        // Timeline pass state (worker thread only)
+        size_t sourcePosition = SIZE_MAX;                     ///< Frame the next Grab() returns, if known
+        size_t stateEnteredFrame = 0;                         ///< Frame at which the current state was entered
+        Core::StateId timelineState = Core::kInvalidStateId;  ///< State after the last analysed frame
+        std::optional<Core::ShinyResult> timelineShinyResult; ///< Latest shiny result in timelineState
+        size_t maxThumbnails = kMaxThumbnails;                ///< Thinning threshold for thumbnails
+
+        // Shared with the GUI thread (guarded by mutex)
+        mutable std::mutex mutex;             ///< Guards the members below
+        std::condition_variable wake;         ///< Signalled on new requests and shutdown
+        std::optional<FrameRequest> pending;  ///< Latest request not yet started
+        std::optional<FrameImages> completed; ///< Latest finished request not yet taken
+        std::vector<FrameVerdict> timeline;   ///< Entries [0, analysedFrames) are valid
+        size_t analysedFrames = 0;            ///< Timeline pass progress
+        std::vector<Thumbnails> thumbnails;   ///< [i] belongs to frame i * thumbnailStride
+        size_t thumbnailStride = 1;           ///< Frames between sampled thumbnails (written by the worker)
+        bool stopping = false;                ///< Set by the destructor
+
+        std::thread thread; ///< Worker thread (started last, joined first)
+    };
+} // namespace SH3DS::App
@@ -3,10 +3,10 @@
 #include "Capture/FileFrameSource.h"
 #include "Capture/VideoFrameSource.h"
 #include "Core/Config.h"
+#include "Core/Logger.h"
 #include "DebugLayer.h"
 #include "FSM/HuntProfiles.h"
-#include "Kappa/Logger.h"
-#include "Vision/DominantColorDetector.h"
+#include "Vision/FusionDetector.h"
 
 #include <filesystem>
 
@@ -79,17 +79,19 @@ namespace SH3DS::App
             hardwareConfig.screenCalibration, unifiedConfig.rois, hardwareConfig.bottomScreenCalibration);
 
         // Create FSM
-        // TODO(hunt-profile-dispatch): Currently only XY Starter SR is supported. When multi-profile
-        // support is needed, add a `hunt_profile` key to the unified hunt YAML and dispatch here via
-        // a lookup table (e.g. "xy_starter_sr" -> HuntProfiles::CreateXYStarterSR).
-        pipeline.fsm = FSM::HuntProfiles::CreateXYStarterSR(unifiedConfig.fsmParams);
+        pipeline.fsm = FSM::HuntProfiles::Create(unifiedConfig.huntProfile, unifiedConfig.fsmParams);
 
         // Create detector
         if (!unifiedConfig.shinyDetector.method.empty())
         {
-            pipeline.detector = Vision::DominantColorDetector::CreateDominantColorDetector(
-                unifiedConfig.shinyDetector, unifiedConfig.huntId);
-            pipeline.shinyRoi = unifiedConfig.shinyDetector.roi;
+            pipeline.detector =
+                Vision::FusionDetector::CreateMethodDetector(unifiedConfig.shinyDetector, unifiedConfig.huntId);
+            if (!pipeline.detector)
+            {
+                LOG_WARN("Unknown shiny detection method '{}'; shiny detection disabled",
+                    unifiedConfig.shinyDetector.method);
+            }
+            pipeline.shinyRoi = Vision::FusionDetector::MethodRoi(unifiedConfig.shinyDetector);
             pipeline.shinyCheckState = unifiedConfig.shinyCheckState;
         }
 
@@ -1,12 +1,51 @@
 #include "TextureUploader.h"
 
-#include <opencv2/imgproc.hpp>
+#include <cstring>
 
 namespace SH3DS::App
 {
-    GLuint TextureUploader::CreateTexture()
+    namespace
+    {
+        GLenum PixelFormat(int channels)
+        {
+            switch (channels)
+            {
+            case 1:
+                return GL_RED;
+            case 4:
+                return GL_BGRA;
+            default:
+                return GL_BGR;
+            }
+        }
+
+        GLint InternalFormat(int channels)
+        {
+            switch (channels)
+            {
+            case 1:
+                return GL_R8;
+            case 4:
+                return GL_RGBA8;
+            default:
+                return GL_RGB8;
+            }
+        }
+
+        bool IsSupported(const cv::Mat &mat)
+        {
+            const int channels = mat.channels();
+            return !mat.empty() && mat.depth() == CV_8U && (channels == 1 || channels == 3 || channels == 4);
+        }
+
+        bool IsSameImage(const cv::Mat &a, const cv::Mat &b)
+        {
+            return a.data == b.data && a.size() == b.size() && a.type() == b.type() && a.step[0] == b.step[0];
+        }
+    } // namespace
+
+    TextureUploader::TextureUploader()
     {
-        GLuint textureId = 0;
         glGenTextures(1, &textureId);
         glBindTexture(GL_TEXTURE_2D, textureId);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -14,34 +53,135 @@ namespace SH3DS::App
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glBindTexture(GL_TEXTURE_2D, 0);
-        return textureId;
+
+        glGenBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+    }
+
+    TextureUploader::~TextureUploader()
+    {
+        glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+        glDeleteTextures(1, &textureId);
     }
 
-    void TextureUploader::Upload(const cv::Mat &mat, GLuint textureId)
+    bool TextureUploader::Upload(const cv::Mat &mat)
     {
-        if (mat.empty() || textureId == 0)
+        if (!IsSupported(mat) || !Transfer(mat))
         {
-            return;
+            return false;
         }
+        lastUploaded.release();
+        return true;
+    }
 
-        cv::Mat rgb;
-        if (mat.channels() == 4)
+    bool TextureUploader::Upload(const cv::Mat &mat, uint64_t generation)
+    {
+        if (!IsSupported(mat) || (generation == lastGeneration && IsSameImage(mat, lastUploaded)))
         {
-            cv::cvtColor(mat, rgb, cv::COLOR_BGRA2RGBA);
+            return false;
         }
-        else if (mat.channels() == 3)
+        if (!Transfer(mat))
         {
-            cv::cvtColor(mat, rgb, cv::COLOR_BGR2RGB);
+            return false;
         }
-        else
+        lastUploaded = mat;
+        lastGeneration = generation;
+        return true;
+    }
+
+    bool TextureUploader::Transfer(const cv::Mat &mat)
+    {
+        const int matChannels = mat.channels();
+        const GLenum format = PixelFormat(matChannels);
+        glBindTexture(GL_TEXTURE_2D, textureId);
+
+        // (Re)allocate storage only when the image geometry changes
+        if (mat.cols != width || mat.rows != height || matChannels != channels)
         {
-            rgb = mat;
+            glTexImage2D(GL_TEXTURE_2D,
+                0,
+                InternalFormat(matChannels),
+                mat.cols,
+                mat.rows,
+                0,
+                format,
+                GL_UNSIGNED_BYTE,
+                nullptr);
+
+            const GLint gray[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+            const GLint identity[] = { GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA };
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, matChannels == 1 ? gray : identity);
+
+            width = mat.cols;
+            height = mat.rows;
+            channels = matChannels;
         }
 
-        glBindTexture(GL_TEXTURE_2D, textureId);
-        GLenum format = (rgb.channels() == 4) ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, rgb.cols, rgb.rows, 0, format, GL_UNSIGNED_BYTE, rgb.data);
+        const size_t rowBytes = static_cast<size_t>(mat.cols) * mat.elemSize();
+        const size_t byteCount = rowBytes * static_cast<size_t>(mat.rows);
+        const size_t index = nextBuffer;
+        nextBuffer = (nextBuffer + 1) % kBufferCount;
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffers[index]);
+        if (capacity[index] < byteCount)
+        {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(byteCount), nullptr, GL_STREAM_DRAW);
+            capacity[index] = byteCount;
+        }
+
+        // Invalidating lets the driver hand out fresh memory if the GPU still reads this buffer
+        auto *mapped = static_cast<uchar *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+            0,
+            static_cast<GLsizeiptr>(byteCount),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+        bool uploaded = false;
+        if (mapped)
+        {
+            if (mat.isContinuous())
+            {
+                std::memcpy(mapped, mat.data, byteCount);
+            }
+            else
+            {
+                for (int y = 0; y < mat.rows; ++y)
+                {
+                    std::memcpy(mapped + static_cast<size_t>(y) * rowBytes, mat.ptr(y), rowBytes);
+                }
+            }
+
+            if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+            {
+                GLint previousAlignment = 4;
+                glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // rows are packed tightly in the buffer
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mat.cols, mat.rows, format, GL_UNSIGNED_BYTE, nullptr);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+                uploaded = true;
+            }
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
         glBindTexture(GL_TEXTURE_2D, 0);
+        return uploaded;
     }
 
+    void TextureUploader::Invalidate()
+    {
+        lastUploaded.release();
+    }
+
+    GLuint TextureUploader::GetTextureId() const
+    {
+        return textureId;
+    }
+
+    int TextureUploader::GetWidth() const
+    {
+        return width;
+    }
+
+    int TextureUploader::GetHeight() const
+    {
+        return height;
+    }
 } // namespace SH3DS::App
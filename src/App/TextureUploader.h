@@ -4,25 +4,91 @@
 
 #include <glad/glad.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 namespace SH3DS::App
 {
     /**
-     * @brief Utility for uploading cv::Mat images to OpenGL textures.
+     * @brief Streams cv::Mat images into one OpenGL texture.
+     *
+     * Texture storage is allocated once per image size and refreshed with glTexSubImage2D. Pixels go through two
+     * pixel buffer objects used in turn, so the copy into driver memory never waits on the previous transfer.
+     * BGR(A) data is uploaded as-is (GL_BGR / GL_BGRA) and grayscale is swizzled to gray, so no CPU conversion
+     * takes place. Alternating images of different sizes reallocates the storage every time; use one uploader per
+     * image size instead.
+     *
+     * Requires a current OpenGL 3.3+ context for construction, Upload() and destruction.
      */
     class TextureUploader
     {
     public:
         /**
-         * @brief Creates a new OpenGL texture with default parameters.
-         * @return OpenGL texture ID.
+         * @brief Creates the texture and its pixel buffer objects.
+         */
+        TextureUploader();
+
+        /**
+         * @brief Deletes the texture and its pixel buffer objects.
+         */
+        ~TextureUploader();
+
+        TextureUploader(const TextureUploader &) = delete;
+        TextureUploader &operator=(const TextureUploader &) = delete;
+
+        /**
+         * @brief Uploads an image into the texture, always transferring its pixels.
+         * @param mat 8-bit image with 1, 3 (BGR) or 4 (BGRA) channels; ROI views are fine.
+         * @return True if the texture was updated, false if the image was empty or unsupported.
          */
-        static GLuint CreateTexture();
+        bool Upload(const cv::Mat &mat);
 
         /**
-         * @brief Uploads a cv::Mat to an existing OpenGL texture.
-         * @param mat Source image (BGR or BGRA).
-         * @param textureId Target OpenGL texture ID.
+         * @brief Uploads an image unless it is the last one uploaded and unchanged since.
+         *
+         * The producer owns @p generation and must bump it whenever it rewrites the pixels of a buffer in place.
+         * The same buffer (data, size, type and stride) with the same generation as the last upload is skipped.
+         * A reference to the last uploaded Mat is kept, so its buffer cannot be freed and reused meanwhile.
+         *
+         * @param mat 8-bit image with 1, 3 (BGR) or 4 (BGRA) channels; ROI views are fine.
+         * @param generation Version of the pixels in @p mat.
+         * @return True if the texture was updated, false if the image was empty, unsupported or unchanged.
          */
-        static void Upload(const cv::Mat &mat, GLuint textureId);
+        bool Upload(const cv::Mat &mat, uint64_t generation);
+
+        /**
+         * @brief Forgets the last uploaded image so the next Upload() always transfers, whatever its generation.
+         */
+        void Invalidate();
+
+        /** @brief Returns the OpenGL texture ID. */
+        [[nodiscard]] GLuint GetTextureId() const;
+
+        /** @brief Returns the width of the texture (0 before the first upload). */
+        [[nodiscard]] int GetWidth() const;
+
+        /** @brief Returns the height of the texture (0 before the first upload). */
+        [[nodiscard]] int GetHeight() const;
+
+    private:
+        static constexpr size_t kBufferCount = 2; ///< Pixel buffer objects used in turn
+
+        /**
+         * @brief Streams the pixels of a supported, non-empty image into the texture.
+         * @param mat The image.
+         * @return True if the texture was updated.
+         */
+        bool Transfer(const cv::Mat &mat);
+
+        GLuint textureId = 0;                        ///< Target texture
+        std::array<GLuint, kBufferCount> buffers{};  ///< Pixel unpack buffers
+        std::array<size_t, kBufferCount> capacity{}; ///< Allocated bytes per buffer
+        size_t nextBuffer = 0;                       ///< Buffer the next upload writes to
+        int width = 0;                               ///< Allocated texture width
+        int height = 0;                              ///< Allocated texture height
+        int channels = 0;                            ///< Channels of the allocated texture
+        cv::Mat lastUploaded;                        ///< Last image uploaded with a generation (held to detect repeats)
+        uint64_t lastGeneration = 0;                 ///< Generation of lastUploaded
     };
 } // namespace SH3DS::App
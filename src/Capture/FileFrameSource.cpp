@@ -1,11 +1,44 @@
 #include "FileFrameSource.h"
 
-#include "Kappa/Logger.h"
+#include "Core/Logger.h"
 
 #include <opencv2/imgcodecs.hpp>
 
+#include <cstdio>
+
 namespace SH3DS::Capture
 {
+    namespace
+    {
+        /**
+         * @brief Reads a whole file into @p bytes, reusing its capacity.
+         * @return True if the file was read completely.
+         */
+        bool ReadFileInto(const std::filesystem::path &path, std::vector<uchar> &bytes)
+        {
+#ifdef _WIN32
+            std::FILE *file = _wfopen(path.c_str(), L"rb");
+#else
+            std::FILE *file = std::fopen(path.c_str(), "rb");
+#endif
+            if (file == nullptr)
+            {
+                return false;
+            }
+
+            bool ok = std::fseek(file, 0, SEEK_END) == 0;
+            const long size = ok ? std::ftell(file) : -1;
+            ok = size > 0 && std::fseek(file, 0, SEEK_SET) == 0;
+            if (ok)
+            {
+                bytes.resize(static_cast<std::size_t>(size));
+                ok = std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+            }
+            std::fclose(file);
+            return ok;
+        }
+    } // namespace
+
     FileFrameSource::FileFrameSource(const std::filesystem::path &directory, double playbackFps)
         : directory(directory),
           playbackFps(playbackFps)
@@ -48,33 +81,61 @@ namespace SH3DS::Capture
         framePaths.clear();
         currentIndex = 0;
         open = false;
+        fileBytes = {};
+        decodeBuffer.release();
     }
 
     std::optional<Core::Frame> FileFrameSource::Grab()
     {
-        if (!open || currentIndex >= framePaths.size())
+        Core::Frame frame;
+        if (!GrabInto(frame))
         {
             return std::nullopt;
         }
+        return frame;
+    }
+
+    bool FileFrameSource::GrabInto(Core::Frame &frame)
+    {
+        if (!open || currentIndex >= framePaths.size())
+        {
+            return false;
+        }
 
-        cv::Mat image = cv::imread(framePaths[currentIndex].string(), cv::IMREAD_COLOR);
-        if (image.empty())
+        // While cropping, the full image only lives in the reused decode buffer
+        cv::Mat &decoded = cropHint ? decodeBuffer : frame.image;
+        const auto &path = framePaths[currentIndex];
+        bool ok = ReadFileInto(path, fileBytes);
+        if (ok)
         {
-            LOG_WARN("FileFrameSource: Failed to read image: {}", framePaths[currentIndex].string());
+            const cv::Mat encoded(1, static_cast<int>(fileBytes.size()), CV_8UC1, fileBytes.data());
+            ok = !cv::imdecode(encoded, cv::IMREAD_COLOR, &decoded).empty();
+        }
+        if (!ok)
+        {
+            LOG_WARN("FileFrameSource: Failed to read image: {}", path.string());
             ++currentIndex;
-            return std::nullopt;
+            return false;
         }
 
-        Core::Frame frame;
-        frame.image = image;
+        frame.metadata = {};
         frame.metadata.sequenceNumber = currentIndex;
         frame.metadata.captureTime = std::chrono::steady_clock::now();
-        frame.metadata.sourceWidth = image.cols;
-        frame.metadata.sourceHeight = image.rows;
+        frame.metadata.sourceWidth = decoded.cols;
+        frame.metadata.sourceHeight = decoded.rows;
         frame.metadata.fpsEstimate = playbackFps;
+        if (const auto region = CropRegion(cropHint, decoded.size()))
+        {
+            decoded(*region).copyTo(frame.image);
+            frame.metadata.cropOrigin = region->tl();
+        }
+        else if (cropHint)
+        {
+            decoded.copyTo(frame.image); // the decode buffer is reused by the next grab
+        }
 
         ++currentIndex;
-        return frame;
+        return true;
     }
 
     bool FileFrameSource::IsOpen() const
@@ -87,6 +148,15 @@ namespace SH3DS::Capture
         return "FileFrameSource(" + directory.string() + ", " + std::to_string(framePaths.size()) + " frames)";
     }
 
+    void FileFrameSource::SetCropHint(std::optional<cv::Rect> region)
+    {
+        cropHint = region;
+        if (!cropHint)
+        {
+            decodeBuffer.release();
+        }
+    }
+
     bool FileFrameSource::Seek(size_t frameIndex)
     {
         if (frameIndex >= framePaths.size())
@@ -31,10 +31,26 @@ namespace SH3DS::Capture
 
         std::optional<Core::Frame> Grab() override;
 
+        /**
+         * @brief Reads the next file into a reused byte buffer and decodes it into @p frame's image.
+         *
+         * The decode target is reused whenever the image size has not changed, so a replay of equal-sized frames
+         * stops allocating image buffers after the first grab.
+         */
+        bool GrabInto(Core::Frame &frame) override;
+
         bool IsOpen() const override;
 
         std::string Describe() const override;
 
+        /**
+         * @brief Keeps only the hinted region of each decoded image.
+         *
+         * The image codecs decode whole files, so the full image is still decoded once, into a buffer reused across
+         * grabs, and only the region is copied into the frame.
+         */
+        void SetCropHint(std::optional<cv::Rect> region) override;
+
         bool Seek(size_t frameIndex) override;
         size_t GetFrameCount() const override;
 
@@ -53,5 +69,8 @@ namespace SH3DS::Capture
         std::vector<std::filesystem::path> framePaths;
         size_t currentIndex = 0;
         bool open = false;
+        std::optional<cv::Rect> cropHint;
+        std::vector<uchar> fileBytes; ///< Reused encoded contents of the current file
+        cv::Mat decodeBuffer;         ///< Reused full-size decode target while cropping
     };
 } // namespace SH3DS::Capture
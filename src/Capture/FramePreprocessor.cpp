@@ -1,7 +1,7 @@
 #include "FramePreprocessor.h"
 
 #include "Core/Constants.h"
-#include "Kappa/Logger.h"
+#include "Core/Logger.h"
 
 #include <opencv2/imgproc.hpp>
 
@@ -59,7 +59,7 @@ namespace SH3DS::Capture
             }
             else
             {
-                bottomWarpMatrix = CalculateWarpMatrix(*this->bottomCalibration);
+                bottomWarpMatrix = CalculateWarpMatrix(*this->bottomCalibration, frameOrigin);
             }
         }
     }
@@ -75,22 +75,33 @@ namespace SH3DS::Capture
         cv::warpPerspective(
             cameraFrame, warped, warpMatrix, cv::Size(calibration.targetWidth, calibration.targetHeight));
 
-        return ExtractRois(warped, calibration);
+        Core::ROISet rois;
+        ExtractRois(warped, calibration, rois);
+        return rois;
     }
 
     std::optional<DualScreenResult> FramePreprocessor::ProcessDualScreen(const cv::Mat &cameraFrame) const
     {
-        if (cameraFrame.empty() || warpMatrix.empty())
+        DualScreenResult result;
+        if (!ProcessDualScreen(cameraFrame, result))
         {
             return std::nullopt;
         }
+        return result;
+    }
 
-        DualScreenResult result;
+    bool FramePreprocessor::ProcessDualScreen(const cv::Mat &cameraFrame, DualScreenResult &result) const
+    {
+        if (cameraFrame.empty() || warpMatrix.empty())
+        {
+            return false;
+        }
 
-        // warpedTop/warpedBottom are independent allocations from warpPerspective.
-        // topRois are intentionally left empty here — callers must apply any post-warp
+        // warpPerspective writes into the result's images when their size and type already match.
+        // topRois are intentionally not refreshed here — callers must apply any post-warp
         // correction (e.g. color improvement) to warpedTop and then call ReextractRois()
         // to populate topRois from the corrected image.
+        result.topStatistics = {};
         cv::warpPerspective(
             cameraFrame, result.warpedTop, warpMatrix, cv::Size(calibration.targetWidth, calibration.targetHeight));
 
@@ -102,24 +113,29 @@ namespace SH3DS::Capture
                 result.warpedBottom,
                 bottomWarpMatrix,
                 cv::Size(bottomCalibration->targetWidth, bottomCalibration->targetHeight));
-            result.bottomRois = ExtractRois(result.warpedBottom, *bottomCalibration);
+            ExtractRois(result.warpedBottom, *bottomCalibration, result.bottomRois);
+        }
+        else
+        {
+            result.warpedBottom.release();
+            result.bottomRois.clear();
         }
 
-        return result;
+        return true;
     }
 
     void FramePreprocessor::ReextractRois(DualScreenResult &result) const
     {
         if (!result.warpedTop.empty())
         {
-            result.topRois = ExtractRois(result.warpedTop, calibration);
+            ExtractRois(result.warpedTop, calibration, result.topRois);
         }
     }
 
-    Core::ROISet FramePreprocessor::ExtractRois(const cv::Mat &warpedImage,
-        const Core::ScreenCalibrationConfig &calib) const
+    void FramePreprocessor::ExtractRois(const cv::Mat &warpedImage,
+        const Core::ScreenCalibrationConfig &calib,
+        Core::ROISet &rois) const
     {
-        Core::ROISet rois;
         for (const auto &roiDef : roiDefs)
         {
             int x = static_cast<int>(std::round(roiDef.x * calib.targetWidth));
@@ -134,11 +150,15 @@ namespace SH3DS::Capture
 
             if (w > 0 && h > 0)
             {
-                // Clone to give caller independent ownership (sub-regions share memory with source)
-                rois[roiDef.name] = warpedImage(cv::Rect(x, y, w, h)).clone();
+                // Views, not copies: nested ROIs cost nothing to extract and consumers can locate each ROI inside
+                // the warped screen (cv::Mat::locateROI) to share per-screen work such as colour integrals.
+                rois[roiDef.name] = warpedImage(cv::Rect(x, y, w, h));
+            }
+            else
+            {
+                rois.erase(roiDef.name);
             }
         }
-        return rois;
     }
 
     void FramePreprocessor::SetFixedCorners(std::array<cv::Point2f, 4> corners)
@@ -165,15 +185,42 @@ namespace SH3DS::Capture
             bottomCalibration = bottom;
         }
         bottomCalibration->corners = corners;
-        bottomWarpMatrix = CalculateWarpMatrix(*bottomCalibration);
+        bottomWarpMatrix = CalculateWarpMatrix(*bottomCalibration, frameOrigin);
+    }
+
+    void FramePreprocessor::SetFrameOrigin(cv::Point origin)
+    {
+        if (origin == frameOrigin)
+        {
+            return;
+        }
+        frameOrigin = origin;
+        if (!AreCornersDegenerate(calibration.corners))
+        {
+            RecalculateWarpMatrix();
+        }
+        if (bottomCalibration)
+        {
+            bottomWarpMatrix = CalculateWarpMatrix(*bottomCalibration, frameOrigin);
+        }
+    }
+
+    cv::Rect FramePreprocessor::ScreenBounds() const
+    {
+        std::vector<cv::Point2f> corners(calibration.corners.begin(), calibration.corners.end());
+        if (bottomCalibration)
+        {
+            corners.insert(corners.end(), bottomCalibration->corners.begin(), bottomCalibration->corners.end());
+        }
+        return cv::boundingRect(corners);
     }
 
     void FramePreprocessor::RecalculateWarpMatrix()
     {
-        warpMatrix = CalculateWarpMatrix(calibration);
+        warpMatrix = CalculateWarpMatrix(calibration, frameOrigin);
     }
 
-    cv::Mat FramePreprocessor::CalculateWarpMatrix(const Core::ScreenCalibrationConfig &calib)
+    cv::Mat FramePreprocessor::CalculateWarpMatrix(const Core::ScreenCalibrationConfig &calib, cv::Point origin)
     {
         std::vector<cv::Point2f> dst = {
             cv::Point2f(0.0f, 0.0f),
@@ -182,7 +229,12 @@ namespace SH3DS::Capture
             cv::Point2f(0.0f, static_cast<float>(calib.targetHeight)),
         };
 
-        std::vector<cv::Point2f> src(calib.corners.begin(), calib.corners.end());
+        // Corners are in full-frame coordinates; a cropped frame starts at origin
+        std::vector<cv::Point2f> src;
+        for (const auto &corner : calib.corners)
+        {
+            src.emplace_back(corner.x - static_cast<float>(origin.x), corner.y - static_cast<float>(origin.y));
+        }
         return cv::getPerspectiveTransform(src, dst);
     }
 
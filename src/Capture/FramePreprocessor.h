@@ -16,10 +16,11 @@ namespace SH3DS::Capture
      */
     struct DualScreenResult
     {
-        cv::Mat warpedTop;       ///< Full warped top screen image
-        cv::Mat warpedBottom;    ///< Full warped bottom screen image (empty if no calibration)
-        Core::ROISet topRois;    ///< Extracted ROIs from top screen
-        Core::ROISet bottomRois; ///< Extracted ROIs from bottom screen
+        cv::Mat warpedTop;                   ///< Full warped top screen image
+        cv::Mat warpedBottom;                ///< Full warped bottom screen image (empty if no calibration)
+        Core::ROISet topRois;                ///< ROIs of the top screen (views into warpedTop)
+        Core::ROISet bottomRois;             ///< ROIs of the bottom screen (views into warpedBottom)
+        Core::FrameStatistics topStatistics; ///< Statistics of warpedTop (pixelCount 0 until measured)
     };
 
     /**
@@ -64,6 +65,19 @@ namespace SH3DS::Capture
          */
         std::optional<DualScreenResult> ProcessDualScreen(const cv::Mat &cameraFrame) const;
 
+        /**
+         * @brief Warps both screens into an existing result, reusing its images and ROI maps.
+         *
+         * Same contract as the optional-returning overload, except that @p result.topRois keeps its previous
+         * entries until ReextractRois() is called. A result that is fed every frame stops allocating once its
+         * images have the calibrated sizes; anything still viewing its images sees them overwritten.
+         *
+         * @param cameraFrame The raw camera frame.
+         * @param result Receives the warped screens; its statistics are reset to "not measured".
+         * @return True on success, false if the frame is empty or the top screen is not calibrated.
+         */
+        bool ProcessDualScreen(const cv::Mat &cameraFrame, DualScreenResult &result) const;
+
         /**
          * @brief Extracts top-screen ROIs from the (possibly corrected) warpedTop image.
          *
@@ -86,14 +100,34 @@ namespace SH3DS::Capture
          */
         void SetBottomCorners(std::array<cv::Point2f, 4> corners);
 
+        /**
+         * @brief Sets where incoming camera frames start within the full camera frame.
+         *
+         * Corners stay in full-frame coordinates; frames cropped by a FrameSource crop hint are warped through this
+         * origin (FrameMetadata::cropOrigin).
+         * @param origin Top-left of the incoming frames in the full frame.
+         */
+        void SetFrameOrigin(cv::Point origin);
+
+        /**
+         * @brief Returns the bounding box of the calibrated screens in full-frame coordinates.
+         * @return Bounding box of the top (and, if calibrated, bottom) screen corners.
+         */
+        cv::Rect ScreenBounds() const;
+
     private:
         /**
          * @brief Extracts named ROIs from a warped screen image.
+         *
+         * The ROIs are views sharing the warped image's buffer, which must not be modified afterwards. Entries
+         * already in @p rois are overwritten in place, so refilling the same map allocates nothing.
          * @param warpedImage The perspective-corrected screen image.
          * @param calib The calibration config used for coordinate mapping.
-         * @return Map of ROI name to extracted sub-image.
+         * @param rois Map of ROI name to extracted sub-image.
          */
-        Core::ROISet ExtractRois(const cv::Mat &warpedImage, const Core::ScreenCalibrationConfig &calib) const;
+        void ExtractRois(const cv::Mat &warpedImage,
+            const Core::ScreenCalibrationConfig &calib,
+            Core::ROISet &rois) const;
 
         /**
          * @brief Recalculates the warp matrix.
@@ -103,14 +137,16 @@ namespace SH3DS::Capture
         /**
          * @brief Calculates a warp matrix from calibration config.
          * @param calib The calibration config.
+         * @param origin Top-left of the incoming frames in the full frame.
          * @return The perspective transform matrix.
          */
-        static cv::Mat CalculateWarpMatrix(const Core::ScreenCalibrationConfig &calib);
+        static cv::Mat CalculateWarpMatrix(const Core::ScreenCalibrationConfig &calib, cv::Point origin);
 
         Core::ScreenCalibrationConfig calibration;                      ///< Top screen calibration
         std::vector<Core::RoiDefinition> roiDefs;                       ///< The ROI definitions
         cv::Mat warpMatrix;                                             ///< Top screen warp matrix
         std::optional<Core::ScreenCalibrationConfig> bottomCalibration; ///< Bottom screen calibration
         cv::Mat bottomWarpMatrix;                                       ///< Bottom screen warp matrix
+        cv::Point frameOrigin;                                          ///< Top-left of incoming frames (crop hint)
     };
 } // namespace SH3DS::Capture
@@ -2,9 +2,12 @@
 
 #include "Core/Types.h"
 
+#include <opencv2/core.hpp>
+
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 
 namespace SH3DS::Capture
 {
@@ -33,6 +36,26 @@ namespace SH3DS::Capture
          */
         virtual std::optional<Core::Frame> Grab() = 0;
 
+        /**
+         * @brief Grabs a frame into a caller-owned frame, reusing its image buffer.
+         *
+         * The default moves the result of Grab() into @p frame. Sources that can decode or copy straight into
+         * frame.image override it, so a frame kept across calls stops allocating once its size has settled.
+         *
+         * @param frame Receives the frame; its contents are unspecified when false is returned.
+         * @return True if a frame was grabbed.
+         */
+        virtual bool GrabInto(Core::Frame &frame)
+        {
+            auto grabbed = Grab();
+            if (!grabbed)
+            {
+                return false;
+            }
+            frame = std::move(*grabbed);
+            return true;
+        }
+
         /**
          * @brief Checks if the frame source is open.
          * @return True if the frame source is open, false otherwise.
@@ -44,5 +67,41 @@ namespace SH3DS::Capture
          * @return A string describing the frame source.
          */
         virtual std::string Describe() const = 0;
+
+        /**
+         * @brief Asks the source to deliver only part of each frame.
+         *
+         * Sources that support it decode, copy and keep only @p region (clamped to the frame) and report its top-left
+         * corner in FrameMetadata::cropOrigin; sourceWidth and sourceHeight stay the full frame size. Sources that
+         * cannot crop ignore the hint and keep delivering full frames with a zero origin.
+         *
+         * @param region Region in full-frame pixels, or std::nullopt for full frames again.
+         */
+        virtual void SetCropHint(std::optional<cv::Rect> region)
+        {
+            (void)region;
+        }
+
+    protected:
+        /**
+         * @brief Clamps a crop hint to a frame.
+         * @param hint The crop hint.
+         * @param frameSize Size of the full frame.
+         * @return The region to keep, or std::nullopt if the whole frame should be kept.
+         */
+        static std::optional<cv::Rect> CropRegion(const std::optional<cv::Rect> &hint, cv::Size frameSize)
+        {
+            if (!hint)
+            {
+                return std::nullopt;
+            }
+            const cv::Rect frameRect(0, 0, frameSize.width, frameSize.height);
+            const cv::Rect region = *hint & frameRect;
+            if (region.empty() || region == frameRect)
+            {
+                return std::nullopt;
+            }
+            return region;
+        }
     };
 } // namespace SH3DS::Capture
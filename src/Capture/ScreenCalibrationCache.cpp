@@ -0,0 +1,101 @@
+#include "ScreenCalibrationCache.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <fstream>
+#include <system_error>
+
+namespace SH3DS::Capture
+{
+    namespace
+    {
+        bool ParseCorners(const YAML::Node &node, std::array<cv::Point2f, 4> &corners)
+        {
+            if (!node.IsSequence() || node.size() != corners.size())
+            {
+                return false;
+            }
+            for (size_t i = 0; i < corners.size(); ++i)
+            {
+                const YAML::Node point = node[i];
+                if (!point.IsSequence() || point.size() != 2)
+                {
+                    return false;
+                }
+                corners[i] = cv::Point2f(point[0].as<float>(), point[1].as<float>());
+            }
+            return true;
+        }
+
+        void EmitCorners(YAML::Emitter &out, const std::array<cv::Point2f, 4> &corners)
+        {
+            out << YAML::BeginSeq;
+            for (const auto &corner : corners)
+            {
+                out << YAML::Flow << YAML::BeginSeq << corner.x << corner.y << YAML::EndSeq;
+            }
+            out << YAML::EndSeq;
+        }
+    } // namespace
+
+    std::optional<ScreenCalibrationCache> LoadScreenCalibrationCache(const std::filesystem::path &path)
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(path, error))
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            const YAML::Node root = YAML::LoadFile(path.string());
+            ScreenCalibrationCache cache;
+            cache.cameraId = root["camera_id"].as<std::string>("");
+            cache.frameWidth = root["frame_width"].as<int>(0);
+            cache.frameHeight = root["frame_height"].as<int>(0);
+            if (cache.frameWidth <= 0 || cache.frameHeight <= 0 || !ParseCorners(root["top_corners"], cache.topCorners)
+                || !ParseCorners(root["bottom_corners"], cache.bottomCorners))
+            {
+                return std::nullopt;
+            }
+            return cache;
+        }
+        catch (const YAML::Exception &)
+        {
+            return std::nullopt;
+        }
+    }
+
+    bool SaveScreenCalibrationCache(const std::filesystem::path &path, const ScreenCalibrationCache &cache)
+    {
+        YAML::Emitter out;
+        out << YAML::BeginMap;
+        out << YAML::Key << "camera_id" << YAML::Value << cache.cameraId;
+        out << YAML::Key << "frame_width" << YAML::Value << cache.frameWidth;
+        out << YAML::Key << "frame_height" << YAML::Value << cache.frameHeight;
+        out << YAML::Key << "top_corners" << YAML::Value;
+        EmitCorners(out, cache.topCorners);
+        out << YAML::Key << "bottom_corners" << YAML::Value;
+        EmitCorners(out, cache.bottomCorners);
+        out << YAML::EndMap;
+
+        std::error_code error;
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            file << out.c_str() << '\n';
+            if (!file)
+            {
+                return false;
+            }
+        }
+        std::filesystem::rename(temporary, path, error);
+        return !error;
+    }
+} // namespace SH3DS::Capture
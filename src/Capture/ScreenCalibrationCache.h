@@ -0,0 +1,41 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace SH3DS::Capture
+{
+    /**
+     * @brief Screen corners locked by ScreenDetector, saved so a restart can skip calibration.
+     */
+    struct ScreenCalibrationCache
+    {
+        std::string cameraId;                       ///< Camera the corners were measured on
+        int frameWidth = 0;                         ///< Camera frame width at calibration
+        int frameHeight = 0;                        ///< Camera frame height at calibration
+        std::array<cv::Point2f, 4> topCorners{};    ///< Top screen corners (TL, TR, BR, BL)
+        std::array<cv::Point2f, 4> bottomCorners{}; ///< Bottom screen corners (TL, TR, BR, BL)
+    };
+
+    /**
+     * @brief Loads a calibration cache written by SaveScreenCalibrationCache().
+     * @param path Cache file.
+     * @return The cache, or std::nullopt if the file is missing or malformed.
+     */
+    std::optional<ScreenCalibrationCache> LoadScreenCalibrationCache(const std::filesystem::path &path);
+
+    /**
+     * @brief Writes a calibration cache as YAML.
+     *
+     * The file is written next to @p path and renamed over it, so a crash mid-write leaves the previous cache intact.
+     *
+     * @param path Cache file.
+     * @param cache Corners to save.
+     * @return True on success.
+     */
+    bool SaveScreenCalibrationCache(const std::filesystem::path &path, const ScreenCalibrationCache &cache);
+} // namespace SH3DS::Capture
@@ -1,9 +1,12 @@
 #include "ScreenDetector.h"
 
+#include "Core/HotLog.h"
+#include "Core/Logger.h"
 #include "FramePreprocessor.h"
-#include "Kappa/Logger.h"
+#include "ScreenCalibrationCache.h"
 
 #include <opencv2/imgproc.hpp>
+#include <opencv2/video/tracking.hpp>
 
 #include <algorithm>
 #include <cmath>
@@ -11,6 +14,30 @@
 
 namespace SH3DS::Capture
 {
+    namespace
+    {
+        constexpr float kCacheEdgeMargin = 0.05f; ///< Depth of the edge strips sampled when validating cached corners
+        constexpr int kTrackingWindowSize = 15;   ///< Lucas-Kanade window (px) at each pyramid level
+        constexpr int kTrackingPyramidLevels = 2; ///< Pyramid levels above the full-resolution patch
+
+        /**
+         * @brief Scales a quad about its centroid and shifts it into a region's coordinates.
+         */
+        std::vector<cv::Point> ScaleQuad(const std::array<cv::Point2f, 4> &corners, float scale, cv::Point origin)
+        {
+            const cv::Point2f centroid((corners[0].x + corners[1].x + corners[2].x + corners[3].x) / 4.0f,
+                (corners[0].y + corners[1].y + corners[2].y + corners[3].y) / 4.0f);
+            std::vector<cv::Point> quad;
+            quad.reserve(corners.size());
+            for (const auto &corner : corners)
+            {
+                quad.emplace_back(cvRound(centroid.x + (corner.x - centroid.x) * scale) - origin.x,
+                    cvRound(centroid.y + (corner.y - centroid.y) * scale) - origin.y);
+            }
+            return quad;
+        }
+    } // namespace
+
     ScreenDetector::ScreenDetector(ScreenDetectorConfig config) : config(std::move(config))
     {
     }
@@ -36,8 +63,35 @@ namespace SH3DS::Capture
             return calibratedResult;
         }
 
-        auto result = DetectOnce(cameraFrame);
-        SmoothCorners(result);
+        // A restart checks the saved corners once before falling back to full detection
+        if (!cacheChecked && !cameraFrame.empty())
+        {
+            cacheChecked = true;
+            if (RestoreFromCache(cameraFrame))
+            {
+                return calibratedResult;
+            }
+        }
+
+        // Follow the corners from the previous frame while tracking holds; otherwise run full contour detection
+        ScreenDetectionResult result;
+        if (!tracking || !TrackCorners(cameraFrame, result))
+        {
+            if (tracking)
+            {
+                HOT_LOG_DEBUG("ScreenDetector: Corner tracking lost, falling back to contour detection");
+                tracking = false;
+            }
+
+            result = DetectOnce(cameraFrame);
+            const bool bothFound = result.topScreen.has_value() && result.bottomScreen.has_value();
+            if (config.trackCorners && bothFound)
+            {
+                // Seed from the raw detection: smoothed corners may lag the real ones by a few pixels
+                SeedTracking(cameraFrame, result.topScreen->corners, result.bottomScreen->corners);
+            }
+            SmoothCorners(result);
+        }
 
         // Update split point when both screens are visible
         if (result.topScreen && result.bottomScreen)
@@ -65,6 +119,8 @@ namespace SH3DS::Capture
             {
                 calibrated = true;
                 calibratedResult = result;
+                tracking = false;
+                SaveToCache(cameraFrame);
                 LOG_INFO("Screen detection calibrated ({:.0f}% success rate over {} frames)",
                     successRate * 100.0,
                     calibrationWindow.size());
@@ -116,6 +172,16 @@ namespace SH3DS::Capture
         return calibrated;
     }
 
+    bool ScreenDetector::IsRestoredFromCache() const
+    {
+        return restoredFromCache;
+    }
+
+    bool ScreenDetector::IsTracking() const
+    {
+        return tracking;
+    }
+
     void ScreenDetector::Reset()
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -124,10 +190,13 @@ namespace SH3DS::Capture
         smoothedBottomCorners = std::nullopt;
         framesSinceTopDetection = 0;
         framesSinceBottomDetection = 0;
+        tracking = false;
         splitPointY = -1.0f;
         calibrated = false;
         calibrationWindow.clear();
         calibratedResult = {};
+        cacheChecked = true; // an explicit reset asks for fresh detection; the next lock overwrites the cache
+        restoredFromCache = false;
     }
 
     std::unique_ptr<ScreenDetector> ScreenDetector::CreateScreenDetector(ScreenDetectorConfig config)
@@ -218,7 +287,7 @@ namespace SH3DS::Capture
 
         if (candidates.empty() && !cameraFrame.empty())
         {
-            LOG_DEBUG("ScreenDetector: No candidates found in non-empty frame (Otsu={:.0f}, fallback={})",
+            HOT_LOG_DEBUG("ScreenDetector: No candidates found in non-empty frame (Otsu={:.0f}, fallback={})",
                 otsuThreshold,
                 config.brightnessThreshold);
         }
@@ -355,6 +424,97 @@ namespace SH3DS::Capture
         }
     }
 
+    bool ScreenDetector::TrackCorners(const cv::Mat &cameraFrame, ScreenDetectionResult &result)
+    {
+        if (cameraFrame.empty())
+        {
+            return false;
+        }
+
+        const cv::Rect frameRect(0, 0, cameraFrame.cols, cameraFrame.rows);
+        const cv::Size window(kTrackingWindowSize, kTrackingWindowSize);
+        std::array<cv::Point2f, kTrackedCornerCount> corners;
+        std::vector<cv::Point2f> previousPoint(1);
+        std::vector<cv::Point2f> nextPoint;
+        std::vector<uchar> status;
+        std::vector<float> error;
+        cv::Mat patch;
+
+        // Each corner is tracked within the patch it was seeded in, so only small crops are converted and searched
+        for (size_t i = 0; i < kTrackedCornerCount; ++i)
+        {
+            const cv::Rect &rect = trackRects[i];
+            if ((rect & frameRect) != rect)
+            {
+                return false; // frame size changed
+            }
+            cv::cvtColor(cameraFrame(rect), patch, cv::COLOR_BGR2GRAY);
+
+            const cv::Point2f origin(static_cast<float>(rect.x), static_cast<float>(rect.y));
+            previousPoint[0] = trackedCorners[i] - origin;
+            cv::calcOpticalFlowPyrLK(
+                trackPatches[i], patch, previousPoint, nextPoint, status, error, window, kTrackingPyramidLevels);
+            if (status[0] == 0 || static_cast<double>(error[0]) > config.maxTrackingError)
+            {
+                return false;
+            }
+            corners[i] = nextPoint[0] + origin;
+        }
+
+        std::array<cv::Point2f, 4> topCorners;
+        std::array<cv::Point2f, 4> bottomCorners;
+        std::copy_n(corners.begin(), 4, topCorners.begin());
+        std::copy_n(corners.begin() + 4, 4, bottomCorners.begin());
+
+        // A corner that slid along an edge still has a small patch error; the quads catch it
+        const DetectedScreen top = MakeScreen(topCorners);
+        const DetectedScreen bottom = MakeScreen(bottomCorners);
+        if (!ValidateCornerOrder(topCorners) || !ValidateCornerOrder(bottomCorners)
+            || std::abs(top.aspectRatio - config.topAspectRatio) > config.aspectRatioTolerance
+            || std::abs(bottom.aspectRatio - config.bottomAspectRatio) > config.aspectRatioTolerance)
+        {
+            return false;
+        }
+
+        result.topScreen = top;
+        result.bottomScreen = bottom;
+
+        // Tracked corners are already stable; keep the EMA in step so a fallback continues from here
+        smoothedTopCorners = topCorners;
+        smoothedBottomCorners = bottomCorners;
+        framesSinceTopDetection = 0;
+        framesSinceBottomDetection = 0;
+
+        SeedTracking(cameraFrame, topCorners, bottomCorners);
+        return true;
+    }
+
+    void ScreenDetector::SeedTracking(const cv::Mat &cameraFrame,
+        const std::array<cv::Point2f, 4> &topCorners,
+        const std::array<cv::Point2f, 4> &bottomCorners)
+    {
+        const cv::Rect frameRect(0, 0, cameraFrame.cols, cameraFrame.rows);
+        const int radius = config.trackingPatchRadius;
+        tracking = false;
+
+        for (size_t i = 0; i < kTrackedCornerCount; ++i)
+        {
+            const cv::Point2f &corner = i < 4 ? topCorners[i] : bottomCorners[i - 4];
+            const cv::Point centre(cvRound(corner.x), cvRound(corner.y));
+            const cv::Rect rect =
+                cv::Rect(centre.x - radius, centre.y - radius, 2 * radius + 1, 2 * radius + 1) & frameRect;
+            if (!rect.contains(centre) || rect.width < kTrackingWindowSize || rect.height < kTrackingWindowSize)
+            {
+                return;
+            }
+
+            trackRects[i] = rect;
+            trackedCorners[i] = corner;
+            cv::cvtColor(cameraFrame(rect), trackPatches[i], cv::COLOR_BGR2GRAY);
+        }
+        tracking = true;
+    }
+
     std::array<cv::Point2f, 4> ScreenDetector::OrderCorners(const std::vector<cv::Point> &contour)
     {
         std::array<cv::Point2f, 4> ordered;
@@ -440,4 +600,146 @@ namespace SH3DS::Capture
         return confidence;
     }
 
+    DetectedScreen ScreenDetector::MakeScreen(const std::array<cv::Point2f, 4> &corners) const
+    {
+        DetectedScreen screen;
+        screen.corners = corners;
+        screen.aspectRatio = ComputeAspectRatio(corners);
+        screen.confidence = ComputeConfidence(corners, screen.aspectRatio);
+        return screen;
+    }
+
+    bool ScreenDetector::RestoreFromCache(const cv::Mat &cameraFrame)
+    {
+        if (config.calibrationCachePath.empty())
+        {
+            return false;
+        }
+
+        const auto cache = LoadScreenCalibrationCache(config.calibrationCachePath);
+        if (!cache)
+        {
+            LOG_INFO("Screen calibration cache '{}' not found; calibrating", config.calibrationCachePath);
+            return false;
+        }
+        if (cache->cameraId != config.cameraId || cache->frameWidth != cameraFrame.cols
+            || cache->frameHeight != cameraFrame.rows)
+        {
+            LOG_INFO("Screen calibration cache is for '{}' at {}x{}, camera is '{}' at {}x{}; calibrating",
+                cache->cameraId,
+                cache->frameWidth,
+                cache->frameHeight,
+                config.cameraId,
+                cameraFrame.cols,
+                cameraFrame.rows);
+            return false;
+        }
+
+        const double topContrast = ScreenContrast(cameraFrame, cache->topCorners);
+        const double bottomContrast = ScreenContrast(cameraFrame, cache->bottomCorners);
+        if (topContrast < config.cacheMinContrast || bottomContrast < config.cacheMinContrast)
+        {
+            LOG_INFO("Screen calibration cache rejected (screen contrast {:.0f}/{:.0f} < {:.0f}); calibrating",
+                topContrast,
+                bottomContrast,
+                config.cacheMinContrast);
+            return false;
+        }
+
+        calibratedResult = {};
+        calibratedResult.topScreen = MakeScreen(cache->topCorners);
+        calibratedResult.bottomScreen = MakeScreen(cache->bottomCorners);
+        splitPointY = ((cache->topCorners[0].y + cache->topCorners[2].y) / 2.0f
+                          + (cache->bottomCorners[0].y + cache->bottomCorners[2].y) / 2.0f)
+                      / 2.0f;
+        calibrated = true;
+        restoredFromCache = true;
+
+        LOG_INFO("Screen calibration restored from '{}' (screen contrast {:.0f}/{:.0f})",
+            config.calibrationCachePath,
+            topContrast,
+            bottomContrast);
+        return true;
+    }
+
+    void ScreenDetector::SaveToCache(const cv::Mat &cameraFrame) const
+    {
+        if (config.calibrationCachePath.empty() || !calibratedResult.topScreen || !calibratedResult.bottomScreen)
+        {
+            return;
+        }
+
+        ScreenCalibrationCache cache;
+        cache.cameraId = config.cameraId;
+        cache.frameWidth = cameraFrame.cols;
+        cache.frameHeight = cameraFrame.rows;
+        cache.topCorners = calibratedResult.topScreen->corners;
+        cache.bottomCorners = calibratedResult.bottomScreen->corners;
+        if (!SaveScreenCalibrationCache(config.calibrationCachePath, cache))
+        {
+            LOG_WARN("Could not write screen calibration cache '{}'", config.calibrationCachePath);
+        }
+    }
+
+    double ScreenDetector::ScreenContrast(const cv::Mat &cameraFrame, const std::array<cv::Point2f, 4> &corners)
+    {
+        // Compare a strip just inside each edge with a strip just outside it. A bright quad anywhere near the saved
+        // one raises the average, but only a screen still sitting on the saved edges passes on all four sides.
+        const float depth = 2.0f * kCacheEdgeMargin; // strip depth as a fraction of the corner-to-centroid distance
+        const auto outer = ScaleQuad(corners, 1.0f + depth, cv::Point(0, 0));
+        int left = cameraFrame.cols;
+        int top = cameraFrame.rows;
+        int right = 0;
+        int bottom = 0;
+        for (const auto &point : outer)
+        {
+            left = std::min(left, point.x);
+            top = std::min(top, point.y);
+            right = std::max(right, point.x + 1);
+            bottom = std::max(bottom, point.y + 1);
+        }
+        const cv::Rect frameRect(0, 0, cameraFrame.cols, cameraFrame.rows);
+        const cv::Rect region = cv::Rect(left, top, right - left, bottom - top) & frameRect;
+        if (region.width < 8 || region.height < 8)
+        {
+            return -1.0;
+        }
+
+        cv::Mat gray;
+        cv::cvtColor(cameraFrame(region), gray, cv::COLOR_BGR2GRAY);
+
+        const cv::Point2f origin(static_cast<float>(region.x), static_cast<float>(region.y));
+        const cv::Point2f centroid = (corners[0] + corners[1] + corners[2] + corners[3]) * 0.25f;
+        auto stripMean = [&](const cv::Point2f &a, const cv::Point2f &b, float towardCentre) -> std::optional<double> {
+            const std::array<cv::Point2f, 4> strip = {
+                a, b, b + (centroid - b) * towardCentre, a + (centroid - a) * towardCentre
+            };
+            std::vector<cv::Point> polygon;
+            for (const auto &point : strip)
+            {
+                polygon.emplace_back(cvRound(point.x - origin.x), cvRound(point.y - origin.y));
+            }
+            cv::Mat mask(gray.size(), CV_8UC1, cv::Scalar(0));
+            cv::fillConvexPoly(mask, polygon, cv::Scalar(255));
+            if (cv::countNonZero(mask) == 0)
+            {
+                return std::nullopt;
+            }
+            return cv::mean(gray, mask)[0];
+        };
+
+        double contrast = 255.0;
+        for (size_t i = 0; i < corners.size(); ++i)
+        {
+            const auto inside = stripMean(corners[i], corners[(i + 1) % corners.size()], depth);
+            const auto outside = stripMean(corners[i], corners[(i + 1) % corners.size()], -depth);
+            if (!inside || !outside)
+            {
+                return -1.0;
+            }
+            contrast = std::min(contrast, *inside - *outside);
+        }
+        return contrast;
+    }
+
 } // namespace SH3DS::Capture
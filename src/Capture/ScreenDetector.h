@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace SH3DS::Capture
@@ -50,6 +51,12 @@ namespace SH3DS::Capture
         int morphKernelSize = 5;                                   ///< Kernel size for morphological operations
         double polyEpsilonFraction = 0.02;                         ///< approxPolyDP epsilon as fraction of perimeter
         int calibrationFrames = 15; ///< Minimum frames in rolling window before calibration can lock
+        std::string calibrationCachePath; ///< File locked corners are saved to and restored from; empty = off
+        std::string cameraId;             ///< Camera identity stored with the cached corners
+        double cacheMinContrast = 30.0;   ///< Min brightness step (0-255) across every edge of a cached screen
+        bool trackCorners = true;         ///< Track corners with optical flow between contour detections
+        int trackingPatchRadius = 32;     ///< Half-size (px) of the patch each corner is tracked in
+        double maxTrackingError = 12.0;   ///< Max mean patch difference (0-255) before tracking gives up
     };
 
     /**
@@ -58,6 +65,16 @@ namespace SH3DS::Capture
      *
      * Detects screens during the first calibrationFrames frames, then locks in
      * the detected corners and returns cached results on subsequent calls.
+     *
+     * With a calibration cache configured, locked corners are saved to disk. On the first frame after construction
+     * the saved corners are checked once (same camera and resolution, both screens still brighter than the bezel
+     * along every edge) and, if they pass, locked immediately without running detection.
+     *
+     * Until calibration locks, a frame in which both screens are found seeds a tracker: the eight corners are then
+     * followed frame to frame with pyramidal Lucas-Kanade on small patches around each corner, which is much cheaper
+     * than contour detection and gives sub-pixel corners that need no EMA smoothing. Contour detection takes over
+     * again as soon as a corner is lost, its patch error exceeds maxTrackingError, or a tracked quad stops looking
+     * like a screen.
      */
     class ScreenDetector
     {
@@ -77,6 +94,12 @@ namespace SH3DS::Capture
         /** @brief Whether calibration is complete (corners locked). */
         bool IsCalibrated() const;
 
+        /** @brief Whether the locked corners came from the calibration cache. */
+        bool IsRestoredFromCache() const;
+
+        /** @brief Whether corners are being tracked with optical flow instead of re-detected each frame. */
+        bool IsTracking() const;
+
         /** @brief Reset calibration and smoothing state. Forces re-detection. */
         void Reset();
 
@@ -99,6 +122,14 @@ namespace SH3DS::Capture
             int &framesSinceDetection,
             double alpha);
 
+        /** @brief Follow the tracked corners into the frame; false if tracking confidence dropped. */
+        bool TrackCorners(const cv::Mat &cameraFrame, ScreenDetectionResult &result);
+
+        /** @brief Start tracking from freshly detected corners (stops tracking if they cannot be seeded). */
+        void SeedTracking(const cv::Mat &cameraFrame,
+            const std::array<cv::Point2f, 4> &topCorners,
+            const std::array<cv::Point2f, 4> &bottomCorners);
+
         /** @brief Order contour points as TL, TR, BR, BL. */
         static std::array<cv::Point2f, 4> OrderCorners(const std::vector<cv::Point> &contour);
 
@@ -111,6 +142,19 @@ namespace SH3DS::Capture
         /** @brief Compute detection confidence from shape quality and aspect ratio match. */
         [[nodiscard]] double ComputeConfidence(const std::array<cv::Point2f, 4> &corners, double aspectRatio) const;
 
+        /** @brief Build a fresh DetectedScreen (aspect ratio and confidence) from ordered corners. */
+        [[nodiscard]] DetectedScreen MakeScreen(const std::array<cv::Point2f, 4> &corners) const;
+
+        /** @brief Lock the cached corners if they match the camera and still frame both screens. */
+        bool RestoreFromCache(const cv::Mat &cameraFrame);
+
+        /** @brief Save the locked corners to the calibration cache. */
+        void SaveToCache(const cv::Mat &cameraFrame) const;
+
+        /** @brief Smallest inside-minus-outside brightness step across the quad's edges (-1 if not in the frame). */
+        [[nodiscard]] static double ScreenContrast(const cv::Mat &cameraFrame,
+            const std::array<cv::Point2f, 4> &corners);
+
         ScreenDetectorConfig config; ///< Algorithm configuration
 
         // Temporal smoothing state
@@ -119,6 +163,13 @@ namespace SH3DS::Capture
         int framesSinceTopDetection = 0;                                 ///< Frames since last top screen detection
         int framesSinceBottomDetection = 0;                              ///< Frames since last bottom screen detection
 
+        // Optical-flow tracking state (corners 0-3 top, 4-7 bottom)
+        static constexpr size_t kTrackedCornerCount = 8;             ///< Corners tracked across both screens
+        bool tracking = false;                                       ///< Whether corners are being tracked
+        std::array<cv::Point2f, kTrackedCornerCount> trackedCorners; ///< Corner positions in the previous frame
+        std::array<cv::Rect, kTrackedCornerCount> trackRects;        ///< Patch rectangles in the previous frame
+        std::array<cv::Mat, kTrackedCornerCount> trackPatches;       ///< Grayscale patches from the previous frame
+
         // Position memory for single-screen classification
         float splitPointY = -1.0f; ///< Vertical midpoint between top/bottom screens (-1 = unknown)
 
@@ -128,6 +179,8 @@ namespace SH3DS::Capture
         static constexpr double kCalibrationSuccessThreshold = 0.8; ///< Required success rate (80%)
         std::deque<bool> calibrationWindow;                         ///< Rolling window of detection success/failure
         ScreenDetectionResult calibratedResult;                     ///< Locked result after calibration
+        bool cacheChecked = false;                                  ///< Whether the calibration cache was consulted
+        bool restoredFromCache = false;                             ///< Whether the locked result came from the cache
 
         // Thread safety
         mutable std::mutex mutex; ///< Guards mutable state in Detect() and Reset()
@@ -1,6 +1,6 @@
 #include "VideoFrameSource.h"
 
-#include "Kappa/Logger.h"
+#include "Core/Logger.h"
 
 namespace SH3DS::Capture
 {
@@ -44,46 +44,66 @@ namespace SH3DS::Capture
     void VideoFrameSource::Close()
     {
         capture.release();
+        decodeBuffer.release();
         currentIndex = 0;
         totalFrames = 0;
         isOpen = false;
     }
 
     std::optional<Core::Frame> VideoFrameSource::Grab()
+    {
+        Core::Frame frame;
+        if (!GrabInto(frame))
+        {
+            return std::nullopt;
+        }
+        return frame;
+    }
+
+    bool VideoFrameSource::GrabInto(Core::Frame &frame)
     {
         std::lock_guard<std::mutex> lock(mutex);
 
         if (!isOpen || currentIndex >= totalFrames)
         {
-            return std::nullopt;
+            return false;
         }
 
-        cv::Mat image;
-        if (!capture.read(image) || image.empty())
+        // While cropping, the full frame only lives in the reused decode buffer
+        cv::Mat &decoded = cropHint ? decodeBuffer : frame.image;
+        if (!capture.read(decoded) || decoded.empty())
         {
             LOG_WARN("VideoFrameSource: Failed to read frame {}", currentIndex);
             ++currentIndex;
-            return std::nullopt;
+            return false;
         }
 
-        if (image.channels() != 3 && image.channels() != 4)
+        if (decoded.channels() != 3 && decoded.channels() != 4)
         {
             LOG_WARN(
-                "VideoFrameSource: Unexpected frame format at index {}: channels={}", currentIndex, image.channels());
+                "VideoFrameSource: Unexpected frame format at index {}: channels={}", currentIndex, decoded.channels());
             ++currentIndex;
-            return std::nullopt;
+            return false;
         }
 
-        Core::Frame frame;
-        frame.image = image;
+        frame.metadata = {};
         frame.metadata.sequenceNumber = currentIndex;
         frame.metadata.captureTime = std::chrono::steady_clock::now();
-        frame.metadata.sourceWidth = image.cols;
-        frame.metadata.sourceHeight = image.rows;
+        frame.metadata.sourceWidth = decoded.cols;
+        frame.metadata.sourceHeight = decoded.rows;
         frame.metadata.fpsEstimate = playbackFps;
+        if (const auto region = CropRegion(cropHint, decoded.size()))
+        {
+            decoded(*region).copyTo(frame.image);
+            frame.metadata.cropOrigin = region->tl();
+        }
+        else if (cropHint)
+        {
+            decoded.copyTo(frame.image); // the decode buffer is reused by the next grab
+        }
 
         ++currentIndex;
-        return frame;
+        return true;
     }
 
     bool VideoFrameSource::IsOpen() const
@@ -96,6 +116,16 @@ namespace SH3DS::Capture
         return "VideoFrameSource(" + videoPath.string() + ", " + std::to_string(totalFrames) + " frames)";
     }
 
+    void VideoFrameSource::SetCropHint(std::optional<cv::Rect> region)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cropHint = region;
+        if (!cropHint)
+        {
+            decodeBuffer.release();
+        }
+    }
+
     bool VideoFrameSource::Seek(size_t frameIndex)
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -28,9 +28,22 @@ namespace SH3DS::Capture
         bool Open() override;
         void Close() override;
         std::optional<Core::Frame> Grab() override;
+
+        /**
+         * @brief Decodes the next frame straight into @p frame's image buffer.
+         */
+        bool GrabInto(Core::Frame &frame) override;
         bool IsOpen() const override;
         std::string Describe() const override;
 
+        /**
+         * @brief Crops each frame on grab.
+         *
+         * With a hint set, frames are decoded into one reused buffer and only the region is copied into the returned
+         * frame, so no full-size image is allocated or handed downstream per frame.
+         */
+        void SetCropHint(std::optional<cv::Rect> region) override;
+
         bool Seek(size_t frameIndex) override;
         size_t GetFrameCount() const override;
 
@@ -44,13 +57,15 @@ namespace SH3DS::Capture
             double playbackFps);
 
     private:
-        std::filesystem::path videoPath; ///< Path to the video file
-        double playbackFps;              ///< Playback FPS override
-        cv::VideoCapture capture;        ///< OpenCV video capture
-        size_t currentIndex = 0;         ///< Current frame index
-        size_t totalFrames = 0;          ///< Total number of frames
-        double nativeFps = 0.0;          ///< Video's native FPS
-        bool isOpen = false;             ///< Whether the video is open
-        mutable std::mutex mutex;        ///< Guards cv::VideoCapture and currentIndex
+        std::filesystem::path videoPath;  ///< Path to the video file
+        double playbackFps;               ///< Playback FPS override
+        cv::VideoCapture capture;         ///< OpenCV video capture
+        size_t currentIndex = 0;          ///< Current frame index
+        size_t totalFrames = 0;           ///< Total number of frames
+        double nativeFps = 0.0;           ///< Video's native FPS
+        bool isOpen = false;              ///< Whether the video is open
+        std::optional<cv::Rect> cropHint; ///< Region to keep of each frame
+        cv::Mat decodeBuffer;             ///< Reused full-size decode target while cropping
+        mutable std::mutex mutex;         ///< Guards cv::VideoCapture and currentIndex
     };
 } // namespace SH3DS::Capture
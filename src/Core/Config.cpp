@@ -1,6 +1,6 @@
 #include "Config.h"
 
-#include "Kappa/Logger.h"
+#include "Core/Logger.h"
 
 #include <yaml-cpp/yaml.h>
 
@@ -283,6 +283,8 @@ namespace SH3DS::Core
             config.screenCalibration.targetWidth = calib["target_width"].as<int>(config.screenCalibration.targetWidth);
             config.screenCalibration.targetHeight =
                 calib["target_height"].as<int>(config.screenCalibration.targetHeight);
+            config.screenCalibration.cachePath =
+                calib["cache_file"].as<std::string>(config.screenCalibration.cachePath);
         }
 
         if (auto bottomCalib = root["bottom_screen_calibration"])
@@ -305,6 +307,14 @@ namespace SH3DS::Core
             config.orchestrator.logFile = orch["log_file"].as<std::string>(config.orchestrator.logFile);
             config.orchestrator.logRotationMb = orch["log_rotation_mb"].as<int>(config.orchestrator.logRotationMb);
             config.orchestrator.logMaxFiles = orch["log_max_files"].as<int>(config.orchestrator.logMaxFiles);
+            config.orchestrator.asyncLog = orch["async_log"].as<bool>(config.orchestrator.asyncLog);
+            config.orchestrator.frameDeltaThreshold =
+                orch["frame_delta_threshold"].as<double>(config.orchestrator.frameDeltaThreshold);
+            config.orchestrator.sharedMemoryName =
+                orch["shared_memory_name"].as<std::string>(config.orchestrator.sharedMemoryName);
+            config.orchestrator.sharedMemorySlots =
+                orch["shared_memory_slots"].as<int>(config.orchestrator.sharedMemorySlots);
+            config.orchestrator.cropMargin = orch["crop_margin"].as<int>(config.orchestrator.cropMargin);
         }
 
         return config;
@@ -502,6 +512,7 @@ namespace SH3DS::Core
         // Identity
         config.huntId = root["hunt_id"].as<std::string>("");
         config.huntName = root["hunt_name"].as<std::string>("");
+        config.huntProfile = root["hunt_profile"].as<std::string>("");
         config.targetPokemon = root["target_pokemon"].as<std::string>("");
         config.screenMode = ParseScreenMode(root["screen_mode"], "Config");
 
@@ -573,6 +584,8 @@ namespace SH3DS::Core
             config.shinyDetector.brightnessThreshold = det["brightness_threshold"].as<int>(240);
             config.shinyDetector.minBrightPixelRatio = det["min_bright_pixel_ratio"].as<double>(0.005);
             config.shinyDetector.minConsecutiveFrames = det["min_consecutive_frames"].as<int>(3);
+            config.shinyDetector.modelPath = det["model_path"].as<std::string>("");
+            config.shinyDetector.modelConfidence = det["model_confidence"].as<double>(0.8);
         }
 
         // Fusion
@@ -695,6 +708,10 @@ namespace SH3DS::Core
                     method.minBrightPixelRatio = methodNode["min_bright_pixel_ratio"].as<double>(0.005);
                     method.minConsecutiveFrames = methodNode["min_consecutive_frames"].as<int>(3);
 
+                    // cnn params
+                    method.modelPath = methodNode["model_path"].as<std::string>("");
+                    method.modelConfidence = methodNode["model_confidence"].as<double>(0.8);
+
                     profile.methods.push_back(method);
                 }
             }
@@ -50,6 +50,7 @@ namespace SH3DS::Core
                                                  ///< runtime by ScreenDetector auto-calibration.
         int targetWidth = kTopScreenWidth;       ///< Target width for warped image
         int targetHeight = kTopScreenHeight;     ///< Target height for warped image
+        std::string cachePath;                   ///< Where detected corners persist across restarts; empty = off
     };
 
     /**
@@ -66,7 +67,15 @@ namespace SH3DS::Core
         std::string logFile;                     ///< Path to log file
         int logRotationMb = 50;                  ///< Log rotation size in megabytes
         int logMaxFiles = 5;                     ///< Maximum number of log files
+        bool asyncLog = false;                   ///< Format and write per-frame (HOT_LOG_*) logs on a background thread
         std::string shinyRoi = "pokemon_sprite"; ///< ROI name used for shiny detection (from hunt config)
+        std::string shinyCheckState;             ///< Gates shiny detection; empty = every frame (from hunt config)
+        int shinyCheckDelayMs = 1500;            ///< Time in shinyCheckState before the burst (from hunt config)
+        int shinyCheckFrames = 15;               ///< ROIs per burst passed to DetectSequence (from hunt config)
+        double frameDeltaThreshold = 4.0;        ///< Max thumbnail cell change (0-255) of an unchanged frame; 0 = off
+        std::string sharedMemoryName;            ///< POSIX shared-memory ring for viewers (e.g. "/sh3ds"); empty = off
+        int sharedMemorySlots = 4;               ///< Slots in the shared-memory ring
+        int cropMargin = 16;                     ///< Pixels kept around the calibrated screens by the source; -1 = off
     };
 
     /**
@@ -191,6 +200,8 @@ namespace SH3DS::Core
         int brightnessThreshold = 240;             ///< Brightness threshold
         double minBrightPixelRatio = 0.005;        ///< Minimum pixel ratio for brightness detection
         int minConsecutiveFrames = 3;              ///< Minimum number of consecutive frames for detection
+        std::string modelPath;                     ///< Quantised CNN model file (cnn method)
+        double modelConfidence = 0.8;              ///< Minimum class probability for a CNN verdict
     };
 
     /**
@@ -289,6 +300,7 @@ namespace SH3DS::Core
         // Identity
         std::string huntId;                         ///< Unique identifier for this hunt config
         std::string huntName;                       ///< Human-readable name
+        std::string huntProfile;                    ///< FSM built by HuntProfiles::Create (e.g. "xy_starter_sr")
         std::string targetPokemon;                  ///< Target Pokémon
         ScreenMode screenMode = ScreenMode::Single; ///< Single vs dual-screen detection mode
 
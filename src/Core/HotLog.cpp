@@ -0,0 +1,326 @@
+#include "HotLog.h"
+
+#include "Core/Logger.h"
+
+namespace SH3DS::Core
+{
+    namespace
+    {
+        constexpr std::size_t kCacheLineSize = 64; ///< Keeps the ring indices apart
+
+        std::atomic<uint64_t> nextLoggerId{ 1 }; ///< Source of HotLogger::id
+
+        /**
+         * @brief A logger's ring for the current thread.
+         */
+        struct ThreadRingEntry
+        {
+            uint64_t loggerId = 0;      ///< Owning logger
+            HotLogRing *ring = nullptr; ///< The ring
+        };
+
+        /// Rings this thread produces into, one per logger it has used in asynchronous mode.
+        thread_local std::vector<ThreadRingEntry> threadRings;
+
+        /**
+         * @brief Forwards a message to Core::Logger at the same level.
+         * @param level Message level.
+         * @param message Formatted message.
+         */
+        void WriteToLogger(HotLogLevel level, std::string_view message)
+        {
+            switch (level)
+            {
+            case HotLogLevel::Trace:
+                LOG_TRACE("{}", message);
+                break;
+            case HotLogLevel::Debug:
+                LOG_DEBUG("{}", message);
+                break;
+            case HotLogLevel::Info:
+                LOG_INFO("{}", message);
+                break;
+            case HotLogLevel::Warn:
+                LOG_WARN("{}", message);
+                break;
+            case HotLogLevel::Error:
+                LOG_ERROR("{}", message);
+                break;
+            case HotLogLevel::Critical:
+                LOG_CRITICAL("{}", message);
+                break;
+            case HotLogLevel::Off:
+                break;
+            }
+        }
+    } // namespace
+
+    /**
+     * @brief Lock-free single-producer, single-consumer queue of records.
+     *
+     * The producing thread owns head and the consumer (whoever holds HotLogger::drainMutex) owns tail; each side only
+     * reads the other's index, with acquire/release ordering publishing the slot contents. Publishing an index and
+     * then reading the other one is sequentially consistent on both sides, so a push and the consumer's last look at
+     * the ring cannot both miss each other: either the consumer sees the record, or TryPush() reports the ring as
+     * drained and the producer wakes the writer.
+     */
+    class HotLogRing
+    {
+    public:
+        /**
+         * @brief Constructs an empty ring.
+         * @param capacity Records the ring holds.
+         */
+        explicit HotLogRing(std::size_t capacity) : slots(capacity)
+        {
+        }
+
+        /**
+         * @brief Appends a record (producer thread only).
+         * @param record The record.
+         * @param drained Set to true if the consumer had emptied the ring before this record (it may be idle).
+         * @return False if the ring is full.
+         */
+        bool TryPush(const HotLogRecord &record, bool &drained)
+        {
+            const uint64_t writeIndex = head.load(std::memory_order_relaxed);
+            if (writeIndex - tail.load(std::memory_order_acquire) >= slots.size())
+            {
+                return false;
+            }
+            slots[writeIndex % slots.size()] = record;
+            head.store(writeIndex + 1, std::memory_order_seq_cst);
+            drained = tail.load(std::memory_order_seq_cst) >= writeIndex;
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest record (consumer only).
+         * @param record Receives the record.
+         * @return False if the ring is empty.
+         */
+        bool TryPop(HotLogRecord &record)
+        {
+            const uint64_t readIndex = tail.load(std::memory_order_relaxed);
+            if (readIndex == head.load(std::memory_order_seq_cst))
+            {
+                return false;
+            }
+            record = slots[readIndex % slots.size()];
+            tail.store(readIndex + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+    private:
+        alignas(kCacheLineSize) std::atomic<uint64_t> head{ 0 }; ///< Next slot the producer writes
+        alignas(kCacheLineSize) std::atomic<uint64_t> tail{ 0 }; ///< Next slot the consumer reads
+        std::vector<HotLogRecord> slots;                         ///< Record storage
+    };
+
+    HotLogLevel ParseHotLogLevel(std::string_view name)
+    {
+        if (name == "trace")
+        {
+            return HotLogLevel::Trace;
+        }
+        if (name == "debug")
+        {
+            return HotLogLevel::Debug;
+        }
+        if (name == "info")
+        {
+            return HotLogLevel::Info;
+        }
+        if (name == "warn" || name == "warning")
+        {
+            return HotLogLevel::Warn;
+        }
+        if (name == "error" || name == "err")
+        {
+            return HotLogLevel::Error;
+        }
+        if (name == "critical")
+        {
+            return HotLogLevel::Critical;
+        }
+        return HotLogLevel::Off;
+    }
+
+    HotLogger::HotLogger(Sink sink, std::size_t ringCapacity)
+        : sink(sink ? std::move(sink) : Sink(WriteToLogger)),
+          ringCapacity(std::max<std::size_t>(ringCapacity, 1)),
+          id(nextLoggerId.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    HotLogger::~HotLogger()
+    {
+        Stop();
+    }
+
+    HotLogger &HotLogger::Get()
+    {
+        static HotLogger logger;
+        return logger;
+    }
+
+    void HotLogger::SetLevel(HotLogLevel level)
+    {
+        minLevel.store(level, std::memory_order_relaxed);
+    }
+
+    HotLogLevel HotLogger::Level() const
+    {
+        return minLevel.load(std::memory_order_relaxed);
+    }
+
+    void HotLogger::StartAsync()
+    {
+        std::lock_guard lock(writerMutex);
+        if (writer.joinable())
+        {
+            return;
+        }
+        stopping = false;
+        workPending = false;
+        async.store(true, std::memory_order_release);
+        writer = std::thread([this] { WriterLoop(); });
+    }
+
+    void HotLogger::Stop()
+    {
+        bool running = false;
+        {
+            std::lock_guard lock(writerMutex);
+            running = writer.joinable();
+            stopping = true;
+            async.store(false, std::memory_order_release);
+        }
+        if (running)
+        {
+            wake.notify_all();
+            writer.join();
+        }
+        Drain();
+    }
+
+    bool HotLogger::IsAsync() const
+    {
+        return async.load(std::memory_order_acquire);
+    }
+
+    std::size_t HotLogger::Drain()
+    {
+        std::lock_guard drainLock(drainMutex);
+
+        // Rings only ever get added, so once the snapshot has grown to the thread count it stops allocating
+        drainSnapshot.clear();
+        {
+            std::lock_guard ringsLock(ringsMutex);
+            for (const auto &ring : rings)
+            {
+                drainSnapshot.push_back(ring.get());
+            }
+        }
+
+        std::size_t written = 0;
+        HotLogRecord record;
+        for (HotLogRing *ring : drainSnapshot)
+        {
+            while (ring->TryPop(record))
+            {
+                Write(record, drainBuffer);
+                ++written;
+            }
+        }
+
+        const uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops)
+        {
+            drainBuffer = fmt::format("HotLog: {} records dropped (ring full)", drops - reportedDrops);
+            sink(HotLogLevel::Warn, drainBuffer);
+            reportedDrops = drops;
+        }
+        return written;
+    }
+
+    uint64_t HotLogger::DroppedRecords() const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    void HotLogger::Submit(const HotLogRecord &record)
+    {
+        if (!async.load(std::memory_order_acquire))
+        {
+            thread_local std::string buffer;
+            Write(record, buffer);
+            return;
+        }
+
+        bool drained = false;
+        if (!ThreadRing().TryPush(record, drained))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Only the first record after the writer emptied the ring needs a wake-up; the rest of the burst rides on it
+        if (drained)
+        {
+            {
+                std::lock_guard lock(writerMutex);
+                workPending = true;
+            }
+            wake.notify_one();
+        }
+    }
+
+    HotLogRing &HotLogger::ThreadRing()
+    {
+        for (const auto &entry : threadRings)
+        {
+            if (entry.loggerId == id)
+            {
+                return *entry.ring;
+            }
+        }
+
+        std::lock_guard lock(ringsMutex);
+        rings.push_back(std::make_unique<HotLogRing>(ringCapacity));
+        threadRings.push_back({ .loggerId = id, .ring = rings.back().get() });
+        return *rings.back();
+    }
+
+    void HotLogger::Write(const HotLogRecord &record, std::string &buffer)
+    {
+        buffer.clear();
+        try
+        {
+            record.formatter(record, buffer);
+        }
+        catch (const fmt::format_error &e)
+        {
+            buffer = fmt::format("HotLog: bad format \"{}\": {}", record.format, e.what());
+        }
+        sink(record.level, buffer);
+    }
+
+    void HotLogger::WriterLoop()
+    {
+        std::unique_lock lock(writerMutex);
+        while (true)
+        {
+            // Sleeps until a producer refills a drained ring; Stop() writes whatever is left after the join
+            wake.wait(lock, [this] { return stopping || workPending; });
+            if (stopping)
+            {
+                return;
+            }
+            workPending = false;
+            lock.unlock();
+            Drain();
+            lock.lock();
+        }
+    }
+} // namespace SH3DS::Core
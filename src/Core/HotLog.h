@@ -0,0 +1,378 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Lowest hot-path log level compiled in, as a HotLogLevel value (0 = trace ... 6 = off).
+ *
+ * Set by the SH3DS_HOT_LOG_LEVEL CMake option. Statements below it are discarded at compile time and their arguments
+ * are never evaluated.
+ */
+#ifndef SH3DS_HOT_LOG_ACTIVE_LEVEL
+#define SH3DS_HOT_LOG_ACTIVE_LEVEL 0
+#endif
+
+/**
+ * @brief Logs through HotLogger::Get() if @p level is compiled in and enabled at runtime.
+ *
+ * The format must be a string literal; arguments are only evaluated when the statement is enabled.
+ */
+#define SH3DS_HOT_LOG(level, format, ...)                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if constexpr (::SH3DS::Core::HotLogDetail::IsCompiledIn(level, SH3DS_HOT_LOG_ACTIVE_LEVEL))                    \
+        {                                                                                                              \
+            if (auto &hotLogger = ::SH3DS::Core::HotLogger::Get(); hotLogger.ShouldLog(level))                         \
+            {                                                                                                          \
+                hotLogger.Log(level, "" format __VA_OPT__(, ) __VA_ARGS__);                                            \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+#define HOT_LOG_TRACE(...) SH3DS_HOT_LOG(::SH3DS::Core::HotLogLevel::Trace, __VA_ARGS__)
+#define HOT_LOG_DEBUG(...) SH3DS_HOT_LOG(::SH3DS::Core::HotLogLevel::Debug, __VA_ARGS__)
+#define HOT_LOG_INFO(...) SH3DS_HOT_LOG(::SH3DS::Core::HotLogLevel::Info, __VA_ARGS__)
+
+namespace SH3DS::Core
+{
+    /**
+     * @brief Hot-path log severity, ordered like spdlog's levels.
+     */
+    enum class HotLogLevel : uint8_t
+    {
+        Trace,
+        Debug,
+        Info,
+        Warn,
+        Error,
+        Critical,
+        Off,
+    };
+
+    /**
+     * @brief Parses a level name as used by orchestrator.log_level ("trace" ... "critical", "off").
+     * @param name Level name.
+     * @return The level, or Off if the name is unknown (as spdlog::level::from_str does).
+     */
+    HotLogLevel ParseHotLogLevel(std::string_view name);
+
+    /**
+     * @brief One captured log statement: a static format string plus its arguments, not yet formatted.
+     */
+    struct HotLogRecord
+    {
+        static constexpr std::size_t kMaxArgs = 8;        ///< Arguments one statement may capture
+        static constexpr std::size_t kTextCapacity = 160; ///< Bytes of string arguments kept; the rest is cut
+
+        /** @brief Formats a record; instantiated per argument type list so the record itself stays untyped. */
+        using Formatter = void (*)(const HotLogRecord &record, std::string &out);
+
+        const char *format = nullptr;           ///< Format string literal
+        Formatter formatter = nullptr;          ///< Decodes args and formats them into a string
+        HotLogLevel level = HotLogLevel::Info;  ///< Severity
+        uint16_t textSize = 0;                  ///< Bytes of text in use
+        std::array<uint64_t, kMaxArgs> args{};  ///< Raw argument bits (strings: offset << 16 | size in text)
+        std::array<char, kTextCapacity> text{}; ///< String argument bytes
+    };
+
+    namespace HotLogDetail
+    {
+        /**
+         * @brief Whether a statement survives compile-time stripping.
+         * @param level Statement level.
+         * @param activeLevel SH3DS_HOT_LOG_ACTIVE_LEVEL at the call site.
+         * @return True if @p level is at or above @p activeLevel.
+         */
+        constexpr bool IsCompiledIn(HotLogLevel level, int activeLevel)
+        {
+            return static_cast<int>(level) >= activeLevel;
+        }
+
+        template<typename T>
+        concept TextArg = std::is_convertible_v<const T &, std::string_view>;
+
+        template<typename T>
+        concept NumberArg = std::is_arithmetic_v<T> && !std::is_same_v<T, char>;
+
+        /** @brief Type an argument is stored and formatted as: strings of any kind become std::string_view. */
+        template<typename T>
+        using StoredArg = std::conditional_t<TextArg<T>, std::string_view, std::decay_t<T>>;
+
+        /**
+         * @brief Stores one argument in the record.
+         * @param record Record being filled.
+         * @param value Argument value.
+         * @return The raw bits kept in HotLogRecord::args.
+         */
+        template<typename T>
+        uint64_t Encode(HotLogRecord &record, const T &value)
+        {
+            if constexpr (TextArg<T>)
+            {
+                const std::string_view view(value);
+                const std::size_t offset = record.textSize;
+                const std::size_t size = std::min(view.size(), HotLogRecord::kTextCapacity - offset);
+                std::memcpy(record.text.data() + offset, view.data(), size);
+                record.textSize = static_cast<uint16_t>(offset + size);
+                const uint64_t packedOffset = offset;
+                const uint64_t packedSize = size;
+                return (packedOffset << 16) | packedSize;
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                return value ? 1u : 0u;
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                return std::bit_cast<uint64_t>(static_cast<double>(value));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                static_assert(sizeof(T) == sizeof(uint64_t), "long double HotLog arguments are not supported");
+                return std::bit_cast<uint64_t>(value);
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                static_assert(NumberArg<T>, "HotLog arguments must be numbers, bools or strings");
+                const int64_t wide = value;
+                return std::bit_cast<uint64_t>(wide);
+            }
+            else
+            {
+                static_assert(NumberArg<T>, "HotLog arguments must be numbers, bools or strings");
+                const uint64_t wide = value;
+                return wide;
+            }
+        }
+
+        /**
+         * @brief Restores one argument from the record, as the widest type of its kind.
+         * @param record Filled record.
+         * @param bits Raw bits returned by Encode().
+         * @return The argument (strings as a view into the record).
+         */
+        template<typename T>
+        auto Decode(const HotLogRecord &record, uint64_t bits)
+        {
+            if constexpr (TextArg<T>)
+            {
+                const std::size_t offset = bits >> 16;
+                const std::size_t size = bits & 0xFFFF;
+                return std::string_view(record.text.data() + offset, size);
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                return bits != 0;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return std::bit_cast<double>(bits);
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                return std::bit_cast<int64_t>(bits);
+            }
+            else
+            {
+                return bits;
+            }
+        }
+
+        /** @brief Expands the stored arguments into fmt::format_to. */
+        template<typename... Args, std::size_t... Indices>
+        void FormatRecordImpl(const HotLogRecord &record, std::string &out, std::index_sequence<Indices...>)
+        {
+            fmt::format_to(std::back_inserter(out),
+                fmt::runtime(record.format),
+                Decode<Args>(record, record.args[Indices])...);
+        }
+
+        /**
+         * @brief HotLogRecord::Formatter for a statement with argument types @p Args.
+         * @param record Filled record.
+         * @param out String the message is appended to.
+         */
+        template<typename... Args>
+        void FormatRecord(const HotLogRecord &record, std::string &out)
+        {
+            FormatRecordImpl<Args...>(record, out, std::index_sequence_for<Args...>{});
+        }
+    } // namespace HotLogDetail
+
+    class HotLogRing;
+
+    /**
+     * @brief Low-overhead logger for statements issued every frame.
+     *
+     * A statement captures its format string literal and raw arguments into a fixed-size HotLogRecord. In the
+     * default synchronous mode the record is formatted and written on the calling thread, like a plain LOG_DEBUG.
+     * After StartAsync() each producing thread instead pushes records into its own lock-free single-producer ring,
+     * and a writer thread formats them and hands the text to the sink, so the pipeline thread pays for neither fmt
+     * nor sink I/O. The writer sleeps until a record lands in a ring it has emptied, so an idle logger costs no
+     * wake-ups. A full ring drops the record rather than block; drops are counted and reported by the writer.
+     *
+     * Rings are created on a thread's first asynchronous statement and live as long as the logger.
+     */
+    class HotLogger
+    {
+    public:
+        /** @brief Receives each formatted message. */
+        using Sink = std::function<void(HotLogLevel level, std::string_view message)>;
+
+        static constexpr std::size_t kDefaultRingCapacity = 1024; ///< Records buffered per producing thread
+
+        /**
+         * @brief Constructs a logger.
+         * @param sink Receives formatted messages; empty = forward to Core::Logger at the same level.
+         * @param ringCapacity Records buffered per producing thread in asynchronous mode.
+         */
+        explicit HotLogger(Sink sink = {}, std::size_t ringCapacity = kDefaultRingCapacity);
+
+        /** @brief Stops the writer thread, writing everything still queued. */
+        ~HotLogger();
+
+        HotLogger(const HotLogger &) = delete;
+        HotLogger &operator=(const HotLogger &) = delete;
+
+        /**
+         * @brief Returns the process-wide logger used by the HOT_LOG_* macros.
+         * @return The logger.
+         */
+        static HotLogger &Get();
+
+        /**
+         * @brief Sets the runtime level; statements below it return before capturing anything.
+         * @param level Minimum level logged.
+         */
+        void SetLevel(HotLogLevel level);
+
+        /**
+         * @brief Returns the runtime level.
+         * @return Minimum level logged.
+         */
+        HotLogLevel Level() const;
+
+        /**
+         * @brief Checks whether a statement at @p level would be logged.
+         * @param level Statement level.
+         * @return True if @p level is at or above the runtime level.
+         */
+        bool ShouldLog(HotLogLevel level) const
+        {
+            return level >= minLevel.load(std::memory_order_relaxed) && level != HotLogLevel::Off;
+        }
+
+        /**
+         * @brief Captures one statement; callers normally go through the HOT_LOG_* macros.
+         * @param level Statement level.
+         * @param format Format string literal (must outlive the logger).
+         * @param args Numbers, bools or strings; strings are copied into the record.
+         */
+        template<typename... Args>
+        void Log(HotLogLevel level, const char *format, const Args &...args)
+        {
+            static_assert(sizeof...(Args) <= HotLogRecord::kMaxArgs, "too many HotLog arguments");
+            HotLogRecord record;
+            record.format = format;
+            record.formatter = &HotLogDetail::FormatRecord<HotLogDetail::StoredArg<Args>...>;
+            record.level = level;
+            [[maybe_unused]] std::size_t index = 0;
+            ((record.args[index++] = HotLogDetail::Encode<HotLogDetail::StoredArg<Args>>(record, args)), ...);
+            Submit(record);
+        }
+
+        /**
+         * @brief Switches to asynchronous mode and starts the writer thread (no-op if already running).
+         */
+        void StartAsync();
+
+        /**
+         * @brief Stops the writer thread, writes everything queued and returns to synchronous mode.
+         *
+         * A statement racing with Stop() on another thread may still land in its ring; the next Drain() writes it.
+         */
+        void Stop();
+
+        /**
+         * @brief Whether statements are queued for the writer thread.
+         * @return True between StartAsync() and Stop().
+         */
+        bool IsAsync() const;
+
+        /**
+         * @brief Formats and writes every queued record on the calling thread.
+         * @return Number of records written.
+         */
+        std::size_t Drain();
+
+        /**
+         * @brief Returns how many records were dropped because a ring was full.
+         * @return Dropped record count since construction.
+         */
+        uint64_t DroppedRecords() const;
+
+    private:
+        /**
+         * @brief Queues a captured record, or writes it right away in synchronous mode.
+         * @param record The record.
+         */
+        void Submit(const HotLogRecord &record);
+
+        /**
+         * @brief Returns the calling thread's ring, creating it on first use.
+         * @return The ring.
+         */
+        HotLogRing &ThreadRing();
+
+        /**
+         * @brief Formats a record and passes it to the sink.
+         * @param record The record.
+         * @param buffer Reused formatting buffer.
+         */
+        void Write(const HotLogRecord &record, std::string &buffer);
+
+        /**
+         * @brief Writer thread body: drains the rings whenever a producer signals new work, until Stop().
+         */
+        void WriterLoop();
+
+        Sink sink;                                              ///< Message destination
+        std::size_t ringCapacity;                               ///< Records per ring
+        uint64_t id;                                            ///< Key of this logger in the thread-local ring cache
+        std::atomic<HotLogLevel> minLevel{ HotLogLevel::Info }; ///< Runtime level
+        std::atomic<bool> async{ false };                       ///< Records are queued instead of written
+        std::atomic<uint64_t> dropped{ 0 };                     ///< Records lost to a full ring
+        uint64_t reportedDrops = 0;                             ///< Drops already reported (guarded by drainMutex)
+        std::string drainBuffer;                                ///< Formatting buffer (guarded by drainMutex)
+        std::vector<HotLogRing *> drainSnapshot;                ///< Rings being drained (guarded by drainMutex)
+
+        std::mutex ringsMutex;                          ///< Guards rings
+        std::vector<std::unique_ptr<HotLogRing>> rings; ///< One ring per producing thread
+        std::mutex drainMutex;                          ///< Serialises consumers of the rings and the sink
+
+        std::mutex writerMutex;       ///< Guards stopping and workPending
+        std::condition_variable wake; ///< Signals new records and shutdown to the writer
+        bool stopping = false;        ///< Set by Stop()
+        bool workPending = false;     ///< A producer pushed into a drained ring since the writer last woke
+        std::thread writer;           ///< Writer thread (asynchronous mode only)
+    };
+} // namespace SH3DS::Core
@@ -0,0 +1,40 @@
+#include "Logger.h"
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+namespace SH3DS::Core
+{
+    namespace
+    {
+        constexpr const char *kPattern = "[%H:%M:%S.%e] [%n] [%^%l%$] %v"; ///< Time, logger name, level, message
+    } // namespace
+
+    Logger::Logger()
+        : logger(std::make_shared<spdlog::logger>("SH3DS", std::make_shared<spdlog::sinks::stdout_color_sink_mt>()))
+    {
+        logger->set_pattern(kPattern);
+        logger->set_level(spdlog::level::info);
+    }
+
+    Logger &Logger::Get()
+    {
+        static Logger instance;
+        return instance;
+    }
+
+    void Logger::SetLoggerName(const std::string &name)
+    {
+        auto &instance = Get();
+        instance.logger = instance.logger->clone(name);
+    }
+
+    void Logger::SetLevel(spdlog::level::level_enum level)
+    {
+        logger->set_level(level);
+    }
+
+    spdlog::logger &Logger::GetLogger()
+    {
+        return *logger;
+    }
+} // namespace SH3DS::Core
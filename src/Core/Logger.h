@@ -0,0 +1,53 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+#include <string>
+
+namespace SH3DS::Core
+{
+    /**
+     * @brief Process-wide console logger behind the LOG_* macros.
+     *
+     * A thin spdlog wrapper, so the pipeline libraries and sh3ds_headless log without linking the Kappa GUI
+     * framework. The debug GUI logs through it too and uses Kappa only for its Application and Layer classes.
+     */
+    class Logger
+    {
+    public:
+        /**
+         * @brief Returns the process-wide logger.
+         */
+        static Logger &Get();
+
+        /**
+         * @brief Renames the logger; call once at startup, before other threads log.
+         * @param name Name shown in every line.
+         */
+        static void SetLoggerName(const std::string &name);
+
+        /**
+         * @brief Sets the lowest level that is written.
+         * @param level spdlog level.
+         */
+        void SetLevel(spdlog::level::level_enum level);
+
+        /**
+         * @brief Returns the underlying spdlog logger.
+         */
+        spdlog::logger &GetLogger();
+
+    private:
+        Logger();
+
+        std::shared_ptr<spdlog::logger> logger; ///< Colour console logger
+    };
+} // namespace SH3DS::Core
+
+#define LOG_TRACE(...) ::SH3DS::Core::Logger::Get().GetLogger().trace(__VA_ARGS__)
+#define LOG_DEBUG(...) ::SH3DS::Core::Logger::Get().GetLogger().debug(__VA_ARGS__)
+#define LOG_INFO(...) ::SH3DS::Core::Logger::Get().GetLogger().info(__VA_ARGS__)
+#define LOG_WARN(...) ::SH3DS::Core::Logger::Get().GetLogger().warn(__VA_ARGS__)
+#define LOG_ERROR(...) ::SH3DS::Core::Logger::Get().GetLogger().error(__VA_ARGS__)
+#define LOG_CRITICAL(...) ::SH3DS::Core::Logger::Get().GetLogger().critical(__VA_ARGS__)
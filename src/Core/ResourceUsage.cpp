@@ -0,0 +1,39 @@
+#include "ResourceUsage.h"
+
+#include "Logger.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace SH3DS::Core
+{
+    std::optional<long> PeakRssKiB()
+    {
+#if defined(__APPLE__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024; // bytes on macOS
+#elif defined(__unix__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss; // KiB on Linux
+#else
+        return std::nullopt;
+#endif
+    }
+
+    void LogResourceUsage(const char *phase, std::chrono::steady_clock::time_point processStart)
+    {
+        const auto elapsedMs =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - processStart);
+        if (auto rss = PeakRssKiB())
+        {
+            LOG_INFO("{}: {} ms since start, peak RSS {} KiB", phase, elapsedMs.count(), *rss);
+        }
+        else
+        {
+            LOG_INFO("{}: {} ms since start", phase, elapsedMs.count());
+        }
+    }
+} // namespace SH3DS::Core
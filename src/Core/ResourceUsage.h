@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace SH3DS::Core
+{
+    /**
+     * @brief Returns the peak resident set size of this process in KiB, where the platform reports it.
+     */
+    std::optional<long> PeakRssKiB();
+
+    /**
+     * @brief Logs the time since @p processStart and the peak RSS, so startup cost compares across builds.
+     * @param phase Label for the line, e.g. "Startup complete".
+     * @param processStart Time taken at the top of main().
+     */
+    void LogResourceUsage(const char *phase, std::chrono::steady_clock::time_point processStart);
+} // namespace SH3DS::Core
@@ -0,0 +1,41 @@
+#include "StateRegistry.h"
+
+#include <stdexcept>
+
+namespace SH3DS::Core
+{
+    StateId StateRegistry::Intern(std::string_view name)
+    {
+        if (auto it = ids.find(name); it != ids.end())
+        {
+            return it->second;
+        }
+
+        if (names.size() >= kInvalidStateId)
+        {
+            throw std::runtime_error("StateRegistry: too many states (cannot intern '" + std::string(name) + "')");
+        }
+
+        const auto id = static_cast<StateId>(names.size());
+        names.emplace_back(name);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    StateId StateRegistry::Find(std::string_view name) const
+    {
+        auto it = ids.find(name);
+        return it != ids.end() ? it->second : kInvalidStateId;
+    }
+
+    const std::string &StateRegistry::Name(StateId id) const
+    {
+        static const std::string invalidName = "<invalid>";
+        return id < names.size() ? names[id] : invalidName;
+    }
+
+    std::size_t StateRegistry::Size() const
+    {
+        return names.size();
+    }
+} // namespace SH3DS::Core
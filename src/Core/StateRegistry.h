@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Core/Types.h"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SH3DS::Core
+{
+    /**
+     * @brief Interns game state names into dense StateId values.
+     *
+     * IDs are assigned in insertion order starting at 0, so they can index per-state tables directly.
+     * Names are only needed at load time (config, profiles) and for logging/GUI output.
+     */
+    class StateRegistry
+    {
+    public:
+        /**
+         * @brief Returns the ID for a name, assigning the next free ID if the name is new.
+         * @param name The state name.
+         * @return The interned state ID.
+         * @throws std::runtime_error if the registry is full.
+         */
+        StateId Intern(std::string_view name);
+
+        /**
+         * @brief Looks up a name without interning it.
+         * @param name The state name.
+         * @return The state ID, or kInvalidStateId if the name is unknown.
+         */
+        StateId Find(std::string_view name) const;
+
+        /**
+         * @brief Resolves an ID back to its name.
+         * @param id The state ID.
+         * @return The state name, or "<invalid>" for unknown IDs.
+         */
+        const std::string &Name(StateId id) const;
+
+        /**
+         * @brief Returns the number of interned states.
+         * @return The number of interned states (also one past the largest valid ID).
+         */
+        std::size_t Size() const;
+
+    private:
+        std::vector<std::string> names;                  ///< Names indexed by StateId
+        std::map<std::string, StateId, std::less<>> ids; ///< Name -> StateId lookup
+    };
+} // namespace SH3DS::Core
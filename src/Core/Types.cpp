@@ -0,0 +1,58 @@
+#include "Types.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    /**
+     * @brief Appends a diagnostic value: whole numbers without decimals, everything else to three places.
+     * @param out String to append to.
+     * @param value Value to format.
+     */
+    void AppendValue(std::string &out, double value)
+    {
+        char buffer[32];
+        const bool whole = std::abs(value) < 1e15 && value == std::floor(value);
+        std::snprintf(buffer, sizeof(buffer), whole ? "%.0f" : "%.3f", value);
+        out += buffer;
+    }
+} // namespace
+
+namespace SH3DS::Core
+{
+    void ShinyDiagnostics::Add(std::string_view name, double value, double total)
+    {
+        if (count < kCapacity)
+        {
+            entries[count++] = { .name = name, .value = value, .total = total };
+        }
+    }
+
+    std::string ShinyResult::Details() const
+    {
+        std::string out(note);
+        if (!note.empty() && diagnostics.count > 0)
+        {
+            out += ':';
+        }
+
+        for (std::size_t i = 0; i < diagnostics.count; ++i)
+        {
+            const auto &entry = diagnostics.entries[i];
+            if (!out.empty())
+            {
+                out += ' ';
+            }
+            out += entry.name;
+            out += '=';
+            AppendValue(out, entry.value);
+            if (entry.total > 0.0)
+            {
+                out += '/';
+                AppendValue(out, entry.total);
+            }
+        }
+        return out;
+    }
+} // namespace SH3DS::Core
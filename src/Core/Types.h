@@ -2,18 +2,31 @@
 
 #include <opencv2/core.hpp>
 
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace SH3DS::Core
 {
     /**
-     * @brief Game state identifier (string-based for config-driven FSM).
+     * @brief Compact game state identifier.
+     *
+     * State names are interned into a StateRegistry once when the FSM is built; the per-frame loop
+     * only passes these integers around and resolves names for logging and display.
      */
-    using GameState = std::string;
+    using StateId = uint16_t;
+
+    /**
+     * @brief Sentinel StateId meaning "no state".
+     */
+    inline constexpr StateId kInvalidStateId = std::numeric_limits<StateId>::max();
 
     /**
      * @brief Named set of regions of interest extracted from a preprocessed frame.
@@ -30,6 +43,7 @@ namespace SH3DS::Core
         int sourceWidth = 0;                                    ///< Width of the source image
         int sourceHeight = 0;                                   ///< Height of the source image
         double fpsEstimate = 0.0;                               ///< Estimated frames per second
+        cv::Point cropOrigin = {};                              ///< Top-left of the image in the source frame
     };
 
     /**
@@ -41,6 +55,18 @@ namespace SH3DS::Core
         FrameMetadata metadata; ///< Metadata associated with the frame
     };
 
+    /**
+     * @brief Whole-image statistics of a warped screen, gathered in one pass and shared by every consumer.
+     */
+    struct FrameStatistics
+    {
+        std::array<double, 3> channelMeans{};           ///< Mean B, G, R (0-255)
+        double meanV = 0.0;                             ///< Mean HSV V (max of B, G, R), normalised to [0, 1]
+        std::array<uint32_t, 256> luminanceHistogram{}; ///< Histogram of BT.601 luma
+        uint64_t pixelCount = 0;                        ///< Pixels measured (0 = not computed)
+        const void *source = nullptr;                   ///< First pixel of the measured image (identity only)
+    };
+
     /**
      * @brief Verdict from shiny detection.
      */
@@ -51,16 +77,55 @@ namespace SH3DS::Core
         Uncertain,
     };
 
+    /**
+     * @brief One named measurement behind a shiny verdict, e.g. a colour ratio or a vote count.
+     */
+    struct ShinyDiagnostic
+    {
+        std::string_view name = {}; ///< Label; must point at static storage
+        double value = 0.0;         ///< Measured value
+        double total = 0.0;         ///< Shown as value/total when positive
+    };
+
+    /**
+     * @brief Fixed-capacity list of raw diagnostics, kept unformatted until someone asks for them.
+     */
+    struct ShinyDiagnostics
+    {
+        static constexpr std::size_t kCapacity = 8; ///< Entries kept; further Add() calls are dropped
+
+        std::array<ShinyDiagnostic, kCapacity> entries{}; ///< Recorded diagnostics
+        std::size_t count = 0;                            ///< Number of valid entries
+
+        /**
+         * @brief Records a diagnostic, or drops it when the list is full.
+         * @param name Label; must point at static storage.
+         * @param value Measured value.
+         * @param total Denominator shown as value/total when positive.
+         */
+        void Add(std::string_view name, double value, double total = 0.0);
+    };
+
     /**
      * @brief Result of a shiny detection analysis.
+     *
+     * Detectors run every frame while only a debug log line or the UI ever reads the explanation, so a result
+     * carries no heap-allocated text: the method and note are static strings and the numbers behind the verdict
+     * stay raw until Details() formats them.
      */
     struct ShinyResult
     {
         ShinyVerdict verdict = ShinyVerdict::Uncertain; ///< Verdict from shiny detection
         double confidence = 0.0;                        ///< Confidence level of the verdict
-        std::string method;                             ///< Method used for detection
-        std::string details;                            ///< Additional details about the detection
-        cv::Mat debugImage;                             ///< Debug image showing the detection
+        std::string_view method = {};                   ///< Method used for detection; static storage
+        std::string_view note = {};                     ///< Fixed remark, e.g. "model not loaded"; static storage
+        ShinyDiagnostics diagnostics = {};              ///< Raw numbers behind the verdict
+
+        /**
+         * @brief Formats the note and diagnostics, e.g. "normal=0.120 shiny=0.640".
+         * @return Human-readable details (empty if there is nothing to report).
+         */
+        std::string Details() const;
     };
 
     /**
@@ -68,8 +133,8 @@ namespace SH3DS::Core
      */
     struct StateTransition
     {
-        GameState from;                                  ///< Previous state
-        GameState to;                                    ///< New state
+        StateId from = kInvalidStateId;                  ///< Previous state
+        StateId to = kInvalidStateId;                    ///< New state
         std::chrono::steady_clock::time_point timestamp; ///< Timestamp of the transition
     };
 
@@ -92,8 +157,9 @@ namespace SH3DS::Core
     struct HuntDecision
     {
         HuntAction action = HuntAction::Wait;                           ///< Action to take
-        std::string reason;                                             ///< Reason for the decision
+        std::string_view reason = {};                                   ///< Reason for the decision (static text)
         std::chrono::milliseconds delay = std::chrono::milliseconds(0); ///< Delay before next action
+        StateId state = kInvalidStateId;                                ///< State the reason refers to, named when logged
     };
 
     /**
@@ -108,5 +174,7 @@ namespace SH3DS::Core
         double avgCycleSeconds = 0.0;                             ///< Average time per cycle in seconds
         uint64_t errors = 0;                                      ///< Number of errors
         uint64_t watchdogRecoveries = 0;                          ///< Number of watchdog recoveries
+        uint64_t frames = 0;                                      ///< Warped frames seen by the orchestrator
+        uint64_t unchangedFrames = 0;                             ///< Frames whose analysis the delta gate skipped
     };
 } // namespace SH3DS::Core
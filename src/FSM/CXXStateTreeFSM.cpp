@@ -1,11 +1,13 @@
 #include "CXXStateTreeFSM.h"
 
-#include "Kappa/Logger.h"
+#include "Core/HotLog.h"
+#include "Core/Logger.h"
+#include "Vision/FrameStatistics.h"
 #include "Vision/TemplateMatcher.h"
 
-#include <opencv2/imgproc.hpp>
-
 #include <algorithm>
+#include <set>
+#include <string>
 
 namespace SH3DS::FSM
 {
@@ -33,6 +35,47 @@ namespace SH3DS::FSM
         return *this;
     }
 
+    CXXStateTreeFSM::DetectionMethod CXXStateTreeFSM::ParseDetectionMethod(const std::string &name)
+    {
+        if (name == "color_histogram" || name == "pixel_ratio")
+        {
+            return DetectionMethod::ColorHistogram;
+        }
+        if (name == "template_match")
+        {
+            return DetectionMethod::TemplateMatch;
+        }
+        if (name == "intensity_event")
+        {
+            return DetectionMethod::IntensityEvent;
+        }
+        if (name == "always_true")
+        {
+            return DetectionMethod::AlwaysTrue;
+        }
+        return DetectionMethod::Unknown;
+    }
+
+    int CXXStateTreeFSM::DetectionMethodCost(DetectionMethod method)
+    {
+        // Rough relative costs on a 400x240 ROI: intensity_event only reads detector events already computed
+        // for this frame, color_histogram is one lookup-table pass (shared per ROI), template_match adds a resize
+        // and a correlation.
+        switch (method)
+        {
+        case DetectionMethod::AlwaysTrue:
+        case DetectionMethod::Unknown:
+            return 0;
+        case DetectionMethod::IntensityEvent:
+            return 1;
+        case DetectionMethod::ColorHistogram:
+            return 10;
+        case DetectionMethod::TemplateMatch:
+            return 100;
+        }
+        return 0;
+    }
+
     std::unique_ptr<CXXStateTreeFSM> CXXStateTreeFSM::Builder::Build()
     {
         // Build the CXXStateTree graph for transition validation.
@@ -62,23 +105,166 @@ namespace SH3DS::FSM
         Core::ScreenMode screenMode,
         std::vector<StateConfig> stateConfigs)
         : tree(std::move(tree)),
-          initialState(std::move(initialState)),
+          initialStateName(std::move(initialState)),
           debounceFrames(debounceFrames),
           screenMode(screenMode),
-          stateConfigs(std::move(stateConfigs))
+          stateConfigs(std::move(stateConfigs)),
+          stateRegistry(std::make_shared<Core::StateRegistry>())
     {
+        CompileStates();
         Reset();
     }
 
+    void CXXStateTreeFSM::CompileStates()
+    {
+        // Declared states get the lowest IDs (in declaration order), followed by undeclared transition
+        // targets and the initial state, so every name the FSM can report has an ID.
+        for (const auto &stateConfig : stateConfigs)
+        {
+            stateRegistry->Intern(stateConfig.id);
+        }
+        for (const auto &stateConfig : stateConfigs)
+        {
+            for (const auto &target : stateConfig.transitionsTo)
+            {
+                stateRegistry->Intern(target);
+            }
+        }
+        initialState = stateRegistry->Intern(initialStateName);
+
+        compiledStates.assign(stateRegistry->Size(), CompiledState{});
+        for (std::size_t id = 0; id < compiledStates.size(); ++id)
+        {
+            compiledStates[id].gotoEvent = "goto_" + stateRegistry->Name(static_cast<Core::StateId>(id));
+        }
+
+        std::set<std::string> colorRois;
+        std::vector<bool> declared(compiledStates.size(), false);
+        std::vector<std::vector<Core::StateId>> successors(compiledStates.size());
+        for (const auto &stateConfig : stateConfigs)
+        {
+            const Core::StateId id = stateRegistry->Find(stateConfig.id);
+            auto &compiled = compiledStates[id];
+            if (compiled.config)
+            {
+                LOG_WARN("FSM: state '{}' declared more than once; keeping the first declaration", stateConfig.id);
+                continue;
+            }
+            compiled.config = &stateConfig;
+            const auto &detection = stateConfig.detectionParameters;
+            auto compileBlock = [this, &compiled, &colorRois](const Core::RoiDetectionParams &params,
+                                    CompiledBlock &block) {
+                block.method = ParseDetectionMethod(params.method);
+                compiled.cost += DetectionMethodCost(block.method);
+                if (block.method == DetectionMethod::ColorHistogram)
+                {
+                    block.colorRange = colorClassifier.AddRange(params.hsvLower, params.hsvUpper);
+                    colorRois.insert(params.roi);
+                }
+            };
+            if (detection.top.has_value())
+            {
+                compileBlock(*detection.top, compiled.top);
+                if (compiled.top.method == DetectionMethod::IntensityEvent)
+                {
+                    intensityRois.push_back(&detection.top->roi);
+                }
+            }
+            if (detection.bottom.has_value())
+            {
+                compileBlock(*detection.bottom, compiled.bottom);
+            }
+            declared[id] = true;
+            for (const auto &target : stateConfig.transitionsTo)
+            {
+                successors[id].push_back(stateRegistry->Find(target));
+            }
+        }
+
+        colorClassifier.Compile();
+        // With one colour ROI a direct pass over it is cheapest; with several (usually nested) ROIs, classifying
+        // the whole screen once into integral images makes every further ROI four lookups per range.
+        useIntegrals = colorRois.size() > 1;
+        transitionGraph = TransitionGraph(declared, successors);
+
+        for (std::size_t id = 0; id < compiledStates.size(); ++id)
+        {
+            const auto candidates = transitionGraph.Candidates(static_cast<Core::StateId>(id));
+            auto &order = compiledStates[id].evaluationOrder;
+            order.assign(candidates.begin(), candidates.end());
+            std::stable_sort(order.begin(), order.end(), [this](Core::StateId a, Core::StateId b) {
+                return compiledStates[a].cost < compiledStates[b].cost;
+            });
+        }
+
+        const auto report = transitionGraph.Validate(initialState);
+        for (const Core::StateId id : report.unreachable)
+        {
+            LOG_WARN("FSM: state '{}' is unreachable from initial state '{}'", StateName(id), initialStateName);
+        }
+        for (const Core::StateId id : report.deadEnds)
+        {
+            LOG_INFO("FSM: state '{}' has no outgoing transitions (terminal)", StateName(id));
+        }
+        for (const Core::StateId id : report.undeclared)
+        {
+            LOG_WARN("FSM: state '{}' is referenced but has no detection config", StateName(id));
+        }
+    }
+
+    void CXXStateTreeFSM::RebuildTree()
+    {
+        CXXStateTree::StateTree::Builder treeBuilder;
+        treeBuilder.initial(initialStateName);
+        for (const auto &stateConfig : stateConfigs)
+        {
+            treeBuilder.state(stateConfig.id, [&stateConfig](CXXStateTree::State &s) {
+                for (const auto &target : stateConfig.transitionsTo)
+                {
+                    s.on("goto_" + target, target);
+                }
+            });
+        }
+        tree = std::make_unique<CXXStateTree::StateTree>(treeBuilder.build());
+    }
+
     std::optional<Core::StateTransition> CXXStateTreeFSM::Update(const Core::ROISet &topRois,
         const SH3DS::Core::ROISet &bottomRois)
     {
-        LOG_DEBUG("Called `CXXStateTreeFSM::Update()` on new frame. Current state = {}.", currentState);
+        HOT_LOG_DEBUG("Called `CXXStateTreeFSM::Update()` on new frame. Current state = {}.", StateName(currentState));
+        return UpdateFrame(topRois, bottomRois, false);
+    }
 
-        AdvanceIntensityDetectors(topRois);
+    std::optional<Core::StateTransition> CXXStateTreeFSM::UpdateUnchanged(const Core::ROISet &topRois,
+        const SH3DS::Core::ROISet &bottomRois)
+    {
+        HOT_LOG_DEBUG("Called `CXXStateTreeFSM::UpdateUnchanged()`. Current state = {}.", StateName(currentState));
+        return UpdateFrame(topRois, bottomRois, true);
+    }
 
-        const auto bestCandidateState = DetectBestCandidateState(topRois, bottomRois);
-        if (bestCandidateState.state.empty() || bestCandidateState.confidence < 0.01)
+    void CXXStateTreeFSM::SetFrameStatistics(const Core::FrameStatistics &topStatistics)
+    {
+        if (topStatistics.pixelCount > 0)
+        {
+            screenMeanV = topStatistics.meanV;
+            screenSource = topStatistics.source;
+            screenPixelCount = topStatistics.pixelCount;
+        }
+    }
+
+    std::optional<Core::StateTransition> CXXStateTreeFSM::UpdateFrame(const Core::ROISet &topRois,
+        const SH3DS::Core::ROISet &bottomRois,
+        bool unchanged)
+    {
+        AdvanceIntensityDetectors(topRois, unchanged);
+        screenMeanV.reset();
+
+        const auto bestCandidateState = DetectBestCandidateState(topRois, bottomRois, unchanged);
+        HOT_LOG_DEBUG("FSM: {} detection evaluations ran, {} reused, {} skipped by early exit",
+            lastEvaluationStats.evaluated,
+            lastEvaluationStats.reused,
+            lastEvaluationStats.skipped);
+        if (bestCandidateState.state == Core::kInvalidStateId || bestCandidateState.confidence < 0.01)
         {
             pendingFrameCount = 0;
             return std::nullopt;
@@ -87,7 +273,7 @@ namespace SH3DS::FSM
         // Debounce: require N consecutive frames detecting the same new state
         if (bestCandidateState.state == currentState)
         {
-            pendingState.clear();
+            pendingState = Core::kInvalidStateId;
             pendingFrameCount = 0;
             return std::nullopt;
         }
@@ -108,20 +294,19 @@ namespace SH3DS::FSM
         }
 
         bool isTransitionAllowed = true;
-        const auto *config = FindStateConfig(currentState);
-        if (config && !config->transitionsTo.empty())
+        if (transitionGraph.IsDeclared(currentState) && !transitionGraph.Successors(currentState).empty())
         {
-            const auto &allowedTargets = config->transitionsTo;
-            if (std::find(allowedTargets.begin(), allowedTargets.end(), pendingState) == allowedTargets.end())
+            if (!transitionGraph.HasEdge(currentState, pendingState))
             {
-                LOG_WARN("FSM: Illegal transition {} -> {}! (ignoring)", currentState, pendingState);
+                LOG_WARN(
+                    "FSM: Illegal transition {} -> {}! (ignoring)", StateName(currentState), StateName(pendingState));
                 isTransitionAllowed = false;
             }
         }
 
         if (!isTransitionAllowed)
         {
-            pendingState.clear();
+            pendingState = Core::kInvalidStateId;
             pendingFrameCount = 0;
             return std::nullopt;
         }
@@ -132,13 +317,16 @@ namespace SH3DS::FSM
 
         try
         {
-            tree->send("goto_" + pendingState);
+            tree->send(compiledStates[pendingState].gotoEvent);
         }
         catch (const std::runtime_error &e)
         {
-            LOG_ERROR("FSM: CXXStateTree rejected transition {} -> {}: {}", currentState, pendingState, e.what());
+            LOG_ERROR("FSM: CXXStateTree rejected transition {} -> {}: {}",
+                StateName(currentState),
+                StateName(pendingState),
+                e.what());
 
-            pendingState.clear();
+            pendingState = Core::kInvalidStateId;
             pendingFrameCount = 0;
             return std::nullopt;
         }
@@ -155,27 +343,21 @@ namespace SH3DS::FSM
 
     void CXXStateTreeFSM::Reset()
     {
-        CXXStateTree::StateTree::Builder treeBuilder;
-        treeBuilder.initial(initialState);
-        for (const auto &stateConfig : stateConfigs)
-        {
-            treeBuilder.state(stateConfig.id, [&stateConfig](CXXStateTree::State &s) {
-                for (const auto &target : stateConfig.transitionsTo)
-                {
-                    s.on("goto_" + target, target);
-                }
-            });
-        }
-        tree = std::make_unique<CXXStateTree::StateTree>(treeBuilder.build());
+        RebuildTree();
 
         currentState = initialState;
         stateEnteredAt = std::chrono::steady_clock::now();
-        pendingState.clear();
+        pendingState = Core::kInvalidStateId;
         pendingFrameCount = 0;
         transitionHistory.clear();
         topIntensityDetector.Reset();
         raisesAtLastTransition = 0;
         intensityFrameCounter = 0;
+        lastAverageV.reset();
+        screenMeanV.reset();
+        blockScores.clear();
+        lastEvaluationStats = {};
+        totalEvaluationStats = {};
     }
 
     bool CXXStateTreeFSM::IsStuck() const
@@ -189,16 +371,21 @@ namespace SH3DS::FSM
         return GetTimeInCurrentState() > std::chrono::seconds(config->maxDurationS);
     }
 
-    const Core::GameState &CXXStateTreeFSM::GetCurrentState() const
+    Core::StateId CXXStateTreeFSM::GetCurrentState() const
     {
         return currentState;
     }
 
-    const Core::GameState &CXXStateTreeFSM::GetInitialState() const
+    Core::StateId CXXStateTreeFSM::GetInitialState() const
     {
         return initialState;
     }
 
+    std::shared_ptr<const Core::StateRegistry> CXXStateTreeFSM::GetStateRegistry() const
+    {
+        return stateRegistry;
+    }
+
     std::chrono::milliseconds CXXStateTreeFSM::GetTimeInCurrentState() const
     {
         auto now = std::chrono::steady_clock::now();
@@ -210,34 +397,62 @@ namespace SH3DS::FSM
         return transitionHistory;
     }
 
+    const TransitionGraph &CXXStateTreeFSM::GetTransitionGraph() const
+    {
+        return transitionGraph;
+    }
+
+    const CXXStateTreeFSM::EvaluationStats &CXXStateTreeFSM::GetLastEvaluationStats() const
+    {
+        return lastEvaluationStats;
+    }
+
+    const CXXStateTreeFSM::EvaluationStats &CXXStateTreeFSM::GetTotalEvaluationStats() const
+    {
+        return totalEvaluationStats;
+    }
+
     CXXStateTreeFSM::DetectionResult CXXStateTreeFSM::DetectBestCandidateState(const Core::ROISet &topRois,
-        const SH3DS::Core::ROISet &bottomRois) const
+        const SH3DS::Core::ROISet &bottomRois,
+        bool reuseScores) const
     {
-        LOG_DEBUG("FSM: EvaluateRules called with {} top ROIs, {} bottom ROIs, {} states",
+        HOT_LOG_DEBUG("FSM: EvaluateRules called with {} top ROIs, {} bottom ROIs, {} states",
             topRois.size(),
             bottomRois.size(),
             stateConfigs.size());
 
         DetectionResult bestResult;
-        std::vector<std::string> candidates;
-        const auto *currentConfig = FindStateConfig(currentState);
-        const bool constrained = currentConfig != nullptr;
-        if (constrained)
+        lastEvaluationStats = {};
+        colorCounts.clear();
+        for (auto &screen : screenIntegrals)
         {
-            candidates.push_back(currentState);
-            candidates.insert(
-                candidates.end(), currentConfig->transitionsTo.begin(), currentConfig->transitionsTo.end());
+            screen.data = nullptr;
         }
 
-        for (const auto &stateConfig : stateConfigs)
+        // One slot per state and screen. A changed frame forgets every score; an unchanged one keeps them, so only
+        // blocks the previous frame never scored (e.g. successors of a state just entered) read their ROI.
+        if (!reuseScores || blockScores.size() != compiledStates.size() * 2)
         {
-            if (constrained)
+            blockScores.assign(compiledStates.size() * 2, std::nullopt);
+        }
+
+        // Ties go to the lower StateId (declaration order), exactly as the original declaration-order scan did,
+        // so evaluating cheapest-first does not change which state wins.
+        auto canBeatBest = [&bestResult](double confidence, Core::StateId stateId) {
+            if (confidence > bestResult.confidence)
             {
-                if (std::find(candidates.begin(), candidates.end(), stateConfig.id) == candidates.end())
-                {
-                    continue;
-                }
+                return true;
             }
+            return confidence == bestResult.confidence && bestResult.state != Core::kInvalidStateId
+                   && stateId < bestResult.state;
+        };
+
+        // Candidates (self + declared successors, or every declared state when unconstrained) precompiled in
+        // ascending estimated cost, so cheap detectors establish a best score before expensive ones run.
+        for (const Core::StateId stateId : compiledStates[currentState].evaluationOrder)
+        {
+            const auto &compiled = compiledStates[stateId];
+            const auto &stateConfig = *compiled.config;
 
             const auto &stateDetectionParameters = stateConfig.detectionParameters;
             const bool hasTop = stateDetectionParameters.top.has_value();
@@ -247,7 +462,16 @@ namespace SH3DS::FSM
                 continue;
             }
 
+            const uint64_t blockCount =
+                screenMode == Core::ScreenMode::Dual ? (hasTop ? 1u : 0u) + (hasBottom ? 1u : 0u) : 1u;
+            if (!canBeatBest(kMaxConfidence, stateId))
+            {
+                lastEvaluationStats.skipped += blockCount;
+                continue;
+            }
+
             auto evaluateForRoi = [&](const std::optional<Core::RoiDetectionParams> &roiDetectionParams,
+                                      const CompiledBlock &block,
                                       const Core::ROISet &roiSet,
                                       const char *screenLabel) -> std::optional<double> {
                 if (!roiDetectionParams.has_value())
@@ -256,7 +480,6 @@ namespace SH3DS::FSM
                 }
 
                 const auto &params = roiDetectionParams.value();
-                const std::string method = params.method;
 
                 auto it = roiSet.find(params.roi);
                 if (it == roiSet.end() || it->second.empty())
@@ -266,41 +489,50 @@ namespace SH3DS::FSM
 
                 const cv::Mat &roiMat = it->second;
                 double confidence = 0.0;
+                bool reused = false;
 
-                if (method == "template_match")
+                switch (block.method)
                 {
-                    confidence = EvaluateTemplateMatch(roiMat, params);
-                }
-                else if (method == "color_histogram" || method == "pixel_ratio")
+                case DetectionMethod::TemplateMatch:
+                case DetectionMethod::ColorHistogram:
                 {
-                    confidence = EvaluateColorHistogram(roiMat, params);
+                    const std::size_t slot = static_cast<std::size_t>(stateId) * 2 + (&roiSet == &bottomRois ? 1u : 0u);
+                    auto &score = blockScores[slot];
+                    reused = reuseScores && score.has_value();
+                    if (!reused)
+                    {
+                        score = block.method == DetectionMethod::TemplateMatch
+                                    ? EvaluateTemplateMatch(roiMat, params)
+                                    : EvaluateColorHistogram(roiMat, params, block.colorRange);
+                    }
+                    confidence = score.value();
+                    break;
                 }
-                else if (method == "intensity_event")
-                {
+                case DetectionMethod::IntensityEvent:
                     // intensity_event is an edge trigger: skip for the current state (we're already here).
                     // Only evaluate for successor candidates so the Drop+Raise fires a transition INTO the state.
-                    if (stateConfig.id == currentState)
+                    if (stateId == currentState)
                     {
                         return std::nullopt;
                     }
                     confidence = EvaluateIntensityEvent();
-                }
-                else if (method == "always_true")
-                {
+                    break;
+                case DetectionMethod::AlwaysTrue:
                     // always_true is a placeholder for unimplemented detection; also skip for current state
                     // so it doesn't compete with real detectors on successor states.
-                    if (stateConfig.id == currentState)
+                    if (stateId == currentState)
                     {
                         return std::nullopt;
                     }
                     confidence = 1.0;
-                }
-                else
-                {
+                    break;
+                case DetectionMethod::Unknown:
                     return std::nullopt;
                 }
+                ++(reused ? lastEvaluationStats.reused : lastEvaluationStats.evaluated);
 
-                LOG_DEBUG("FSM: Evaluating Rule for state '{}' on {} ROI '{}': confidence={:.3f} (threshold={:.2f})",
+                HOT_LOG_DEBUG(
+                    "FSM: Evaluating Rule for state '{}' on {} ROI '{}': confidence={:.3f} (threshold={:.2f})",
                     stateConfig.id,
                     screenLabel,
                     params.roi,
@@ -318,73 +550,76 @@ namespace SH3DS::FSM
             double combinedConfidence = 0.0;
             if (screenMode == Core::ScreenMode::Single)
             {
-                auto evaluateSingleScreenBlock =
-                    [&](const std::optional<Core::RoiDetectionParams> &block) -> std::optional<double> {
-                    auto topConfidence = evaluateForRoi(block, topRois, "top");
+                auto evaluateSingleScreenBlock = [&](const std::optional<Core::RoiDetectionParams> &params,
+                                                     const CompiledBlock &block) -> std::optional<double> {
+                    auto topConfidence = evaluateForRoi(params, block, topRois, "top");
                     if (topConfidence.has_value())
                     {
                         return topConfidence;
                     }
-                    return evaluateForRoi(block, bottomRois, "bottom");
+                    return evaluateForRoi(params, block, bottomRois, "bottom");
                 };
 
-                if (hasTop)
+                auto confidence = hasTop ? evaluateSingleScreenBlock(stateDetectionParameters.top, compiled.top)
+                                         : evaluateSingleScreenBlock(stateDetectionParameters.bottom, compiled.bottom);
+                if (!confidence.has_value())
                 {
-                    auto topConfidence = evaluateSingleScreenBlock(stateDetectionParameters.top);
-                    if (!topConfidence.has_value())
-                    {
-                        continue;
-                    }
-                    combinedConfidence = topConfidence.value();
-                }
-                else
-                {
-                    auto bottomConfidence = evaluateSingleScreenBlock(stateDetectionParameters.bottom);
-                    if (!bottomConfidence.has_value())
-                    {
-                        continue;
-                    }
-                    combinedConfidence = bottomConfidence.value();
+                    continue;
                 }
+                combinedConfidence = confidence.value();
             }
-            else
+            else if (hasTop && hasBottom)
             {
-                auto topConfidence = evaluateForRoi(stateDetectionParameters.top, topRois, "top");
-                auto bottomConfidence = evaluateForRoi(stateDetectionParameters.bottom, bottomRois, "bottom");
-
-                if (hasTop && hasBottom)
+                // Both screens must pass and the result is their minimum: run the cheaper screen first and only
+                // pay for the other one if the first result can still produce a winner.
+                const bool topFirst =
+                    DetectionMethodCost(compiled.top.method) <= DetectionMethodCost(compiled.bottom.method);
+                const auto &firstParams = topFirst ? stateDetectionParameters.top : stateDetectionParameters.bottom;
+                const auto &secondParams = topFirst ? stateDetectionParameters.bottom : stateDetectionParameters.top;
+                const auto &firstBlock = topFirst ? compiled.top : compiled.bottom;
+                const auto &secondBlock = topFirst ? compiled.bottom : compiled.top;
+                const auto &firstRois = topFirst ? topRois : bottomRois;
+                const auto &secondRois = topFirst ? bottomRois : topRois;
+
+                auto firstConfidence =
+                    evaluateForRoi(firstParams, firstBlock, firstRois, topFirst ? "top" : "bottom");
+                if (!firstConfidence.has_value() || !canBeatBest(firstConfidence.value(), stateId))
                 {
-                    if (!topConfidence.has_value() || !bottomConfidence.has_value())
-                    {
-                        continue;
-                    }
-                    combinedConfidence = std::min(topConfidence.value(), bottomConfidence.value());
+                    ++lastEvaluationStats.skipped;
+                    continue;
                 }
-                else if (hasTop)
+
+                auto secondConfidence =
+                    evaluateForRoi(secondParams, secondBlock, secondRois, topFirst ? "bottom" : "top");
+                if (!secondConfidence.has_value())
                 {
-                    if (!topConfidence.has_value())
-                    {
-                        continue;
-                    }
-                    combinedConfidence = topConfidence.value();
+                    continue;
                 }
-                else
+                combinedConfidence = std::min(firstConfidence.value(), secondConfidence.value());
+            }
+            else
+            {
+                auto confidence =
+                    hasTop ? evaluateForRoi(stateDetectionParameters.top, compiled.top, topRois, "top")
+                           : evaluateForRoi(stateDetectionParameters.bottom, compiled.bottom, bottomRois, "bottom");
+                if (!confidence.has_value())
                 {
-                    if (!bottomConfidence.has_value())
-                    {
-                        continue;
-                    }
-                    combinedConfidence = bottomConfidence.value();
+                    continue;
                 }
+                combinedConfidence = confidence.value();
             }
 
-            if (combinedConfidence > bestResult.confidence)
+            if (canBeatBest(combinedConfidence, stateId))
             {
-                bestResult.state = stateConfig.id;
+                bestResult.state = stateId;
                 bestResult.confidence = combinedConfidence;
             }
         }
 
+        totalEvaluationStats.evaluated += lastEvaluationStats.evaluated;
+        totalEvaluationStats.skipped += lastEvaluationStats.skipped;
+        totalEvaluationStats.reused += lastEvaluationStats.reused;
+
         return bestResult;
     }
 
@@ -399,16 +634,75 @@ namespace SH3DS::FSM
         return templateMatcher.Match(roi, roiDetectionParameters.templatePath);
     }
 
-    double CXXStateTreeFSM::EvaluateColorHistogram(const cv::Mat &roi,
-        const Core::RoiDetectionParams &roiDetectionParameters) const
+    const std::array<uint32_t, Vision::ColorClassifier::kMaxRanges> &CXXStateTreeFSM::CountColors(
+        const cv::Mat &roi) const
     {
-        cv::Mat hsv;
-        cv::cvtColor(roi, hsv, cv::COLOR_BGR2HSV);
+        // Several states usually test the same ROI; one classification pass yields the counts for all of them.
+        for (const auto &entry : colorCounts)
+        {
+            if (entry.data == roi.data && entry.size == roi.size())
+            {
+                return entry.counts;
+            }
+        }
 
-        cv::Mat mask;
-        cv::inRange(hsv, roiDetectionParameters.hsvLower, roiDetectionParameters.hsvUpper, mask);
+        auto &entry = colorCounts.emplace_back(ColorCounts{ .data = roi.data, .size = roi.size(), .counts = {} });
+        if (!useIntegrals || !CountColorsFromIntegrals(roi, entry.counts))
+        {
+            colorClassifier.CountPixels(roi, entry.counts);
+        }
+        return entry.counts;
+    }
 
-        const double pixelRatio = cv::countNonZero(mask) / static_cast<double>(roi.total());
+    bool CXXStateTreeFSM::CountColorsFromIntegrals(const cv::Mat &roi, std::span<uint32_t> counts) const
+    {
+        // The preprocessor hands out ROIs as views into the warped screen, so the screen can be recovered here.
+        if (!roi.isSubmatrix())
+        {
+            return false;
+        }
+        cv::Size screenSize;
+        cv::Point offset;
+        roi.locateROI(screenSize, offset);
+
+        auto screen = std::find_if(screenIntegrals.begin(), screenIntegrals.end(), [&](const ScreenIntegrals &s) {
+            return s.data == roi.datastart && s.size == screenSize;
+        });
+        if (screen == screenIntegrals.end())
+        {
+            // Reuse a stale slot so the integral buffers are not reallocated every frame.
+            screen = std::find_if(screenIntegrals.begin(), screenIntegrals.end(), [](const ScreenIntegrals &s) {
+                return s.data == nullptr;
+            });
+            if (screen == screenIntegrals.end())
+            {
+                screen = screenIntegrals.insert(screenIntegrals.end(), ScreenIntegrals{});
+            }
+
+            cv::Mat whole = roi;
+            whole.adjustROI(offset.y,
+                screenSize.height - offset.y - roi.rows,
+                offset.x,
+                screenSize.width - offset.x - roi.cols);
+            colorClassifier.ComputeIntegrals(whole, screen->integrals);
+            screen->data = roi.datastart;
+            screen->size = screenSize;
+        }
+
+        const cv::Rect rect(offset, roi.size());
+        for (std::size_t i = 0; i < screen->integrals.size(); ++i)
+        {
+            counts[i] = Vision::ColorClassifier::SumRect(screen->integrals[i], rect);
+        }
+        return true;
+    }
+
+    double CXXStateTreeFSM::EvaluateColorHistogram(const cv::Mat &roi,
+        const Core::RoiDetectionParams &roiDetectionParameters,
+        int colorRange) const
+    {
+        const double pixelRatio =
+            CountColors(roi)[static_cast<std::size_t>(colorRange)] / static_cast<double>(roi.total());
 
         if (pixelRatio < roiDetectionParameters.pixelRatioMin || pixelRatio > roiDetectionParameters.pixelRatioMax)
         {
@@ -429,31 +723,38 @@ namespace SH3DS::FSM
             return 0.0;
         }
 
-        cv::Mat hsv;
-        cv::cvtColor(roi, hsv, cv::COLOR_BGR2HSV);
-        cv::Scalar meanVal = cv::mean(hsv);
-        return meanVal[2] / 255.0;
+        // Only a view of the measured screen starting at its first pixel and covering all of it is that screen;
+        // a clone or a separately resized image of the same size is not.
+        if (screenMeanV.has_value() && roi.data == screenSource && roi.total() == screenPixelCount)
+        {
+            return screenMeanV.value();
+        }
+
+        Core::FrameStatistics statistics;
+        Vision::ComputeFrameStatistics(roi, statistics);
+        return statistics.meanV;
     }
 
-    void CXXStateTreeFSM::AdvanceIntensityDetectors(const Core::ROISet &topRois)
+    void CXXStateTreeFSM::AdvanceIntensityDetectors(const Core::ROISet &topRois, bool unchanged)
     {
-        for (const auto &sc : stateConfigs)
+        // The detector's baseline decays per frame, so unchanged frames still advance it, with the last sample.
+        if (unchanged && lastAverageV.has_value())
         {
-            if (!sc.detectionParameters.top.has_value())
-            {
-                continue;
-            }
-            if (sc.detectionParameters.top->method != "intensity_event")
-            {
-                continue;
-            }
-            auto it = topRois.find(sc.detectionParameters.top->roi);
+            topIntensityDetector.Update(lastAverageV.value(), intensityFrameCounter++);
+            return;
+        }
+
+        lastAverageV.reset();
+        for (const auto *roiName : intensityRois)
+        {
+            auto it = topRois.find(*roiName);
             if (it == topRois.end() || it->second.empty())
             {
                 continue;
             }
             const double avgV = ComputeAverageV(it->second);
-            LOG_DEBUG("IntensityDetector advance: avgV={:.3f} frame={}", avgV, intensityFrameCounter);
+            HOT_LOG_DEBUG("IntensityDetector advance: avgV={:.3f} frame={}", avgV, intensityFrameCounter);
+            lastAverageV = avgV;
             topIntensityDetector.Update(avgV, intensityFrameCounter++);
             return;
         }
@@ -500,15 +801,13 @@ namespace SH3DS::FSM
         }
     }
 
-    const CXXStateTreeFSM::StateConfig *CXXStateTreeFSM::FindStateConfig(const std::string &id) const
+    const CXXStateTreeFSM::StateConfig *CXXStateTreeFSM::FindStateConfig(Core::StateId id) const
     {
-        for (const auto &sc : stateConfigs)
-        {
-            if (sc.id == id)
-            {
-                return &sc;
-            }
-        }
-        return nullptr;
+        return id < compiledStates.size() ? compiledStates[id].config : nullptr;
+    }
+
+    const std::string &CXXStateTreeFSM::StateName(Core::StateId id) const
+    {
+        return stateRegistry->Name(id);
     }
 } // namespace SH3DS::FSM
@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Core/Config.h"
+#include "Core/StateRegistry.h"
 #include "Core/Types.h"
 #include "FSM/GameStateFSM.h"
+#include "FSM/TransitionGraph.h"
+#include "Vision/ColorClassifier.h"
 #include "Vision/IntensityEventDetector.h"
 #include "Vision/TemplateMatcher.h"
 
 #include <opencv2/core.hpp>
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -24,6 +30,7 @@ namespace SH3DS::FSM
      * States and transitions are defined in C++ via the Builder.
      * Detection parameters (HSV ranges, thresholds) come from YAML config.
      * The CXXStateTree graph validates transition legality.
+     * State names are interned into a StateRegistry at build time; the per-frame path works on StateId only.
      */
     class CXXStateTreeFSM : public GameStateFSM
     {
@@ -40,6 +47,42 @@ namespace SH3DS::FSM
             Core::StateDetectionParams detectionParameters; ///< Detection parameters (from YAML)
         };
 
+        /**
+         * @brief Detection method of a ROI block, parsed once from its config string.
+         */
+        enum class DetectionMethod
+        {
+            AlwaysTrue,     ///< "always_true"
+            IntensityEvent, ///< "intensity_event"
+            ColorHistogram, ///< "color_histogram" / "pixel_ratio"
+            TemplateMatch,  ///< "template_match"
+            Unknown,        ///< Anything else (never matches)
+        };
+
+        /**
+         * @brief Per-frame detection work counters.
+         */
+        struct EvaluationStats
+        {
+            uint64_t evaluated = 0; ///< ROI blocks whose detection method actually ran
+            uint64_t skipped = 0;   ///< ROI blocks skipped because they could not beat the best candidate
+            uint64_t reused = 0;    ///< ROI blocks scored from the previous frame by UpdateUnchanged()
+        };
+
+        /**
+         * @brief Parses a detection method name from config.
+         * @param name The method name.
+         * @return The parsed method, or DetectionMethod::Unknown.
+         */
+        static DetectionMethod ParseDetectionMethod(const std::string &name);
+
+        /**
+         * @brief Returns the relative cost of one evaluation, used to order candidates cheapest-first.
+         * @param method The detection method.
+         * @return The relative cost (0 = free).
+         */
+        static int DetectionMethodCost(DetectionMethod method);
+
         /**
          * @brief Builder for constructing a CXXStateTreeFSM.
          */
@@ -76,6 +119,9 @@ namespace SH3DS::FSM
 
             /**
              * @brief Builds and returns the FSM.
+             *
+             * Interns state names, compiles the transition graph and logs any structural problems
+             * (unreachable states, dead ends, undeclared targets) reported by TransitionGraph::Validate().
              * @return std::unique_ptr<CXXStateTreeFSM> The built FSM.
              */
             std::unique_ptr<CXXStateTreeFSM> Build();
@@ -92,18 +138,50 @@ namespace SH3DS::FSM
         std::optional<Core::StateTransition> Update(const Core::ROISet &topRois,
             const SH3DS::Core::ROISet &bottomRois) override;
 
+        /**
+         * @brief Runs the debounce and intensity logic on an unchanged frame, reusing the previous frame's
+         * template and colour scores (ROIs are only read for blocks that were not scored last frame).
+         */
+        std::optional<Core::StateTransition> UpdateUnchanged(const Core::ROISet &topRois,
+            const SH3DS::Core::ROISet &bottomRois) override;
+
+        /**
+         * @brief Uses the screen's mean V for the intensity detector when its ROI covers the whole screen.
+         */
+        void SetFrameStatistics(const Core::FrameStatistics &topStatistics) override;
+
         void Reset() override;
 
         bool IsStuck() const override;
 
-        const Core::GameState &GetCurrentState() const override;
+        Core::StateId GetCurrentState() const override;
+
+        Core::StateId GetInitialState() const override;
 
-        const Core::GameState &GetInitialState() const override;
+        std::shared_ptr<const Core::StateRegistry> GetStateRegistry() const override;
 
         std::chrono::milliseconds GetTimeInCurrentState() const override;
 
         const std::vector<Core::StateTransition> &GetTransitionHistory() const override;
 
+        /**
+         * @brief Returns the transition graph compiled at build time (for validation tooling).
+         * @return The compiled transition graph.
+         */
+        const TransitionGraph &GetTransitionGraph() const;
+
+        /**
+         * @brief Returns detection work done during the last Update().
+         * @return Evaluated and skipped ROI block counts for the last frame.
+         */
+        const EvaluationStats &GetLastEvaluationStats() const;
+
+        /**
+         * @brief Returns detection work accumulated since construction or the last Reset().
+         * @return Evaluated and skipped ROI block counts.
+         */
+        const EvaluationStats &GetTotalEvaluationStats() const;
+
     private:
         /**
          * @brief Constructs a new CXXStateTreeFSM.
@@ -123,18 +201,31 @@ namespace SH3DS::FSM
          */
         struct DetectionResult
         {
-            Core::GameState state;   ///< The detected state.
-            double confidence = 0.0; ///< The confidence level of the detection.
+            Core::StateId state = Core::kInvalidStateId; ///< The detected state.
+            double confidence = 0.0;                     ///< The confidence level of the detection.
         };
 
+        /**
+         * @brief Shared body of Update() and UpdateUnchanged().
+         * @param topRois The top ROISet.
+         * @param bottomRois The bottom ROISet.
+         * @param unchanged True if the frame is unchanged since the previous update.
+         * @return An optional containing the state transition if successful, an empty optional otherwise.
+         */
+        std::optional<Core::StateTransition> UpdateFrame(const Core::ROISet &topRois,
+            const SH3DS::Core::ROISet &bottomRois,
+            bool unchanged);
+
         /**
          * @brief Detects the best candidate state from the current ROISet.
          * @param topRois The current top ROISet.
          * @param bottomRois The current bottom ROISet.
+         * @param reuseScores Reuse template and colour scores cached by the previous frame.
          * @return DetectionResult The result of the detection.
          */
         DetectionResult DetectBestCandidateState(const Core::ROISet &topRois,
-            const SH3DS::Core::ROISet &bottomRois) const;
+            const SH3DS::Core::ROISet &bottomRois,
+            bool reuseScores) const;
 
         /**
          * @brief Evaluates the template match for a given ROI.
@@ -148,20 +239,41 @@ namespace SH3DS::FSM
          * @brief Evaluates the color histogram for a given ROI.
          * @param roi The ROI to evaluate.
          * @param stateDetectionParameters The detection parameters.
+         * @param colorRange Index of the block's HSV range in colorClassifier.
          * @return double The color histogram score.
          */
-        double EvaluateColorHistogram(const cv::Mat &roi, const Core::RoiDetectionParams &roiDetectionParameters) const;
+        double EvaluateColorHistogram(const cv::Mat &roi,
+            const Core::RoiDetectionParams &roiDetectionParameters,
+            int colorRange) const;
+
+        /**
+         * @brief Returns per-range pixel counts for an ROI, classifying it at most once per frame.
+         * @param roi The ROI to classify.
+         * @return Pixel count for every range in colorClassifier.
+         */
+        const std::array<uint32_t, Vision::ColorClassifier::kMaxRanges> &CountColors(const cv::Mat &roi) const;
+
+        /**
+         * @brief Counts an ROI's colours from its screen's range integral images, building them on first use
+         * this frame.
+         * @param roi The ROI.
+         * @param counts Output, one entry per range in colorClassifier.
+         * @return False (counts untouched) if the ROI is not a view into a larger screen image.
+         */
+        bool CountColorsFromIntegrals(const cv::Mat &roi, std::span<uint32_t> counts) const;
 
         /**
          * @brief Advances the intensity detector once per frame using the first configured intensity_event ROI.
          * @param topRois The top-screen ROI set for the current frame.
+         * @param unchanged Feed the previous frame's average V instead of measuring the ROI again.
          */
-        void AdvanceIntensityDetectors(const Core::ROISet &topRois);
+        void AdvanceIntensityDetectors(const Core::ROISet &topRois, bool unchanged);
 
         /** @brief Returns 1.0 if a new Drop+Raise pair has completed since last transition, else 0.0. */
         double EvaluateIntensityEvent() const;
 
-        /** @brief Computes the average normalised V-channel value [0,1] from a BGR ROI. */
+        /** @brief Computes the average normalised V-channel value [0,1] from a BGR ROI, or takes it from the
+         * published screen statistics when the ROI is the measured screen itself (same pixels, same count). */
         double ComputeAverageV(const cv::Mat &roi) const;
 
         /**
@@ -170,29 +282,110 @@ namespace SH3DS::FSM
          */
         void RecordTransition(const Core::StateTransition &transition);
 
+        /**
+         * @brief Detection block (top or bottom) resolved once at construction.
+         */
+        struct CompiledBlock
+        {
+            DetectionMethod method = DetectionMethod::Unknown; ///< Parsed detection method
+            int colorRange = -1;                               ///< HSV range index in colorClassifier (-1 if unused)
+        };
+
+        /**
+         * @brief Per-state data resolved once at construction, indexed by StateId.
+         */
+        struct CompiledState
+        {
+            const StateConfig *config = nullptr;        ///< State configuration (nullptr for undeclared)
+            std::string gotoEvent;                      ///< CXXStateTree event that enters this state
+            CompiledBlock top;                          ///< Compiled top detection block
+            CompiledBlock bottom;                       ///< Compiled bottom detection block
+            int cost = 0;                               ///< Estimated cost of evaluating this state
+            std::vector<Core::StateId> evaluationOrder; ///< Candidates while in this state, cheapest first
+        };
+
+        /**
+         * @brief Colour counts of one ROI, cached for the duration of a single detection pass.
+         */
+        struct ColorCounts
+        {
+            const uchar *data = nullptr;                                        ///< ROI pixel data (identifies the ROI)
+            cv::Size size;                                                      ///< ROI size
+            std::array<uint32_t, Vision::ColorClassifier::kMaxRanges> counts{}; ///< Pixel count per range
+        };
+
+        /**
+         * @brief Range integral images of one warped screen, built at most once per frame.
+         */
+        struct ScreenIntegrals
+        {
+            const uchar *data = nullptr;    ///< Screen pixel data (identifies the screen; nullptr = stale)
+            cv::Size size;                  ///< Screen size
+            std::vector<cv::Mat> integrals; ///< One integral image per range in colorClassifier
+        };
+
+        /**
+         * @brief Upper bound of any detection method's confidence; used for early exit.
+         */
+        static constexpr double kMaxConfidence = 1.0;
+
+        /**
+         * @brief Interns all state names, fills the compiled per-state table and the transition graph.
+         */
+        void CompileStates();
+
+        /**
+         * @brief Rebuilds the CXXStateTree graph from the state configurations.
+         */
+        void RebuildTree();
+
         /**
          * @brief Finds a state configuration by ID.
          * @param id The state ID.
          * @return const StateConfig* A pointer to the state configuration if found, nullptr otherwise.
          */
-        const StateConfig *FindStateConfig(const std::string &id) const;
+        const StateConfig *FindStateConfig(Core::StateId id) const;
+
+        /**
+         * @brief Resolves a state ID to its name for logging.
+         * @param id The state ID.
+         * @return The state name.
+         */
+        const std::string &StateName(Core::StateId id) const;
 
         std::unique_ptr<CXXStateTree::StateTree> tree;          ///< CXXStateTree instance
-        std::string initialState;                               ///< Initial state ID
+        std::string initialStateName;                           ///< Initial state name (for the CXXStateTree)
         int debounceFrames;                                     ///< Debounce frame count
         Core::ScreenMode screenMode = Core::ScreenMode::Single; ///< Screen mode for detection
         std::vector<StateConfig> stateConfigs;                  ///< All state configurations
-
-        Core::GameState currentState;                         ///< The current state
-        std::chrono::steady_clock::time_point stateEnteredAt; ///< When current state was entered
-        Core::GameState pendingState;                         ///< The pending state
-        int pendingFrameCount = 0;                            ///< Debounce frame counter
-        std::vector<Core::StateTransition> transitionHistory; ///< Transition history
-        mutable Vision::TemplateMatcher templateMatcher;      ///< Template matcher for detection
+        std::shared_ptr<Core::StateRegistry> stateRegistry;     ///< Name <-> StateId mapping
+        std::vector<CompiledState> compiledStates;              ///< Per-state data indexed by StateId
+        TransitionGraph transitionGraph;                        ///< Compiled transitionsTo lists
+        Core::StateId initialState = Core::kInvalidStateId;     ///< Initial state ID
+
+        Core::StateId currentState = Core::kInvalidStateId;     ///< The current state
+        std::chrono::steady_clock::time_point stateEnteredAt;   ///< When current state was entered
+        Core::StateId pendingState = Core::kInvalidStateId;     ///< The pending state
+        int pendingFrameCount = 0;                              ///< Debounce frame counter
+        std::vector<Core::StateTransition> transitionHistory;   ///< Transition history
+        mutable Vision::TemplateMatcher templateMatcher;        ///< Template matcher for detection
+        Vision::ColorClassifier colorClassifier;                ///< All color_histogram ranges in one lookup table
+        mutable std::vector<ColorCounts> colorCounts;           ///< Per-ROI colour counts for the current frame
+        mutable std::vector<ScreenIntegrals> screenIntegrals;   ///< Per-screen integrals (buffers reused per frame)
+        bool useIntegrals = false;                              ///< Colour rules read several distinct ROIs
+        mutable std::vector<std::optional<double>> blockScores; ///< Last template/colour score per [state][screen]
+
+        mutable EvaluationStats lastEvaluationStats;    ///< Detection work during the last Update()
+        mutable EvaluationStats totalEvaluationStats;   ///< Detection work since the last Reset()
+        std::vector<const std::string *> intensityRois; ///< Top intensity_event ROI names in declaration order
 
         Vision::IntensityEventDetector
             topIntensityDetector;               ///< Tracks top-screen brightness for intensity_event method
         std::size_t raisesAtLastTransition = 0; ///< events_.size() baseline at last state transition
         uint64_t intensityFrameCounter = 0;     ///< Frame counter fed to IntensityEventDetector
+        std::optional<double> lastAverageV;     ///< Average V fed on the previous frame
+        std::optional<double> screenMeanV;      ///< Mean V of the whole top screen, for the next Update() only
+        const void *screenSource = nullptr;     ///< FrameStatistics::source of screenMeanV
+        uint64_t screenPixelCount = 0;          ///< FrameStatistics::pixelCount of screenMeanV
     };
 } // namespace SH3DS::FSM
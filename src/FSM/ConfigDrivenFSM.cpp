@@ -1,6 +1,6 @@
 #include "ConfigDrivenFSM.h"
 
-#include "Kappa/Logger.h"
+#include "Core/Logger.h"
 #include "Vision/TemplateMatcher.h"
 
 #include <opencv2/imgcodecs.hpp>
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "Core/StateRegistry.h"
 #include "Core/Types.h"
 
 #include <chrono>
+#include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace SH3DS::FSM
@@ -25,6 +28,35 @@ namespace SH3DS::FSM
         virtual std::optional<Core::StateTransition> Update(const Core::ROISet &topRois,
             const SH3DS::Core::ROISet &bottomRois) = 0;
 
+        /**
+         * @brief Updates the FSM with a frame that is unchanged since the previous Update().
+         *
+         * Time-based logic (debounce, stuck detection) still advances; implementations may reuse the previous
+         * frame's detection scores instead of re-evaluating the ROIs. The default simply calls Update().
+         *
+         * @param topRois The top ROISet of the previous frame.
+         * @param bottomRois The bottom ROISet of the previous frame.
+         * @return An optional containing the state transition if successful, an empty optional otherwise.
+         */
+        virtual std::optional<Core::StateTransition> UpdateUnchanged(const Core::ROISet &topRois,
+            const SH3DS::Core::ROISet &bottomRois)
+        {
+            return Update(topRois, bottomRois);
+        }
+
+        /**
+         * @brief Publishes statistics of the whole top screen the next Update()'s ROIs are cut from.
+         *
+         * Lets the FSM reuse measurements already taken by the pipeline instead of scanning the same pixels
+         * again. They apply to the next Update() only. The default ignores them.
+         *
+         * @param topStatistics Statistics of the warped (and corrected) top screen.
+         */
+        virtual void SetFrameStatistics(const Core::FrameStatistics &topStatistics)
+        {
+            (void)topStatistics;
+        }
+
         /**
          * @brief Resets the FSM.
          */
@@ -40,13 +72,28 @@ namespace SH3DS::FSM
          * @brief Gets the current state.
          * @return The current state.
          */
-        virtual const Core::GameState &GetCurrentState() const = 0;
+        virtual Core::StateId GetCurrentState() const = 0;
 
         /**
          * @brief Returns the initial state this FSM was built with.
          * @return The initial state ID.
          */
-        virtual const Core::GameState &GetInitialState() const = 0;
+        virtual Core::StateId GetInitialState() const = 0;
+
+        /**
+         * @brief Gets the registry that maps this FSM's state IDs to names.
+         * @return The state registry shared with strategies and the GUI.
+         */
+        virtual std::shared_ptr<const Core::StateRegistry> GetStateRegistry() const = 0;
+
+        /**
+         * @brief Resolves the current state to its name (for logging and display).
+         * @return The current state name.
+         */
+        const std::string &GetCurrentStateName() const
+        {
+            return GetStateRegistry()->Name(GetCurrentState());
+        }
 
         /**
          * @brief Gets the time in the current state.
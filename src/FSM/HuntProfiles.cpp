@@ -1,6 +1,7 @@
 #include "HuntProfiles.h"
 
 #include <stdexcept>
+#include <string_view>
 
 namespace SH3DS::FSM
 {
@@ -17,8 +18,39 @@ namespace SH3DS::FSM
             }
             return it->second;
         }
+
+        struct ProfileFactory
+        {
+            std::string_view name;                                                         ///< `hunt_profile` value
+            std::unique_ptr<CXXStateTreeFSM> (*create)(const Core::HuntDetectionParams &); ///< Builds the FSM
+        };
+
+        constexpr ProfileFactory kProfiles[] = {
+            { "xy_starter_sr", &HuntProfiles::CreateXYStarterSR },
+        };
     } // namespace
 
+    std::unique_ptr<CXXStateTreeFSM> HuntProfiles::Create(const std::string &profile,
+        const Core::HuntDetectionParams &params)
+    {
+        if (profile.empty())
+        {
+            throw std::runtime_error("HuntProfiles: the hunt config names no hunt_profile");
+        }
+
+        std::string known;
+        for (const auto &factory : kProfiles)
+        {
+            if (factory.name == profile)
+            {
+                return factory.create(params);
+            }
+            known += known.empty() ? "" : ", ";
+            known += factory.name;
+        }
+        throw std::runtime_error("HuntProfiles: unknown hunt_profile '" + profile + "' (known: " + known + ")");
+    }
+
     std::unique_ptr<CXXStateTreeFSM> HuntProfiles::CreateXYStarterSR(const Core::HuntDetectionParams &params)
     {
         CXXStateTreeFSM::Builder builder;
@@ -17,6 +17,19 @@ namespace SH3DS::FSM
     class HuntProfiles
     {
     public:
+        /**
+         * @brief Creates the FSM for the profile a hunt config names (`hunt_profile`).
+         *
+         * Known profiles: "xy_starter_sr" (CreateXYStarterSR).
+         *
+         * @param profile Profile name from the unified hunt config.
+         * @param params Detection parameters loaded from YAML.
+         * @return Configured FSM instance.
+         * @throws std::runtime_error if @p profile is empty or not a known profile.
+         */
+        static std::unique_ptr<CXXStateTreeFSM> Create(const std::string &profile,
+            const Core::HuntDetectionParams &params);
+
         /**
          * @brief Creates the XY Starter Soft Reset FSM.
          *
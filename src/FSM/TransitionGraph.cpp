@@ -0,0 +1,157 @@
+#include "TransitionGraph.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace SH3DS::FSM
+{
+    bool TransitionGraphReport::IsClean() const
+    {
+        return unreachable.empty() && deadEnds.empty() && undeclared.empty();
+    }
+
+    TransitionGraph::TransitionGraph(const std::vector<bool> &declared,
+        const std::vector<std::vector<Core::StateId>> &successors)
+        : stateCount(declared.size()),
+          rowWords((declared.size() + 63) / 64),
+          declaredFlags(declared.begin(), declared.end()),
+          adjacency(rowWords * stateCount, 0)
+    {
+        successorOffsets.reserve(stateCount + 1);
+        successorOffsets.push_back(0);
+        for (std::size_t from = 0; from < stateCount; ++from)
+        {
+            if (from < successors.size())
+            {
+                for (const Core::StateId to : successors[from])
+                {
+                    if (to >= stateCount)
+                    {
+                        continue;
+                    }
+                    adjacency[from * rowWords + to / 64] |= uint64_t{ 1 } << (to % 64);
+                    successorIds.push_back(to);
+                }
+            }
+            successorOffsets.push_back(static_cast<uint32_t>(successorIds.size()));
+        }
+
+        std::vector<Core::StateId> allDeclared;
+        for (std::size_t id = 0; id < stateCount; ++id)
+        {
+            if (declaredFlags[id])
+            {
+                allDeclared.push_back(static_cast<Core::StateId>(id));
+            }
+        }
+
+        candidateOffsets.reserve(stateCount + 1);
+        candidateOffsets.push_back(0);
+        for (std::size_t id = 0; id < stateCount; ++id)
+        {
+            const auto stateId = static_cast<Core::StateId>(id);
+            if (!declaredFlags[id])
+            {
+                candidateIds.insert(candidateIds.end(), allDeclared.begin(), allDeclared.end());
+            }
+            else
+            {
+                // Ascending ID order keeps the declaration-order tie-break of the detection loop.
+                for (const Core::StateId candidate : allDeclared)
+                {
+                    if (candidate == stateId || HasEdge(stateId, candidate))
+                    {
+                        candidateIds.push_back(candidate);
+                    }
+                }
+            }
+            candidateOffsets.push_back(static_cast<uint32_t>(candidateIds.size()));
+        }
+    }
+
+    std::size_t TransitionGraph::StateCount() const
+    {
+        return stateCount;
+    }
+
+    bool TransitionGraph::IsDeclared(Core::StateId id) const
+    {
+        return id < stateCount && declaredFlags[id] != 0;
+    }
+
+    bool TransitionGraph::HasEdge(Core::StateId from, Core::StateId to) const
+    {
+        if (from >= stateCount || to >= stateCount)
+        {
+            return false;
+        }
+        return (adjacency[from * rowWords + to / 64] >> (to % 64)) & 1u;
+    }
+
+    std::span<const Core::StateId> TransitionGraph::Successors(Core::StateId id) const
+    {
+        if (id >= stateCount)
+        {
+            return {};
+        }
+        return std::span<const Core::StateId>(successorIds)
+            .subspan(successorOffsets[id], successorOffsets[id + 1] - successorOffsets[id]);
+    }
+
+    std::span<const Core::StateId> TransitionGraph::Candidates(Core::StateId id) const
+    {
+        if (id >= stateCount)
+        {
+            return {};
+        }
+        return std::span<const Core::StateId>(candidateIds)
+            .subspan(candidateOffsets[id], candidateOffsets[id + 1] - candidateOffsets[id]);
+    }
+
+    TransitionGraphReport TransitionGraph::Validate(Core::StateId initial) const
+    {
+        TransitionGraphReport report;
+
+        // Walk the same edges the FSM can take at runtime: candidates of each visited state.
+        std::vector<bool> visited(stateCount, false);
+        std::queue<Core::StateId> frontier;
+        if (initial < stateCount)
+        {
+            visited[initial] = true;
+            frontier.push(initial);
+        }
+        while (!frontier.empty())
+        {
+            const Core::StateId id = frontier.front();
+            frontier.pop();
+            for (const Core::StateId next : Candidates(id))
+            {
+                if (!visited[next])
+                {
+                    visited[next] = true;
+                    frontier.push(next);
+                }
+            }
+        }
+
+        for (std::size_t id = 0; id < stateCount; ++id)
+        {
+            const auto stateId = static_cast<Core::StateId>(id);
+            if (!declaredFlags[id])
+            {
+                report.undeclared.push_back(stateId);
+                continue;
+            }
+            if (!visited[id])
+            {
+                report.unreachable.push_back(stateId);
+            }
+            if (Successors(stateId).empty())
+            {
+                report.deadEnds.push_back(stateId);
+            }
+        }
+
+        return report;
+    }
+} // namespace SH3DS::FSM
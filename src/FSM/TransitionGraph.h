@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Core/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SH3DS::FSM
+{
+    /**
+     * @brief Structural problems found in a transition graph.
+     */
+    struct TransitionGraphReport
+    {
+        std::vector<Core::StateId> unreachable; ///< Declared states not reachable from the initial state
+        std::vector<Core::StateId> deadEnds;    ///< Declared states with no outgoing transitions
+        std::vector<Core::StateId> undeclared;  ///< Referenced states that have no StateConfig
+
+        /**
+         * @brief Returns true if no problems were found.
+         * @return True if all lists are empty.
+         */
+        bool IsClean() const;
+    };
+
+    /**
+     * @brief Dense, immutable transition graph compiled once from the FSM's transitionsTo lists.
+     *
+     * Holds an adjacency bitset for O(1) legality checks and flat per-state index tables for
+     * successor and candidate enumeration, so the per-frame path never builds or searches lists.
+     */
+    class TransitionGraph
+    {
+    public:
+        TransitionGraph() = default;
+
+        /**
+         * @brief Compiles the graph.
+         * @param declared For each StateId, whether it has a StateConfig (size = number of interned states).
+         * @param successors For each StateId, its allowed targets (undeclared states have none).
+         */
+        TransitionGraph(const std::vector<bool> &declared, const std::vector<std::vector<Core::StateId>> &successors);
+
+        /**
+         * @brief Returns the number of states (declared or not) the graph covers.
+         * @return The state count.
+         */
+        std::size_t StateCount() const;
+
+        /**
+         * @brief Returns true if the state has a StateConfig.
+         * @param id The state ID.
+         * @return True if declared.
+         */
+        bool IsDeclared(Core::StateId id) const;
+
+        /**
+         * @brief Returns true if `from` lists `to` as an allowed target.
+         * @param from Source state ID.
+         * @param to Target state ID.
+         * @return True if the edge exists.
+         */
+        bool HasEdge(Core::StateId from, Core::StateId to) const;
+
+        /**
+         * @brief Returns the allowed targets of a state, in declaration order.
+         * @param id The state ID.
+         * @return Successor IDs (empty for terminal or undeclared states).
+         */
+        std::span<const Core::StateId> Successors(Core::StateId id) const;
+
+        /**
+         * @brief Returns the declared states worth evaluating while the FSM is in `id`, in ascending ID order.
+         *
+         * A declared state yields itself plus its declared successors; an undeclared state is unconstrained
+         * and yields every declared state.
+         * @param id The current state ID.
+         * @return Candidate state IDs.
+         */
+        std::span<const Core::StateId> Candidates(Core::StateId id) const;
+
+        /**
+         * @brief Checks the graph for unreachable states, dead ends and undeclared targets.
+         * @param initial The initial state ID.
+         * @return The validation report.
+         */
+        TransitionGraphReport Validate(Core::StateId initial) const;
+
+    private:
+        std::size_t stateCount = 0;              ///< Number of states covered
+        std::size_t rowWords = 0;                ///< 64-bit words per adjacency row
+        std::vector<uint8_t> declaredFlags;      ///< 1 if the state has a StateConfig
+        std::vector<uint64_t> adjacency;         ///< stateCount x stateCount bit matrix
+        std::vector<uint32_t> successorOffsets;  ///< CSR offsets into successorIds (stateCount + 1)
+        std::vector<Core::StateId> successorIds; ///< Flattened successor lists
+        std::vector<uint32_t> candidateOffsets;  ///< CSR offsets into candidateIds (stateCount + 1)
+        std::vector<Core::StateId> candidateIds; ///< Flattened candidate lists
+    };
+} // namespace SH3DS::FSM
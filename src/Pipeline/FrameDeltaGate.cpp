@@ -0,0 +1,84 @@
+#include "FrameDeltaGate.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace SH3DS::Pipeline
+{
+    namespace
+    {
+        constexpr int kCellSize = 8; ///< Thumbnail cell edge in screen pixels
+    } // namespace
+
+    FrameDeltaGate::FrameDeltaGate(double threshold) : threshold(threshold)
+    {
+    }
+
+    bool FrameDeltaGate::Update(const cv::Mat &warpedTop, const cv::Mat &warpedBottom)
+    {
+        ++frames;
+        if (threshold <= 0.0)
+        {
+            return true;
+        }
+
+        Shrink(warpedTop, topCurrent);
+        Shrink(warpedBottom, bottomCurrent);
+        if (!Differs(topReference, topCurrent) && !Differs(bottomReference, bottomCurrent))
+        {
+            ++unchanged;
+            return false;
+        }
+
+        // The changed frame becomes the new reference; the old reference buffers are reused next frame.
+        std::swap(topReference, topCurrent);
+        std::swap(bottomReference, bottomCurrent);
+        return true;
+    }
+
+    uint64_t FrameDeltaGate::Frames() const
+    {
+        return frames;
+    }
+
+    uint64_t FrameDeltaGate::UnchangedFrames() const
+    {
+        return unchanged;
+    }
+
+    double FrameDeltaGate::SkipRate() const
+    {
+        return frames == 0 ? 0.0 : static_cast<double>(unchanged) / static_cast<double>(frames);
+    }
+
+    void FrameDeltaGate::Reset()
+    {
+        topReference.release();
+        bottomReference.release();
+        frames = 0;
+        unchanged = 0;
+    }
+
+    void FrameDeltaGate::Shrink(const cv::Mat &screen, cv::Mat &thumbnail)
+    {
+        if (screen.empty())
+        {
+            thumbnail.release();
+            return;
+        }
+
+        const cv::Size size(std::max(screen.cols / kCellSize, 1), std::max(screen.rows / kCellSize, 1));
+        cv::resize(screen, thumbnail, size, 0.0, 0.0, cv::INTER_AREA);
+    }
+
+    bool FrameDeltaGate::Differs(const cv::Mat &reference, const cv::Mat &current) const
+    {
+        if (reference.size() != current.size() || reference.type() != current.type())
+        {
+            return true;
+        }
+        return !current.empty() && cv::norm(reference, current, cv::NORM_INF) > threshold;
+    }
+} // namespace SH3DS::Pipeline
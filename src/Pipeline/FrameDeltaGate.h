@@ -0,0 +1,81 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+
+namespace SH3DS::Pipeline
+{
+    /**
+     * @brief Decides whether a warped frame differs enough from the last processed one to be worth analysing.
+     *
+     * Each screen is shrunk to a thumbnail of 8x8 pixel cell averages (which also averages out camera noise) and
+     * compared against the thumbnail of the last frame that was reported as changed. A frame is unchanged when no
+     * cell channel moved by more than the threshold. Comparing against the last processed frame rather than the
+     * previous one means a slow fade still trips the gate once it has drifted far enough.
+     */
+    class FrameDeltaGate
+    {
+    public:
+        /**
+         * @brief Constructs the gate.
+         * @param threshold Largest per-cell change (0-255) still treated as unchanged; 0 or less disables the gate.
+         */
+        explicit FrameDeltaGate(double threshold);
+
+        /**
+         * @brief Feeds one warped frame.
+         * @param warpedTop Warped top screen.
+         * @param warpedBottom Warped bottom screen (may be empty).
+         * @return True if the frame must be analysed, false if the last processed frame's results still hold.
+         */
+        bool Update(const cv::Mat &warpedTop, const cv::Mat &warpedBottom);
+
+        /**
+         * @brief Returns the number of frames fed to Update().
+         * @return Frame count.
+         */
+        uint64_t Frames() const;
+
+        /**
+         * @brief Returns the number of frames reported as unchanged.
+         * @return Unchanged frame count.
+         */
+        uint64_t UnchangedFrames() const;
+
+        /**
+         * @brief Returns the fraction of frames whose analysis was skipped.
+         * @return Unchanged frames divided by frames (0 before the first frame).
+         */
+        double SkipRate() const;
+
+        /**
+         * @brief Forgets the reference frame and counters; the next Update() reports a change.
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Shrinks a screen to its cell-average thumbnail.
+         * @param screen The warped screen (may be empty).
+         * @param thumbnail Output thumbnail (released if the screen is empty).
+         */
+        static void Shrink(const cv::Mat &screen, cv::Mat &thumbnail);
+
+        /**
+         * @brief Checks whether a thumbnail moved past the threshold relative to its reference.
+         * @param reference Thumbnail of the last processed frame.
+         * @param current Thumbnail of the new frame.
+         * @return True if the screen changed.
+         */
+        bool Differs(const cv::Mat &reference, const cv::Mat &current) const;
+
+        double threshold;        ///< Largest per-cell change treated as unchanged (<= 0 = disabled)
+        cv::Mat topReference;    ///< Top thumbnail of the last processed frame
+        cv::Mat bottomReference; ///< Bottom thumbnail of the last processed frame
+        cv::Mat topCurrent;      ///< Top thumbnail of the frame being checked (buffer reused)
+        cv::Mat bottomCurrent;   ///< Bottom thumbnail of the frame being checked (buffer reused)
+        uint64_t frames = 0;     ///< Frames fed to Update()
+        uint64_t unchanged = 0;  ///< Frames reported as unchanged
+    };
+} // namespace SH3DS::Pipeline
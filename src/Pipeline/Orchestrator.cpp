@@ -1,13 +1,29 @@
 #include "Orchestrator.h"
 
-#include "Kappa/Logger.h"
+#include "Core/HotLog.h"
+#include "Core/Logger.h"
 #include "Vision/ColorImprovement.h"
+#include "Vision/FrameStatistics.h"
 
+#include <algorithm>
 #include <chrono>
+#include <string_view>
 #include <thread>
+#include <utility>
 
 namespace SH3DS::Pipeline
 {
+    namespace
+    {
+        template<size_t N>
+        void CopyText(std::array<char, N> &target, std::string_view text)
+        {
+            const size_t length = std::min(text.size(), N - 1);
+            std::copy_n(text.data(), length, target.data());
+            target[length] = '\0';
+        }
+    } // namespace
+
     Orchestrator::Orchestrator(std::unique_ptr<Capture::FrameSource> frameSource,
         std::unique_ptr<Capture::ScreenDetector> screenDetector,
         std::unique_ptr<Capture::FramePreprocessor> preprocessor,
@@ -23,8 +39,21 @@ namespace SH3DS::Pipeline
           detector(std::move(detector)),
           strategy(std::move(strategy)),
           input(std::move(input)),
-          config(std::move(config))
+          config(std::move(config)),
+          shinyCheck(this->config.shinyRoi,
+              this->config.shinyCheckState.empty() || !this->fsm
+                  ? Core::kInvalidStateId
+                  : this->fsm->GetStateRegistry()->Find(this->config.shinyCheckState),
+              std::chrono::milliseconds(this->config.shinyCheckDelayMs),
+              this->config.shinyCheckFrames),
+          frameDelta(this->config.frameDeltaThreshold)
     {
+        if (!this->config.shinyCheckState.empty() && this->fsm
+            && this->fsm->GetStateRegistry()->Find(this->config.shinyCheckState) == Core::kInvalidStateId)
+        {
+            LOG_WARN("Orchestrator: shiny check state '{}' is not known to the FSM; detecting every frame",
+                this->config.shinyCheckState);
+        }
     }
 
     void Orchestrator::Run()
@@ -98,10 +127,14 @@ namespace SH3DS::Pipeline
         }
 
         const auto finalStats = Stats();
-        LOG_INFO("Orchestrator stopped. Final stats: {} encounters, {} shinies, {} watchdog stuck events",
+        LOG_INFO("Orchestrator stopped. Final stats: {} encounters, {} shinies, {} watchdog stuck events, "
+                 "{}/{} unchanged frames skipped ({:.1f}%)",
             finalStats.encounters,
             finalStats.shiniesFound,
-            finalStats.watchdogRecoveries);
+            finalStats.watchdogRecoveries,
+            finalStats.unchangedFrames,
+            finalStats.frames,
+            frameDelta.SkipRate() * 100.0);
     }
 
     void Orchestrator::Stop()
@@ -113,77 +146,119 @@ namespace SH3DS::Pipeline
     {
         auto stats = strategy->Stats();
         stats.watchdogRecoveries += watchdogStuckCount;
+        stats.frames = frameDelta.Frames();
+        stats.unchangedFrames = frameDelta.UnchangedFrames();
         return stats;
     }
 
     void Orchestrator::MainLoopTick()
     {
-        LOG_DEBUG("Orchestrator: Grabbing frame...");
+        HOT_LOG_DEBUG("Orchestrator: Grabbing frame...");
 
-        auto frame = frameSource->Grab();
-        if (!frame.has_value())
+        if (!frameSource->GrabInto(currentFrame))
         {
-            LOG_TRACE("Orchestrator: frameSource->Grab() returned nullopt (exhausted or timeout).");
+            HOT_LOG_TRACE("Orchestrator: frameSource->GrabInto() returned false (exhausted or timeout).");
             return;
         }
 
+        // Screen detection needs whole frames: if the screens were reset while the source crops, start over
+        if (screenDetector && !screenDetector->IsCalibrated() && cropHintSet)
+        {
+            UpdateCropHint();
+            if (currentFrame.metadata.cropOrigin != cv::Point())
+            {
+                return;
+            }
+        }
+
+        preprocessor->SetFrameOrigin(currentFrame.metadata.cropOrigin);
         if (screenDetector)
         {
-            screenDetector->ApplyTo(*preprocessor, frame->image);
+            screenDetector->ApplyTo(*preprocessor, currentFrame.image);
         }
 
-        LOG_DEBUG("Orchestrator: Processing frame #{}...", frame->metadata.sequenceNumber);
+        HOT_LOG_DEBUG("Orchestrator: Processing frame #{}...", currentFrame.metadata.sequenceNumber);
 
-        auto dualScreenResult = preprocessor->ProcessDualScreen(frame->image);
-        if (!dualScreenResult.has_value())
+        if (!preprocessor->ProcessDualScreen(currentFrame.image, warpedScreens))
         {
-            LOG_DEBUG("Orchestrator: Screen not detected in frame #{}", frame->metadata.sequenceNumber);
+            HOT_LOG_DEBUG("Orchestrator: Screen not detected in frame #{}", currentFrame.metadata.sequenceNumber);
             return;
         }
+        UpdateCropHint();
 
-        // Apply color correction to the full warped top image before ROI extraction so that
-        // Gray World WB has the complete scene to compute balanced gains. Bottom screen is
-        // LCD-rendered UI — WB correction is not applied.
-        if (!dualScreenResult->warpedTop.empty()) [[likely]]
+        // Title screens and dialogue waits repeat the same picture for seconds. Such frames skip colour correction
+        // and ROI extraction, and the FSM and detector get the last analysed frame's ROIs to reuse their scores.
+        const bool unchanged =
+            !frameDelta.Update(warpedScreens.warpedTop, warpedScreens.warpedBottom) && lastScreens.has_value();
+        if (!unchanged)
         {
-            dualScreenResult->warpedTop = Vision::ImproveFrameColors(dualScreenResult->warpedTop);
-            preprocessor->ReextractRois(*dualScreenResult);
+            // Apply color correction to the full warped top image before ROI extraction so that
+            // Gray World WB has the complete scene to compute balanced gains. Bottom screen is
+            // LCD-rendered UI — WB correction is not applied.
+            // One statistics pass feeds Gray World; the correction's last pass refreshes them for the FSM.
+            if (!warpedScreens.warpedTop.empty()) [[likely]]
+            {
+                Vision::ComputeFrameStatistics(warpedScreens.warpedTop, warpedScreens.topStatistics);
+                Vision::ImproveFrameColorsInto(
+                    warpedScreens.warpedTop, warpedScreens.warpedTop, warpedScreens.topStatistics, colorBuffers);
+                preprocessor->ReextractRois(warpedScreens);
+            }
+
+            // The previous analysis becomes next tick's warp target, so the two results trade buffers forever.
+            if (!lastScreens.has_value())
+            {
+                lastScreens.emplace();
+            }
+            std::swap(*lastScreens, warpedScreens);
         }
+        const auto &screens = *lastScreens;
 
-        LOG_DEBUG("Orchestrator: Updating FSM...");
+        HOT_LOG_DEBUG("Orchestrator: Updating FSM{}...", unchanged ? " (unchanged frame)" : "");
 
-        auto transition = fsm->Update(dualScreenResult->topRois, dualScreenResult->bottomRois);
+        std::optional<Core::StateTransition> transition;
+        if (unchanged)
+        {
+            transition = fsm->UpdateUnchanged(screens.topRois, screens.bottomRois);
+        }
+        else
+        {
+            fsm->SetFrameStatistics(screens.topStatistics);
+            transition = fsm->Update(screens.topRois, screens.bottomRois);
+        }
         if (transition.has_value())
         {
-            LOG_INFO(
-                "Frame #{}: FSM Transition {} -> {}", frame->metadata.sequenceNumber, transition->from, transition->to);
+            const auto states = fsm->GetStateRegistry();
+            LOG_INFO("Frame #{}: FSM Transition {} -> {}",
+                currentFrame.metadata.sequenceNumber,
+                states->Name(transition->from),
+                states->Name(transition->to));
         }
 
-        LOG_DEBUG("Orchestrator: Detecting shiny...");
+        HOT_LOG_DEBUG("Orchestrator: Detecting shiny...");
 
+        // Outside the check window the detector does not run at all; inside it, one DetectSequence over a burst.
         std::optional<Core::ShinyResult> shinyResult;
         if (detector)
         {
-            auto spriteIt = dualScreenResult->topRois.find(config.shinyRoi);
-            if (spriteIt != dualScreenResult->topRois.end() && !spriteIt->second.empty())
-            {
-                shinyResult = detector->Detect(spriteIt->second);
-            }
+            shinyResult = shinyCheck.Update(
+                *detector, fsm->GetCurrentState(), fsm->GetTimeInCurrentState(), screens.topRois, unchanged);
         }
 
-        LOG_DEBUG("Orchestrator: Strategy tick (current state: {})...", fsm->GetCurrentState());
+        HOT_LOG_DEBUG("Orchestrator: Strategy tick (current state: {})...", fsm->GetCurrentStateName());
 
         const auto strategyDecision = strategy->Tick(fsm->GetCurrentState(), fsm->GetTimeInCurrentState(), shinyResult);
 
-        LOG_DEBUG("Orchestrator: Executing decision...");
+        PublishFrame(currentFrame, screens, unchanged, shinyResult);
+
+        HOT_LOG_DEBUG("Orchestrator: Executing decision...");
 
         ExecuteDecision(strategyDecision);
 
-        LOG_DEBUG("Orchestrator: Watchdog handling...");
+        HOT_LOG_DEBUG("Orchestrator: Watchdog handling...");
 
         HandleWatchdog();
 
-        LOG_DEBUG("Orchestrator: MainLoopTick complete.");
+        HOT_LOG_DEBUG("Orchestrator: MainLoopTick complete.");
     }
 
     void Orchestrator::HandleWatchdog()
@@ -192,17 +267,115 @@ namespace SH3DS::Pipeline
         {
             ++watchdogStuckCount;
             LOG_WARN("Watchdog: FSM stuck in state '{}' for {}ms",
-                fsm->GetCurrentState(),
+                fsm->GetCurrentStateName(),
                 fsm->GetTimeInCurrentState().count());
             LOG_ERROR("ABORT: watchdog detected stuck FSM state");
             Stop();
         }
     }
 
+    void Orchestrator::UpdateCropHint()
+    {
+        if (config.cropMargin < 0 || !frameSource)
+        {
+            return;
+        }
+
+        const bool locked = !screenDetector || screenDetector->IsCalibrated();
+        if (locked == cropHintSet)
+        {
+            return;
+        }
+        cropHintSet = locked;
+
+        if (!locked)
+        {
+            frameSource->SetCropHint(std::nullopt);
+            LOG_INFO("Orchestrator: screen calibration reset; capturing full frames");
+            return;
+        }
+
+        const cv::Rect bounds = preprocessor->ScreenBounds();
+        const int margin = config.cropMargin;
+        const cv::Rect region(
+            bounds.x - margin, bounds.y - margin, bounds.width + 2 * margin, bounds.height + 2 * margin);
+        frameSource->SetCropHint(region);
+        LOG_INFO("Orchestrator: capture cropped to {}x{} at ({}, {}) around the calibrated screens",
+            region.width,
+            region.height,
+            region.x,
+            region.y);
+    }
+
+    void Orchestrator::PublishFrame(const Core::Frame &frame,
+        const Capture::DualScreenResult &screens,
+        bool unchanged,
+        const std::optional<Core::ShinyResult> &shinyResult)
+    {
+        if (config.sharedMemoryName.empty() || frameRingFailed)
+        {
+            return;
+        }
+
+        const std::array<cv::Mat, kSharedImageCount> images = { frame.image, screens.warpedTop, screens.warpedBottom };
+        if (!frameRing)
+        {
+            // Size the raw slot for the uncropped source frame: the first publish may already be cropped, and a
+            // later full frame (crop hint cleared) must still fit.
+            size_t imageCapacity = static_cast<size_t>(std::max(frame.metadata.sourceWidth, 0))
+                                   * static_cast<size_t>(std::max(frame.metadata.sourceHeight, 0))
+                                   * frame.image.elemSize();
+            for (const auto &image : images)
+            {
+                imageCapacity = std::max(imageCapacity, image.total() * image.elemSize());
+            }
+            try
+            {
+                frameRing = SharedFrameRingWriter::CreateSharedFrameRingWriter(config.sharedMemoryName,
+                    static_cast<size_t>(std::max(config.sharedMemorySlots, 2)),
+                    imageCapacity);
+                LOG_INFO("Orchestrator: publishing frames to shared memory '{}'", config.sharedMemoryName);
+            }
+            catch (const std::exception &e)
+            {
+                LOG_ERROR("Orchestrator: shared-memory publishing disabled: {}", e.what());
+                frameRingFailed = true;
+                return;
+            }
+        }
+
+        FrameTelemetry telemetry;
+        telemetry.sequenceNumber = frame.metadata.sequenceNumber;
+        telemetry.captureTimeNs =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(frame.metadata.captureTime.time_since_epoch()).count();
+        telemetry.stateId = fsm->GetCurrentState();
+        CopyText(telemetry.stateName, fsm->GetCurrentStateName());
+        telemetry.timeInStateMs = fsm->GetTimeInCurrentState().count();
+        telemetry.unchanged = unchanged ? 1 : 0;
+        if (shinyResult.has_value())
+        {
+            telemetry.hasShinyResult = 1;
+            telemetry.verdict = shinyResult->verdict;
+            telemetry.confidence = shinyResult->confidence;
+            CopyText(telemetry.method, shinyResult->method);
+        }
+        telemetry.encounters = strategy->Stats().encounters;
+
+        frameRing->Publish(telemetry, images);
+    }
+
     void Orchestrator::ExecuteDecision(const Strategy::StrategyDecision &strategyDecision)
     {
         const auto &decision = strategyDecision.decision;
         const auto &command = strategyDecision.command;
+        // Decisions carry a StateId rather than a formatted name; resolve it only for the lines that are logged.
+        const auto stateName = [&]() -> std::string_view {
+            if (decision.state == Core::kInvalidStateId)
+            {
+                return {};
+            }
+            return fsm->GetStateRegistry()->Name(decision.state);
+        };
 
         switch (decision.action)
         {
@@ -216,11 +389,11 @@ namespace SH3DS::Pipeline
                     input->ReleaseAll();
                 }
             }
-            LOG_DEBUG("Input: {} (buttons=0x{:04X})", decision.reason, command.buttonsPressed);
+            LOG_DEBUG("Input: {} {} (buttons=0x{:04X})", decision.reason, stateName(), command.buttonsPressed);
             break;
 
         case Core::HuntAction::AlertShiny:
-            LOG_ERROR("*** SHINY FOUND! *** {}", decision.reason);
+            LOG_ERROR("*** SHINY FOUND! *** {} in {}", decision.reason, stateName());
             Stop();
             break;
 
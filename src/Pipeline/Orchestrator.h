@@ -7,11 +7,16 @@
 #include "Core/Types.h"
 #include "FSM/GameStateFSM.h"
 #include "Input/InputAdapter.h"
+#include "Pipeline/FrameDeltaGate.h"
+#include "Pipeline/SharedFrameRing.h"
+#include "Pipeline/ShinyCheckScheduler.h"
 #include "Strategy/HuntStrategy.h"
+#include "Vision/ColorImprovement.h"
 #include "Vision/ShinyDetector.h"
 
 #include <atomic>
 #include <memory>
+#include <optional>
 
 namespace SH3DS::Pipeline
 {
@@ -52,7 +57,7 @@ namespace SH3DS::Pipeline
         void Stop();
 
         /**
-         * @brief Returns accumulated hunt statistics.
+         * @brief Returns accumulated hunt statistics, including the frame-delta gate's skip counts.
          * @return Hunt statistics snapshot.
          */
         Core::HuntStatistics Stats() const;
@@ -60,6 +65,9 @@ namespace SH3DS::Pipeline
     private:
         /**
          * @brief Executes one iteration of the main loop.
+         *
+         * Every per-frame image lives in a member (currentFrame, warpedScreens, lastScreens, colorBuffers) and is
+         * overwritten in place, so once the first frames have sized the buffers a steady-state tick allocates none.
          */
         void MainLoopTick();
 
@@ -74,6 +82,30 @@ namespace SH3DS::Pipeline
          */
         void ExecuteDecision(const Strategy::StrategyDecision &strategyDecision);
 
+        /**
+         * @brief Keeps the frame source's crop hint in step with screen calibration.
+         *
+         * Once the screens are calibrated (or fixed by configuration) the source is asked for their bounding box plus
+         * OrchestratorConfig::cropMargin; if the screen detector is reset, full frames are requested again.
+         */
+        void UpdateCropHint();
+
+        /**
+         * @brief Publishes the frame and its telemetry to the shared-memory ring, if one is configured.
+         *
+         * The ring is created on the first call, sized for that frame's images. If it cannot be created the error is
+         * logged once and publishing stays off.
+         *
+         * @param frame The grabbed frame.
+         * @param screens The analysed screens used this tick.
+         * @param unchanged Whether the last analysis was reused.
+         * @param shinyResult This tick's detection result, if any.
+         */
+        void PublishFrame(const Core::Frame &frame,
+            const Capture::DualScreenResult &screens,
+            bool unchanged,
+            const std::optional<Core::ShinyResult> &shinyResult);
+
         std::unique_ptr<Capture::FrameSource> frameSource;        ///< Frame acquisition source
         std::unique_ptr<Capture::ScreenDetector> screenDetector;  ///< Automatic screen corner detection
         std::unique_ptr<Capture::FramePreprocessor> preprocessor; ///< Perspective warp and ROI extraction
@@ -82,6 +114,15 @@ namespace SH3DS::Pipeline
         std::unique_ptr<Strategy::HuntStrategy> strategy;         ///< Hunt strategy
         std::unique_ptr<Input::InputAdapter> input;               ///< Input adapter for 3DS injection
         Core::OrchestratorConfig config;                          ///< Runtime configuration
+        ShinyCheckScheduler shinyCheck;                           ///< Gates and batches shiny detection
+        FrameDeltaGate frameDelta;                                ///< Skips analysis of unchanged frames
+        Core::Frame currentFrame;                                 ///< Grab target, reused every tick
+        Capture::DualScreenResult warpedScreens;                  ///< Warp target, swapped with lastScreens
+        std::optional<Capture::DualScreenResult> lastScreens;     ///< Last analysed frame, reused while unchanged
+        Vision::ColorImprovementBuffers colorBuffers;             ///< Colour-correction intermediates
+        std::unique_ptr<SharedFrameRingWriter> frameRing;         ///< Viewer ring (created on first publish)
+        bool frameRingFailed = false;                             ///< Ring creation failed; publishing is off
+        bool cropHintSet = false;                                 ///< Whether the source was asked to crop
         std::atomic<bool> running = false;                        ///< Whether the main loop is running
         uint64_t watchdogStuckCount = 0;                          ///< Number of stuck detections
     };
@@ -0,0 +1,383 @@
+#include "SharedFrameRing.h"
+
+#include "Core/Logger.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SH3DS::Pipeline
+{
+    namespace
+    {
+        constexpr std::array<char, 8> kMagic = { 'S', 'H', '3', 'D', 'S', 'R', 'N', 'G' };
+        constexpr uint32_t kLayoutVersion = 1;
+        constexpr size_t kAlignment = 64; ///< Cache line; keeps slot counters and pixel rows apart
+        constexpr int kMaxReadAttempts = 8;
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+            "counters shared between processes must be lock-free");
+        static_assert(std::is_trivially_copyable_v<FrameTelemetry>);
+
+        struct ImageHeader
+        {
+            int32_t rows = 0; ///< 0 if the slot carries no image
+            int32_t cols = 0; ///< Columns
+            int32_t type = 0; ///< OpenCV type; rows are stored packed
+        };
+
+        struct alignas(kAlignment) RingHeader
+        {
+            std::atomic<uint32_t> version{ 0 };  ///< kLayoutVersion once the writer finished initialising
+            std::array<char, 8> magic{};         ///< kMagic
+            uint32_t slotCount = 0;              ///< Number of slots
+            uint64_t imageCapacity = 0;          ///< Bytes reserved per image (multiple of kAlignment)
+            uint64_t slotStride = 0;             ///< Bytes between slot starts
+            std::atomic<uint64_t> published{ 0 }; ///< Frames published so far
+        };
+
+        struct alignas(kAlignment) SlotHeader
+        {
+            std::atomic<uint64_t> sequence{ 0 };               ///< Odd while the slot is being written
+            uint64_t publication = 0;                          ///< Publication number of the slot's frame
+            FrameTelemetry telemetry;                          ///< Telemetry of the slot's frame
+            std::array<ImageHeader, kSharedImageCount> images; ///< Geometry of the slot's images
+        };
+
+        size_t AlignUp(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        RingHeader *Header(void *mapping)
+        {
+            return static_cast<RingHeader *>(mapping);
+        }
+
+        SlotHeader *Slot(void *mapping, size_t index)
+        {
+            auto *bytes = static_cast<std::byte *>(mapping) + sizeof(RingHeader) + index * Header(mapping)->slotStride;
+            return reinterpret_cast<SlotHeader *>(bytes);
+        }
+
+        std::byte *ImageData(SlotHeader *slot, size_t image, size_t imageCapacity)
+        {
+            return reinterpret_cast<std::byte *>(slot) + sizeof(SlotHeader) + image * imageCapacity;
+        }
+
+#if defined(__unix__) || defined(__APPLE__)
+        std::runtime_error SystemError(const std::string &what, const std::string &name)
+        {
+            return std::runtime_error(what + " '" + name + "': " + std::strerror(errno));
+        }
+
+        void *CreateMapping(const std::string &name, size_t size)
+        {
+            shm_unlink(name.c_str()); // a crashed writer may have left its segment behind
+            const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (fd < 0)
+            {
+                throw SystemError("Cannot create shared memory", name);
+            }
+            if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                const auto error = SystemError("Cannot size shared memory", name);
+                close(fd);
+                shm_unlink(name.c_str());
+                throw error;
+            }
+            void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (mapping == MAP_FAILED)
+            {
+                const auto error = SystemError("Cannot map shared memory", name);
+                shm_unlink(name.c_str());
+                throw error;
+            }
+            return mapping;
+        }
+
+        void *OpenMapping(const std::string &name, size_t &size)
+        {
+            const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+            {
+                throw SystemError("Cannot open shared memory", name);
+            }
+            struct stat status{};
+            if (fstat(fd, &status) != 0)
+            {
+                const auto error = SystemError("Cannot stat shared memory", name);
+                close(fd);
+                throw error;
+            }
+            size = static_cast<size_t>(status.st_size);
+            if (size < sizeof(RingHeader))
+            {
+                close(fd);
+                throw std::runtime_error("Shared memory '" + name + "' is not a frame ring");
+            }
+            void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (mapping == MAP_FAILED)
+            {
+                throw SystemError("Cannot map shared memory", name);
+            }
+            return mapping;
+        }
+
+        void Unmap(void *mapping, size_t size)
+        {
+            munmap(mapping, size);
+        }
+
+        void Unlink(const std::string &name)
+        {
+            shm_unlink(name.c_str());
+        }
+#else
+        void *CreateMapping(const std::string &, size_t)
+        {
+            throw std::runtime_error("Shared frame rings need POSIX shared memory");
+        }
+
+        void *OpenMapping(const std::string &, size_t &)
+        {
+            throw std::runtime_error("Shared frame rings need POSIX shared memory");
+        }
+
+        void Unmap(void *, size_t)
+        {
+        }
+
+        void Unlink(const std::string &)
+        {
+        }
+#endif
+    } // namespace
+
+    SharedFrameRingWriter::SharedFrameRingWriter(std::string name, size_t slotCount, size_t imageCapacity)
+        : name(std::move(name))
+    {
+        if (slotCount < 2)
+        {
+            throw std::runtime_error("A shared frame ring needs at least 2 slots");
+        }
+
+        const size_t capacity = AlignUp(imageCapacity, kAlignment);
+        const size_t slotStride = sizeof(SlotHeader) + kSharedImageCount * capacity;
+        mappingSize = sizeof(RingHeader) + slotCount * slotStride;
+        mapping = CreateMapping(this->name, mappingSize);
+
+        auto *header = new (mapping) RingHeader{};
+        header->magic = kMagic;
+        header->slotCount = static_cast<uint32_t>(slotCount);
+        header->imageCapacity = capacity;
+        header->slotStride = slotStride;
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            new (Slot(mapping, i)) SlotHeader{};
+        }
+        header->version.store(kLayoutVersion, std::memory_order_release);
+    }
+
+    SharedFrameRingWriter::~SharedFrameRingWriter()
+    {
+        Unmap(mapping, mappingSize);
+        Unlink(name);
+    }
+
+    std::unique_ptr<SharedFrameRingWriter> SharedFrameRingWriter::CreateSharedFrameRingWriter(std::string name,
+        size_t slotCount,
+        size_t imageCapacity)
+    {
+        return std::make_unique<SharedFrameRingWriter>(std::move(name), slotCount, imageCapacity);
+    }
+
+    bool SharedFrameRingWriter::Publish(const FrameTelemetry &telemetry,
+        const std::array<cv::Mat, kSharedImageCount> &images)
+    {
+        bool complete = true;
+        auto *header = Header(mapping);
+        const size_t capacity = header->imageCapacity;
+        auto *slot = Slot(mapping, published % header->slotCount);
+
+        // Seqlock write: odd counter, then the payload, then the next even counter
+        const uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot->publication = published + 1;
+        slot->telemetry = telemetry;
+        for (size_t i = 0; i < kSharedImageCount; ++i)
+        {
+            const cv::Mat &image = images[i];
+            const size_t rowBytes = image.empty() ? 0 : static_cast<size_t>(image.cols) * image.elemSize();
+            if (image.empty())
+            {
+                slot->images[i] = {};
+                continue;
+            }
+            if (rowBytes * static_cast<size_t>(image.rows) > capacity || image.dims > 2)
+            {
+                LOG_WARN("SharedFrameRing '{}': frame {} image {} ({}x{}, {} bytes) exceeds the {}-byte slot; "
+                         "published empty",
+                    name,
+                    telemetry.sequenceNumber,
+                    i,
+                    image.cols,
+                    image.rows,
+                    rowBytes * static_cast<size_t>(image.rows),
+                    capacity);
+                slot->images[i] = {};
+                complete = false;
+                continue;
+            }
+
+            std::byte *data = ImageData(slot, i, capacity);
+            if (image.isContinuous())
+            {
+                std::memcpy(data, image.data, rowBytes * static_cast<size_t>(image.rows));
+            }
+            else
+            {
+                for (int y = 0; y < image.rows; ++y)
+                {
+                    std::memcpy(data + static_cast<size_t>(y) * rowBytes, image.ptr(y), rowBytes);
+                }
+            }
+            slot->images[i] = { .rows = image.rows, .cols = image.cols, .type = image.type() };
+        }
+
+        slot->sequence.store(sequence + 2, std::memory_order_release);
+        header->published.store(++published, std::memory_order_release);
+        return complete;
+    }
+
+    uint64_t SharedFrameRingWriter::Published() const
+    {
+        return published;
+    }
+
+    size_t SharedFrameRingWriter::ImageCapacity() const
+    {
+        return Header(mapping)->imageCapacity;
+    }
+
+    SharedFrameRingReader::SharedFrameRingReader(const std::string &name)
+    {
+        mapping = OpenMapping(name, mappingSize);
+
+        const auto *header = Header(mapping);
+        if (header->version.load(std::memory_order_acquire) != kLayoutVersion || header->magic != kMagic
+            || header->slotCount < 2
+            || mappingSize < sizeof(RingHeader) + header->slotCount * header->slotStride)
+        {
+            Unmap(mapping, mappingSize);
+            throw std::runtime_error("Shared memory '" + name + "' is not a frame ring (or is still being created)");
+        }
+    }
+
+    SharedFrameRingReader::~SharedFrameRingReader()
+    {
+        Unmap(mapping, mappingSize);
+    }
+
+    std::unique_ptr<SharedFrameRingReader> SharedFrameRingReader::CreateSharedFrameRingReader(const std::string &name)
+    {
+        return std::make_unique<SharedFrameRingReader>(name);
+    }
+
+    uint64_t SharedFrameRingReader::Published() const
+    {
+        return Header(mapping)->published.load(std::memory_order_acquire);
+    }
+
+    std::optional<SharedFrameView> SharedFrameRingReader::Latest() const
+    {
+        const auto *header = Header(mapping);
+        const size_t capacity = header->imageCapacity;
+
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt)
+        {
+            const uint64_t published = header->published.load(std::memory_order_acquire);
+            if (published == 0)
+            {
+                return std::nullopt;
+            }
+
+            const size_t index = (published - 1) % header->slotCount;
+            auto *slot = Slot(mapping, index);
+            const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence % 2 != 0)
+            {
+                continue; // being rewritten; the writer has moved on, so look up the newest slot again
+            }
+
+            SharedFrameView view;
+            view.publication = slot->publication;
+            view.telemetry = slot->telemetry;
+            view.slot = index;
+            view.slotSequence = sequence;
+            const auto imageHeaders = slot->images;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot->sequence.load(std::memory_order_relaxed) != sequence)
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < kSharedImageCount; ++i)
+            {
+                const ImageHeader &image = imageHeaders[i];
+                if (image.rows > 0 && image.cols > 0)
+                {
+                    view.images[i] = cv::Mat(image.rows, image.cols, image.type, ImageData(slot, i, capacity));
+                }
+            }
+            return view;
+        }
+        return std::nullopt;
+    }
+
+    bool SharedFrameRingReader::IsCurrent(const SharedFrameView &view) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return Slot(mapping, view.slot)->sequence.load(std::memory_order_relaxed) == view.slotSequence;
+    }
+
+    std::optional<SharedFrameSnapshot> SharedFrameRingReader::CopyLatest() const
+    {
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt)
+        {
+            auto view = Latest();
+            if (!view.has_value())
+            {
+                return std::nullopt;
+            }
+
+            SharedFrameSnapshot snapshot{ .publication = view->publication,
+                .telemetry = view->telemetry,
+                .images = {} };
+            for (size_t i = 0; i < kSharedImageCount; ++i)
+            {
+                view->images[i].copyTo(snapshot.images[i]);
+            }
+            if (IsCurrent(*view))
+            {
+                return snapshot;
+            }
+        }
+        return std::nullopt;
+    }
+} // namespace SH3DS::Pipeline
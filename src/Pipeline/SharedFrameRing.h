@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Core/Types.h"
+
+#include <opencv2/core.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace SH3DS::Pipeline
+{
+    /**
+     * @brief Images carried by each ring slot.
+     */
+    enum class SharedImage : uint32_t
+    {
+        Raw,    ///< Camera frame as grabbed
+        Top,    ///< Warped (colour-corrected) top screen
+        Bottom, ///< Warped bottom screen (empty without bottom calibration)
+    };
+
+    inline constexpr size_t kSharedImageCount = 3; ///< Number of SharedImage values
+
+    /**
+     * @brief Per-frame pipeline telemetry. Plain data, copied byte for byte into shared memory.
+     */
+    struct FrameTelemetry
+    {
+        uint64_t sequenceNumber = 0;                                ///< Frame sequence number from the source
+        int64_t captureTimeNs = 0;                                  ///< Capture time (steady clock ns)
+        Core::StateId stateId = Core::kInvalidStateId;              ///< Current FSM state
+        std::array<char, 48> stateName{};                           ///< Current state name (NUL-terminated)
+        int64_t timeInStateMs = 0;                                  ///< Time spent in the current state
+        uint8_t unchanged = 0;                                      ///< 1 if the last analysis was reused
+        uint8_t hasShinyResult = 0;                                 ///< 1 if the detector produced a verdict
+        Core::ShinyVerdict verdict = Core::ShinyVerdict::Uncertain; ///< Verdict (valid if hasShinyResult)
+        double confidence = 0.0;                                    ///< Confidence (valid if hasShinyResult)
+        std::array<char, 32> method{};                              ///< Detection method (NUL-terminated)
+        uint64_t encounters = 0;                                    ///< Encounters so far
+    };
+
+    /**
+     * @brief A slot read from the ring whose images still point into shared memory.
+     *
+     * The images are only valid while the writer has not come back around to the slot; check
+     * SharedFrameRingReader::IsCurrent() after using them and discard whatever was derived from them if it fails.
+     */
+    struct SharedFrameView
+    {
+        uint64_t publication = 0;                      ///< Publication number (1 = first frame published)
+        FrameTelemetry telemetry;                      ///< Telemetry (already copied out)
+        std::array<cv::Mat, kSharedImageCount> images; ///< Read-only views into the mapping, indexed by SharedImage
+        size_t slot = 0;                               ///< Slot the view was read from
+        uint64_t slotSequence = 0;                     ///< Slot counter at the time of the read
+    };
+
+    /**
+     * @brief A slot copied out of the ring; owns its images.
+     */
+    struct SharedFrameSnapshot
+    {
+        uint64_t publication = 0;                      ///< Publication number (1 = first frame published)
+        FrameTelemetry telemetry;                      ///< Telemetry
+        std::array<cv::Mat, kSharedImageCount> images; ///< Deep copies, indexed by SharedImage
+    };
+
+    /**
+     * @brief Publishes frames and telemetry into a named POSIX shared-memory ring.
+     *
+     * The segment holds a fixed number of slots, each with its own sequence counter (a seqlock): the counter is odd
+     * while the slot is being written and advances by two per publication. Publishing never waits for readers, so
+     * any number of viewer processes can attach without slowing the pipeline; a reader that is overtaken simply
+     * sees a changed counter and retries. Images larger than the slot capacity are published empty.
+     *
+     * The segment is created (replacing a stale one of the same name) by the constructor and unlinked by the
+     * destructor. Only available on POSIX systems; elsewhere the constructor throws.
+     */
+    class SharedFrameRingWriter
+    {
+    public:
+        /**
+         * @brief Creates and maps the segment.
+         * @param name Segment name, starting with '/' (e.g. "/sh3ds").
+         * @param slotCount Number of slots (at least 2).
+         * @param imageCapacity Bytes reserved for each image of a slot.
+         * @throws std::runtime_error if the segment cannot be created.
+         */
+        SharedFrameRingWriter(std::string name, size_t slotCount, size_t imageCapacity);
+
+        /**
+         * @brief Unmaps and unlinks the segment. Attached readers keep their mapping.
+         */
+        ~SharedFrameRingWriter();
+
+        SharedFrameRingWriter(const SharedFrameRingWriter &) = delete;
+        SharedFrameRingWriter &operator=(const SharedFrameRingWriter &) = delete;
+
+        /**
+         * @brief Creates a shared frame ring writer.
+         * @param name Segment name, starting with '/'.
+         * @param slotCount Number of slots (at least 2).
+         * @param imageCapacity Bytes reserved for each image of a slot.
+         * @return The writer.
+         */
+        static std::unique_ptr<SharedFrameRingWriter> CreateSharedFrameRingWriter(std::string name,
+            size_t slotCount,
+            size_t imageCapacity);
+
+        /**
+         * @brief Writes one frame into the next slot.
+         * @param telemetry Frame telemetry.
+         * @param images Images indexed by SharedImage; any type, ROI views are fine, empty images stay empty.
+         * @return False if an image did not fit its slot; it is logged and published empty, the rest still goes out.
+         */
+        bool Publish(const FrameTelemetry &telemetry, const std::array<cv::Mat, kSharedImageCount> &images);
+
+        /**
+         * @brief Returns the number of frames published so far.
+         * @return Publication count.
+         */
+        uint64_t Published() const;
+
+        /**
+         * @brief Returns the bytes reserved per image.
+         * @return Image capacity.
+         */
+        size_t ImageCapacity() const;
+
+    private:
+        std::string name;        ///< Segment name
+        void *mapping = nullptr; ///< Start of the mapped segment
+        size_t mappingSize = 0;  ///< Size of the mapped segment
+        uint64_t published = 0;  ///< Frames published so far
+    };
+
+    /**
+     * @brief Attaches read-only to a ring created by SharedFrameRingWriter.
+     */
+    class SharedFrameRingReader
+    {
+    public:
+        /**
+         * @brief Opens and maps an existing segment.
+         * @param name Segment name, as given to the writer.
+         * @throws std::runtime_error if the segment does not exist or is not a frame ring.
+         */
+        explicit SharedFrameRingReader(const std::string &name);
+
+        /**
+         * @brief Unmaps the segment.
+         */
+        ~SharedFrameRingReader();
+
+        SharedFrameRingReader(const SharedFrameRingReader &) = delete;
+        SharedFrameRingReader &operator=(const SharedFrameRingReader &) = delete;
+
+        /**
+         * @brief Creates a shared frame ring reader.
+         * @param name Segment name, as given to the writer.
+         * @return The reader.
+         */
+        static std::unique_ptr<SharedFrameRingReader> CreateSharedFrameRingReader(const std::string &name);
+
+        /**
+         * @brief Returns the number of frames the writer has published.
+         * @return Publication count.
+         */
+        uint64_t Published() const;
+
+        /**
+         * @brief Returns the newest frame without copying its pixels.
+         * @return The frame, or std::nullopt if nothing was published yet or the writer kept overtaking the read.
+         */
+        std::optional<SharedFrameView> Latest() const;
+
+        /**
+         * @brief Checks that a view's slot has not been rewritten since Latest() returned it.
+         * @param view A view returned by Latest().
+         * @return True if the view's images are still the published ones.
+         */
+        bool IsCurrent(const SharedFrameView &view) const;
+
+        /**
+         * @brief Copies the newest frame out of the ring.
+         * @return The frame, or std::nullopt if nothing was published yet or the writer kept overtaking the copy.
+         */
+        std::optional<SharedFrameSnapshot> CopyLatest() const;
+
+    private:
+        void *mapping = nullptr; ///< Start of the mapped segment
+        size_t mappingSize = 0;  ///< Size of the mapped segment
+    };
+} // namespace SH3DS::Pipeline
@@ -0,0 +1,108 @@
+#include "ShinyCheckScheduler.h"
+
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace SH3DS::Pipeline
+{
+    ShinyCheckScheduler::ShinyCheckScheduler(std::string roiName,
+        Core::StateId checkState,
+        std::chrono::milliseconds delay,
+        int burstFrames)
+        : roiName(std::move(roiName)),
+          checkState(checkState),
+          delay(delay),
+          burst(static_cast<std::size_t>(std::max(burstFrames, 1)))
+    {
+    }
+
+    std::optional<Core::ShinyResult> ShinyCheckScheduler::Update(const Vision::ShinyDetector &detector,
+        Core::StateId currentState,
+        std::chrono::milliseconds timeInState,
+        const Core::ROISet &topRois,
+        bool unchanged)
+    {
+        if (checkState == Core::kInvalidStateId)
+        {
+            if (unchanged && verdict.has_value())
+            {
+                return verdict;
+            }
+
+            const cv::Mat *roi = FindRoi(topRois);
+            if (!roi)
+            {
+                verdict = std::nullopt;
+                return std::nullopt;
+            }
+            ++detectorRuns;
+            verdict = detector.Detect(*roi);
+            return verdict;
+        }
+
+        if (currentState != lastState)
+        {
+            Reset();
+            lastState = currentState;
+        }
+
+        if (currentState != checkState || timeInState < delay)
+        {
+            return std::nullopt;
+        }
+
+        if (verdict.has_value())
+        {
+            return verdict;
+        }
+
+        const cv::Mat *roi = FindRoi(topRois);
+        if (!roi)
+        {
+            return std::nullopt;
+        }
+
+        // copyTo reuses the slot's buffer when the ROI size is unchanged, so bursts stop allocating after the first.
+        roi->copyTo(burst[captured]);
+        ++captured;
+        if (captured < burst.size())
+        {
+            return std::nullopt;
+        }
+
+        ++detectorRuns;
+        verdict = detector.DetectSequence(std::span<const cv::Mat>(burst.data(), captured));
+        LOG_DEBUG("ShinyCheck: burst of {} frames evaluated: {}", captured, verdict->Details());
+        return verdict;
+    }
+
+    std::size_t ShinyCheckScheduler::CapturedFrames() const
+    {
+        return captured;
+    }
+
+    uint64_t ShinyCheckScheduler::DetectorRuns() const
+    {
+        return detectorRuns;
+    }
+
+    void ShinyCheckScheduler::Reset()
+    {
+        captured = 0;
+        lastState = Core::kInvalidStateId;
+        verdict = std::nullopt;
+    }
+
+    const cv::Mat *ShinyCheckScheduler::FindRoi(const Core::ROISet &topRois) const
+    {
+        auto it = topRois.find(roiName);
+        if (it == topRois.end() || it->second.empty())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+} // namespace SH3DS::Pipeline
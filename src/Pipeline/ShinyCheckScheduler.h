@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Vision/ShinyDetector.h"
+
+#include <opencv2/core.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SH3DS::Pipeline
+{
+    /**
+     * @brief Decides when the shiny detector runs.
+     *
+     * Detection is skipped outside the check window. Once the FSM has spent `delay` in the check state, the
+     * scheduler captures `burstFrames` sprite ROIs and runs DetectSequence() once over the burst; the verdict
+     * is then held until the state changes. Without a check state every frame is detected individually.
+     */
+    class ShinyCheckScheduler
+    {
+    public:
+        /**
+         * @brief Constructs the scheduler.
+         * @param roiName Top-screen ROI that contains the sprite.
+         * @param checkState State in which the shiny check happens (kInvalidStateId detects every frame).
+         * @param delay Time to spend in the check state before capturing.
+         * @param burstFrames Number of ROIs to capture for the sequence verdict (at least 1).
+         */
+        ShinyCheckScheduler(std::string roiName,
+            Core::StateId checkState,
+            std::chrono::milliseconds delay,
+            int burstFrames);
+
+        /**
+         * @brief Feeds one frame.
+         * @param detector The shiny detector.
+         * @param currentState Current FSM state.
+         * @param timeInState Time the FSM has spent in the current state.
+         * @param topRois Top-screen ROIs of the frame.
+         * @param unchanged True if the frame is unchanged since the previous one; without a check state the
+         * previous verdict is returned instead of detecting again. Bursts still capture unchanged frames.
+         * @return The verdict once the burst has been evaluated (held until the state changes), nullopt before.
+         */
+        std::optional<Core::ShinyResult> Update(const Vision::ShinyDetector &detector,
+            Core::StateId currentState,
+            std::chrono::milliseconds timeInState,
+            const Core::ROISet &topRois,
+            bool unchanged = false);
+
+        /**
+         * @brief Returns the number of ROIs captured for the current burst.
+         * @return Captured frame count.
+         */
+        std::size_t CapturedFrames() const;
+
+        /**
+         * @brief Returns how many times the detector has been invoked (Detect or DetectSequence).
+         * @return Detector invocation count.
+         */
+        uint64_t DetectorRuns() const;
+
+        /**
+         * @brief Drops the current burst and verdict; the next Update() starts a fresh check state visit.
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Returns the sprite ROI of the frame, or nullptr if it is missing or empty.
+         * @param topRois Top-screen ROIs of the frame.
+         * @return The sprite ROI.
+         */
+        const cv::Mat *FindRoi(const Core::ROISet &topRois) const;
+
+        std::string roiName;                             ///< Sprite ROI name
+        Core::StateId checkState;                        ///< Shiny check state (kInvalidStateId = ungated)
+        std::chrono::milliseconds delay;                 ///< Delay before capturing
+        std::vector<cv::Mat> burst;                      ///< Captured ROIs (buffers reused across bursts)
+        std::size_t captured = 0;                        ///< Number of valid entries in burst
+        Core::StateId lastState = Core::kInvalidStateId; ///< State seen on the previous Update()
+        std::optional<Core::ShinyResult> verdict;        ///< Burst verdict (or the last verdict when ungated)
+        uint64_t detectorRuns = 0;                       ///< Detector invocations
+    };
+} // namespace SH3DS::Pipeline
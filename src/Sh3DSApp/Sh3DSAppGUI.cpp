@@ -1,15 +1,22 @@
 #include "App/SH3DSDebugApp.h"
-#include "Kappa/Logger.h"
+#include "Core/HotLog.h"
+#include "Core/Logger.h"
+#include "Core/ResourceUsage.h"
 
 #include <CLI/CLI.hpp>
 #include <spdlog/spdlog.h>
 
+#include <chrono>
+
 int main(int argc, char *argv[])
 {
-    Kappa::Logger::SetLoggerName("SH-3DS");
+    const auto processStart = std::chrono::steady_clock::now();
+
+    SH3DS::Core::Logger::SetLoggerName("SH-3DS");
 
 #ifndef NDEBUG
-    Kappa::Logger::Get().SetLevel(spdlog::level::debug);
+    SH3DS::Core::Logger::Get().SetLevel(spdlog::level::debug);
+    SH3DS::Core::HotLogger::Get().SetLevel(SH3DS::Core::HotLogLevel::Debug);
     LOG_DEBUG("Log level set to Debug for debug build");
 #endif
 
@@ -18,16 +25,25 @@ int main(int argc, char *argv[])
     std::string hardwareConfigPath = "config/hardware.yaml";
     std::string huntConfigPath = "config/hunts/xy_starter_sr_fennekin.yaml";
     std::string replayPath;
+    bool exitAfterStartup = false;
 
     app.add_option("--hardware", hardwareConfigPath, "Path to hardware config YAML");
     app.add_option("--hunt-config", huntConfigPath, "Path to unified hunt config YAML");
     app.add_option("--replay", replayPath, "Replay source (directory or video file)")->required();
+    app.add_flag("--exit-after-startup",
+        exitAfterStartup,
+        "Open the window and build the pipeline, report startup cost, then exit");
 
     CLI11_PARSE(app, argc, argv);
 
     try
     {
         SH3DS::App::SH3DSDebugApp debugApp(hardwareConfigPath, huntConfigPath, replayPath);
+        SH3DS::Core::LogResourceUsage("Startup complete", processStart);
+        if (exitAfterStartup)
+        {
+            return 0;
+        }
         debugApp.Run();
     }
     catch (const std::exception &e)
@@ -0,0 +1,203 @@
+#include "Capture/FileFrameSource.h"
+#include "Capture/FramePreprocessor.h"
+#include "Capture/ScreenDetector.h"
+#include "Capture/VideoFrameSource.h"
+#include "Core/Config.h"
+#include "Core/HotLog.h"
+#include "Core/Logger.h"
+#include "Core/ResourceUsage.h"
+#include "FSM/HuntProfiles.h"
+#include "Input/MockInputAdapter.h"
+#include "Pipeline/Orchestrator.h"
+#include "Strategy/SoftResetStrategy.h"
+#include "Vision/FusionDetector.h"
+
+#include <CLI/CLI.hpp>
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    std::atomic<SH3DS::Pipeline::Orchestrator *> activeOrchestrator = nullptr; ///< Stopped by HandleSignal
+    volatile std::sig_atomic_t stopRequested = 0;                              ///< Set by HandleSignal
+
+    static_assert(std::atomic<SH3DS::Pipeline::Orchestrator *>::is_always_lock_free,
+        "the signal handler may only touch lock-free atomics");
+
+    /**
+     * @brief SIGINT/SIGTERM handler: asks the orchestrator to finish its current tick and return.
+     *
+     * A second signal falls through to the default handler, so a wedged run can still be killed.
+     */
+    void HandleSignal(int signal)
+    {
+        stopRequested = 1;
+        if (auto *orchestrator = activeOrchestrator.load())
+        {
+            orchestrator->Stop();
+        }
+        std::signal(signal, SIG_DFL);
+    }
+
+    /**
+     * @brief Opens the capture source: @p sourceOverride if set, otherwise the hardware config's camera.
+     *
+     * Directories replay as image sequences and other paths as video files. Live capture types ("mjpeg",
+     * "usb") have no frame source yet.
+     */
+    std::unique_ptr<SH3DS::Capture::FrameSource> CreateFrameSource(const SH3DS::Core::HardwareConfig &hardware,
+        const std::string &sourceOverride)
+    {
+        const std::string type = sourceOverride.empty() ? hardware.camera.type : "file";
+        const std::filesystem::path path = sourceOverride.empty() ? hardware.camera.uri : sourceOverride;
+        const double fps = hardware.orchestrator.targetFps;
+
+        if (type != "file" && type != "video")
+        {
+            throw std::runtime_error("camera type '" + type + "' is not supported by the headless build yet");
+        }
+
+        if (std::filesystem::is_directory(path))
+        {
+            return SH3DS::Capture::FileFrameSource::CreateFileFrameSource(path, fps);
+        }
+        return SH3DS::Capture::VideoFrameSource::CreateVideoFrameSource(path, fps);
+    }
+
+    /**
+     * @brief Builds the orchestrator and its pipeline from the hardware and hunt configs.
+     */
+    std::unique_ptr<SH3DS::Pipeline::Orchestrator> BuildOrchestrator(const SH3DS::Core::HardwareConfig &hardwareConfig,
+        const std::string &huntConfigPath,
+        const std::string &sourceOverride)
+    {
+        const auto unifiedConfig = SH3DS::Core::LoadUnifiedHuntConfig(huntConfigPath);
+
+        LOG_INFO("Hunt: {} (target: {})", unifiedConfig.huntName, unifiedConfig.targetPokemon);
+
+        auto source = CreateFrameSource(hardwareConfig, sourceOverride);
+        LOG_INFO("Source: {}", source->Describe());
+
+        SH3DS::Capture::ScreenDetectorConfig detectorConfig;
+        detectorConfig.calibrationCachePath = hardwareConfig.screenCalibration.cachePath;
+        detectorConfig.cameraId = sourceOverride.empty()
+                                      ? hardwareConfig.camera.type + ":" + hardwareConfig.camera.uri
+                                      : "file:" + sourceOverride;
+
+        auto preprocessor = std::make_unique<SH3DS::Capture::FramePreprocessor>(
+            hardwareConfig.screenCalibration, unifiedConfig.rois, hardwareConfig.bottomScreenCalibration);
+
+        auto fsm = SH3DS::FSM::HuntProfiles::Create(unifiedConfig.huntProfile, unifiedConfig.fsmParams);
+        auto states = fsm->GetStateRegistry();
+
+        std::unique_ptr<SH3DS::Vision::ShinyDetector> detector;
+        if (!unifiedConfig.shinyDetector.method.empty())
+        {
+            detector = SH3DS::Vision::FusionDetector::CreateMethodDetector(unifiedConfig.shinyDetector,
+                unifiedConfig.huntId);
+            if (!detector)
+            {
+                throw std::runtime_error(
+                    "unknown shiny detection method '" + unifiedConfig.shinyDetector.method + "'");
+            }
+        }
+
+        // No network input adapter exists yet; inputs are logged by the mock adapter.
+        LOG_WARN(
+            "Input: console '{}' has no adapter in this build; using the mock adapter", hardwareConfig.console.type);
+
+        SH3DS::Core::OrchestratorConfig orchestratorConfig = hardwareConfig.orchestrator;
+        orchestratorConfig.shinyRoi = SH3DS::Vision::FusionDetector::MethodRoi(unifiedConfig.shinyDetector);
+        orchestratorConfig.shinyCheckState = unifiedConfig.shinyCheckState;
+        orchestratorConfig.shinyCheckDelayMs = unifiedConfig.shinyCheckDelayMs;
+        orchestratorConfig.shinyCheckFrames = unifiedConfig.shinyCheckFrames;
+
+        return std::make_unique<SH3DS::Pipeline::Orchestrator>(std::move(source),
+            SH3DS::Capture::ScreenDetector::CreateScreenDetector(std::move(detectorConfig)),
+            std::move(preprocessor),
+            std::move(fsm),
+            std::move(detector),
+            std::make_unique<SH3DS::Strategy::SoftResetStrategy>(SH3DS::Core::ToHuntConfig(unifiedConfig), states),
+            SH3DS::Input::MockInputAdapter::CreateMockInputAdapter(),
+            orchestratorConfig);
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const auto processStart = std::chrono::steady_clock::now();
+
+    SH3DS::Core::Logger::SetLoggerName("SH-3DS");
+
+    CLI::App app{ "SH-3DS: Headless Shiny Hunting Daemon" };
+
+    std::string hardwareConfigPath = "config/hardware.yaml";
+    std::string huntConfigPath = "config/hunts/xy_starter_sr_fennekin.yaml";
+    std::string sourcePath;
+    std::string logLevel;
+    bool exitAfterStartup = false;
+
+    app.add_option("--hardware", hardwareConfigPath, "Path to hardware config YAML");
+    app.add_option("--hunt-config", huntConfigPath, "Path to unified hunt config YAML");
+    app.add_option("--source", sourcePath, "Replay source (directory or video file) instead of the camera");
+    app.add_option("--log-level", logLevel, "Log level (trace ... critical); default: orchestrator.log_level");
+    app.add_flag("--exit-after-startup", exitAfterStartup, "Build the pipeline, report startup cost, then exit");
+
+    CLI11_PARSE(app, argc, argv);
+
+    try
+    {
+        const auto hardwareConfig = SH3DS::Core::LoadHardwareConfig(hardwareConfigPath);
+        const std::string &level = logLevel.empty() ? hardwareConfig.orchestrator.logLevel : logLevel;
+        SH3DS::Core::Logger::Get().SetLevel(spdlog::level::from_str(level));
+        auto &hotLog = SH3DS::Core::HotLogger::Get();
+        hotLog.SetLevel(SH3DS::Core::ParseHotLogLevel(level));
+        if (hardwareConfig.orchestrator.asyncLog)
+        {
+            hotLog.StartAsync();
+        }
+
+        auto orchestrator = BuildOrchestrator(hardwareConfig, huntConfigPath, sourcePath);
+        SH3DS::Core::LogResourceUsage("Startup complete", processStart);
+        if (exitAfterStartup)
+        {
+            return 0;
+        }
+
+        activeOrchestrator = orchestrator.get();
+        std::signal(SIGINT, HandleSignal);
+        std::signal(SIGTERM, HandleSignal);
+
+        // A signal landing between this check and Run() is lost, but the second one kills the process
+        if (!stopRequested)
+        {
+            orchestrator->Run();
+        }
+
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
+        activeOrchestrator = nullptr;
+        hotLog.Stop(); // Flush queued per-frame lines before the summary
+
+        const auto stats = orchestrator->Stats();
+        LOG_INFO("Stopped after {} encounters ({} frames, {} unchanged)",
+            stats.encounters,
+            stats.frames,
+            stats.unchangedFrames);
+        SH3DS::Core::LogResourceUsage("Shutdown", processStart);
+    }
+    catch (const std::exception &e)
+    {
+        LOG_ERROR("Fatal error: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
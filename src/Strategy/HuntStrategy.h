@@ -31,12 +31,12 @@ namespace SH3DS::Strategy
 
         /**
          * @brief Evaluate the current game state and decide what to do next.
-         * @param currentState Current FSM state identifier.
+         * @param currentState Current FSM state ID (resolve names via the FSM's StateRegistry).
          * @param timeInState How long the FSM has been in this state.
          * @param shinyResult Shiny detection result, if available.
          * @return Strategy decision with action and optional input command.
          */
-        virtual StrategyDecision Tick(const Core::GameState &currentState,
+        virtual StrategyDecision Tick(Core::StateId currentState,
             std::chrono::milliseconds timeInState,
             const std::optional<Core::ShinyResult> &shinyResult) = 0;
 
@@ -1,17 +1,41 @@
 #include "SoftResetStrategy.h"
 
 #include "Core/Constants.h"
+#include "Core/Logger.h"
 #include "Input/InputCommand.h"
-#include "Kappa/Logger.h"
 
 namespace SH3DS::Strategy
 {
-    SoftResetStrategy::SoftResetStrategy(Core::HuntConfig config) : config(std::move(config))
+    SoftResetStrategy::SoftResetStrategy(Core::HuntConfig config, std::shared_ptr<const Core::StateRegistry> states)
+        : config(std::move(config)),
+          states(std::move(states))
     {
+        // Resolve state names once so Tick() only compares and indexes StateIds.
+        if (!this->config.shinyCheckState.empty())
+        {
+            shinyCheckState = this->states->Find(this->config.shinyCheckState);
+            if (shinyCheckState == Core::kInvalidStateId)
+            {
+                LOG_WARN("Strategy: shiny check state '{}' is not known to the FSM", this->config.shinyCheckState);
+            }
+        }
+
+        actionsByState.assign(this->states->Size(), nullptr);
+        for (const auto &[stateName, stateActions] : this->config.actions)
+        {
+            const Core::StateId id = this->states->Find(stateName);
+            if (id == Core::kInvalidStateId)
+            {
+                LOG_WARN("Strategy: actions configured for unknown state '{}' (ignored)", stateName);
+                continue;
+            }
+            actionsByState[id] = &stateActions;
+        }
+
         Reset();
     }
 
-    StrategyDecision SoftResetStrategy::Tick(const Core::GameState &currentState,
+    StrategyDecision SoftResetStrategy::Tick(Core::StateId currentState,
         std::chrono::milliseconds timeInState,
         const std::optional<Core::ShinyResult> &shinyResult)
     {
@@ -26,7 +50,7 @@ namespace SH3DS::Strategy
         }
 
         // Check shiny only in the configured state, once per state entry.
-        if (!config.shinyCheckState.empty() && currentState == config.shinyCheckState && !shinyCheckResolvedInState)
+        if (shinyCheckState != Core::kInvalidStateId && currentState == shinyCheckState && !shinyCheckResolvedInState)
         {
             // Wait for the delay before checking
             if (timeInState < std::chrono::milliseconds(config.shinyCheckDelayMs))
@@ -39,9 +63,12 @@ namespace SH3DS::Strategy
                 if (shinyResult->verdict == Core::ShinyVerdict::Shiny)
                 {
                     ++stats.shiniesFound;
-                    LOG_ERROR("SHINY FOUND! confidence={:.3f} method={}", shinyResult->confidence, shinyResult->method);
+                    LOG_ERROR("SHINY FOUND! confidence={:.3f} method={} {}",
+                        shinyResult->confidence,
+                        shinyResult->method,
+                        shinyResult->Details());
                     return {
-                        { .action = Core::HuntAction::AlertShiny, .reason = "Shiny detected! " + shinyResult->details },
+                        { .action = Core::HuntAction::AlertShiny, .reason = "shiny detected", .state = currentState },
                         {},
                     };
                 }
@@ -69,20 +96,23 @@ namespace SH3DS::Strategy
             }
             else
             {
-                // Detector is expected to run continuously in orchestrator. If no result is available
-                // in this frame, wait until one appears; do not request repeated explicit checks.
+                // The orchestrator delivers a verdict once its burst of check frames has been evaluated.
+                // Until then, wait; do not request repeated explicit checks.
                 return { { .action = Core::HuntAction::Wait, .reason = "awaiting shiny result" }, {} };
             }
         }
 
         // Look up actions for the current state
-        auto it = config.actions.find(currentState);
-        if (it == config.actions.end() || it->second.empty())
+        const auto *actions = currentState < actionsByState.size() ? actionsByState[currentState] : nullptr;
+        if (!actions || actions->empty())
         {
-            return { { .action = Core::HuntAction::Wait, .reason = "no actions for state: " + currentState }, {} };
+            return {
+                { .action = Core::HuntAction::Wait, .reason = "no actions for state", .state = currentState },
+                {},
+            };
         }
 
-        const auto &stateActions = it->second;
+        const auto &stateActions = *actions;
 
         // Standalone wait action
         if (static_cast<size_t>(actionIndex) < stateActions.size())
@@ -93,11 +123,7 @@ namespace SH3DS::Strategy
             {
                 if (timeInState < std::chrono::milliseconds(action.waitMs))
                 {
-                    return {
-                        { .action = Core::HuntAction::Wait,
-                            .reason = "waiting " + std::to_string(action.waitMs) + "ms" },
-                        {},
-                    };
+                    return { { .action = Core::HuntAction::Wait, .reason = "waiting out the state's wait action" }, {} };
                 }
                 ++actionIndex;
             }
@@ -132,8 +158,9 @@ namespace SH3DS::Strategy
 
                     return {
                         { .action = Core::HuntAction::SendInput,
-                            .reason = "pressing buttons for state: " + currentState,
-                            .delay = std::chrono::milliseconds(action.holdMs) },
+                            .reason = "pressing buttons for state",
+                            .delay = std::chrono::milliseconds(action.holdMs),
+                            .state = currentState },
                         cmd,
                     };
                 }
@@ -175,7 +202,7 @@ namespace SH3DS::Strategy
     {
         stats = {};
         stats.huntStarted = std::chrono::steady_clock::now();
-        lastState.clear();
+        lastState = Core::kInvalidStateId;
         actionIndex = 0;
         lastActionTime = std::chrono::steady_clock::now();
         waitingForShinyCheck = false;
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "Core/Config.h"
+#include "Core/StateRegistry.h"
 #include "Strategy/HuntStrategy.h"
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,13 +20,14 @@ namespace SH3DS::Strategy
         /**
          * @brief Constructs a soft-reset strategy from hunt configuration.
          * @param config Hunt configuration with input sequences per state.
+         * @param states Registry of the FSM driving this strategy; state names in the config are resolved once here.
          */
-        explicit SoftResetStrategy(Core::HuntConfig config);
+        SoftResetStrategy(Core::HuntConfig config, std::shared_ptr<const Core::StateRegistry> states);
 
         /**
          * @brief Evaluate the current game state and decide what to do next.
          */
-        StrategyDecision Tick(const Core::GameState &currentState,
+        StrategyDecision Tick(Core::StateId currentState,
             std::chrono::milliseconds timeInState,
             const std::optional<Core::ShinyResult> &shinyResult) override;
 
@@ -59,13 +62,16 @@ namespace SH3DS::Strategy
          */
         uint32_t ButtonNameToBit(const std::string &name) const;
 
-        Core::HuntConfig config;                              ///< Hunt configuration
-        Core::HuntStatistics stats;                           ///< Accumulated statistics
-        Core::GameState lastState;                            ///< Last observed game state
-        int actionIndex = 0;                                  ///< Current action index within state
-        std::chrono::steady_clock::time_point lastActionTime; ///< Timestamp of last action
-        bool waitingForShinyCheck = false;                    ///< Whether waiting for shiny check
-        int consecutiveStuckCount = 0;                        ///< Consecutive stuck recovery count
-        bool shinyCheckResolvedInState = false;               ///< Whether shiny check was already resolved in state
+        Core::HuntConfig config;                                            ///< Hunt configuration
+        std::shared_ptr<const Core::StateRegistry> states;                  ///< State names for log messages
+        Core::StateId shinyCheckState = Core::kInvalidStateId;              ///< Resolved config.shinyCheckState
+        std::vector<const std::vector<Core::InputAction> *> actionsByState; ///< config.actions indexed by StateId
+        Core::HuntStatistics stats;                                         ///< Accumulated statistics
+        Core::StateId lastState = Core::kInvalidStateId;                    ///< Last observed game state
+        int actionIndex = 0;                                                ///< Current action index within state
+        std::chrono::steady_clock::time_point lastActionTime;               ///< Timestamp of last action
+        bool waitingForShinyCheck = false;                                  ///< Whether waiting for shiny check
+        int consecutiveStuckCount = 0;                                      ///< Consecutive stuck recovery count
+        bool shinyCheckResolvedInState = false;                             ///< Shiny check already resolved in state
     };
 } // namespace SH3DS::Strategy
@@ -0,0 +1,155 @@
+#include "CnnDetector.h"
+
+#include "Core/Logger.h"
+#include "SequenceVoter.h"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SH3DS::Vision
+{
+    namespace
+    {
+        constexpr std::string_view kMethodName = "cnn"; ///< Reported in ShinyResult::method
+
+        /** @brief The model only accepts 3-channel 8-bit BGR crops; anything else is reported, not classified. */
+        bool IsBgr(const cv::Mat &roi)
+        {
+            return roi.type() == CV_8UC3;
+        }
+    } // namespace
+
+    CnnDetector::CnnDetector(Core::DetectionMethodConfig config, std::string profileId)
+        : config(std::move(config)),
+          id(std::move(profileId))
+    {
+        if (this->config.modelPath.empty())
+        {
+            LOG_WARN("CnnDetector: no model_path configured for profile {}", id);
+            return;
+        }
+
+        try
+        {
+            model.emplace(QuantizedCnn::Load(this->config.modelPath));
+            LOG_INFO("CnnDetector: loaded {} ({}x{} input, {} MACs per ROI)",
+                this->config.modelPath,
+                model->InputWidth(),
+                model->InputHeight(),
+                model->MacsPerInference());
+        }
+        catch (const std::runtime_error &e)
+        {
+            LOG_WARN("CnnDetector: {}", e.what());
+        }
+    }
+
+    Core::ShinyResult CnnDetector::Detect(const cv::Mat &pokemonRoi) const
+    {
+        if (pokemonRoi.empty())
+        {
+            return { .method = kMethodName };
+        }
+
+        if (!model)
+        {
+            return { .method = kMethodName, .note = "model not loaded" };
+        }
+
+        if (!IsBgr(pokemonRoi))
+        {
+            return { .method = kMethodName, .note = "expected a BGR ROI" };
+        }
+
+        return MakeResult(model->Predict(pokemonRoi));
+    }
+
+    Core::ShinyResult CnnDetector::DetectSequence(std::span<const cv::Mat> rois) const
+    {
+        std::vector<cv::Mat> frames;
+        frames.reserve(rois.size());
+        for (const auto &roi : rois)
+        {
+            if (!roi.empty() && IsBgr(roi))
+            {
+                frames.push_back(roi);
+            }
+        }
+
+        if (frames.empty() || !model)
+        {
+            return { .method = kMethodName, .note = model ? "" : "model not loaded" };
+        }
+
+        SequenceVoter voter(frames.size());
+        for (const float probability : model->Predict(frames))
+        {
+            voter.Add(MakeResult(probability));
+        }
+        return voter.Result();
+    }
+
+    std::vector<Core::ShinyResult> CnnDetector::DetectBatch(std::span<const cv::Mat> rois) const
+    {
+        std::vector<Core::ShinyResult> results(rois.size());
+        std::vector<cv::Mat> frames;
+        std::vector<std::size_t> slots;
+        for (std::size_t i = 0; i < rois.size(); ++i)
+        {
+            if (rois[i].empty() || !model || !IsBgr(rois[i]))
+            {
+                results[i] = Detect(rois[i]);
+                continue;
+            }
+            frames.push_back(rois[i]);
+            slots.push_back(i);
+        }
+
+        if (!frames.empty())
+        {
+            const std::vector<float> probabilities = model->Predict(frames);
+            for (std::size_t j = 0; j < slots.size(); ++j)
+            {
+                results[slots[j]] = MakeResult(probabilities[j]);
+            }
+        }
+        return results;
+    }
+
+    std::string CnnDetector::ProfileId() const
+    {
+        return id;
+    }
+
+    void CnnDetector::Reset()
+    {
+        // No internal state to reset
+    }
+
+    std::unique_ptr<ShinyDetector> CnnDetector::CreateCnnDetector(const Core::DetectionMethodConfig &config,
+        const std::string &profileId)
+    {
+        return std::make_unique<CnnDetector>(config, profileId);
+    }
+
+    Core::ShinyResult CnnDetector::MakeResult(float shinyProbability) const
+    {
+        const double shiny = shinyProbability;
+        Core::ShinyResult result{ .method = kMethodName };
+        result.diagnostics.Add("p_shiny", shiny);
+
+        if (shiny >= config.modelConfidence)
+        {
+            result.verdict = Core::ShinyVerdict::Shiny;
+            result.confidence = shiny;
+        }
+        else if (1.0 - shiny >= config.modelConfidence)
+        {
+            result.verdict = Core::ShinyVerdict::NotShiny;
+            result.confidence = 1.0 - shiny;
+        }
+        return result;
+    }
+} // namespace SH3DS::Vision
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "QuantizedCnn.h"
+#include "ShinyDetector.h"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SH3DS::Vision
+{
+    /**
+     * @brief Detects shiny Pokemon with a small int8 CNN classifier on the sprite ROI.
+     *
+     * The model is loaded from DetectionMethodConfig::modelPath at construction. A class probability of at
+     * least modelConfidence gives a Shiny or NotShiny verdict; anything in between is Uncertain.
+     */
+    class CnnDetector : public ShinyDetector
+    {
+    public:
+        /**
+         * @brief Constructs a CnnDetector and loads its model.
+         * @param config Detection method configuration with the model path and confidence.
+         * @param profileId Profile identifier for this detector instance.
+         */
+        explicit CnnDetector(Core::DetectionMethodConfig config, std::string profileId);
+
+        /**
+         * @brief Detects shiny status from a single ROI frame.
+         */
+        Core::ShinyResult Detect(const cv::Mat &pokemonRoi) const override;
+
+        /**
+         * @brief Detects shiny status from a sequence of ROI frames by majority vote.
+         *
+         * All frames are classified as one batch, layer by layer.
+         */
+        Core::ShinyResult DetectSequence(std::span<const cv::Mat> rois) const override;
+
+        /**
+         * @brief Detects shiny status in each sprite slot of a frame.
+         *
+         * All non-empty slots are classified as one batch, layer by layer.
+         */
+        std::vector<Core::ShinyResult> DetectBatch(std::span<const cv::Mat> rois) const override;
+
+        /**
+         * @brief Returns the profile identifier.
+         */
+        std::string ProfileId() const override;
+
+        /**
+         * @brief Resets internal state (no-op for this stateless detector).
+         */
+        void Reset() override;
+
+        /**
+         * @brief Create a CNN detector.
+         * @param config The detection method configuration.
+         * @param profileId The profile ID.
+         * @return A unique pointer to the CNN detector.
+         */
+        static std::unique_ptr<ShinyDetector> CreateCnnDetector(const Core::DetectionMethodConfig &config,
+            const std::string &profileId);
+
+    private:
+        /**
+         * @brief Turns a shiny probability into a verdict.
+         * @param shinyProbability The model output.
+         * @return The detection result.
+         */
+        Core::ShinyResult MakeResult(float shinyProbability) const;
+
+        Core::DetectionMethodConfig config; ///< Detection method configuration
+        std::string id;                     ///< Profile identifier
+        std::optional<QuantizedCnn> model;  ///< Loaded model (empty if loading failed)
+    };
+} // namespace SH3DS::Vision
@@ -0,0 +1,300 @@
+#include "ColorClassifier.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace SH3DS::Vision
+{
+    namespace
+    {
+        /// Low bits per channel resolved by the fine tables.
+        constexpr int kFineBits = 2;
+        constexpr int kFineLevels = 1 << kFineBits;
+        constexpr int kCoarseLevels = 256 >> kFineBits;
+        constexpr int kFineTableSize = kFineLevels * kFineLevels * kFineLevels;
+        constexpr int kCoarseTableSize = kCoarseLevels * kCoarseLevels * kCoarseLevels;
+        /// Set in a coarse entry whose bin straddles a range boundary; the low bits index a fine table.
+        constexpr uint32_t kFineFlag = 0x80000000u;
+        /// Class ids are stored as uint8_t.
+        constexpr std::size_t kMaxClasses = 256;
+
+        constexpr std::size_t CoarseIndex(int b, int g, int r)
+        {
+            return static_cast<std::size_t>(
+                ((b >> kFineBits) * kCoarseLevels + (g >> kFineBits)) * kCoarseLevels + (r >> kFineBits));
+        }
+
+        constexpr std::size_t FineIndex(int b, int g, int r)
+        {
+            constexpr int mask = kFineLevels - 1;
+            return static_cast<std::size_t>((((b & mask) << kFineBits) | (g & mask)) << kFineBits | (r & mask));
+        }
+
+        /// Colour class of one BGR pixel from the compiled coarse and fine tables.
+        uint32_t Classify(const uint32_t *coarseTable, const uint8_t *fineTable, const uchar *pixel)
+        {
+            const uint32_t entry = coarseTable[CoarseIndex(pixel[0], pixel[1], pixel[2])];
+            return (entry & kFineFlag) == 0u
+                       ? entry
+                       : fineTable[(entry & ~kFineFlag) * kFineTableSize + FineIndex(pixel[0], pixel[1], pixel[2])];
+        }
+    } // namespace
+
+    int ColorClassifier::AddRange(const cv::Scalar &hsvLower, const cv::Scalar &hsvUpper)
+    {
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            if (ranges[i].lower == hsvLower && ranges[i].upper == hsvUpper)
+            {
+                return static_cast<int>(i);
+            }
+        }
+
+        if (ranges.size() >= kMaxRanges)
+        {
+            throw std::runtime_error("ColorClassifier: too many HSV ranges (max " + std::to_string(kMaxRanges) + ")");
+        }
+
+        ranges.push_back({ .lower = hsvLower, .upper = hsvUpper });
+        compiled = false;
+        return static_cast<int>(ranges.size() - 1);
+    }
+
+    void ColorClassifier::Compile()
+    {
+        classMasks.assign(1, 0u);
+        coarse.assign(kCoarseTableSize, 0u);
+        fine.clear();
+        rangeMembers.clear();
+        compiled = true;
+        if (ranges.empty())
+        {
+            return;
+        }
+
+        std::map<uint32_t, uint8_t> classOf{ { 0u, 0 } };
+        auto classFor = [&](uint32_t mask) -> uint8_t {
+            auto [it, inserted] = classOf.try_emplace(mask, static_cast<uint8_t>(classMasks.size()));
+            if (inserted)
+            {
+                if (classMasks.size() >= kMaxClasses)
+                {
+                    throw std::runtime_error("ColorClassifier: HSV ranges overlap into too many colour classes");
+                }
+                classMasks.push_back(mask);
+            }
+            return it->second;
+        };
+
+        // One blue bin at a time: all 256 x 256 (g, r) colours for its kFineLevels blue values, converted and
+        // tested with the same cvtColor + inRange the classifier replaces, so boundaries are bit-exact.
+        cv::Mat slab(kFineLevels * 256, 256, CV_8UC3);
+        cv::Mat hsv;
+        cv::Mat inside;
+        std::vector<uint32_t> masks(slab.total());
+        std::vector<uint8_t> classes(slab.total());
+
+        for (int blueBin = 0; blueBin < kCoarseLevels; ++blueBin)
+        {
+            for (int row = 0; row < slab.rows; ++row)
+            {
+                auto *pixel = slab.ptr<cv::Vec3b>(row);
+                const auto b = static_cast<uchar>(blueBin * kFineLevels + row / 256);
+                const auto g = static_cast<uchar>(row % 256);
+                for (int r = 0; r < 256; ++r)
+                {
+                    pixel[r] = cv::Vec3b(b, g, static_cast<uchar>(r));
+                }
+            }
+            cv::cvtColor(slab, hsv, cv::COLOR_BGR2HSV);
+
+            std::fill(masks.begin(), masks.end(), 0u);
+            for (std::size_t i = 0; i < ranges.size(); ++i)
+            {
+                cv::inRange(hsv, ranges[i].lower, ranges[i].upper, inside);
+                const uchar *flags = inside.ptr<uchar>();
+                for (std::size_t p = 0; p < masks.size(); ++p)
+                {
+                    masks[p] |= flags[p] ? (1u << i) : 0u;
+                }
+            }
+
+            uint32_t lastMask = 0;
+            uint8_t lastClass = 0;
+            for (std::size_t p = 0; p < masks.size(); ++p)
+            {
+                if (masks[p] != lastMask)
+                {
+                    lastMask = masks[p];
+                    lastClass = classFor(lastMask);
+                }
+                classes[p] = lastClass;
+            }
+
+            for (int greenBin = 0; greenBin < kCoarseLevels; ++greenBin)
+            {
+                for (int redBin = 0; redBin < kCoarseLevels; ++redBin)
+                {
+                    std::array<uint8_t, kFineTableSize> binClasses{};
+                    bool uniform = true;
+                    for (int bf = 0; bf < kFineLevels; ++bf)
+                    {
+                        for (int gf = 0; gf < kFineLevels; ++gf)
+                        {
+                            const int row = bf * 256 + greenBin * kFineLevels + gf;
+                            for (int rf = 0; rf < kFineLevels; ++rf)
+                            {
+                                const auto pixel = static_cast<std::size_t>(row * 256 + redBin * kFineLevels + rf);
+                                const uint8_t cls = classes[pixel];
+                                binClasses[FineIndex(bf, gf, rf)] = cls;
+                                uniform = uniform && cls == binClasses[0];
+                            }
+                        }
+                    }
+
+                    const std::size_t index =
+                        CoarseIndex(blueBin << kFineBits, greenBin << kFineBits, redBin << kFineBits);
+                    if (uniform)
+                    {
+                        coarse[index] = binClasses[0];
+                    }
+                    else
+                    {
+                        coarse[index] = kFineFlag | static_cast<uint32_t>(fine.size() / kFineTableSize);
+                        fine.insert(fine.end(), binClasses.begin(), binClasses.end());
+                    }
+                }
+            }
+        }
+
+        // Membership of every class in every range, so ComputeIntegrals' per-range row scans are byte lookups.
+        rangeMembers.assign(ranges.size() * kMaxClasses, 0);
+        for (std::size_t cls = 0; cls < classMasks.size(); ++cls)
+        {
+            for (uint32_t mask = classMasks[cls]; mask != 0u; mask &= mask - 1u)
+            {
+                rangeMembers[static_cast<std::size_t>(std::countr_zero(mask)) * kMaxClasses + cls] = 1;
+            }
+        }
+    }
+
+    bool ColorClassifier::IsCompiled() const
+    {
+        return compiled;
+    }
+
+    std::size_t ColorClassifier::RangeCount() const
+    {
+        return ranges.size();
+    }
+
+    void ColorClassifier::CountPixels(const cv::Mat &bgr, std::span<uint32_t> counts) const
+    {
+        if (!compiled)
+        {
+            throw std::runtime_error("ColorClassifier: CountPixels called before Compile");
+        }
+        if (counts.size() < ranges.size())
+        {
+            throw std::runtime_error("ColorClassifier: counts span smaller than the range count");
+        }
+        std::fill(counts.begin(), counts.end(), 0u);
+        if (bgr.empty() || ranges.empty())
+        {
+            return;
+        }
+        if (bgr.type() != CV_8UC3)
+        {
+            throw std::runtime_error("ColorClassifier: expected a CV_8UC3 image");
+        }
+
+        std::array<uint32_t, kMaxClasses> histogram{};
+        const uint32_t *coarseTable = coarse.data();
+        const uint8_t *fineTable = fine.data();
+        for (int row = 0; row < bgr.rows; ++row)
+        {
+            const uchar *pixel = bgr.ptr<uchar>(row);
+            const uchar *end = pixel + static_cast<std::ptrdiff_t>(bgr.cols) * 3;
+            for (; pixel != end; pixel += 3)
+            {
+                ++histogram[Classify(coarseTable, fineTable, pixel)];
+            }
+        }
+
+        // Class 0 is the empty mask; expand every other class into the ranges it belongs to.
+        for (std::size_t cls = 1; cls < classMasks.size(); ++cls)
+        {
+            for (uint32_t mask = classMasks[cls]; mask != 0u; mask &= mask - 1u)
+            {
+                counts[static_cast<std::size_t>(std::countr_zero(mask))] += histogram[cls];
+            }
+        }
+    }
+
+    void ColorClassifier::ComputeIntegrals(const cv::Mat &bgr, std::vector<cv::Mat> &integrals) const
+    {
+        if (!compiled)
+        {
+            throw std::runtime_error("ColorClassifier: ComputeIntegrals called before Compile");
+        }
+        if (bgr.type() != CV_8UC3)
+        {
+            throw std::runtime_error("ColorClassifier: expected a CV_8UC3 image");
+        }
+
+        integrals.resize(ranges.size());
+        for (auto &integral : integrals)
+        {
+            integral.create(bgr.rows + 1, bgr.cols + 1, CV_32SC1);
+            std::fill_n(integral.ptr<int32_t>(0), integral.cols, 0);
+        }
+        if (ranges.empty())
+        {
+            return;
+        }
+
+        const uint32_t *coarseTable = coarse.data();
+        const uint8_t *fineTable = fine.data();
+        if (rowClasses.size() < static_cast<std::size_t>(bgr.cols))
+        {
+            rowClasses.resize(static_cast<std::size_t>(bgr.cols));
+        }
+        for (int row = 0; row < bgr.rows; ++row)
+        {
+            const uchar *pixel = bgr.ptr<uchar>(row);
+            uint8_t *cls = rowClasses.data();
+            for (int col = 0; col < bgr.cols; ++col, pixel += 3)
+            {
+                cls[col] = static_cast<uint8_t>(Classify(coarseTable, fineTable, pixel));
+            }
+
+            for (std::size_t i = 0; i < ranges.size(); ++i)
+            {
+                const uint8_t *member = rangeMembers.data() + i * kMaxClasses;
+                const int32_t *above = integrals[i].ptr<int32_t>(row);
+                int32_t *out = integrals[i].ptr<int32_t>(row + 1);
+                int32_t rowSum = 0;
+                out[0] = 0;
+                for (int col = 0; col < bgr.cols; ++col)
+                {
+                    rowSum += member[cls[col]];
+                    out[col + 1] = above[col + 1] + rowSum;
+                }
+            }
+        }
+    }
+
+    uint32_t ColorClassifier::SumRect(const cv::Mat &integral, const cv::Rect &rect)
+    {
+        const int32_t *top = integral.ptr<int32_t>(rect.y);
+        const int32_t *bottom = integral.ptr<int32_t>(rect.y + rect.height);
+        const int32_t sum = bottom[rect.x + rect.width] - bottom[rect.x] - top[rect.x + rect.width] + top[rect.x];
+        return static_cast<uint32_t>(sum);
+    }
+} // namespace SH3DS::Vision
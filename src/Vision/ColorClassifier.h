@@ -0,0 +1,102 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SH3DS::Vision
+{
+    /**
+     * @brief Counts pixels inside a set of HSV ranges directly from BGR, without an HSV image.
+     *
+     * Ranges are registered at load time and compiled into a BGR lookup table: every colour maps to a class
+     * whose bitmask says which ranges contain it. The table is two-level (64 coarse bins per channel, with a
+     * 4x4x4 fine table only for bins that straddle a range boundary), so results match cvtColor + inRange
+     * exactly. Counting is one pass over the ROI that yields the count of every range at once.
+     */
+    class ColorClassifier
+    {
+    public:
+        static constexpr std::size_t kMaxRanges = 32; ///< One bit per range in a class mask
+
+        /**
+         * @brief Registers an HSV range; identical ranges share an index.
+         * @param hsvLower Lower HSV bounds (OpenCV 8-bit scale, H in 0-179).
+         * @param hsvUpper Upper HSV bounds.
+         * @return Index of the range in the counts produced by CountPixels().
+         * @throws std::runtime_error if kMaxRanges distinct ranges are already registered.
+         */
+        int AddRange(const cv::Scalar &hsvLower, const cv::Scalar &hsvUpper);
+
+        /**
+         * @brief Builds the lookup table for all registered ranges. Call once after the last AddRange().
+         * @throws std::runtime_error if the ranges overlap into more than 256 distinct colour classes.
+         */
+        void Compile();
+
+        /**
+         * @brief Returns true once Compile() has run.
+         * @return True if compiled.
+         */
+        bool IsCompiled() const;
+
+        /**
+         * @brief Returns the number of registered ranges.
+         * @return The range count.
+         */
+        std::size_t RangeCount() const;
+
+        /**
+         * @brief Counts the pixels of a BGR image that fall in each registered range.
+         * @param bgr The image (CV_8UC3, any stride).
+         * @param counts Output, one entry per range (size >= RangeCount()); overwritten.
+         * @throws std::runtime_error if the classifier is not compiled, the image is not CV_8UC3 or counts is
+         * too small.
+         */
+        void CountPixels(const cv::Mat &bgr, std::span<uint32_t> counts) const;
+
+        /**
+         * @brief Builds one integral image per registered range over a BGR image in a single classification pass.
+         *
+         * Entry (y, x) of integral i is the number of pixels above and left of (x, y) that fall in range i, so the
+         * count inside any rectangle of the image is four lookups (SumRect()). Meant for a whole warped screen
+         * whose ROIs overlap: the screen is classified once, however many ROIs are queried.
+         * @param bgr The image (CV_8UC3, any stride).
+         * @param integrals Output, resized to RangeCount() CV_32SC1 images of (rows + 1) x (cols + 1); existing
+         * buffers of the right size are reused.
+         * @note Classifies rows into a scratch buffer owned by the classifier, so after warm-up it does not allocate;
+         * do not call it on one instance from several threads.
+         * @throws std::runtime_error if the classifier is not compiled or the image is not CV_8UC3.
+         */
+        void ComputeIntegrals(const cv::Mat &bgr, std::vector<cv::Mat> &integrals) const;
+
+        /**
+         * @brief Returns the pixel count inside a rectangle from an integral image built by ComputeIntegrals().
+         * @param integral One range's integral image.
+         * @param rect Rectangle in image coordinates (must lie inside the image).
+         * @return The number of pixels of the range inside rect.
+         */
+        static uint32_t SumRect(const cv::Mat &integral, const cv::Rect &rect);
+
+    private:
+        /**
+         * @brief A registered HSV range.
+         */
+        struct HsvRange
+        {
+            cv::Scalar lower; ///< Lower HSV bounds
+            cv::Scalar upper; ///< Upper HSV bounds
+        };
+
+        std::vector<HsvRange> ranges;            ///< Registered ranges, bit i of a class mask = ranges[i]
+        std::vector<uint32_t> classMasks;        ///< Range bitmask per colour class
+        std::vector<uint32_t> coarse;            ///< Per coarse bin: class id, or kFineFlag | fine table index
+        std::vector<uint8_t> fine;               ///< 64 class ids per boundary bin
+        std::vector<uint8_t> rangeMembers;       ///< [range * kMaxClasses + class] = 1 if the class is in the range
+        mutable std::vector<uint8_t> rowClasses; ///< ComputeIntegrals() scratch: class of each pixel of a row
+        bool compiled = false;                   ///< Set by Compile()
+    };
+} // namespace SH3DS::Vision
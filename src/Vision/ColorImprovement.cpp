@@ -1,5 +1,7 @@
 #include "Vision/ColorImprovement.h"
 
+#include "Vision/FrameStatistics.h"
+
 #include <opencv2/imgproc.hpp>
 
 #include <algorithm>
@@ -30,10 +32,32 @@ namespace
 namespace SH3DS::Vision
 {
     cv::Mat ImproveFrameColors(const cv::Mat &frame, const ColorImprovementConfig &config)
+    {
+        Core::FrameStatistics statistics;
+        ComputeFrameStatistics(frame, statistics);
+        return ImproveFrameColors(frame, statistics, config);
+    }
+
+    cv::Mat ImproveFrameColors(const cv::Mat &frame,
+        Core::FrameStatistics &statistics,
+        const ColorImprovementConfig &config)
+    {
+        ColorImprovementBuffers buffers;
+        cv::Mat outputFrame;
+        ImproveFrameColorsInto(frame, outputFrame, statistics, buffers, config);
+        return outputFrame;
+    }
+
+    void ImproveFrameColorsInto(const cv::Mat &frame,
+        cv::Mat &output,
+        Core::FrameStatistics &statistics,
+        ColorImprovementBuffers &buffers,
+        const ColorImprovementConfig &config)
     {
         if (frame.empty() || frame.type() != CV_8UC3)
         {
-            return frame;
+            output = frame;
+            return;
         }
 
         // Cache CLAHE and gamma LUT — rebuilt only when config changes.
@@ -51,52 +75,46 @@ namespace SH3DS::Vision
             cachedConfig = config;
         }
 
-        cv::Mat working;
-
         // ------------------------------------------------------------------
         // Stage 1: Gray World white balance
         // ------------------------------------------------------------------
-        cv::Mat floatFrame;
-        frame.convertTo(floatFrame, CV_32FC3, 1.0 / 255.0);
-
-        cv::Scalar means = cv::mean(floatFrame);
-        double grayMean = (means[0] + means[1] + means[2]) / 3.0;
-
-        std::array<cv::Mat, 3> channels;
-        cv::split(floatFrame, channels.data());
+        // Gains come from the shared channel means and are applied through a per-channel LUT: one 8-bit pass
+        // instead of the float convert / split / scale / merge round trip.
+        if (statistics.pixelCount == 0)
+        {
+            ComputeFrameStatistics(frame, statistics);
+        }
+        const auto &means = statistics.channelMeans;
+        const double grayMean = (means[0] + means[1] + means[2]) / 3.0 / 255.0;
+        buffers.gainLut.create(1, 256, CV_8UC3);
+        auto *gains = buffers.gainLut.ptr<cv::Vec3b>();
         for (std::size_t c = 0; c < 3; ++c)
         {
-            double channelMean = means[static_cast<int>(c)];
-            double safeMean = std::max(channelMean, 1e-4);
-            double gain = std::clamp(grayMean / safeMean, config.wbGainMin, config.wbGainMax);
-            channels[c].convertTo(channels[c], -1, gain);
-
-            cv::threshold(channels[c], channels[c], 1.0, 1.0, cv::THRESH_TRUNC);
+            const double channelMean = std::max(means[c] / 255.0, 1e-4);
+            const double gain = std::clamp(grayMean / channelMean, config.wbGainMin, config.wbGainMax);
+            for (int i = 0; i < 256; ++i)
+            {
+                const double balanced = std::min(static_cast<double>(i) / 255.0 * gain, 1.0);
+                gains[i][static_cast<int>(c)] = cv::saturate_cast<uchar>(balanced * 255.0);
+            }
         }
-        cv::merge(channels.data(), 3, floatFrame);
-
-        floatFrame.convertTo(working, CV_8UC3, 255.0);
+        cv::LUT(frame, buffers.gainLut, buffers.working);
 
         // ------------------------------------------------------------------
         // Stage 2: CLAHE on the L channel (LAB space)
         // ------------------------------------------------------------------
-        cv::Mat lab;
-        cv::cvtColor(working, lab, cv::COLOR_BGR2Lab);
-
-        std::array<cv::Mat, 3> labChannels;
-        cv::split(lab, labChannels.data());
+        auto &labChannels = buffers.labChannels;
+        cv::cvtColor(buffers.working, buffers.lab, cv::COLOR_BGR2Lab);
+        cv::split(buffers.lab, labChannels.data());
 
         cachedClahe->apply(labChannels[0], labChannels[0]);
 
-        cv::merge(labChannels.data(), 3, lab);
-        cv::cvtColor(lab, working, cv::COLOR_Lab2BGR);
+        cv::merge(labChannels.data(), labChannels.size(), buffers.lab);
+        cv::cvtColor(buffers.lab, buffers.working, cv::COLOR_Lab2BGR);
 
         // ------------------------------------------------------------------
-        // Stage 3: Gamma correction via LUT
+        // Stage 3: Gamma correction via LUT, measuring the corrected frame on the way
         // ------------------------------------------------------------------
-        cv::Mat outputFrame;
-        cv::LUT(working, cachedGammaLut, outputFrame);
-
-        return outputFrame;
+        ApplyLutWithStatistics(buffers.working, cachedGammaLut, output, statistics);
     }
 } // namespace SH3DS::Vision
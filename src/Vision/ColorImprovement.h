@@ -1,7 +1,11 @@
 #pragma once
 
+#include "Core/Types.h"
+
 #include <opencv2/core.hpp>
 
+#include <array>
+
 namespace SH3DS::Vision
 {
     /**
@@ -17,6 +21,17 @@ namespace SH3DS::Vision
         double gamma = 1.1;          ///< Gamma value (> 1.0 darkens midtones/shadows)
     };
 
+    /**
+     * @brief Intermediate images of ImproveFrameColorsInto(), kept by the caller so they are reused across frames.
+     */
+    struct ColorImprovementBuffers
+    {
+        cv::Mat gainLut;                    ///< Per-channel Gray World gain LUT (1x256, 8UC3)
+        cv::Mat working;                    ///< White-balanced frame, later the CLAHE result in BGR
+        cv::Mat lab;                        ///< Lab image around the CLAHE stage
+        std::array<cv::Mat, 3> labChannels; ///< Split Lab planes (L is equalised in place)
+    };
+
     /**
      * @brief Applies a three-stage color correction to a warped screen frame.
      *
@@ -33,4 +48,40 @@ namespace SH3DS::Vision
      * @return Corrected BGR image.
      */
     [[nodiscard]] cv::Mat ImproveFrameColors(const cv::Mat &frame, const ColorImprovementConfig &config = {});
+
+    /**
+     * @brief Applies the same correction using statistics the caller already gathered for @p frame.
+     *
+     * Gray World takes its channel means from @p statistics instead of measuring the frame again, and the
+     * final gamma pass refreshes @p statistics for the corrected image at no extra cost, so consumers
+     * downstream (e.g. the FSM's intensity detector) can share them.
+     *
+     * @param frame      BGR image to correct.
+     * @param statistics On entry the statistics of @p frame (see ComputeFrameStatistics()); on return those of
+     *                   the corrected image. Left untouched for unsupported formats.
+     * @param config     Pipeline parameters (defaults give sensible results).
+     * @return Corrected BGR image.
+     */
+    [[nodiscard]] cv::Mat ImproveFrameColors(const cv::Mat &frame,
+        Core::FrameStatistics &statistics,
+        const ColorImprovementConfig &config = {});
+
+    /**
+     * @brief Applies the statistics-sharing correction into caller-owned images.
+     *
+     * Same result as ImproveFrameColors(frame, statistics, config), but every intermediate lives in @p buffers and
+     * the result is written into @p output, so a caller that keeps both across frames of one size allocates no
+     * image after the first frame. @p frame is only read by the first stage, so @p output may be @p frame itself.
+     *
+     * @param frame      BGR image to correct.
+     * @param output     Receives the corrected image (a header sharing @p frame for unsupported formats).
+     * @param statistics On entry the statistics of @p frame; on return those of @p output.
+     * @param buffers    Scratch images reused between calls.
+     * @param config     Pipeline parameters (defaults give sensible results).
+     */
+    void ImproveFrameColorsInto(const cv::Mat &frame,
+        cv::Mat &output,
+        Core::FrameStatistics &statistics,
+        ColorImprovementBuffers &buffers,
+        const ColorImprovementConfig &config = {});
 } // namespace SH3DS::Vision
@@ -1,15 +1,18 @@
 #include "DominantColorDetector.h"
 
-#include "Kappa/Logger.h"
-
-#include <opencv2/imgproc.hpp>
+#include "Core/Logger.h"
 
 #include <algorithm>
-#include <map>
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace
 {
+    constexpr std::string_view kMethodName = "dominant_color"; ///< Reported in ShinyResult::method
+
     /**
      * @brief Swaps lower/upper bounds if inverted and warns about Hue overflow.
      * @param lower Lower bound HSV values.
@@ -36,108 +39,66 @@ namespace
 
 namespace SH3DS::Vision
 {
-    DominantColorDetector::DominantColorDetector(Core::DetectionMethodConfig config, std::string profileId)
+    DominantColorDetector::DominantColorDetector(Core::DetectionMethodConfig config,
+        std::string profileId,
+        std::shared_ptr<SequenceEvaluator> sequenceEvaluator)
         : config(std::move(config)),
-          id(std::move(profileId))
+          id(std::move(profileId)),
+          sequenceEvaluator(std::move(sequenceEvaluator))
     {
         ValidateHsvRange(this->config.normalHsvLower, this->config.normalHsvUpper, "normal");
         ValidateHsvRange(this->config.shinyHsvLower, this->config.shinyHsvUpper, "shiny");
+
+        normalRange = colorClassifier.AddRange(this->config.normalHsvLower, this->config.normalHsvUpper);
+        shinyRange = colorClassifier.AddRange(this->config.shinyHsvLower, this->config.shinyHsvUpper);
+        colorClassifier.Compile();
     }
 
     Core::ShinyResult DominantColorDetector::Detect(const cv::Mat &pokemonRoi) const
     {
+        Core::ShinyResult result{ .method = kMethodName };
         if (pokemonRoi.empty())
         {
-            return { .verdict = Core::ShinyVerdict::Uncertain,
-                .confidence = 0.0,
-                .method = "dominant_color",
-                .details = {},
-                .debugImage = {} };
+            return result;
         }
 
-        cv::Mat hsv;
-        cv::cvtColor(pokemonRoi, hsv, cv::COLOR_BGR2HSV);
-
-        cv::Mat normalMask;
-        cv::inRange(hsv, config.normalHsvLower, config.normalHsvUpper, normalMask);
-        double normalRatio = cv::countNonZero(normalMask) / static_cast<double>(pokemonRoi.total());
-
-        cv::Mat shinyMask;
-        cv::inRange(hsv, config.shinyHsvLower, config.shinyHsvUpper, shinyMask);
-        double shinyRatio = cv::countNonZero(shinyMask) / static_cast<double>(pokemonRoi.total());
+        std::array<uint32_t, ColorClassifier::kMaxRanges> counts{};
+        colorClassifier.CountPixels(pokemonRoi, counts);
+        const double total = static_cast<double>(pokemonRoi.total());
+        const double normalRatio = counts[static_cast<std::size_t>(normalRange)] / total;
+        const double shinyRatio = counts[static_cast<std::size_t>(shinyRange)] / total;
 
-        std::string details = "normal=" + std::to_string(normalRatio) + " shiny=" + std::to_string(shinyRatio);
+        result.diagnostics.Add("normal", normalRatio);
+        result.diagnostics.Add("shiny", shinyRatio);
 
         if (shinyRatio >= config.shinyRatioThreshold && shinyRatio > normalRatio)
         {
-            return {
-                .verdict = Core::ShinyVerdict::Shiny,
-                .confidence = std::min(shinyRatio / config.shinyRatioThreshold, 1.0),
-                .method = "dominant_color",
-                .details = details,
-                .debugImage = {},
-            };
+            result.verdict = Core::ShinyVerdict::Shiny;
+            result.confidence = std::min(shinyRatio / config.shinyRatioThreshold, 1.0);
         }
-
-        if (normalRatio >= config.normalRatioThreshold)
+        else if (normalRatio >= config.normalRatioThreshold)
         {
-            return {
-                .verdict = Core::ShinyVerdict::NotShiny,
-                .confidence = std::min(normalRatio / config.normalRatioThreshold, 1.0),
-                .method = "dominant_color",
-                .details = details,
-                .debugImage = {},
-            };
+            result.verdict = Core::ShinyVerdict::NotShiny;
+            result.confidence = std::min(normalRatio / config.normalRatioThreshold, 1.0);
         }
-
-        return {
-            .verdict = Core::ShinyVerdict::Uncertain,
-            .confidence = 0.0,
-            .method = "dominant_color",
-            .details = details,
-            .debugImage = {},
-        };
+        return result;
     }
 
     Core::ShinyResult DominantColorDetector::DetectSequence(std::span<const cv::Mat> rois) const
     {
         if (rois.empty())
         {
-            return { .verdict = Core::ShinyVerdict::Uncertain,
-                .confidence = 0.0,
-                .method = "dominant_color",
-                .details = {},
-                .debugImage = {} };
-        }
-
-        std::map<Core::ShinyVerdict, int> votes;
-        std::map<Core::ShinyVerdict, double> totalConfidence;
-
-        for (const auto &roi : rois)
-        {
-            auto res = Detect(roi);
-            votes[res.verdict]++;
-            totalConfidence[res.verdict] += res.confidence;
+            return { .method = kMethodName };
         }
 
-        // Find the verdict with the most votes
-        Core::ShinyVerdict winner = Core::ShinyVerdict::Uncertain;
-        int maxVotes = -1;
-
-        for (const auto &[verdict, count] : votes)
-        {
-            if (count > maxVotes)
-            {
-                maxVotes = count;
-                winner = verdict;
-            }
-        }
+        return sequenceEvaluator->Evaluate(*this, rois);
+    }
 
-        return { .verdict = winner,
-            .confidence = totalConfidence[winner] / static_cast<double>(maxVotes),
-            .method = "dominant_color",
-            .details = "sequence_majority_vote: count=" + std::to_string(maxVotes) + "/" + std::to_string(rois.size()),
-            .debugImage = {} };
+    std::vector<Core::ShinyResult> DominantColorDetector::DetectBatch(std::span<const cv::Mat> rois) const
+    {
+        std::vector<Core::ShinyResult> results(rois.size());
+        sequenceEvaluator->EvaluateEach(*this, rois, results);
+        return results;
     }
 
     std::string DominantColorDetector::ProfileId() const
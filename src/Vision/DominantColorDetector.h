@@ -1,9 +1,12 @@
 #pragma once
 
+#include "ColorClassifier.h"
+#include "SequenceEvaluator.h"
 #include "ShinyDetector.h"
 
 #include <span>
 #include <string>
+#include <vector>
 
 namespace SH3DS::Vision
 {
@@ -17,8 +20,11 @@ namespace SH3DS::Vision
          * @brief Constructs a DominantColorDetector.
          * @param config Detection method configuration with HSV bounds and ratio thresholds.
          * @param profileId Profile identifier for this detector instance.
+         * @param sequenceEvaluator Worker pool for DetectSequence() / DetectBatch().
          */
-        explicit DominantColorDetector(Core::DetectionMethodConfig config, std::string profileId);
+        DominantColorDetector(Core::DetectionMethodConfig config,
+            std::string profileId,
+            std::shared_ptr<SequenceEvaluator> sequenceEvaluator = SequenceEvaluator::Shared());
 
         /**
          * @brief Detects shiny status from a single ROI frame.
@@ -26,10 +32,17 @@ namespace SH3DS::Vision
         Core::ShinyResult Detect(const cv::Mat &pokemonRoi) const override;
 
         /**
-         * @brief Detects shiny status from a sequence of ROI frames (uses middle frame).
+         * @brief Detects shiny status from a sequence of ROI frames by majority vote.
+         *
+         * Frames are evaluated in parallel and evaluation stops once the remaining frames cannot change the vote.
          */
         Core::ShinyResult DetectSequence(std::span<const cv::Mat> rois) const override;
 
+        /**
+         * @brief Detects shiny status in each sprite slot of a frame, evaluating the slots in parallel.
+         */
+        std::vector<Core::ShinyResult> DetectBatch(std::span<const cv::Mat> rois) const override;
+
         /**
          * @brief Returns the profile identifier.
          */
@@ -50,7 +63,11 @@ namespace SH3DS::Vision
             const std::string &profileId);
 
     private:
-        Core::DetectionMethodConfig config; ///< Detection method configuration
-        std::string id;                     ///< Profile identifier
+        Core::DetectionMethodConfig config;                   ///< Detection method configuration
+        std::string id;                                       ///< Profile identifier
+        ColorClassifier colorClassifier;                      ///< Normal and shiny ranges in one lookup table
+        int normalRange = 0;                                  ///< Index of the normal range in colorClassifier
+        int shinyRange = 0;                                   ///< Index of the shiny range in colorClassifier
+        std::shared_ptr<SequenceEvaluator> sequenceEvaluator; ///< Shared pool for DetectSequence() / DetectBatch()
     };
 } // namespace SH3DS::Vision
@@ -0,0 +1,92 @@
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace SH3DS::Vision
+{
+    namespace
+    {
+        // BT.601 luma weights in 8-bit fixed point (sum 256).
+        constexpr uint32_t kLumaB = 29;
+        constexpr uint32_t kLumaG = 150;
+        constexpr uint32_t kLumaR = 77;
+
+        /**
+         * @brief Shared pass of ComputeFrameStatistics and ApplyLutWithStatistics.
+         * @param bgr 8-bit 3-channel input.
+         * @param lut Per-value mapping applied before measuring, or nullptr to measure the input as-is.
+         * @param output Receives the mapped image when @p lut is set.
+         * @param statistics Output statistics.
+         */
+        void Accumulate(const cv::Mat &bgr, const uchar *lut, cv::Mat *output, Core::FrameStatistics &statistics)
+        {
+            statistics = {};
+            if (bgr.empty() || bgr.type() != CV_8UC3)
+            {
+                return;
+            }
+
+            uint64_t sumB = 0;
+            uint64_t sumG = 0;
+            uint64_t sumR = 0;
+            uint64_t sumV = 0;
+            auto &histogram = statistics.luminanceHistogram;
+            for (int y = 0; y < bgr.rows; ++y)
+            {
+                const uchar *in = bgr.ptr<uchar>(y);
+                uchar *out = output ? output->ptr<uchar>(y) : nullptr;
+                for (int x = 0; x < bgr.cols; ++x, in += 3)
+                {
+                    uint32_t b = in[0];
+                    uint32_t g = in[1];
+                    uint32_t r = in[2];
+                    if (lut)
+                    {
+                        b = lut[b];
+                        g = lut[g];
+                        r = lut[r];
+                        out[0] = static_cast<uchar>(b);
+                        out[1] = static_cast<uchar>(g);
+                        out[2] = static_cast<uchar>(r);
+                        out += 3;
+                    }
+                    sumB += b;
+                    sumG += g;
+                    sumR += r;
+                    sumV += std::max({ b, g, r });
+                    ++histogram[(b * kLumaB + g * kLumaG + r * kLumaR + 128) >> 8];
+                }
+            }
+
+            const uint64_t count = bgr.total();
+            const auto pixels = static_cast<double>(count);
+            statistics.channelMeans = { static_cast<double>(sumB) / pixels,
+                static_cast<double>(sumG) / pixels,
+                static_cast<double>(sumR) / pixels };
+            statistics.meanV = static_cast<double>(sumV) / pixels / 255.0;
+            statistics.pixelCount = count;
+            statistics.source = output ? output->data : bgr.data;
+        }
+    } // namespace
+
+    void ComputeFrameStatistics(const cv::Mat &bgr, Core::FrameStatistics &statistics)
+    {
+        Accumulate(bgr, nullptr, nullptr, statistics);
+    }
+
+    void ApplyLutWithStatistics(const cv::Mat &bgr,
+        const cv::Mat &lut,
+        cv::Mat &output,
+        Core::FrameStatistics &statistics)
+    {
+        if (bgr.type() != CV_8UC3 || lut.type() != CV_8UC1 || lut.total() != 256 || !lut.isContinuous())
+        {
+            throw std::runtime_error("ApplyLutWithStatistics: expected an 8-bit BGR image and a 256-entry CV_8U LUT");
+        }
+
+        output.create(bgr.size(), CV_8UC3);
+        Accumulate(bgr, lut.ptr<uchar>(), &output, statistics);
+    }
+} // namespace SH3DS::Vision
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Core/Types.h"
+
+#include <opencv2/core.hpp>
+
+namespace SH3DS::Vision
+{
+    /**
+     * @brief Computes channel means, mean V and the luma histogram of a BGR image in a single pass.
+     *
+     * Mean V matches the mean of cvtColor(COLOR_BGR2HSV)'s V channel exactly, without the hue and saturation
+     * work. Images that are not 8-bit 3-channel leave @p statistics default (pixelCount 0).
+     *
+     * @param bgr The image (an ROI view is fine).
+     * @param statistics Output statistics.
+     */
+    void ComputeFrameStatistics(const cv::Mat &bgr, Core::FrameStatistics &statistics);
+
+    /**
+     * @brief Maps every channel of a BGR image through a LUT and gathers the statistics of the result in the
+     * same pass.
+     * @param bgr 8-bit 3-channel input image.
+     * @param lut 256-entry CV_8U look-up table applied to all channels.
+     * @param output Output image (reallocated only if its size or type differ).
+     * @param statistics Statistics of @p output.
+     */
+    void ApplyLutWithStatistics(const cv::Mat &bgr,
+        const cv::Mat &lut,
+        cv::Mat &output,
+        Core::FrameStatistics &statistics);
+} // namespace SH3DS::Vision
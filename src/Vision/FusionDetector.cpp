@@ -0,0 +1,259 @@
+#include "FusionDetector.h"
+
+#include "CnnDetector.h"
+#include "Core/Logger.h"
+#include "DominantColorDetector.h"
+#include "HistogramDetector.h"
+#include "SparkleDetector.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace SH3DS::Vision
+{
+    namespace
+    {
+        constexpr std::string_view kMethodName = "fusion"; ///< Reported in ShinyResult::method
+
+        /**
+         * @brief Maps a method's verdict onto the fused shiny score in [0, 1].
+         * @param result The method's result.
+         * @return 0.5 +/- half the confidence, or 0.5 for Uncertain.
+         */
+        double ShinyScore(const Core::ShinyResult &result)
+        {
+            const double confidence = std::clamp(result.confidence, 0.0, 1.0);
+            switch (result.verdict)
+            {
+            case Core::ShinyVerdict::Shiny:
+                return 0.5 + 0.5 * confidence;
+            case Core::ShinyVerdict::NotShiny:
+                return 0.5 - 0.5 * confidence;
+            case Core::ShinyVerdict::Uncertain:
+                break;
+            }
+            return 0.5;
+        }
+    } // namespace
+
+    FusionDetector::FusionDetector(std::vector<Member> members,
+        Core::FusionConfig fusion,
+        std::string profileId,
+        std::shared_ptr<SequenceEvaluator> sequenceEvaluator)
+        : fusion(fusion),
+          id(std::move(profileId)),
+          sequenceEvaluator(std::move(sequenceEvaluator))
+    {
+        for (auto &member : members)
+        {
+            if (!member.detector || member.weight <= 0.0)
+            {
+                LOG_WARN("FusionDetector: dropping method with weight {} for profile {}", member.weight, id);
+                continue;
+            }
+            totalWeight += member.weight;
+            this->members.push_back(std::move(member));
+        }
+
+        // Heaviest first: the fused score's bounds tighten fastest, so short-circuiting happens earliest.
+        std::stable_sort(this->members.begin(), this->members.end(), [](const Member &a, const Member &b) {
+            return a.weight > b.weight;
+        });
+    }
+
+    Core::ShinyResult FusionDetector::Detect(const cv::Mat &pokemonRoi) const
+    {
+        if (pokemonRoi.empty() || members.empty())
+        {
+            return { .method = kMethodName, .note = members.empty() ? "no detection methods" : "" };
+        }
+
+        FusedScore score;
+        score.remainingWeight = totalWeight;
+        for (const auto &member : members)
+        {
+            if (Accumulate(score, member, member.detector->Detect(pokemonRoi)))
+            {
+                break;
+            }
+        }
+        return MakeResult(score);
+    }
+
+    Core::ShinyResult FusionDetector::DetectSequence(std::span<const cv::Mat> rois) const
+    {
+        if (rois.empty())
+        {
+            return { .method = kMethodName };
+        }
+
+        return sequenceEvaluator->Evaluate(*this, rois);
+    }
+
+    std::vector<Core::ShinyResult> FusionDetector::DetectBatch(std::span<const cv::Mat> rois) const
+    {
+        FusedScore initial;
+        initial.remainingWeight = totalWeight;
+        std::vector<Core::ShinyResult> results(rois.size());
+        std::vector<FusedScore> scores(rois.size(), initial);
+        std::vector<std::size_t> pending;
+        for (std::size_t i = 0; i < rois.size(); ++i)
+        {
+            if (rois[i].empty() || members.empty())
+            {
+                results[i] = Detect(rois[i]);
+            }
+            else
+            {
+                pending.push_back(i);
+            }
+        }
+
+        std::vector<cv::Mat> batch;
+        for (const auto &member : members)
+        {
+            if (pending.empty())
+            {
+                break;
+            }
+
+            batch.clear();
+            for (const std::size_t slot : pending)
+            {
+                batch.push_back(rois[slot]);
+            }
+            const std::vector<Core::ShinyResult> memberResults = member.detector->DetectBatch(batch);
+
+            // Settled slots drop out; the rest stay pending for the next method.
+            std::size_t kept = 0;
+            for (std::size_t j = 0; j < pending.size(); ++j)
+            {
+                const std::size_t slot = pending[j];
+                if (Accumulate(scores[slot], member, memberResults[j]))
+                {
+                    results[slot] = MakeResult(scores[slot]);
+                }
+                else
+                {
+                    pending[kept++] = slot;
+                }
+            }
+            pending.resize(kept);
+        }
+
+        for (const std::size_t slot : pending)
+        {
+            results[slot] = MakeResult(scores[slot]);
+        }
+        return results;
+    }
+
+    std::string FusionDetector::ProfileId() const
+    {
+        return id;
+    }
+
+    void FusionDetector::Reset()
+    {
+        for (auto &member : members)
+        {
+            member.detector->Reset();
+        }
+    }
+
+    std::size_t FusionDetector::MemberCount() const
+    {
+        return members.size();
+    }
+
+    std::unique_ptr<ShinyDetector> FusionDetector::CreateMethodDetector(const Core::DetectionMethodConfig &config,
+        const std::string &profileId)
+    {
+        if (config.method == "dominant_color")
+        {
+            return DominantColorDetector::CreateDominantColorDetector(config, profileId);
+        }
+        if (config.method == "histogram_compare")
+        {
+            return HistogramDetector::CreateHistogramDetector(config, profileId);
+        }
+        if (config.method == "cnn")
+        {
+            return CnnDetector::CreateCnnDetector(config, profileId);
+        }
+        if (config.method == "sparkle")
+        {
+            return SparkleDetector::CreateSparkleDetector(config, profileId);
+        }
+        return nullptr;
+    }
+
+    const std::string &FusionDetector::MethodRoi(const Core::DetectionMethodConfig &config)
+    {
+        return config.method == "sparkle" ? config.sparkleRoi : config.roi;
+    }
+
+    std::unique_ptr<ShinyDetector> FusionDetector::CreateFusionDetector(const Core::DetectionProfile &profile)
+    {
+        std::vector<Member> members;
+        for (const auto &method : profile.methods)
+        {
+            auto detector = CreateMethodDetector(method, profile.profileId);
+            if (!detector)
+            {
+                LOG_WARN("FusionDetector: skipping unsupported method '{}' in profile {}",
+                    method.method,
+                    profile.profileId);
+                continue;
+            }
+            members.push_back({ .detector = std::move(detector), .weight = method.weight });
+        }
+
+        LOG_INFO("FusionDetector: {} of {} methods active for profile {}",
+            members.size(),
+            profile.methods.size(),
+            profile.profileId);
+        return std::make_unique<FusionDetector>(std::move(members), profile.fusion, profile.profileId);
+    }
+
+    bool FusionDetector::Accumulate(FusedScore &score, const Member &member, const Core::ShinyResult &result) const
+    {
+        score.weightedScore += member.weight * ShinyScore(result);
+        ++score.evaluated;
+        score.remainingWeight = score.evaluated == members.size() ? 0.0 : score.remainingWeight - member.weight;
+        score.methodScores.Add(result.method, ShinyScore(result));
+
+        // The final score lies in [low, high] whatever the methods not yet run return.
+        score.low = score.weightedScore / totalWeight;
+        score.high = (score.weightedScore + score.remainingWeight) / totalWeight;
+        return score.low >= fusion.shinyThreshold || score.high < fusion.uncertainThreshold
+               || (score.low >= fusion.uncertainThreshold && score.high < fusion.shinyThreshold);
+    }
+
+    Core::ShinyResult FusionDetector::MakeResult(const FusedScore &score) const
+    {
+        // Fused entries first: with more members than fit, per-method scores are what gets dropped.
+        Core::ShinyResult result{ .method = kMethodName };
+        result.diagnostics.Add("score_low", score.low);
+        result.diagnostics.Add("score_high", score.high);
+        result.diagnostics.Add("evaluated", static_cast<double>(score.evaluated), static_cast<double>(members.size()));
+        for (std::size_t i = 0; i < score.methodScores.count; ++i)
+        {
+            result.diagnostics.Add(score.methodScores.entries[i].name, score.methodScores.entries[i].value);
+        }
+
+        if (score.low >= fusion.shinyThreshold)
+        {
+            result.verdict = Core::ShinyVerdict::Shiny;
+            result.confidence = score.low;
+        }
+        else if (score.high < fusion.uncertainThreshold)
+        {
+            result.verdict = Core::ShinyVerdict::NotShiny;
+            result.confidence = 1.0 - score.high;
+        }
+        return result;
+    }
+} // namespace SH3DS::Vision
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "SequenceEvaluator.h"
+#include "ShinyDetector.h"
+
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SH3DS::Vision
+{
+    /**
+     * @brief Combines several shiny detection methods into one weighted verdict.
+     *
+     * Each method's verdict is mapped to a shiny score in [0, 1] (0.5 + confidence / 2 for Shiny, 0.5 - confidence
+     * / 2 for NotShiny, 0.5 for Uncertain) and the weighted mean is compared against FusionConfig: at least
+     * shinyThreshold is Shiny, below uncertainThreshold is NotShiny, anything between is Uncertain. Methods run
+     * heaviest weight first and evaluation stops as soon as the remaining weight can no longer move the mean
+     * across either threshold.
+     */
+    class FusionDetector : public ShinyDetector
+    {
+    public:
+        /**
+         * @brief One fused method.
+         */
+        struct Member
+        {
+            std::unique_ptr<ShinyDetector> detector; ///< The method's detector
+            double weight = 1.0;                     ///< Weight in the fused score (must be positive)
+        };
+
+        /**
+         * @brief Constructs a FusionDetector.
+         * @param members Methods to fuse; members with a non-positive weight or no detector are dropped.
+         * @param fusion Fusion thresholds.
+         * @param profileId Profile identifier for this detector instance.
+         * @param sequenceEvaluator Worker pool for DetectSequence().
+         */
+        FusionDetector(std::vector<Member> members,
+            Core::FusionConfig fusion,
+            std::string profileId,
+            std::shared_ptr<SequenceEvaluator> sequenceEvaluator = SequenceEvaluator::Shared());
+
+        /**
+         * @brief Detects shiny status from a single ROI frame by running the methods in weight order.
+         */
+        Core::ShinyResult Detect(const cv::Mat &pokemonRoi) const override;
+
+        /**
+         * @brief Detects shiny status from a sequence of ROI frames by majority vote over the fused verdicts.
+         *
+         * Frames are evaluated in parallel and evaluation stops once the remaining frames cannot change the vote.
+         */
+        Core::ShinyResult DetectSequence(std::span<const cv::Mat> rois) const override;
+
+        /**
+         * @brief Detects shiny status in each sprite slot of a frame.
+         *
+         * Methods run member-major: each method gets one DetectBatch() call over the slots it can still change,
+         * so a slot drops out as soon as its own fused score is settled.
+         */
+        std::vector<Core::ShinyResult> DetectBatch(std::span<const cv::Mat> rois) const override;
+
+        /**
+         * @brief Returns the profile identifier.
+         */
+        std::string ProfileId() const override;
+
+        /**
+         * @brief Resets every fused method.
+         */
+        void Reset() override;
+
+        /**
+         * @brief Returns the number of fused methods.
+         * @return Method count.
+         */
+        std::size_t MemberCount() const;
+
+        /**
+         * @brief Creates a detector for a single method config.
+         * @param config The detection method configuration ("dominant_color", "histogram_compare", "cnn" or
+         *        "sparkle").
+         * @param profileId The profile ID.
+         * @return The detector, or nullptr if the method is unknown.
+         */
+        static std::unique_ptr<ShinyDetector> CreateMethodDetector(const Core::DetectionMethodConfig &config,
+            const std::string &profileId);
+
+        /**
+         * @brief Returns the ROI a single method's detector reads.
+         * @param config The detection method configuration.
+         * @return sparkleRoi for "sparkle", which watches the sparkle animation rather than the sprite; roi otherwise.
+         */
+        static const std::string &MethodRoi(const Core::DetectionMethodConfig &config);
+
+        /**
+         * @brief Create a fusion detector over every method of a detection profile.
+         * @param profile The detection profile (methods, weights and fusion thresholds).
+         * @return A unique pointer to the fusion detector.
+         */
+        static std::unique_ptr<ShinyDetector> CreateFusionDetector(const Core::DetectionProfile &profile);
+
+    private:
+        /**
+         * @brief Running fused score of one ROI.
+         */
+        struct FusedScore
+        {
+            double weightedScore = 0.0;          ///< Sum of weight * score over the methods run so far
+            double remainingWeight = 0.0;        ///< Weight of the methods not run yet
+            double low = 0.0;                    ///< Lowest final score still reachable
+            double high = 1.0;                   ///< Highest final score still reachable
+            std::size_t evaluated = 0;           ///< Methods run so far
+            Core::ShinyDiagnostics methodScores; ///< Per-method shiny score, in run order (reported after the bounds)
+        };
+
+        /**
+         * @brief Folds one method's result into a fused score.
+         * @param score The ROI's fused score.
+         * @param member The method that produced the result.
+         * @param result The method's result.
+         * @return True once the remaining methods can no longer change the verdict.
+         */
+        bool Accumulate(FusedScore &score, const Member &member, const Core::ShinyResult &result) const;
+
+        /**
+         * @brief Turns a fused score into the final verdict.
+         * @param score The ROI's fused score.
+         * @return The detection result.
+         */
+        Core::ShinyResult MakeResult(const FusedScore &score) const;
+
+        std::vector<Member> members;                          ///< Fused methods, heaviest weight first
+        Core::FusionConfig fusion;                            ///< Shiny / uncertain thresholds
+        std::string id;                                       ///< Profile identifier
+        double totalWeight = 0.0;                             ///< Sum of member weights
+        std::shared_ptr<SequenceEvaluator> sequenceEvaluator; ///< Shared pool for DetectSequence()
+    };
+} // namespace SH3DS::Vision
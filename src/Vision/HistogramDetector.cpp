@@ -1,154 +1,88 @@
 #include "HistogramDetector.h"
 
-#include "Kappa/Logger.h"
-
-#include <opencv2/imgproc.hpp>
+#include "Core/Logger.h"
+#include "HistogramUtils.h"
 
 #include <algorithm>
-#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace SH3DS::Vision
 {
-    HistogramDetector::HistogramDetector(Core::DetectionMethodConfig config, std::string profileId)
+    namespace
+    {
+        constexpr std::string_view kMethodName = "histogram_compare"; ///< Reported in ShinyResult::method
+    } // namespace
+
+    HistogramDetector::HistogramDetector(Core::DetectionMethodConfig config,
+        std::string profileId,
+        std::shared_ptr<SequenceEvaluator> sequenceEvaluator)
         : config(std::move(config)),
-          id(std::move(profileId))
+          id(std::move(profileId)),
+          compareMethod(ParseHistogramCompareMethod(this->config.compareMethod)),
+          sequenceEvaluator(std::move(sequenceEvaluator))
     {
+        // Loaded up front so the first check of a hunt does not pay for file I/O.
+        normalHist = LoadReference(this->config.referenceNormal, "normal");
+        shinyHist = LoadReference(this->config.referenceShiny, "shiny");
     }
 
     Core::ShinyResult HistogramDetector::Detect(const cv::Mat &pokemonRoi) const
     {
+        Core::ShinyResult result{ .method = kMethodName };
         if (pokemonRoi.empty())
         {
-            return { .verdict = Core::ShinyVerdict::Uncertain,
-                .confidence = 0.0,
-                .method = "histogram_compare",
-                .details = {},
-                .debugImage = {} };
+            return result;
         }
 
-        // Load references lazily
-        LoadReferences();
-
-        cv::Mat hsv;
-        cv::cvtColor(pokemonRoi, hsv, cv::COLOR_BGR2HSV);
-
-        // Compute HS histogram of the ROI
-        cv::Mat roiHist;
-        int channels[] = { 0, 1 };
-        int histSize[] = { 30, 32 }; // H: 30 bins, S: 32 bins
-        float hRange[] = { 0, 180 };
-        float sRange[] = { 0, 256 };
-        const float *ranges[] = { hRange, sRange };
-        cv::calcHist(&hsv, 1, channels, cv::Mat(), roiHist, 2, histSize, ranges);
-        cv::normalize(roiHist, roiHist, 0, 1, cv::NORM_MINMAX);
-
         if (normalHist.empty() || shinyHist.empty())
         {
-            return { .verdict = Core::ShinyVerdict::Uncertain,
-                .confidence = 0.0,
-                .method = "histogram_compare",
-                .details = "missing reference histograms",
-                .debugImage = {} };
+            result.note = "missing reference histograms";
+            return result;
         }
 
-        int method = cv::HISTCMP_CORREL;
-        if (config.compareMethod == "chi_square")
-        {
-            method = cv::HISTCMP_CHISQR;
-        }
-        else if (config.compareMethod == "intersection")
-        {
-            method = cv::HISTCMP_INTERSECT;
-        }
-        else if (config.compareMethod == "bhattacharyya")
-        {
-            method = cv::HISTCMP_BHATTACHARYYA;
-        }
+        // One buffer per thread: DetectSequence() runs Detect() concurrently on the evaluator's workers.
+        thread_local cv::Mat roiHist;
+        ComputeHSHistogramInto(pokemonRoi, kHueBins, kSaturationBins, roiHist);
 
-        double normalCorr = cv::compareHist(roiHist, normalHist, method);
-        double shinyCorr = cv::compareHist(roiHist, shinyHist, method);
+        // Oriented so that higher is more similar for every method.
+        const double normalCorr = CompareHistograms(roiHist, normalHist, compareMethod);
+        const double shinyCorr = CompareHistograms(roiHist, shinyHist, compareMethod);
 
-        // Distance metrics (lower is better) need to be inverted for the differential calculation
-        if (method == cv::HISTCMP_CHISQR || method == cv::HISTCMP_BHATTACHARYYA)
-        {
-            normalCorr = -normalCorr;
-            shinyCorr = -shinyCorr;
-        }
-
-        std::string details = "normal_corr=" + std::to_string(normalCorr) + " shiny_corr=" + std::to_string(shinyCorr);
+        result.diagnostics.Add("normal_corr", normalCorr);
+        result.diagnostics.Add("shiny_corr", shinyCorr);
 
         double differential = shinyCorr - normalCorr;
 
         if (differential > config.differentialThreshold)
         {
-            return {
-                .verdict = Core::ShinyVerdict::Shiny,
-                .confidence = std::min(differential / config.differentialThreshold, 1.0),
-                .method = "histogram_compare",
-                .details = details,
-                .debugImage = {},
-            };
+            result.verdict = Core::ShinyVerdict::Shiny;
+            result.confidence = std::min(differential / config.differentialThreshold, 1.0);
         }
-
-        if (differential < -config.differentialThreshold)
+        else if (differential < -config.differentialThreshold)
         {
-            return {
-                .verdict = Core::ShinyVerdict::NotShiny,
-                .confidence = std::min(-differential / config.differentialThreshold, 1.0),
-                .method = "histogram_compare",
-                .details = details,
-                .debugImage = {},
-            };
+            result.verdict = Core::ShinyVerdict::NotShiny;
+            result.confidence = std::min(-differential / config.differentialThreshold, 1.0);
         }
-
-        return {
-            .verdict = Core::ShinyVerdict::Uncertain,
-            .confidence = 0.0,
-            .method = "histogram_compare",
-            .details = details,
-            .debugImage = {},
-        };
+        return result;
     }
 
     Core::ShinyResult HistogramDetector::DetectSequence(std::span<const cv::Mat> rois) const
     {
         if (rois.empty())
         {
-            return { .verdict = Core::ShinyVerdict::Uncertain,
-                .confidence = 0.0,
-                .method = "histogram_compare",
-                .details = {},
-                .debugImage = {} };
-        }
-
-        std::map<Core::ShinyVerdict, int> votes;
-        std::map<Core::ShinyVerdict, double> totalConfidence;
-
-        for (const auto &roi : rois)
-        {
-            auto res = Detect(roi);
-            votes[res.verdict]++;
-            totalConfidence[res.verdict] += res.confidence;
+            return { .method = kMethodName };
         }
 
-        Core::ShinyVerdict winner = Core::ShinyVerdict::Uncertain;
-        int maxVotes = -1;
-
-        for (const auto &[verdict, count] : votes)
-        {
-            if (count > maxVotes)
-            {
-                maxVotes = count;
-                winner = verdict;
-            }
-        }
+        return sequenceEvaluator->Evaluate(*this, rois);
+    }
 
-        return { .verdict = winner,
-            .confidence = totalConfidence[winner] / static_cast<double>(maxVotes),
-            .method = "histogram_compare",
-            .details = "sequence_majority_vote: count=" + std::to_string(maxVotes) + "/" + std::to_string(rois.size()),
-            .debugImage = {} };
+    std::vector<Core::ShinyResult> HistogramDetector::DetectBatch(std::span<const cv::Mat> rois) const
+    {
+        std::vector<Core::ShinyResult> results(rois.size());
+        sequenceEvaluator->EvaluateEach(*this, rois, results);
+        return results;
     }
 
     std::string HistogramDetector::ProfileId() const
@@ -161,39 +95,31 @@ namespace SH3DS::Vision
         // No internal state to reset
     }
 
-    void HistogramDetector::LoadReferences() const
+    cv::Mat HistogramDetector::LoadReference(const std::string &path, const char *name)
     {
-        if (referencesLoaded)
+        if (path.empty())
         {
-            return;
+            return {};
         }
-        referencesLoaded = true;
 
-        if (!config.referenceNormal.empty())
+        cv::Mat hist = LoadHistogram(path);
+        if (hist.empty())
         {
-            cv::FileStorage fs(config.referenceNormal, cv::FileStorage::READ);
-            if (fs.isOpened())
-            {
-                fs["histogram"] >> normalHist;
-            }
-            else
-            {
-                LOG_WARN("Failed to load normal histogram: {}", config.referenceNormal);
-            }
+            LOG_WARN("Failed to load {} histogram: {}", name, path);
+            return {};
         }
-
-        if (!config.referenceShiny.empty())
+        if (hist.rows != kHueBins || hist.cols != kSaturationBins)
         {
-            cv::FileStorage fs(config.referenceShiny, cv::FileStorage::READ);
-            if (fs.isOpened())
-            {
-                fs["histogram"] >> shinyHist;
-            }
-            else
-            {
-                LOG_WARN("Failed to load shiny histogram: {}", config.referenceShiny);
-            }
+            LOG_WARN("Ignoring {} histogram {}: expected {}x{} bins, got {}x{}",
+                name,
+                path,
+                kHueBins,
+                kSaturationBins,
+                hist.rows,
+                hist.cols);
+            return {};
         }
+        return hist;
     }
 
     std::unique_ptr<ShinyDetector> HistogramDetector::CreateHistogramDetector(const Core::DetectionMethodConfig &config,
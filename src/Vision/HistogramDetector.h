@@ -1,11 +1,14 @@
 #pragma once
 
+#include "HistogramUtils.h"
+#include "SequenceEvaluator.h"
 #include "ShinyDetector.h"
 
 #include <opencv2/core.hpp>
 
 #include <span>
 #include <string>
+#include <vector>
 
 namespace SH3DS::Vision
 {
@@ -16,11 +19,14 @@ namespace SH3DS::Vision
     {
     public:
         /**
-         * @brief Constructs a HistogramDetector.
+         * @brief Constructs a HistogramDetector and loads its reference histograms.
          * @param config Detection method configuration with reference paths and comparison settings.
          * @param profileId Profile identifier for this detector instance.
+         * @param sequenceEvaluator Worker pool for DetectSequence() / DetectBatch().
          */
-        explicit HistogramDetector(Core::DetectionMethodConfig config, std::string profileId);
+        HistogramDetector(Core::DetectionMethodConfig config,
+            std::string profileId,
+            std::shared_ptr<SequenceEvaluator> sequenceEvaluator = SequenceEvaluator::Shared());
 
         /**
          * @brief Detects shiny status from a single ROI frame.
@@ -28,10 +34,17 @@ namespace SH3DS::Vision
         Core::ShinyResult Detect(const cv::Mat &pokemonRoi) const override;
 
         /**
-         * @brief Detects shiny status from a sequence of ROI frames (uses middle frame).
+         * @brief Detects shiny status from a sequence of ROI frames by majority vote.
+         *
+         * Frames are evaluated in parallel and evaluation stops once the remaining frames cannot change the vote.
          */
         Core::ShinyResult DetectSequence(std::span<const cv::Mat> rois) const override;
 
+        /**
+         * @brief Detects shiny status in each sprite slot of a frame, evaluating the slots in parallel.
+         */
+        std::vector<Core::ShinyResult> DetectBatch(std::span<const cv::Mat> rois) const override;
+
         /**
          * @brief Returns the profile identifier.
          */
@@ -52,16 +65,23 @@ namespace SH3DS::Vision
             const std::string &profileId);
 
     private:
+        static constexpr int kHueBins = 30;        ///< Hue bins over [0, 180)
+        static constexpr int kSaturationBins = 32; ///< Saturation bins over [0, 256)
+
         /**
-         * @brief Lazily loads reference histograms from configured file paths.
+         * @brief Loads and validates a reference histogram.
+         * @param path Reference file (YAML/XML or binary ".hist"); empty means not configured.
+         * @param name Reference name for log messages.
+         * @return The histogram, or an empty Mat if missing or of the wrong size.
          */
-        void LoadReferences() const;
+        static cv::Mat LoadReference(const std::string &path, const char *name);
 
-        Core::DetectionMethodConfig config;    ///< Detection method configuration
-        std::string id;                        ///< Profile identifier
-        mutable cv::Mat normalHist;            ///< Reference histogram for normal appearance
-        mutable cv::Mat shinyHist;             ///< Reference histogram for shiny appearance
-        mutable bool referencesLoaded = false; ///< Whether references have been loaded
+        Core::DetectionMethodConfig config;                   ///< Detection method configuration
+        std::string id;                                       ///< Profile identifier
+        HistogramCompareMethod compareMethod;                 ///< Parsed config.compareMethod
+        cv::Mat normalHist;                                   ///< Reference histogram for normal appearance
+        cv::Mat shinyHist;                                    ///< Reference histogram for shiny appearance
+        std::shared_ptr<SequenceEvaluator> sequenceEvaluator; ///< Shared pool for DetectSequence() / DetectBatch()
     };
 
 } // namespace SH3DS::Vision
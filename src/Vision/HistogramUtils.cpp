@@ -1,43 +1,241 @@
 #include "HistogramUtils.h"
 
+#include "Core/Logger.h"
+
 #include <opencv2/imgproc.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
 namespace SH3DS::Vision
 {
+    namespace
+    {
+        /// Fixed-point shift of OpenCV's 8-bit RGB->HSV conversion.
+        constexpr int kHsvShift = 12;
 
-    cv::Mat ComputeHSHistogram(const cv::Mat &bgrImage, int hBins, int sBins)
+        /// Marks an 8-bit value outside the histogram range.
+        constexpr int kOutOfRange = -1;
+
+        /// Magic number at the start of a binary ".hist" file.
+        constexpr std::array<char, 4> kBinaryMagic = { 'S', 'H', 'H', '1' };
+
+        /**
+         * @brief Division tables of OpenCV's 8-bit RGB->HSV conversion (hue scaled to [0, 180)).
+         */
+        struct HsvTables
+        {
+            std::array<int, 256> sdiv{}; ///< (255 << shift) / v
+            std::array<int, 256> hdiv{}; ///< (180 << shift) / (6 * diff)
+
+            HsvTables()
+            {
+                for (std::size_t i = 1; i < sdiv.size(); ++i)
+                {
+                    const auto value = static_cast<double>(i);
+                    sdiv[i] = cv::saturate_cast<int>((255 << kHsvShift) / value);
+                    hdiv[i] = cv::saturate_cast<int>((180 << kHsvShift) / (6. * value));
+                }
+            }
+        };
+
+        const HsvTables &GetHsvTables()
+        {
+            static const HsvTables tables;
+            return tables;
+        }
+
+        /**
+         * @brief Builds calcHist's uniform 8-bit bin lookup for one channel.
+         * @param bins Number of bins.
+         * @param low Inclusive lower range bound.
+         * @param high Exclusive upper range bound.
+         * @return Bin index per 8-bit value, or kOutOfRange.
+         */
+        std::array<int, 256> BuildBinTable(int bins, double low, double high)
+        {
+            const double scale = bins / (high - low);
+            const double offset = -scale * low;
+            std::array<int, 256> table{};
+            for (std::size_t index = 0; index < table.size(); ++index)
+            {
+                const auto value = static_cast<double>(index);
+                table[index] = value >= low && value < high
+                                   ? std::clamp(cvFloor(value * scale + offset), 0, bins - 1)
+                                   : kOutOfRange;
+            }
+            return table;
+        }
+
+        bool EndsWith(const std::string &text, const std::string &suffix)
+        {
+            return text.size() >= suffix.size()
+                   && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+        }
+    } // namespace
+
+    HistogramCompareMethod ParseHistogramCompareMethod(const std::string &name)
     {
-        cv::Mat hsv;
-        cv::cvtColor(bgrImage, hsv, cv::COLOR_BGR2HSV);
+        if (name == "correlation")
+        {
+            return HistogramCompareMethod::Correlation;
+        }
+        if (name == "chi_square")
+        {
+            return HistogramCompareMethod::ChiSquare;
+        }
+        if (name == "intersection")
+        {
+            return HistogramCompareMethod::Intersection;
+        }
+        if (name == "bhattacharyya")
+        {
+            return HistogramCompareMethod::Bhattacharyya;
+        }
 
-        cv::Mat hist;
-        int channels[] = { 0, 1 };
-        int histSize[] = { hBins, sBins };
-        float hRange[] = { 0, 180 };
-        float sRange[] = { 0, 256 };
-        const float *ranges[] = { hRange, sRange };
+        LOG_WARN("HistogramUtils: unknown compare method '{}', using correlation", name);
+        return HistogramCompareMethod::Correlation;
+    }
 
-        cv::calcHist(&hsv, 1, channels, cv::Mat(), hist, 2, histSize, ranges);
-        cv::normalize(hist, hist, 0, 1, cv::NORM_MINMAX);
+    double CompareHistograms(const cv::Mat &a, const cv::Mat &b, HistogramCompareMethod method)
+    {
+        switch (method)
+        {
+        case HistogramCompareMethod::Correlation:
+            return cv::compareHist(a, b, cv::HISTCMP_CORREL);
+        case HistogramCompareMethod::ChiSquare:
+            return -cv::compareHist(a, b, cv::HISTCMP_CHISQR);
+        case HistogramCompareMethod::Intersection:
+            return cv::compareHist(a, b, cv::HISTCMP_INTERSECT);
+        case HistogramCompareMethod::Bhattacharyya:
+            return -cv::compareHist(a, b, cv::HISTCMP_BHATTACHARYYA);
+        }
+        return 0.0;
+    }
 
+    cv::Mat ComputeHSHistogram(const cv::Mat &bgrImage, int hBins, int sBins)
+    {
+        cv::Mat hist;
+        ComputeHSHistogramInto(bgrImage, hBins, sBins, hist);
         return hist;
     }
 
+    void ComputeHSHistogramInto(const cv::Mat &bgrImage, int hBins, int sBins, cv::Mat &hist)
+    {
+        hist.create(hBins, sBins, CV_32F);
+        hist.setTo(cv::Scalar::all(0));
+        if (bgrImage.empty())
+        {
+            return;
+        }
+        if (bgrImage.type() != CV_8UC3)
+        {
+            throw std::runtime_error("ComputeHSHistogramInto: expected a CV_8UC3 image");
+        }
+
+        const HsvTables &tables = GetHsvTables();
+        const std::array<int, 256> hBinTable = BuildBinTable(hBins, 0.0, 180.0);
+        const std::array<int, 256> sBinTable = BuildBinTable(sBins, 0.0, 256.0);
+        const int *sdiv = tables.sdiv.data();
+        const int *hdiv = tables.hdiv.data();
+        const int *hBin = hBinTable.data();
+        const int *sBin = sBinTable.data();
+        auto *bins = hist.ptr<float>();
+
+        // Per pixel: OpenCV's fixed-point BGR2HSV for H and S (V is not needed), then calcHist's bin lookup.
+        for (int row = 0; row < bgrImage.rows; ++row)
+        {
+            const uchar *pixel = bgrImage.ptr<uchar>(row);
+            for (int col = 0; col < bgrImage.cols; ++col, pixel += 3)
+            {
+                const int b = pixel[0];
+                const int g = pixel[1];
+                const int r = pixel[2];
+                const int v = std::max({ b, g, r });
+                const int diff = v - std::min({ b, g, r });
+
+                const int s = (diff * sdiv[v] + (1 << (kHsvShift - 1))) >> kHsvShift;
+                int h = v == r ? g - b : (v == g ? b - r + 2 * diff : r - g + 4 * diff);
+                h = (h * hdiv[diff] + (1 << (kHsvShift - 1))) >> kHsvShift;
+                h += h < 0 ? 180 : 0;
+
+                const int hIndex = hBin[h];
+                const int sIndex = sBin[s];
+                if (hIndex != kOutOfRange && sIndex != kOutOfRange)
+                {
+                    bins[hIndex * sBins + sIndex] += 1.0f;
+                }
+            }
+        }
+
+        // normalize(NORM_MINMAX, 0, 1) with the float scale/shift OpenCV uses for CV_32F output.
+        const auto [minIt, maxIt] = std::minmax_element(bins, bins + hist.total());
+        const double minValue = *minIt;
+        const double maxValue = *maxIt;
+        const double range = maxValue - minValue;
+        const double scaleValue = range > DBL_EPSILON ? 1.0 / range : 0.0;
+        const auto scale = static_cast<float>(scaleValue);
+        const auto shift = static_cast<float>(-minValue * scaleValue);
+        std::transform(bins, bins + hist.total(), bins, [scale, shift](float value) { return value * scale + shift; });
+    }
+
     void SaveHistogram(const cv::Mat &hist, const std::string &path)
     {
+        if (EndsWith(path, ".hist"))
+        {
+            cv::Mat data;
+            hist.convertTo(data, CV_32F);
+            data = data.isContinuous() ? data : data.clone();
+
+            const int32_t header[2] = { data.rows, data.cols };
+            std::ofstream out(path, std::ios::binary);
+            out.write(kBinaryMagic.data(), kBinaryMagic.size());
+            out.write(reinterpret_cast<const char *>(header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(data.ptr<float>()),
+                static_cast<std::streamsize>(data.total() * sizeof(float)));
+            return;
+        }
+
         cv::FileStorage fs(path, cv::FileStorage::WRITE);
         fs << "histogram" << hist;
     }
 
     cv::Mat LoadHistogram(const std::string &path)
     {
+        if (EndsWith(path, ".hist"))
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::array<char, 4> magic{};
+            int32_t header[2] = {};
+            if (!in.read(magic.data(), magic.size()) || magic != kBinaryMagic
+                || !in.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] <= 0 || header[1] <= 0)
+            {
+                return {};
+            }
+
+            cv::Mat hist(header[0], header[1], CV_32F);
+            if (!in.read(reinterpret_cast<char *>(hist.ptr<float>()),
+                    static_cast<std::streamsize>(hist.total() * sizeof(float))))
+            {
+                return {};
+            }
+            return hist;
+        }
+
         cv::FileStorage fs(path, cv::FileStorage::READ);
         cv::Mat hist;
         if (fs.isOpened())
         {
             fs["histogram"] >> hist;
         }
+        if (!hist.empty() && hist.type() != CV_32F)
+        {
+            hist.convertTo(hist, CV_32F);
+        }
         return hist;
     }
-
 } // namespace SH3DS::Vision
@@ -6,18 +6,61 @@
 
 namespace SH3DS::Vision
 {
+    /**
+     * @brief Histogram comparison metric (maps to cv::HISTCMP_*).
+     */
+    enum class HistogramCompareMethod
+    {
+        Correlation,   ///< cv::HISTCMP_CORREL (higher is more similar)
+        ChiSquare,     ///< cv::HISTCMP_CHISQR (lower is more similar)
+        Intersection,  ///< cv::HISTCMP_INTERSECT (higher is more similar)
+        Bhattacharyya, ///< cv::HISTCMP_BHATTACHARYYA (lower is more similar)
+    };
+
+    /**
+     * @brief Parses a config compare_method name.
+     * @param name "correlation", "chi_square", "intersection" or "bhattacharyya".
+     * @return The method; unknown names fall back to Correlation with a warning.
+     */
+    HistogramCompareMethod ParseHistogramCompareMethod(const std::string &name);
+
+    /**
+     * @brief Compares two histograms.
+     * @param a First histogram.
+     * @param b Second histogram (same size and type).
+     * @param method The comparison metric.
+     * @return The similarity, oriented so that higher always means more similar (distances are negated).
+     */
+    double CompareHistograms(const cv::Mat &a, const cv::Mat &b, HistogramCompareMethod method);
+
     /**
      * @brief Compute a 2D Hue-Saturation histogram from a BGR image.
      */
     cv::Mat ComputeHSHistogram(const cv::Mat &bgrImage, int hBins, int sBins);
 
     /**
-     * @brief Save a histogram to a YAML file via cv::FileStorage.
+     * @brief Computes a min-max normalised 2D Hue-Saturation histogram of a CV_8UC3 BGR image in one pass.
+     *
+     * Equivalent to cvtColor(BGR2HSV) + calcHist + normalize(NORM_MINMAX) but without an HSV image; `hist` is
+     * only reallocated if it is not already hBins x sBins CV_32F.
+     * @param bgrImage The image (CV_8UC3, any stride).
+     * @param hBins Hue bins over [0, 180).
+     * @param sBins Saturation bins over [0, 256).
+     * @param hist Output histogram.
+     */
+    void ComputeHSHistogramInto(const cv::Mat &bgrImage, int hBins, int sBins, cv::Mat &hist);
+
+    /**
+     * @brief Save a histogram to a file.
+     *
+     * Paths ending in ".hist" use a compact binary layout (magic, rows, cols, raw CV_32F data); anything else
+     * is written as YAML/XML via cv::FileStorage.
      */
     void SaveHistogram(const cv::Mat &hist, const std::string &path);
 
     /**
-     * @brief Load a histogram from a YAML file via cv::FileStorage.
+     * @brief Load a histogram written by SaveHistogram().
+     * @return The histogram (CV_32F), or an empty Mat if the file is missing or malformed.
      */
     cv::Mat LoadHistogram(const std::string &path);
 } // namespace SH3DS::Vision
@@ -0,0 +1,516 @@
+#include "QuantizedCnn.h"
+
+#include <opencv2/core/hal/intrin.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace SH3DS::Vision
+{
+    namespace
+    {
+        /// Magic number at the start of a model file.
+        constexpr std::array<char, 4> kModelMagic = { 'S', 'H', 'C', 'N' };
+
+        /// Model file format version.
+        constexpr int32_t kModelVersion = 1;
+
+        /// Sanity limits applied when loading untrusted files.
+        constexpr int32_t kMaxLayers = 64;
+        constexpr int32_t kMaxDimension = 1024;
+        constexpr std::size_t kMaxLayerElements = std::size_t{ 1 } << 24; ///< Weights or activations of one layer
+
+        template<typename T>
+        T ReadValue(std::ifstream &in, const std::string &path)
+        {
+            T value{};
+            if (!in.read(reinterpret_cast<char *>(&value), sizeof(T)))
+            {
+                throw std::runtime_error("QuantizedCnn: truncated model file: " + path);
+            }
+            return value;
+        }
+
+        template<typename T>
+        std::vector<T> ReadVector(std::ifstream &in, std::size_t count, const std::string &path)
+        {
+            std::vector<T> values(count);
+            if (!in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(count * sizeof(T))))
+            {
+                throw std::runtime_error("QuantizedCnn: truncated model file: " + path);
+            }
+            return values;
+        }
+
+        template<typename T>
+        void WriteValue(std::ofstream &out, const T &value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        void WriteVector(std::ofstream &out, const std::vector<T> &values)
+        {
+            out.write(reinterpret_cast<const char *>(values.data()),
+                static_cast<std::streamsize>(values.size() * sizeof(T)));
+        }
+
+        /**
+         * @brief Adds one input pixel's contribution to every output channel's accumulator.
+         *
+         * Output channels go across the SIMD lanes, eight at a time: each input value is broadcast, multiplied with
+         * the sign-extended weight row and widened into two int32x4 accumulators that stay in registers over all
+         * input channels. 128-bit vectors are used on purpose, since the conv layers have 8-32 output channels.
+         * The remaining channels (the two-class dense head) run scalar.
+         * @param pixel Input channels of the pixel.
+         * @param channels Input channel count.
+         * @param weights Weights for this tap, [in][out].
+         * @param outChannels Output channel count.
+         * @param acc Accumulators, one per output channel.
+         */
+        void AccumulateTap(const int8_t *pixel, int channels, const int8_t *weights, int outChannels, int32_t *acc)
+        {
+            int first = 0;
+#if CV_SIMD128
+            constexpr int kLanes = 8;
+            for (; first + kLanes <= outChannels; first += kLanes)
+            {
+                cv::v_int32x4 low = cv::v_load(acc + first);
+                cv::v_int32x4 high = cv::v_load(acc + first + kLanes / 2);
+                for (int c = 0; c < channels; ++c)
+                {
+                    const cv::v_int16x8 value = cv::v_setall_s16(pixel[c]);
+                    const cv::v_int16x8 row =
+                        cv::v_load_expand(weights + static_cast<std::ptrdiff_t>(c) * outChannels + first);
+                    cv::v_int32x4 productLow;
+                    cv::v_int32x4 productHigh;
+                    cv::v_mul_expand(value, row, productLow, productHigh);
+                    low = cv::v_add(low, productLow);
+                    high = cv::v_add(high, productHigh);
+                }
+                cv::v_store(acc + first, low);
+                cv::v_store(acc + first + kLanes / 2, high);
+            }
+#endif
+            if (first == outChannels)
+            {
+                return;
+            }
+            for (int c = 0; c < channels; ++c)
+            {
+                const int32_t value = pixel[c];
+                const int8_t *row = weights + static_cast<std::ptrdiff_t>(c) * outChannels;
+                for (int o = first; o < outChannels; ++o)
+                {
+                    acc[o] += value * row[o];
+                }
+            }
+        }
+
+        void Requantize(const int32_t *acc, const QuantizedCnn::Layer &layer, int8_t *out)
+        {
+            const int low = layer.relu ? 0 : -128;
+            const float *multiplier = layer.multiplier.data();
+            for (int o = 0; o < layer.outChannels; ++o)
+            {
+                const auto value = static_cast<int>(std::lrint(static_cast<float>(acc[o]) * multiplier[o]));
+                out[o] = static_cast<int8_t>(std::clamp(value, low, 127));
+            }
+        }
+
+        void Conv3x3(const int8_t *in,
+            int height,
+            int width,
+            int channels,
+            const QuantizedCnn::Layer &layer,
+            int32_t *acc,
+            int8_t *out)
+        {
+            const int outChannels = layer.outChannels;
+            const std::ptrdiff_t tapSize = static_cast<std::ptrdiff_t>(channels) * outChannels;
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    std::copy(layer.bias.begin(), layer.bias.end(), acc);
+                    for (int ky = 0; ky < 3; ++ky)
+                    {
+                        const int sy = y + ky - 1;
+                        if (sy < 0 || sy >= height)
+                        {
+                            continue;
+                        }
+                        for (int kx = 0; kx < 3; ++kx)
+                        {
+                            const int sx = x + kx - 1;
+                            if (sx < 0 || sx >= width)
+                            {
+                                continue;
+                            }
+                            AccumulateTap(in + (static_cast<std::ptrdiff_t>(sy) * width + sx) * channels,
+                                channels,
+                                layer.weights.data() + (ky * 3 + kx) * tapSize,
+                                outChannels,
+                                acc);
+                        }
+                    }
+                    Requantize(acc, layer, out + (static_cast<std::ptrdiff_t>(y) * width + x) * outChannels);
+                }
+            }
+        }
+
+        void MaxPool2x2(const int8_t *in, int height, int width, int channels, int8_t *out)
+        {
+            const int outHeight = height / 2;
+            const int outWidth = width / 2;
+            for (int y = 0; y < outHeight; ++y)
+            {
+                const int8_t *top = in + static_cast<std::ptrdiff_t>(2 * y) * width * channels;
+                const int8_t *bottom = top + static_cast<std::ptrdiff_t>(width) * channels;
+                for (int x = 0; x < outWidth; ++x)
+                {
+                    const std::ptrdiff_t left = static_cast<std::ptrdiff_t>(2 * x) * channels;
+                    int8_t *dst = out + (static_cast<std::ptrdiff_t>(y) * outWidth + x) * channels;
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        dst[c] = std::max({ top[left + c],
+                            top[left + channels + c],
+                            bottom[left + c],
+                            bottom[left + channels + c] });
+                    }
+                }
+            }
+        }
+
+        void GlobalAveragePool(const int8_t *in, int height, int width, int channels, int32_t *acc, int8_t *out)
+        {
+            std::fill(acc, acc + channels, 0);
+            const int pixels = height * width;
+            for (int p = 0; p < pixels; ++p)
+            {
+                const int8_t *pixel = in + static_cast<std::ptrdiff_t>(p) * channels;
+                for (int c = 0; c < channels; ++c)
+                {
+                    acc[c] += pixel[c];
+                }
+            }
+            for (int c = 0; c < channels; ++c)
+            {
+                out[c] = static_cast<int8_t>(std::lrint(static_cast<double>(acc[c]) / pixels));
+            }
+        }
+
+        void Dense(const int8_t *in, int inputs, const QuantizedCnn::Layer &layer, int32_t *acc)
+        {
+            std::copy(layer.bias.begin(), layer.bias.end(), acc);
+            // A dense layer is one "tap" whose pixel is the whole flattened input.
+            AccumulateTap(in, inputs, layer.weights.data(), layer.outChannels, acc);
+        }
+    } // namespace
+
+    QuantizedCnn::QuantizedCnn(int inputWidth, int inputHeight, std::vector<Layer> layers)
+        : inputWidth(inputWidth),
+          inputHeight(inputHeight),
+          layers(std::move(layers)),
+          maxActivation(0)
+    {
+        if (inputWidth <= 0 || inputHeight <= 0)
+        {
+            throw std::runtime_error("QuantizedCnn: input size must be positive");
+        }
+        if (this->layers.empty() || this->layers.back().type != LayerType::Dense
+            || this->layers.back().outChannels != kClassCount)
+        {
+            throw std::runtime_error("QuantizedCnn: the last layer must be Dense with 2 outputs");
+        }
+
+        Shape shape{ .height = inputHeight, .width = inputWidth, .channels = kInputChannels };
+        shapes.push_back(shape);
+        for (const auto &layer : this->layers)
+        {
+            const std::size_t outChannels = static_cast<std::size_t>(std::max(layer.outChannels, 0));
+            switch (layer.type)
+            {
+            case LayerType::Conv3x3:
+                if (outChannels == 0
+                    || layer.weights.size() != 9 * static_cast<std::size_t>(shape.channels) * outChannels)
+                {
+                    throw std::runtime_error("QuantizedCnn: Conv3x3 weight count does not match its shape");
+                }
+                shape.channels = layer.outChannels;
+                break;
+            case LayerType::MaxPool2x2:
+                if (shape.height < 2 || shape.width < 2)
+                {
+                    throw std::runtime_error("QuantizedCnn: MaxPool2x2 input is smaller than 2x2");
+                }
+                shape.height /= 2;
+                shape.width /= 2;
+                break;
+            case LayerType::GlobalAveragePool:
+                shape.height = 1;
+                shape.width = 1;
+                break;
+            case LayerType::Dense:
+                if (outChannels == 0 || layer.weights.size() != shape.Size() * outChannels)
+                {
+                    throw std::runtime_error("QuantizedCnn: Dense weight count does not match its shape");
+                }
+                shape = { .height = 1, .width = 1, .channels = layer.outChannels };
+                break;
+            default:
+                throw std::runtime_error("QuantizedCnn: unknown layer type");
+            }
+
+            if ((layer.type == LayerType::Conv3x3 || layer.type == LayerType::Dense)
+                && (layer.bias.size() != outChannels || layer.multiplier.size() != outChannels))
+            {
+                throw std::runtime_error("QuantizedCnn: bias/multiplier count does not match the output channels");
+            }
+            shapes.push_back(shape);
+        }
+
+        for (const auto &s : shapes)
+        {
+            maxActivation = std::max(maxActivation, s.Size());
+        }
+    }
+
+    QuantizedCnn QuantizedCnn::Load(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            throw std::runtime_error("QuantizedCnn: cannot open model file: " + path);
+        }
+
+        const auto magic = ReadValue<std::array<char, 4>>(in, path);
+        const auto version = ReadValue<int32_t>(in, path);
+        if (magic != kModelMagic || version != kModelVersion)
+        {
+            throw std::runtime_error("QuantizedCnn: not a version 1 model file: " + path);
+        }
+
+        const auto width = ReadValue<int32_t>(in, path);
+        const auto height = ReadValue<int32_t>(in, path);
+        const auto layerCount = ReadValue<int32_t>(in, path);
+        if (width <= 0 || width > kMaxDimension || height <= 0 || height > kMaxDimension || layerCount <= 0
+            || layerCount > kMaxLayers)
+        {
+            throw std::runtime_error("QuantizedCnn: implausible model header: " + path);
+        }
+
+        // Weight counts depend on the input channels of each layer, so track them while reading.
+        int channels = kInputChannels;
+        int rows = height;
+        int cols = width;
+        std::vector<Layer> layers;
+        for (int32_t i = 0; i < layerCount; ++i)
+        {
+            Layer layer;
+            layer.type = static_cast<LayerType>(ReadValue<int32_t>(in, path));
+            switch (layer.type)
+            {
+            case LayerType::Conv3x3:
+            case LayerType::Dense:
+            {
+                layer.outChannels = ReadValue<int32_t>(in, path);
+                layer.relu = ReadValue<int32_t>(in, path) != 0;
+                if (layer.outChannels <= 0 || layer.outChannels > kMaxDimension)
+                {
+                    throw std::runtime_error("QuantizedCnn: implausible channel count: " + path);
+                }
+                const Shape input{ .height = rows, .width = cols, .channels = channels };
+                const std::size_t inputs = layer.type == LayerType::Conv3x3 ? 9 * static_cast<std::size_t>(channels)
+                                                                             : input.Size();
+                const auto outputs = static_cast<std::size_t>(layer.outChannels);
+                const std::size_t activations =
+                    layer.type == LayerType::Dense ? outputs : static_cast<std::size_t>(rows) * cols * outputs;
+                if (inputs * outputs > kMaxLayerElements || activations > kMaxLayerElements)
+                {
+                    throw std::runtime_error("QuantizedCnn: implausible layer size: " + path);
+                }
+                layer.weights = ReadVector<int8_t>(in, inputs * outputs, path);
+                layer.bias = ReadVector<int32_t>(in, outputs, path);
+                layer.multiplier = ReadVector<float>(in, outputs, path);
+                channels = layer.outChannels;
+                rows = layer.type == LayerType::Dense ? 1 : rows;
+                cols = layer.type == LayerType::Dense ? 1 : cols;
+                break;
+            }
+            case LayerType::MaxPool2x2:
+                rows /= 2;
+                cols /= 2;
+                break;
+            case LayerType::GlobalAveragePool:
+                rows = 1;
+                cols = 1;
+                break;
+            default:
+                throw std::runtime_error("QuantizedCnn: unknown layer type in " + path);
+            }
+            layers.push_back(std::move(layer));
+        }
+
+        return QuantizedCnn(width, height, std::move(layers));
+    }
+
+    void QuantizedCnn::Save(const std::string &path) const
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+        {
+            throw std::runtime_error("QuantizedCnn: cannot write model file: " + path);
+        }
+
+        out.write(kModelMagic.data(), kModelMagic.size());
+        WriteValue(out, kModelVersion);
+        WriteValue(out, static_cast<int32_t>(inputWidth));
+        WriteValue(out, static_cast<int32_t>(inputHeight));
+        WriteValue(out, static_cast<int32_t>(layers.size()));
+        for (const auto &layer : layers)
+        {
+            WriteValue(out, static_cast<int32_t>(layer.type));
+            if (layer.type == LayerType::Conv3x3 || layer.type == LayerType::Dense)
+            {
+                WriteValue(out, static_cast<int32_t>(layer.outChannels));
+                WriteValue(out, static_cast<int32_t>(layer.relu ? 1 : 0));
+                WriteVector(out, layer.weights);
+                WriteVector(out, layer.bias);
+                WriteVector(out, layer.multiplier);
+            }
+        }
+    }
+
+    float QuantizedCnn::Predict(const cv::Mat &roi) const
+    {
+        return Predict(std::span<const cv::Mat>(&roi, 1)).front();
+    }
+
+    std::vector<float> QuantizedCnn::Predict(std::span<const cv::Mat> rois) const
+    {
+        const std::size_t batch = rois.size();
+        std::vector<float> probabilities(batch);
+        if (batch == 0)
+        {
+            return probabilities;
+        }
+
+        // Ping-pong activation buffers, one maxActivation slot per ROI. Running the whole batch through a
+        // layer before moving on keeps that layer's weights in cache.
+        std::vector<int8_t> current(batch * maxActivation);
+        std::vector<int8_t> next(batch * maxActivation);
+        int maxChannels = kInputChannels;
+        for (const auto &shape : shapes)
+        {
+            maxChannels = std::max(maxChannels, shape.channels);
+        }
+        std::vector<int32_t> acc(static_cast<std::size_t>(maxChannels));
+
+        cv::Mat resized;
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            Quantize(rois[i], resized, current.data() + i * maxActivation);
+        }
+
+        for (std::size_t l = 0; l + 1 < layers.size(); ++l)
+        {
+            const Layer &layer = layers[l];
+            const Shape &in = shapes[l];
+            for (std::size_t i = 0; i < batch; ++i)
+            {
+                const int8_t *src = current.data() + i * maxActivation;
+                int8_t *dst = next.data() + i * maxActivation;
+                switch (layer.type)
+                {
+                case LayerType::Conv3x3:
+                    Conv3x3(src, in.height, in.width, in.channels, layer, acc.data(), dst);
+                    break;
+                case LayerType::MaxPool2x2:
+                    MaxPool2x2(src, in.height, in.width, in.channels, dst);
+                    break;
+                case LayerType::GlobalAveragePool:
+                    GlobalAveragePool(src, in.height, in.width, in.channels, acc.data(), dst);
+                    break;
+                case LayerType::Dense:
+                    Dense(src, static_cast<int>(in.Size()), layer, acc.data());
+                    Requantize(acc.data(), layer, dst);
+                    break;
+                }
+            }
+            std::swap(current, next);
+        }
+
+        // The final Dense layer produces float logits; softmax over two classes is a logistic of their difference.
+        const Layer &head = layers.back();
+        const int inputs = static_cast<int>(shapes[layers.size() - 1].Size());
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            Dense(current.data() + i * maxActivation, inputs, head, acc.data());
+            const float normalLogit = static_cast<float>(acc[0]) * head.multiplier[0];
+            const float shinyLogit = static_cast<float>(acc[1]) * head.multiplier[1];
+            probabilities[i] = 1.0f / (1.0f + std::exp(normalLogit - shinyLogit));
+        }
+        return probabilities;
+    }
+
+    int QuantizedCnn::InputWidth() const
+    {
+        return inputWidth;
+    }
+
+    int QuantizedCnn::InputHeight() const
+    {
+        return inputHeight;
+    }
+
+    uint64_t QuantizedCnn::MacsPerInference() const
+    {
+        uint64_t macs = 0;
+        for (std::size_t l = 0; l < layers.size(); ++l)
+        {
+            const Shape &in = shapes[l];
+            const auto outputs = static_cast<uint64_t>(layers[l].outChannels);
+            if (layers[l].type == LayerType::Conv3x3)
+            {
+                macs += static_cast<uint64_t>(in.Size()) * 9 * outputs;
+            }
+            else if (layers[l].type == LayerType::Dense)
+            {
+                macs += static_cast<uint64_t>(in.Size()) * outputs;
+            }
+        }
+        return macs;
+    }
+
+    void QuantizedCnn::Quantize(const cv::Mat &roi, cv::Mat &resized, int8_t *out) const
+    {
+        if (roi.empty() || roi.type() != CV_8UC3)
+        {
+            throw std::runtime_error("QuantizedCnn: expected a non-empty CV_8UC3 ROI");
+        }
+
+        const cv::Mat *source = &roi;
+        if (roi.cols != inputWidth || roi.rows != inputHeight)
+        {
+            cv::resize(roi, resized, cv::Size(inputWidth, inputHeight), 0.0, 0.0, cv::INTER_AREA);
+            source = &resized;
+        }
+
+        for (int row = 0; row < inputHeight; ++row)
+        {
+            const uchar *pixel = source->ptr<uchar>(row);
+            int8_t *dst = out + static_cast<std::ptrdiff_t>(row) * inputWidth * kInputChannels;
+            for (int i = 0; i < inputWidth * kInputChannels; ++i)
+            {
+                dst[i] = static_cast<int8_t>(pixel[i] >> 1);
+            }
+        }
+    }
+} // namespace SH3DS::Vision
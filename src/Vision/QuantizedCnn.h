@@ -0,0 +1,141 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SH3DS::Vision
+{
+    /**
+     * @brief Small int8-quantised convolutional classifier (normal vs shiny) evaluated on the CPU.
+     *
+     * The input ROI is resized to the model's input size and quantised to int8 as pixel / 2. Activations are
+     * int8 in HWC layout; each layer accumulates in int32 and requantises with a per-channel float multiplier.
+     * The last layer must be a Dense layer with two outputs: the normal and shiny logits.
+     *
+     * Model file layout (little-endian): magic "SHCN", int32 version, int32 input width, int32 input height,
+     * int32 layer count, then per layer an int32 LayerType followed by its parameters:
+     * - Conv3x3: int32 out channels, int32 relu, int8 weights [ky][kx][in][out], int32 bias[out],
+     *   float multiplier[out]
+     * - MaxPool2x2, GlobalAveragePool: nothing
+     * - Dense: int32 outputs, int32 relu, int8 weights [in][out] (input flattened HWC), int32 bias[out],
+     *   float multiplier[out]
+     */
+    class QuantizedCnn
+    {
+    public:
+        static constexpr int kInputChannels = 3; ///< BGR input
+        static constexpr int kClassCount = 2;    ///< Normal and shiny logits
+
+        /**
+         * @brief Layer kind (the numeric values are the file encoding).
+         */
+        enum class LayerType : int32_t
+        {
+            Conv3x3 = 1,           ///< 3x3 convolution, stride 1, zero padding 1
+            MaxPool2x2 = 2,        ///< 2x2 max pooling, stride 2 (odd edges dropped)
+            GlobalAveragePool = 3, ///< Mean over the spatial dimensions
+            Dense = 4,             ///< Fully connected over the flattened input
+        };
+
+        /**
+         * @brief One layer and its quantised parameters.
+         */
+        struct Layer
+        {
+            LayerType type = LayerType::Conv3x3; ///< Layer kind
+            int outChannels = 0;                 ///< Output channels (Conv3x3, Dense)
+            bool relu = false;                   ///< Clamp outputs at zero (Conv3x3, Dense)
+            std::vector<int8_t> weights;         ///< Weights (layout per LayerType)
+            std::vector<int32_t> bias;           ///< Bias per output channel, in accumulator units
+            std::vector<float> multiplier;       ///< Accumulator-to-output scale per output channel
+        };
+
+        /**
+         * @brief Constructs and validates a network.
+         * @param inputWidth Model input width.
+         * @param inputHeight Model input height.
+         * @param layers Layers in evaluation order.
+         * @throws std::runtime_error if the layer shapes are inconsistent.
+         */
+        QuantizedCnn(int inputWidth, int inputHeight, std::vector<Layer> layers);
+
+        /**
+         * @brief Loads a network from a model file.
+         * @param path Model file path.
+         * @return The network.
+         * @throws std::runtime_error if the file is missing or malformed.
+         */
+        static QuantizedCnn Load(const std::string &path);
+
+        /**
+         * @brief Writes the network in the model file format.
+         * @param path Model file path.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        void Save(const std::string &path) const;
+
+        /**
+         * @brief Returns the shiny probability of one ROI.
+         * @param roi The sprite ROI (CV_8UC3, any size).
+         * @return Softmax probability of the shiny class.
+         */
+        float Predict(const cv::Mat &roi) const;
+
+        /**
+         * @brief Returns the shiny probability of each ROI, running the batch through one layer at a time.
+         * @param rois The sprite ROIs (CV_8UC3, any size).
+         * @return One probability per ROI.
+         */
+        std::vector<float> Predict(std::span<const cv::Mat> rois) const;
+
+        /**
+         * @brief Returns the model input width.
+         */
+        int InputWidth() const;
+
+        /**
+         * @brief Returns the model input height.
+         */
+        int InputHeight() const;
+
+        /**
+         * @brief Returns the number of multiply-accumulates per ROI.
+         */
+        uint64_t MacsPerInference() const;
+
+    private:
+        /**
+         * @brief Activation tensor shape (HWC).
+         */
+        struct Shape
+        {
+            int height = 0;   ///< Rows
+            int width = 0;    ///< Columns
+            int channels = 0; ///< Channels
+
+            std::size_t Size() const
+            {
+                return static_cast<std::size_t>(height) * static_cast<std::size_t>(width)
+                       * static_cast<std::size_t>(channels);
+            }
+        };
+
+        /**
+         * @brief Resizes and quantises one ROI into the input activation.
+         * @param roi The ROI.
+         * @param resized Scratch for the resized ROI.
+         * @param out Input activation (Size() of the input shape).
+         */
+        void Quantize(const cv::Mat &roi, cv::Mat &resized, int8_t *out) const;
+
+        int inputWidth;            ///< Model input width
+        int inputHeight;           ///< Model input height
+        std::vector<Layer> layers; ///< Layers in evaluation order
+        std::vector<Shape> shapes; ///< Activation shape before each layer, plus the output shape
+        std::size_t maxActivation; ///< Largest activation size, in elements
+    };
+} // namespace SH3DS::Vision
@@ -0,0 +1,184 @@
+#include "SequenceEvaluator.h"
+
+#include "Vision/ShinyDetector.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace SH3DS::Vision
+{
+    SequenceEvaluator::SequenceEvaluator(unsigned workerCount) : workerCount(workerCount)
+    {
+    }
+
+    SequenceEvaluator::~SequenceEvaluator()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    Core::ShinyResult SequenceEvaluator::Evaluate(const ShinyDetector &detector, std::span<const cv::Mat> rois)
+    {
+        std::lock_guard evaluateLock(evaluateMutex);
+
+        Job current(detector, rois);
+        Run(current);
+        return current.voter.Result();
+    }
+
+    void SequenceEvaluator::EvaluateEach(const ShinyDetector &detector,
+        std::span<const cv::Mat> rois,
+        std::span<Core::ShinyResult> results)
+    {
+        if (results.size() != rois.size())
+        {
+            throw std::invalid_argument("SequenceEvaluator: results and rois differ in size");
+        }
+
+        std::lock_guard evaluateLock(evaluateMutex);
+
+        Job current(detector, rois);
+        current.results = results.data();
+        Run(current);
+    }
+
+    unsigned SequenceEvaluator::DefaultWorkerCount()
+    {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? std::min(hardwareThreads - 1, 7u) : 0u;
+    }
+
+    std::shared_ptr<SequenceEvaluator> SequenceEvaluator::Shared()
+    {
+        static const auto evaluator = std::make_shared<SequenceEvaluator>();
+        return evaluator;
+    }
+
+    void SequenceEvaluator::Run(Job &current)
+    {
+        if (workerCount == 0 || current.rois.size() < 2)
+        {
+            Drain(current);
+            return;
+        }
+
+        if (workers.empty())
+        {
+            workers.reserve(workerCount);
+            for (unsigned i = 0; i < workerCount; ++i)
+            {
+                workers.emplace_back([this] { WorkerLoop(); });
+            }
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            job = &current;
+            ++generation;
+        }
+        wake.notify_all();
+
+        try
+        {
+            Drain(current);
+        }
+        catch (...)
+        {
+            // Still wait for the workers below: they hold references into `current`.
+            current.decided = true;
+            std::lock_guard voteLock(current.voteMutex);
+            if (!current.error)
+            {
+                current.error = std::current_exception();
+            }
+        }
+
+        {
+            std::unique_lock lock(mutex);
+            job = nullptr;
+            idle.wait(lock, [&current] { return current.active == 0; });
+        }
+
+        if (current.error)
+        {
+            std::rethrow_exception(current.error);
+        }
+    }
+
+    void SequenceEvaluator::Drain(Job &job)
+    {
+        while (!job.decided.load(std::memory_order_acquire))
+        {
+            const std::size_t index = job.next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= job.rois.size())
+            {
+                return;
+            }
+
+            if (job.results)
+            {
+                // Each index is claimed once, so the slots are written without locking.
+                job.results[index] = job.detector->Detect(job.rois[index]);
+                continue;
+            }
+
+            const Core::ShinyResult result = job.detector->Detect(job.rois[index]);
+
+            std::lock_guard voteLock(job.voteMutex);
+            job.voter.Add(result);
+            if (job.voter.IsDecided())
+            {
+                job.decided.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    void SequenceEvaluator::WorkerLoop()
+    {
+        uint64_t seenGeneration = 0;
+        while (true)
+        {
+            Job *current = nullptr;
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+                if (stopping)
+                {
+                    return;
+                }
+                seenGeneration = generation;
+                current = job;
+                if (!current)
+                {
+                    continue;
+                }
+                ++current->active;
+            }
+
+            try
+            {
+                Drain(*current);
+            }
+            catch (...)
+            {
+                current->decided = true;
+                std::lock_guard voteLock(current->voteMutex);
+                if (!current->error)
+                {
+                    current->error = std::current_exception();
+                }
+            }
+
+            std::lock_guard lock(mutex);
+            --current->active;
+            idle.notify_all();
+        }
+    }
+} // namespace SH3DS::Vision
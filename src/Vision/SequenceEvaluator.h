@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Vision/SequenceVoter.h"
+
+#include <opencv2/core.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace SH3DS::Vision
+{
+    class ShinyDetector;
+
+    /**
+     * @brief Runs a detector's per-frame Detect() over a sequence on a small worker pool and majority-votes.
+     *
+     * The calling thread works alongside the pool. Frames are claimed one at a time and fed to a SequenceVoter;
+     * once the vote is decided no further frames are claimed. EvaluateEach() instead keeps every per-frame result
+     * (one per sprite slot). Workers start on the first multi-frame sequence and live as long as the evaluator.
+     * The detector's Detect() must be safe to call concurrently, and must not call back into the same evaluator.
+     *
+     * Detectors share one evaluator (Shared() unless one is injected), so a fusion profile with several members
+     * still starts a single pool; concurrent Evaluate() / EvaluateEach() calls take turns.
+     */
+    class SequenceEvaluator
+    {
+    public:
+        /**
+         * @brief Constructs the evaluator.
+         * @param workerCount Pool threads in addition to the caller (0 evaluates on the caller only).
+         */
+        explicit SequenceEvaluator(unsigned workerCount = DefaultWorkerCount());
+
+        ~SequenceEvaluator();
+
+        SequenceEvaluator(const SequenceEvaluator &) = delete;
+        SequenceEvaluator &operator=(const SequenceEvaluator &) = delete;
+
+        /**
+         * @brief Majority-votes the detector's per-frame verdicts over a sequence.
+         * @param detector The detector to run on each frame.
+         * @param rois The frames.
+         * @return The sequence verdict with the mean confidence of the winning votes.
+         * @throws Any exception thrown by the detector.
+         */
+        Core::ShinyResult Evaluate(const ShinyDetector &detector, std::span<const cv::Mat> rois);
+
+        /**
+         * @brief Runs the detector's per-frame Detect() on every ROI, without voting or stopping early.
+         * @param detector The detector to run on each ROI.
+         * @param rois The ROIs (e.g. the sprite slots of one frame).
+         * @param results Output, one result per ROI (same size as rois).
+         * @throws std::invalid_argument if results and rois differ in size; any exception thrown by the detector.
+         */
+        void EvaluateEach(const ShinyDetector &detector,
+            std::span<const cv::Mat> rois,
+            std::span<Core::ShinyResult> results);
+
+        /**
+         * @brief Returns the default pool size: one less than the hardware thread count, at most 7.
+         * @return The default worker count.
+         */
+        static unsigned DefaultWorkerCount();
+
+        /**
+         * @brief Returns the process-wide evaluator detectors use by default (DefaultWorkerCount() workers).
+         * @return The shared evaluator.
+         */
+        static std::shared_ptr<SequenceEvaluator> Shared();
+
+    private:
+        /**
+         * @brief One in-flight sequence, shared by the caller and the workers that joined it.
+         */
+        struct Job
+        {
+            const ShinyDetector *detector = nullptr; ///< Detector being run
+            std::span<const cv::Mat> rois;           ///< Frames of the sequence
+            Core::ShinyResult *results = nullptr;    ///< Per-frame output (EvaluateEach), or null to vote
+            std::atomic<std::size_t> next = 0;       ///< Next unclaimed frame index
+            std::atomic<bool> decided = false;       ///< Set once the vote cannot change
+            std::mutex voteMutex;                    ///< Guards voter and error
+            SequenceVoter voter;                     ///< Streaming vote
+            std::exception_ptr error;                ///< First exception thrown by a worker
+            int active = 0;                          ///< Workers inside Drain() (guarded by mutex)
+
+            Job(const ShinyDetector &detector, std::span<const cv::Mat> rois)
+                : detector(&detector),
+                  rois(rois),
+                  voter(rois.size())
+            {
+            }
+        };
+
+        /**
+         * @brief Publishes a job to the pool, drains it alongside the workers and waits for them to leave it.
+         * @param current The job.
+         * @throws Any exception thrown by the detector.
+         */
+        void Run(Job &current);
+
+        /**
+         * @brief Claims and evaluates frames of a job until none are left or the vote is decided.
+         * @param job The job.
+         */
+        static void Drain(Job &job);
+
+        /**
+         * @brief Worker thread body: joins each published job and drains it.
+         */
+        void WorkerLoop();
+
+        unsigned workerCount;             ///< Pool size (excluding the caller)
+        std::vector<std::thread> workers; ///< Started on the first multi-frame sequence
+        std::mutex evaluateMutex;         ///< Serialises concurrent Evaluate() / EvaluateEach() calls
+        std::mutex mutex;                 ///< Guards job, generation, stopping and Job::active
+        std::condition_variable wake;     ///< Signals a new job or shutdown
+        std::condition_variable idle;     ///< Signals a worker leaving a job
+        Job *job = nullptr;               ///< Currently published job
+        uint64_t generation = 0;          ///< Incremented per published job
+        bool stopping = false;            ///< Set by the destructor
+    };
+} // namespace SH3DS::Vision
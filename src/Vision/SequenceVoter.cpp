@@ -0,0 +1,88 @@
+#include "SequenceVoter.h"
+
+namespace SH3DS::Vision
+{
+    SequenceVoter::SequenceVoter(std::size_t totalFrames) : totalFrames(totalFrames)
+    {
+    }
+
+    void SequenceVoter::Add(const Core::ShinyResult &result)
+    {
+        const auto index = static_cast<std::size_t>(result.verdict);
+        ++votes[index];
+        confidence[index] += result.confidence;
+        ++evaluated;
+        if (method.empty())
+        {
+            method = result.method;
+        }
+    }
+
+    bool SequenceVoter::IsDecided() const
+    {
+        if (evaluated >= totalFrames)
+        {
+            return true;
+        }
+        if (evaluated == 0)
+        {
+            return false;
+        }
+
+        // The leader wins if even giving every remaining frame to a rival cannot overtake it
+        // (or only ties it when the leader already wins the tie-break).
+        const std::size_t remaining = totalFrames - evaluated;
+        const std::size_t leader = Leader();
+        for (std::size_t rival = 0; rival < kVerdictCount; ++rival)
+        {
+            if (rival == leader)
+            {
+                continue;
+            }
+            const std::size_t rivalBest = votes[rival] + remaining;
+            if (rivalBest > votes[leader] || (rivalBest == votes[leader] && rival < leader))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t SequenceVoter::Evaluated() const
+    {
+        return evaluated;
+    }
+
+    Core::ShinyResult SequenceVoter::Result() const
+    {
+        if (evaluated == 0)
+        {
+            return { .method = method };
+        }
+
+        const std::size_t leader = Leader();
+        Core::ShinyResult result{ .verdict = static_cast<Core::ShinyVerdict>(leader),
+            .confidence = confidence[leader] / static_cast<double>(votes[leader]),
+            .method = method,
+            .note = "sequence_majority_vote" };
+        result.diagnostics.Add("count", static_cast<double>(votes[leader]), static_cast<double>(totalFrames));
+        if (evaluated < totalFrames)
+        {
+            result.diagnostics.Add("decided_after", static_cast<double>(evaluated));
+        }
+        return result;
+    }
+
+    std::size_t SequenceVoter::Leader() const
+    {
+        std::size_t leader = 0;
+        for (std::size_t index = 1; index < kVerdictCount; ++index)
+        {
+            if (votes[index] > votes[leader])
+            {
+                leader = index;
+            }
+        }
+        return leader;
+    }
+} // namespace SH3DS::Vision
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Core/Types.h"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace SH3DS::Vision
+{
+    /**
+     * @brief Streaming majority vote over per-frame shiny verdicts.
+     *
+     * Frames are added in any order. The vote is decided as soon as no outcome of the frames not yet seen can
+     * change the winner, so callers can stop evaluating early. Ties go to the lowest ShinyVerdict value.
+     */
+    class SequenceVoter
+    {
+    public:
+        /**
+         * @brief Constructs a voter for a sequence.
+         * @param totalFrames Number of frames in the sequence.
+         */
+        explicit SequenceVoter(std::size_t totalFrames);
+
+        /**
+         * @brief Adds one frame's verdict.
+         * @param result The frame's detection result.
+         */
+        void Add(const Core::ShinyResult &result);
+
+        /**
+         * @brief Returns true once the remaining frames can no longer change the winner.
+         * @return True if the vote is decided.
+         */
+        bool IsDecided() const;
+
+        /**
+         * @brief Returns the number of verdicts added so far.
+         * @return Evaluated frame count.
+         */
+        std::size_t Evaluated() const;
+
+        /**
+         * @brief Returns the current winner with its mean confidence.
+         * @return The sequence result (Uncertain with zero confidence if nothing was added).
+         */
+        Core::ShinyResult Result() const;
+
+    private:
+        static constexpr std::size_t kVerdictCount = 3; ///< Number of ShinyVerdict values
+
+        /**
+         * @brief Returns the verdict index with the most votes (lowest index on ties).
+         * @return The leading verdict index.
+         */
+        std::size_t Leader() const;
+
+        std::size_t totalFrames;                        ///< Frames in the sequence
+        std::size_t evaluated = 0;                      ///< Verdicts added so far
+        std::array<std::size_t, kVerdictCount> votes{}; ///< Votes per verdict
+        std::array<double, kVerdictCount> confidence{}; ///< Summed confidence per verdict
+        std::string_view method;                        ///< Method reported by the frames
+    };
+} // namespace SH3DS::Vision
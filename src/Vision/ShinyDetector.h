@@ -8,6 +8,7 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <vector>
 
 namespace SH3DS::Vision
 {
@@ -33,6 +34,25 @@ namespace SH3DS::Vision
          */
         virtual Core::ShinyResult DetectSequence(std::span<const cv::Mat> rois) const = 0;
 
+        /**
+         * @brief Detect shiny Pokemon in several sprite slots of the same frame (horde and double battles).
+         *
+         * Unlike DetectSequence() the ROIs are independent: each slot gets its own verdict. The default runs
+         * Detect() per slot; detectors override it to share work across the slots.
+         * @param rois One image region per sprite slot.
+         * @return One shiny detection result per slot, in slot order.
+         */
+        virtual std::vector<Core::ShinyResult> DetectBatch(std::span<const cv::Mat> rois) const
+        {
+            std::vector<Core::ShinyResult> results;
+            results.reserve(rois.size());
+            for (const auto &roi : rois)
+            {
+                results.push_back(Detect(roi));
+            }
+            return results;
+        }
+
         /**
          * @brief Get the profile ID.
          * @return The profile ID.
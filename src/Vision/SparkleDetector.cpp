@@ -0,0 +1,211 @@
+#include "SparkleDetector.h"
+
+#include <opencv2/core/hal/intrin.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace SH3DS::Vision
+{
+    namespace
+    {
+        /// Per-lane 8-bit counters can take this many vectors before they must be widened.
+        constexpr int kMaxVectorsPerBlock = 255;
+
+        constexpr std::string_view kMethodName = "sparkle"; ///< Reported in ShinyResult::method
+    } // namespace
+
+    SparkleDetector::SparkleDetector(Core::DetectionMethodConfig config, std::string profileId)
+        : config(std::move(config)),
+          id(std::move(profileId))
+    {
+        this->config.minConsecutiveFrames = std::max(this->config.minConsecutiveFrames, 1);
+    }
+
+    Core::ShinyResult SparkleDetector::Detect(const cv::Mat &pokemonRoi) const
+    {
+        Core::ShinyResult result{ .method = kMethodName };
+        if (pokemonRoi.empty())
+        {
+            return result;
+        }
+
+        double brightRatio = 0.0;
+        run = IsSparkleFrame(pokemonRoi, brightRatio) ? run + 1 : 0;
+        longestRun = std::max(longestRun, run);
+        latched = latched || run >= config.minConsecutiveFrames;
+
+        result.diagnostics.Add("bright", brightRatio);
+        result.diagnostics.Add("run", run);
+        result.diagnostics.Add("longest_run", longestRun);
+
+        if (latched)
+        {
+            result.verdict = Core::ShinyVerdict::Shiny;
+            result.confidence = 1.0;
+        }
+        else if (run == 0)
+        {
+            result.verdict = Core::ShinyVerdict::NotShiny;
+            result.confidence = 1.0 - std::min(brightRatio / config.minBrightPixelRatio, 1.0);
+        }
+        return result;
+    }
+
+    Core::ShinyResult SparkleDetector::DetectSequence(std::span<const cv::Mat> rois) const
+    {
+        int sequenceRun = 0;
+        int sequenceLongest = 0;
+        std::size_t evaluated = 0;
+        for (const auto &roi : rois)
+        {
+            if (roi.empty())
+            {
+                sequenceRun = 0;
+                continue;
+            }
+
+            double brightRatio = 0.0;
+            sequenceRun = IsSparkleFrame(roi, brightRatio) ? sequenceRun + 1 : 0;
+            sequenceLongest = std::max(sequenceLongest, sequenceRun);
+            ++evaluated;
+            if (sequenceRun >= config.minConsecutiveFrames)
+            {
+                break;
+            }
+        }
+
+        Core::ShinyResult result{ .method = kMethodName };
+        result.diagnostics.Add("longest_run", sequenceLongest);
+        result.diagnostics.Add("evaluated", static_cast<double>(evaluated), static_cast<double>(rois.size()));
+
+        if (sequenceLongest >= config.minConsecutiveFrames)
+        {
+            result.verdict = Core::ShinyVerdict::Shiny;
+            result.confidence = 1.0;
+        }
+        // Too few frames to have contained a full run: absence of a sparkle proves nothing.
+        else if (evaluated >= static_cast<std::size_t>(config.minConsecutiveFrames))
+        {
+            result.verdict = Core::ShinyVerdict::NotShiny;
+            result.confidence = 1.0 - static_cast<double>(sequenceLongest) / config.minConsecutiveFrames;
+        }
+        return result;
+    }
+
+    std::vector<Core::ShinyResult> SparkleDetector::DetectBatch(std::span<const cv::Mat> rois) const
+    {
+        std::vector<Core::ShinyResult> results;
+        results.reserve(rois.size());
+        for (const auto &roi : rois)
+        {
+            Core::ShinyResult &result = results.emplace_back(Core::ShinyResult{ .method = kMethodName });
+            if (roi.empty())
+            {
+                continue;
+            }
+
+            double brightRatio = 0.0;
+            const bool sparkle = IsSparkleFrame(roi, brightRatio);
+            result.diagnostics.Add("bright", brightRatio);
+            if (sparkle && config.minConsecutiveFrames <= 1)
+            {
+                result.verdict = Core::ShinyVerdict::Shiny;
+                result.confidence = 1.0;
+            }
+            else if (!sparkle)
+            {
+                result.verdict = Core::ShinyVerdict::NotShiny;
+                result.confidence = 1.0 - std::min(brightRatio / config.minBrightPixelRatio, 1.0);
+            }
+        }
+        return results;
+    }
+
+    std::string SparkleDetector::ProfileId() const
+    {
+        return id;
+    }
+
+    void SparkleDetector::Reset()
+    {
+        run = 0;
+        longestRun = 0;
+        latched = false;
+    }
+
+    uint32_t SparkleDetector::CountBrightPixels(const cv::Mat &bgr, int threshold)
+    {
+        if (bgr.empty())
+        {
+            return 0;
+        }
+        if (bgr.type() != CV_8UC3)
+        {
+            throw std::runtime_error("SparkleDetector: expected a CV_8UC3 image");
+        }
+        if (threshold <= 0)
+        {
+            return static_cast<uint32_t>(bgr.total());
+        }
+        if (threshold > 255)
+        {
+            return 0;
+        }
+
+        const auto limit = static_cast<uchar>(threshold);
+        uint32_t count = 0;
+        for (int row = 0; row < bgr.rows; ++row)
+        {
+            const uchar *pixels = bgr.ptr<uchar>(row);
+            int col = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const int lanes = cv::VTraits<cv::v_uint8>::vlanes();
+            const cv::v_uint8 limitVec = cv::vx_setall_u8(limit);
+            const cv::v_uint8 one = cv::vx_setall_u8(1);
+            while (col <= bgr.cols - lanes)
+            {
+                cv::v_uint8 laneCounts = cv::vx_setzero_u8();
+                for (int block = 0; block < kMaxVectorsPerBlock && col <= bgr.cols - lanes; ++block, col += lanes)
+                {
+                    cv::v_uint8 b;
+                    cv::v_uint8 g;
+                    cv::v_uint8 r;
+                    cv::v_load_deinterleave(pixels + static_cast<std::ptrdiff_t>(col) * 3, b, g, r);
+                    const cv::v_uint8 value = cv::v_max(cv::v_max(b, g), r);
+                    laneCounts = cv::v_add(laneCounts, cv::v_and(cv::v_ge(value, limitVec), one));
+                }
+
+                cv::v_uint16 low;
+                cv::v_uint16 high;
+                cv::v_expand(laneCounts, low, high);
+                count += cv::v_reduce_sum(cv::v_add(low, high));
+            }
+#endif
+            for (; col < bgr.cols; ++col)
+            {
+                const uchar *pixel = pixels + static_cast<std::ptrdiff_t>(col) * 3;
+                count += std::max({ pixel[0], pixel[1], pixel[2] }) >= limit ? 1u : 0u;
+            }
+        }
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        cv::vx_cleanup();
+#endif
+        return count;
+    }
+
+    std::unique_ptr<ShinyDetector> SparkleDetector::CreateSparkleDetector(const Core::DetectionMethodConfig &config,
+        const std::string &profileId)
+    {
+        return std::make_unique<SparkleDetector>(config, profileId);
+    }
+
+    bool SparkleDetector::IsSparkleFrame(const cv::Mat &roi, double &brightRatio) const
+    {
+        brightRatio = static_cast<double>(CountBrightPixels(roi, config.brightnessThreshold))
+                      / static_cast<double>(roi.total());
+        return brightRatio >= config.minBrightPixelRatio;
+    }
+} // namespace SH3DS::Vision
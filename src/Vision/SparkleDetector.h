@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ShinyDetector.h"
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SH3DS::Vision
+{
+    /**
+     * @brief Detects the shiny sparkle animation from the brightness of consecutive frames.
+     *
+     * Fed the sparkle ROI (DetectionMethodConfig::sparkleRoi) one frame at a time. A frame is a sparkle frame
+     * when at least minBrightPixelRatio of its pixels have a max channel (HSV V) of at least brightnessThreshold;
+     * minConsecutiveFrames sparkle frames in a row latch a Shiny verdict until Reset(). Only a run counter is
+     * kept between frames, so no frames are buffered.
+     *
+     * Detect() updates that state and must be called in frame order from one thread.
+     */
+    class SparkleDetector : public ShinyDetector
+    {
+    public:
+        /**
+         * @brief Constructs a SparkleDetector.
+         * @param config Detection method configuration with the sparkle fields.
+         * @param profileId Profile identifier for this detector instance.
+         */
+        explicit SparkleDetector(Core::DetectionMethodConfig config, std::string profileId);
+
+        /**
+         * @brief Feeds the next frame of the sparkle ROI.
+         * @return Shiny once a sparkle run has been seen, Uncertain while a run is building, NotShiny otherwise.
+         */
+        Core::ShinyResult Detect(const cv::Mat &pokemonRoi) const override;
+
+        /**
+         * @brief Scans a sequence of frames in order for a sparkle run (independent of the Detect() state).
+         * @return Shiny if a run was found, NotShiny if the sequence was long enough to contain one but did not.
+         */
+        Core::ShinyResult DetectSequence(std::span<const cv::Mat> rois) const override;
+
+        /**
+         * @brief Scores each sprite slot as a single frame, leaving the Detect() run state untouched.
+         *
+         * Slots of one frame are not consecutive frames, so they must not build a run. Each slot gets the verdict
+         * Detect() would give it right after Reset(): Shiny only if one sparkle frame is enough.
+         */
+        std::vector<Core::ShinyResult> DetectBatch(std::span<const cv::Mat> rois) const override;
+
+        /**
+         * @brief Returns the profile identifier.
+         */
+        std::string ProfileId() const override;
+
+        /**
+         * @brief Clears the run counter and the latched verdict.
+         */
+        void Reset() override;
+
+        /**
+         * @brief Counts pixels whose max channel is at least `threshold`.
+         * @param bgr The image (CV_8UC3, any stride).
+         * @param threshold Brightness threshold in [0, 255].
+         * @return Number of bright pixels.
+         */
+        static uint32_t CountBrightPixels(const cv::Mat &bgr, int threshold);
+
+        /**
+         * @brief Create a sparkle detector.
+         * @param config The detection method configuration.
+         * @param profileId The profile ID.
+         * @return A unique pointer to the sparkle detector.
+         */
+        static std::unique_ptr<ShinyDetector> CreateSparkleDetector(const Core::DetectionMethodConfig &config,
+            const std::string &profileId);
+
+    private:
+        /**
+         * @brief Returns true if the frame has enough bright pixels to be part of a sparkle.
+         * @param roi The frame.
+         * @param brightRatio Receives the bright pixel ratio.
+         * @return True for a sparkle frame.
+         */
+        bool IsSparkleFrame(const cv::Mat &roi, double &brightRatio) const;
+
+        Core::DetectionMethodConfig config; ///< Detection method configuration
+        std::string id;                     ///< Profile identifier
+        mutable int run = 0;                ///< Consecutive sparkle frames up to the last Detect()
+        mutable int longestRun = 0;         ///< Longest run seen since Reset()
+        mutable bool latched = false;       ///< A full sparkle run has been seen since Reset()
+    };
+} // namespace SH3DS::Vision
@@ -3,38 +3,116 @@
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
 namespace SH3DS::Vision
 {
+    namespace
+    {
+        /// Longest row (in bytes) whose 8-bit products can be summed in a uint32_t without overflow.
+        constexpr int kMaxFusedRowLength = static_cast<int>(UINT32_MAX / (255u * 255u));
+    } // namespace
+
     double TemplateMatcher::Match(const cv::Mat &region, const std::string &templatePath)
     {
+        if (region.empty())
+        {
+            return 0.0;
+        }
+
         auto it = cache.find(templatePath);
         if (it == cache.end())
         {
-            cv::Mat tmpl = cv::imread(templatePath, cv::IMREAD_COLOR);
-            if (tmpl.empty())
-            {
-                return 0.0;
-            }
-            cache[templatePath] = tmpl;
-            it = cache.find(templatePath);
+            // Unreadable templates are cached as empty so a missing file is not re-read every frame.
+            TemplateEntry entry{ .source = cv::imread(templatePath, cv::IMREAD_COLOR), .resized = {} };
+            it = cache.emplace(templatePath, std::move(entry)).first;
+        }
+
+        TemplateEntry &entry = it->second;
+        if (entry.source.empty())
+        {
+            return 0.0;
         }
 
-        const cv::Mat &tmpl = it->second;
-        cv::Mat resized;
-        if (tmpl.size() != region.size())
+        const cv::Size regionSize = region.size();
+        const cv::Size templateSize = entry.source.size();
+        const bool fitsInside = templateSize.width <= regionSize.width && templateSize.height <= regionSize.height;
+
+        cv::Mat result;
+        if (fitsInside && templateSize != regionSize)
         {
-            cv::resize(tmpl, resized, region.size());
+            // Template is smaller than the region: true sliding search at native size.
+            cv::matchTemplate(region, entry.source, result, cv::TM_CCORR_NORMED);
         }
         else
         {
-            resized = tmpl;
+            const PreparedTemplate &prepared = Prepare(entry, regionSize);
+            if (region.type() == CV_8UC3 && region.cols * region.channels() <= kMaxFusedRowLength)
+            {
+                return NormalizedDotProduct(region, prepared);
+            }
+            cv::matchTemplate(region, prepared.image, result, cv::TM_CCORR_NORMED);
         }
 
-        cv::Mat result;
-        cv::matchTemplate(region, resized, result, cv::TM_CCORR_NORMED);
-
         double maxVal;
         cv::minMaxLoc(result, nullptr, &maxVal);
         return maxVal;
     }
+
+    const TemplateMatcher::PreparedTemplate &TemplateMatcher::Prepare(TemplateEntry &entry, cv::Size size)
+    {
+        const auto key = std::make_pair(size.width, size.height);
+        auto it = entry.resized.find(key);
+        if (it != entry.resized.end())
+        {
+            return it->second;
+        }
+
+        PreparedTemplate prepared;
+        if (entry.source.size() == size)
+        {
+            prepared.image = entry.source;
+        }
+        else
+        {
+            cv::resize(entry.source, prepared.image, size);
+        }
+        prepared.norm = cv::norm(prepared.image, cv::NORM_L2);
+
+        return entry.resized.emplace(key, std::move(prepared)).first->second;
+    }
+
+    double TemplateMatcher::NormalizedDotProduct(const cv::Mat &region, const PreparedTemplate &tmpl)
+    {
+        // Equal-size TM_CCORR_NORMED is sum(T*I) / (|T| * |I|). |T| is cached, so one pass over the region
+        // accumulates both sum(T*I) and sum(I*I). The inner loop is branch-free 8-bit multiply-accumulate into
+        // 32-bit lanes, which the compiler vectorises; per-row sums are widened to 64 bits.
+        const int rowLength = region.cols * region.channels();
+        uint64_t dot = 0;
+        uint64_t regionSquared = 0;
+        for (int y = 0; y < region.rows; ++y)
+        {
+            const uint8_t *regionRow = region.ptr<uint8_t>(y);
+            const uint8_t *templateRow = tmpl.image.ptr<uint8_t>(y);
+            uint32_t rowDot = 0;
+            uint32_t rowSquared = 0;
+            for (int x = 0; x < rowLength; ++x)
+            {
+                const uint32_t value = regionRow[x];
+                rowDot += value * templateRow[x];
+                rowSquared += value * value;
+            }
+            dot += rowDot;
+            regionSquared += rowSquared;
+        }
+
+        const double denominator = tmpl.norm * std::sqrt(static_cast<double>(regionSquared));
+        if (denominator <= 0.0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(dot) / denominator;
+    }
 } // namespace SH3DS::Vision
@@ -2,13 +2,19 @@
 
 #include <opencv2/core.hpp>
 
+#include <functional>
 #include <map>
 #include <string>
+#include <utility>
 
 namespace SH3DS::Vision
 {
     /**
      * @brief Utility for template matching with caching.
+     *
+     * Templates are loaded once per path. Templates larger than (or not fitting inside) the region are resized
+     * to the region size once per (path, size) and matched with a single normalised dot product; templates
+     * that fit inside the region are searched with a sliding TM_CCORR_NORMED match at native size.
      */
     class TemplateMatcher
     {
@@ -22,6 +28,40 @@ namespace SH3DS::Vision
         double Match(const cv::Mat &region, const std::string &templatePath);
 
     private:
-        std::map<std::string, cv::Mat> cache; ///< Loaded template cache
+        /**
+         * @brief Template resized to a specific region size, with its L2 norm precomputed.
+         */
+        struct PreparedTemplate
+        {
+            cv::Mat image;     ///< Resized template (CV_8UC3)
+            double norm = 0.0; ///< sqrt(sum of squared template values)
+        };
+
+        /**
+         * @brief Cached template file and its resized variants.
+         */
+        struct TemplateEntry
+        {
+            cv::Mat source;                                          ///< Template as loaded (empty if unreadable)
+            std::map<std::pair<int, int>, PreparedTemplate> resized; ///< Keyed by (width, height)
+        };
+
+        /**
+         * @brief Returns the template resized to `size`, preparing and caching it on first use.
+         * @param entry The cached template entry.
+         * @param size The target size.
+         * @return The prepared template.
+         */
+        static const PreparedTemplate &Prepare(TemplateEntry &entry, cv::Size size);
+
+        /**
+         * @brief TM_CCORR_NORMED of two equal-sized CV_8UC3 images in a single fused pass.
+         * @param region The region.
+         * @param tmpl The prepared template (same size and type as region).
+         * @return The normalised cross-correlation in [0.0, 1.0].
+         */
+        static double NormalizedDotProduct(const cv::Mat &region, const PreparedTemplate &tmpl);
+
+        std::map<std::string, TemplateEntry, std::less<>> cache; ///< Loaded template cache
     };
 } // namespace SH3DS::Vision
@@ -14,6 +14,11 @@
 /// Tests the pipeline: FramePreprocessor -> CXXStateTreeFSM -> ShinyDetector.
 namespace
 {
+    const std::string &StateName(const SH3DS::FSM::GameStateFSM &fsm, SH3DS::Core::StateId id)
+    {
+        return fsm.GetStateRegistry()->Name(id);
+    }
+
     SH3DS::Core::StateDetectionParams MakeTopDetection(const std::string &roi,
         const std::string &method,
         const cv::Scalar &hsvLower,
@@ -124,7 +129,7 @@ TEST_F(ReplayPipelineTest, FullPipelineDarkToBrightTransition)
         ASSERT_TRUE(roiSet.has_value());
         fsm->Update(*roiSet, {});
     }
-    EXPECT_EQ(fsm->GetCurrentState(), "dark_screen");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "dark_screen");
 
     // Simulate bright frames (title screen / reveal)
     for (int i = 0; i < 3; ++i)
@@ -134,12 +139,12 @@ TEST_F(ReplayPipelineTest, FullPipelineDarkToBrightTransition)
         ASSERT_TRUE(roiSet.has_value());
         fsm->Update(*roiSet, {});
     }
-    EXPECT_EQ(fsm->GetCurrentState(), "bright_screen");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "bright_screen");
 
     // Verify history
     ASSERT_GE(fsm->GetTransitionHistory().size(), 2u);
-    EXPECT_EQ(fsm->GetTransitionHistory()[0].to, "dark_screen");
-    EXPECT_EQ(fsm->GetTransitionHistory()[1].to, "bright_screen");
+    EXPECT_EQ(StateName(*fsm, fsm->GetTransitionHistory()[0].to), "dark_screen");
+    EXPECT_EQ(StateName(*fsm, fsm->GetTransitionHistory()[1].to), "bright_screen");
 }
 
 TEST_F(ReplayPipelineTest, ShinyDetectorIntegration)
@@ -49,7 +49,7 @@ TEST(XYStarterFennekinReplay, StateSequenceMatchesExpected)
 
     // 6. Per-frame loop (mirrors Orchestrator::MainLoopTick)
     std::vector<std::string> stateLog;
-    std::string lastState = fsm->GetCurrentState();
+    std::string lastState = fsm->GetCurrentStateName();
 
     while (true)
     {
@@ -79,7 +79,7 @@ TEST(XYStarterFennekinReplay, StateSequenceMatchesExpected)
         }
 
         fsm->Update(dualResult->topRois, dualResult->bottomRois);
-        lastState = fsm->GetCurrentState();
+        lastState = fsm->GetCurrentStateName();
         stateLog.push_back(lastState);
     }
 
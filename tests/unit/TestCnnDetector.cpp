@@ -0,0 +1,285 @@
+#include "Core/Config.h"
+#include "Vision/CnnDetector.h"
+#include "Vision/QuantizedCnn.h"
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using SH3DS::Core::ShinyVerdict;
+    using SH3DS::Vision::QuantizedCnn;
+
+    /// Layer of the given type with no parameters set.
+    QuantizedCnn::Layer CreateLayer(QuantizedCnn::LayerType type)
+    {
+        QuantizedCnn::Layer layer;
+        layer.type = type;
+        return layer;
+    }
+
+    /// Global average pool, then a dense head whose normal logit is the mean blue and shiny logit the mean red.
+    QuantizedCnn CreateRedVsBlueModel()
+    {
+        const QuantizedCnn::Layer pool = CreateLayer(QuantizedCnn::LayerType::GlobalAveragePool);
+        QuantizedCnn::Layer head{
+            .type = QuantizedCnn::LayerType::Dense,
+            .outChannels = 2,
+            .relu = false,
+            .weights = { 1, 0, 0, 0, 0, 1 }, // [B, G, R][normal, shiny]
+            .bias = { 0, 0 },
+            .multiplier = { 0.1f, 0.1f },
+        };
+        return QuantizedCnn(4, 4, { pool, head });
+    }
+
+    /// Conv + pool stack: exercises every layer type and the batch path.
+    QuantizedCnn CreateConvModel()
+    {
+        cv::RNG rng(5);
+        auto randomLayer = [&](QuantizedCnn::LayerType type, int inputs, int outputs, bool relu) {
+            QuantizedCnn::Layer layer = CreateLayer(type);
+            layer.outChannels = outputs;
+            layer.relu = relu;
+            layer.weights.resize(static_cast<std::size_t>(inputs) * static_cast<std::size_t>(outputs));
+            for (auto &weight : layer.weights)
+            {
+                weight = static_cast<int8_t>(rng.uniform(-127, 128));
+            }
+            layer.bias.assign(static_cast<std::size_t>(outputs), 100);
+            layer.multiplier.assign(static_cast<std::size_t>(outputs), 0.002f);
+            return layer;
+        };
+
+        std::vector<QuantizedCnn::Layer> layers;
+        layers.push_back(randomLayer(QuantizedCnn::LayerType::Conv3x3, 9 * 3, 8, true));
+        layers.push_back(CreateLayer(QuantizedCnn::LayerType::MaxPool2x2));
+        layers.push_back(randomLayer(QuantizedCnn::LayerType::Conv3x3, 9 * 8, 16, true));
+        layers.push_back(CreateLayer(QuantizedCnn::LayerType::GlobalAveragePool));
+        layers.push_back(randomLayer(QuantizedCnn::LayerType::Dense, 16, 2, false));
+        return QuantizedCnn(20, 12, std::move(layers));
+    }
+
+    cv::Mat CreateRoi(const cv::Scalar &bgr, int width = 16, int height = 16)
+    {
+        return cv::Mat(height, width, CV_8UC3, bgr);
+    }
+} // namespace
+
+class CnnDetectorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        modelPath = (std::filesystem::temp_directory_path() / "sh3ds_test_cnn.bin").string();
+        CreateRedVsBlueModel().Save(modelPath);
+        config.method = "cnn";
+        config.modelPath = modelPath;
+        config.modelConfidence = 0.8;
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(modelPath);
+    }
+
+    std::string modelPath;
+    SH3DS::Core::DetectionMethodConfig config;
+};
+
+TEST(QuantizedCnn, RejectsInconsistentLayers)
+{
+    QuantizedCnn::Layer head{ .type = QuantizedCnn::LayerType::Dense,
+        .outChannels = 2,
+        .relu = false,
+        .weights = { 1, 0, 0, 0 },
+        .bias = { 0, 0 },
+        .multiplier = { 1.0f, 1.0f } };
+    EXPECT_THROW(QuantizedCnn(4, 4, { head }), std::runtime_error);
+
+    const QuantizedCnn::Layer pool = CreateLayer(QuantizedCnn::LayerType::MaxPool2x2);
+    EXPECT_THROW(QuantizedCnn(4, 4, { pool }), std::runtime_error);
+    EXPECT_THROW((QuantizedCnn(0, 4, { pool, head })), std::runtime_error);
+}
+
+TEST(QuantizedCnn, SaveLoadRoundTripPreservesPredictions)
+{
+    const QuantizedCnn model = CreateConvModel();
+    const auto path = (std::filesystem::temp_directory_path() / "sh3ds_test_cnn_roundtrip.bin").string();
+    model.Save(path);
+    const QuantizedCnn loaded = QuantizedCnn::Load(path);
+    std::filesystem::remove(path);
+
+    cv::Mat roi(24, 40, CV_8UC3);
+    cv::RNG(9).fill(roi, cv::RNG::UNIFORM, 0, 256);
+    EXPECT_EQ(loaded.InputWidth(), 20);
+    EXPECT_EQ(loaded.InputHeight(), 12);
+    EXPECT_EQ(loaded.MacsPerInference(), model.MacsPerInference());
+    EXPECT_FLOAT_EQ(loaded.Predict(roi), model.Predict(roi));
+}
+
+TEST(QuantizedCnn, LoadRejectsMissingOrTruncatedFiles)
+{
+    EXPECT_THROW(QuantizedCnn::Load("/nonexistent/model.bin"), std::runtime_error);
+
+    const auto path = (std::filesystem::temp_directory_path() / "sh3ds_test_cnn_truncated.bin").string();
+    CreateConvModel().Save(path);
+    std::filesystem::resize_file(path, 40);
+    EXPECT_THROW(QuantizedCnn::Load(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(QuantizedCnn, LoadRejectsImplausibleLayerSizes)
+{
+    // A valid header whose single dense layer would need 1024x1024x3 x 1024 weights: rejected before allocating.
+    const auto path = (std::filesystem::temp_directory_path() / "sh3ds_test_cnn_oversized.bin").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write("SHCN", 4);
+        for (const int32_t value : { 1, 1024, 1024, 1, static_cast<int32_t>(QuantizedCnn::LayerType::Dense), 1024, 0 })
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+    }
+    EXPECT_THROW(QuantizedCnn::Load(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(QuantizedCnn, BatchMatchesSingleFramePredictions)
+{
+    const QuantizedCnn model = CreateConvModel();
+    cv::RNG rng(17);
+    std::vector<cv::Mat> rois;
+    for (int i = 0; i < 5; ++i)
+    {
+        rois.emplace_back(12, 20, CV_8UC3);
+        rng.fill(rois.back(), cv::RNG::UNIFORM, 0, 256);
+    }
+
+    const std::vector<float> batch = model.Predict(rois);
+    ASSERT_EQ(batch.size(), rois.size());
+    for (std::size_t i = 0; i < rois.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(batch[i], model.Predict(rois[i]));
+    }
+}
+
+TEST(QuantizedCnn, VectorAndScalarOutputChannelsAgree)
+{
+    // Ten conv outputs: channels 0-7 take the SIMD path, 8-9 the scalar tail. Channels 8 and 9 copy the weights of
+    // 0 and 5 (one from each int32 half), and the head compares each copy with its original, so any mismatch moves
+    // the probability off 0.5.
+    cv::RNG rng(23);
+    constexpr int kOutputs = 10;
+    constexpr std::array<std::size_t, 2> kOriginals = { 0, 5 };
+    QuantizedCnn::Layer conv = CreateLayer(QuantizedCnn::LayerType::Conv3x3);
+    conv.outChannels = kOutputs;
+    conv.relu = true;
+    conv.weights.resize(9 * 3 * kOutputs);
+    for (std::size_t i = 0; i < conv.weights.size(); ++i)
+    {
+        const std::size_t output = i % kOutputs;
+        conv.weights[i] = output >= 8 ? conv.weights[i - output + kOriginals[output - 8]]
+                                      : static_cast<int8_t>(rng.uniform(-127, 128));
+    }
+    conv.bias.assign(kOutputs, 50);
+    conv.multiplier.assign(kOutputs, 0.004f);
+
+    for (std::size_t copy = 0; copy < kOriginals.size(); ++copy)
+    {
+        QuantizedCnn::Layer head = CreateLayer(QuantizedCnn::LayerType::Dense);
+        head.outChannels = 2;
+        head.weights.assign(kOutputs * 2, 0);
+        head.weights[kOriginals[copy] * 2] = 1; // normal logit: SIMD channel
+        head.weights[(8 + copy) * 2 + 1] = 1;   // shiny logit: scalar copy
+        head.bias = { 0, 0 };
+        head.multiplier = { 0.1f, 0.1f };
+        const QuantizedCnn model(20, 12, { conv, CreateLayer(QuantizedCnn::LayerType::GlobalAveragePool), head });
+
+        cv::Mat roi(12, 20, CV_8UC3);
+        rng.fill(roi, cv::RNG::UNIFORM, 0, 256);
+        EXPECT_FLOAT_EQ(model.Predict(roi), 0.5f) << "channel " << kOriginals[copy];
+    }
+}
+
+TEST_F(CnnDetectorTest, ClassifiesByModelOutput)
+{
+    SH3DS::Vision::CnnDetector detector(config, "test");
+
+    const auto shiny = detector.Detect(CreateRoi(cv::Scalar(0, 0, 255)));
+    EXPECT_EQ(shiny.verdict, ShinyVerdict::Shiny);
+    EXPECT_GT(shiny.confidence, 0.99);
+    EXPECT_EQ(shiny.method, "cnn");
+
+    EXPECT_EQ(detector.Detect(CreateRoi(cv::Scalar(255, 0, 0))).verdict, ShinyVerdict::NotShiny);
+    EXPECT_EQ(detector.Detect(CreateRoi(cv::Scalar(128, 128, 128))).verdict, ShinyVerdict::Uncertain);
+}
+
+TEST_F(CnnDetectorTest, SequenceVotesOverBatch)
+{
+    SH3DS::Vision::CnnDetector detector(config, "test");
+
+    const std::vector<cv::Mat> rois = {
+        CreateRoi(cv::Scalar(0, 0, 255)),
+        CreateRoi(cv::Scalar(255, 0, 0)),
+        CreateRoi(cv::Scalar(0, 0, 255)),
+        cv::Mat(),
+    };
+    const auto result = detector.DetectSequence(rois);
+    EXPECT_EQ(result.verdict, ShinyVerdict::Shiny);
+    EXPECT_EQ(result.Details(), "sequence_majority_vote: count=2/3");
+}
+
+TEST_F(CnnDetectorTest, BatchGivesOneVerdictPerSlot)
+{
+    SH3DS::Vision::CnnDetector detector(config, "test");
+
+    const std::vector<cv::Mat> slots = {
+        CreateRoi(cv::Scalar(255, 0, 0)),
+        cv::Mat(),
+        CreateRoi(cv::Scalar(0, 0, 255), 24, 20),
+        CreateRoi(cv::Scalar(128, 128, 128)),
+    };
+    const auto results = detector.DetectBatch(slots);
+    ASSERT_EQ(results.size(), slots.size());
+    EXPECT_EQ(results[0].verdict, ShinyVerdict::NotShiny);
+    EXPECT_EQ(results[1].verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(results[2].verdict, ShinyVerdict::Shiny);
+    EXPECT_EQ(results[3].verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(results[2].Details(), detector.Detect(slots[2]).Details());
+}
+
+TEST_F(CnnDetectorTest, NonBgrRoiIsUncertain)
+{
+    SH3DS::Vision::CnnDetector detector(config, "test");
+
+    const cv::Mat gray(16, 16, CV_8UC1, cv::Scalar(255));
+    const auto result = detector.Detect(gray);
+    EXPECT_EQ(result.verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(result.Details(), "expected a BGR ROI");
+
+    const std::vector<cv::Mat> slots = { gray, CreateRoi(cv::Scalar(0, 0, 255)) };
+    const auto results = detector.DetectBatch(slots);
+    EXPECT_EQ(results[0].verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(results[1].verdict, ShinyVerdict::Shiny);
+    EXPECT_EQ(detector.DetectSequence(slots).verdict, ShinyVerdict::Shiny);
+}
+
+TEST_F(CnnDetectorTest, MissingModelIsUncertain)
+{
+    config.modelPath = "/nonexistent/model.bin";
+    SH3DS::Vision::CnnDetector detector(config, "test");
+
+    const auto result = detector.Detect(CreateRoi(cv::Scalar(0, 0, 255)));
+    EXPECT_EQ(result.verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(result.Details(), "model not loaded");
+}
@@ -0,0 +1,173 @@
+#include "Vision/ColorClassifier.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    cv::Mat CreateNoiseImage(int width, int height, uint64_t seed)
+    {
+        cv::Mat image(height, width, CV_8UC3);
+        cv::RNG rng(seed);
+        rng.fill(image, cv::RNG::UNIFORM, 0, 256);
+        return image;
+    }
+
+    uint32_t LegacyCount(const cv::Mat &bgr, const cv::Scalar &lower, const cv::Scalar &upper)
+    {
+        cv::Mat hsv;
+        cv::cvtColor(bgr, hsv, cv::COLOR_BGR2HSV);
+        cv::Mat mask;
+        cv::inRange(hsv, lower, upper, mask);
+        return static_cast<uint32_t>(cv::countNonZero(mask));
+    }
+
+    struct Range
+    {
+        cv::Scalar lower;
+        cv::Scalar upper;
+    };
+
+    const std::vector<Range> kRanges = {
+        { cv::Scalar(0, 0, 0), cv::Scalar(180, 50, 50) },
+        { cv::Scalar(0, 0, 200), cv::Scalar(180, 50, 255) },
+        { cv::Scalar(100, 100, 60), cv::Scalar(130, 255, 200) },
+        { cv::Scalar(95, 25, 170), cv::Scalar(135, 110, 255) },
+        { cv::Scalar(0, 200, 200), cv::Scalar(10, 255, 255) },
+        { cv::Scalar(0, 0, 0), cv::Scalar(0, 0, 0) },
+    };
+} // namespace
+
+TEST(ColorClassifier, CountsMatchCvtColorAndInRange)
+{
+    SH3DS::Vision::ColorClassifier classifier;
+    for (const auto &range : kRanges)
+    {
+        classifier.AddRange(range.lower, range.upper);
+    }
+    classifier.Compile();
+
+    const cv::Mat image = CreateNoiseImage(400, 240, 7);
+    std::array<uint32_t, SH3DS::Vision::ColorClassifier::kMaxRanges> counts{};
+    classifier.CountPixels(image, counts);
+
+    for (std::size_t i = 0; i < kRanges.size(); ++i)
+    {
+        EXPECT_EQ(counts[i], LegacyCount(image, kRanges[i].lower, kRanges[i].upper)) << "range " << i;
+    }
+}
+
+TEST(ColorClassifier, EveryColourMatchesInRange)
+{
+    SH3DS::Vision::ColorClassifier classifier;
+    for (const auto &range : kRanges)
+    {
+        classifier.AddRange(range.lower, range.upper);
+    }
+    classifier.Compile();
+
+    // All 2^24 colours, one image row per (b, g) pair, so every boundary bin is checked.
+    cv::Mat allColours(256 * 256, 256, CV_8UC3);
+    for (int row = 0; row < allColours.rows; ++row)
+    {
+        auto *pixel = allColours.ptr<cv::Vec3b>(row);
+        for (int r = 0; r < 256; ++r)
+        {
+            pixel[r] = cv::Vec3b(static_cast<uchar>(row / 256), static_cast<uchar>(row % 256), static_cast<uchar>(r));
+        }
+    }
+
+    std::array<uint32_t, SH3DS::Vision::ColorClassifier::kMaxRanges> counts{};
+    classifier.CountPixels(allColours, counts);
+    for (std::size_t i = 0; i < kRanges.size(); ++i)
+    {
+        EXPECT_EQ(counts[i], LegacyCount(allColours, kRanges[i].lower, kRanges[i].upper)) << "range " << i;
+    }
+}
+
+TEST(ColorClassifier, NonContinuousRoiMatchesCopy)
+{
+    SH3DS::Vision::ColorClassifier classifier;
+    classifier.AddRange(kRanges[2].lower, kRanges[2].upper);
+    classifier.Compile();
+
+    const cv::Mat image = CreateNoiseImage(200, 100, 3);
+    const cv::Mat roi = image(cv::Rect(13, 7, 61, 43));
+    ASSERT_FALSE(roi.isContinuous());
+
+    std::array<uint32_t, 1> roiCounts{};
+    std::array<uint32_t, 1> copyCounts{};
+    classifier.CountPixels(roi, roiCounts);
+    classifier.CountPixels(roi.clone(), copyCounts);
+    EXPECT_EQ(roiCounts[0], copyCounts[0]);
+}
+
+TEST(ColorClassifier, IntegralsMatchCountPixelsOnAnyRect)
+{
+    SH3DS::Vision::ColorClassifier classifier;
+    for (const auto &range : kRanges)
+    {
+        classifier.AddRange(range.lower, range.upper);
+    }
+    classifier.Compile();
+
+    const cv::Mat image = CreateNoiseImage(200, 120, 11);
+    std::vector<cv::Mat> integrals;
+    classifier.ComputeIntegrals(image(cv::Rect(0, 0, 200, 120)), integrals);
+    ASSERT_EQ(integrals.size(), kRanges.size());
+
+    const std::vector<cv::Rect> rects = { cv::Rect(0, 0, 200, 120),
+        cv::Rect(13, 7, 61, 43),
+        cv::Rect(20, 10, 30, 30),
+        cv::Rect(199, 119, 1, 1),
+        cv::Rect(0, 60, 200, 12) };
+    for (const auto &rect : rects)
+    {
+        std::array<uint32_t, SH3DS::Vision::ColorClassifier::kMaxRanges> counts{};
+        classifier.CountPixels(image(rect), counts);
+        for (std::size_t i = 0; i < kRanges.size(); ++i)
+        {
+            EXPECT_EQ(SH3DS::Vision::ColorClassifier::SumRect(integrals[i], rect), counts[i])
+                << "range " << i << " rect " << rect;
+        }
+    }
+}
+
+TEST(ColorClassifier, IdenticalRangesShareAnIndex)
+{
+    SH3DS::Vision::ColorClassifier classifier;
+    const int first = classifier.AddRange(kRanges[0].lower, kRanges[0].upper);
+    const int second = classifier.AddRange(kRanges[1].lower, kRanges[1].upper);
+    const int again = classifier.AddRange(kRanges[0].lower, kRanges[0].upper);
+
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 1);
+    EXPECT_EQ(again, first);
+    EXPECT_EQ(classifier.RangeCount(), 2u);
+}
+
+TEST(ColorClassifier, CountPixelsBeforeCompileThrows)
+{
+    SH3DS::Vision::ColorClassifier classifier;
+    classifier.AddRange(kRanges[0].lower, kRanges[0].upper);
+
+    std::array<uint32_t, 1> counts{};
+    EXPECT_THROW(classifier.CountPixels(CreateNoiseImage(8, 8, 1), counts), std::runtime_error);
+}
+
+TEST(ColorClassifier, NoRangesCompilesToNothing)
+{
+    SH3DS::Vision::ColorClassifier classifier;
+    classifier.Compile();
+
+    EXPECT_TRUE(classifier.IsCompiled());
+    EXPECT_EQ(classifier.RangeCount(), 0u);
+    classifier.CountPixels(CreateNoiseImage(8, 8, 1), {});
+}
@@ -312,6 +312,7 @@ TEST_F(ConfigTest, LoadUnifiedHuntConfig_ParsesScreenModeAndPerScreenDetectionBl
     WriteFile(huntConfigYaml, R"(
 hunt_id: "xy_dual"
 hunt_name: "Dual Screen Test"
+hunt_profile: "xy_starter_sr"
 target_pokemon: "fennekin"
 screen_mode: "dual"
 debounce_frames: 2
@@ -332,6 +333,7 @@ fsm_states:
 )");
 
     auto config = SH3DS::Core::LoadUnifiedHuntConfig(huntConfigYaml);
+    EXPECT_EQ(config.huntProfile, "xy_starter_sr");
     EXPECT_EQ(config.screenMode, SH3DS::Core::ScreenMode::Dual);
     EXPECT_EQ(config.fsmParams.screenMode, SH3DS::Core::ScreenMode::Dual);
 
@@ -161,3 +161,66 @@ TEST_F(FileFrameSourceSeekTest, SeekViaFrameSeekerInterface)
     EXPECT_EQ(seeker->GetFrameCount(), 5u);
     EXPECT_TRUE(seeker->Seek(2));
 }
+
+TEST_F(FileFrameSourceSeekTest, CropHintKeepsOnlyTheRegion)
+{
+    SH3DS::Capture::FileFrameSource source(testDir);
+    source.Open();
+
+    source.SetCropHint(cv::Rect(4, 2, 8, 6));
+    auto cropped = source.Grab();
+    ASSERT_TRUE(cropped.has_value());
+    EXPECT_EQ(cropped->image.size(), cv::Size(8, 6));
+    EXPECT_EQ(cropped->metadata.cropOrigin, cv::Point(4, 2));
+    EXPECT_EQ(cropped->metadata.sourceWidth, 16);
+    EXPECT_EQ(cropped->metadata.sourceHeight, 16);
+
+    // Clamped to the frame
+    source.SetCropHint(cv::Rect(-4, 10, 40, 40));
+    auto clamped = source.Grab();
+    ASSERT_TRUE(clamped.has_value());
+    EXPECT_EQ(clamped->image.size(), cv::Size(16, 6));
+    EXPECT_EQ(clamped->metadata.cropOrigin, cv::Point(0, 10));
+
+    source.SetCropHint(std::nullopt);
+    auto full = source.Grab();
+    ASSERT_TRUE(full.has_value());
+    EXPECT_EQ(full->image.size(), cv::Size(16, 16));
+    EXPECT_EQ(full->metadata.cropOrigin, cv::Point(0, 0));
+}
+
+TEST_F(FileFrameSourceSeekTest, GrabIntoReusesTheFrameBuffer)
+{
+    SH3DS::Capture::FileFrameSource source(testDir);
+    source.Open();
+
+    SH3DS::Core::Frame frame;
+    ASSERT_TRUE(source.GrabInto(frame));
+    const uchar *buffer = frame.image.data;
+    ASSERT_TRUE(source.GrabInto(frame));
+    EXPECT_EQ(frame.image.data, buffer);
+    EXPECT_EQ(frame.metadata.sequenceNumber, 1u);
+
+    // While cropping, the region is copied into the same kept buffer once its size has settled
+    source.SetCropHint(cv::Rect(4, 2, 8, 6));
+    ASSERT_TRUE(source.GrabInto(frame));
+    const uchar *croppedBuffer = frame.image.data;
+    ASSERT_TRUE(source.GrabInto(frame));
+    EXPECT_EQ(frame.image.data, croppedBuffer);
+    EXPECT_EQ(frame.image.size(), cv::Size(8, 6));
+    EXPECT_EQ(frame.metadata.cropOrigin, cv::Point(4, 2));
+}
+
+TEST_F(FileFrameSourceSeekTest, GrabIntoSkipsUnreadableFiles)
+{
+    std::ofstream(testDir / "frame_0.bmp", std::ios::binary | std::ios::trunc) << "not an image";
+
+    SH3DS::Capture::FileFrameSource source(testDir);
+    source.Open();
+
+    SH3DS::Core::Frame frame;
+    EXPECT_FALSE(source.GrabInto(frame));
+    ASSERT_TRUE(source.GrabInto(frame));
+    EXPECT_EQ(frame.metadata.sequenceNumber, 1u);
+    EXPECT_EQ(frame.image.size(), cv::Size(16, 16));
+}
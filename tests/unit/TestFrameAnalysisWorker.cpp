@@ -0,0 +1,365 @@
+#include "App/FrameAnalysisWorker.h"
+#include "Capture/FramePreprocessor.h"
+#include "Capture/FrameSeeker.h"
+#include "Capture/FrameSource.h"
+#include "Core/StateRegistry.h"
+#include "Core/Types.h"
+#include "FSM/GameStateFSM.h"
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int kWidth = 400;
+    constexpr int kHeight = 240;
+
+    // ── In-memory seekable source; Grab() can be held closed to pin the worker ──
+
+    class StubSource
+        : public SH3DS::Capture::FrameSource
+        , public SH3DS::Capture::FrameSeeker
+    {
+    public:
+        explicit StubSource(std::vector<cv::Mat> frames) : frames(std::move(frames))
+        {
+        }
+
+        bool Open() override
+        {
+            return true;
+        }
+
+        void Close() override
+        {
+        }
+
+        std::optional<SH3DS::Core::Frame> Grab() override
+        {
+            std::unique_lock lock(mutex);
+            blocked = true;
+            changed.notify_all();
+            changed.wait(lock, [this] { return gateOpen; });
+            blocked = false;
+
+            if (position >= frames.size())
+            {
+                return std::nullopt;
+            }
+            grabbed.push_back(position);
+            return SH3DS::Core::Frame{ .image = frames[position++], .metadata = {} };
+        }
+
+        bool IsOpen() const override
+        {
+            return true;
+        }
+
+        std::string Describe() const override
+        {
+            return "stub";
+        }
+
+        bool Seek(size_t frameIndex) override
+        {
+            std::lock_guard lock(mutex);
+            position = frameIndex;
+            ++seeks;
+            return true;
+        }
+
+        size_t GetFrameCount() const override
+        {
+            return frames.size();
+        }
+
+        void CloseGate()
+        {
+            std::lock_guard lock(mutex);
+            gateOpen = false;
+        }
+
+        void OpenGate()
+        {
+            {
+                std::lock_guard lock(mutex);
+                gateOpen = true;
+            }
+            changed.notify_all();
+        }
+
+        void WaitUntilBlocked()
+        {
+            std::unique_lock lock(mutex);
+            changed.wait(lock, [this] { return blocked; });
+        }
+
+        std::vector<size_t> Grabbed()
+        {
+            std::lock_guard lock(mutex);
+            return grabbed;
+        }
+
+        int Seeks()
+        {
+            std::lock_guard lock(mutex);
+            return seeks;
+        }
+
+    private:
+        std::vector<cv::Mat> frames;
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool gateOpen = true;
+        bool blocked = false;
+        size_t position = 0;
+        int seeks = 0;
+        std::vector<size_t> grabbed;
+    };
+
+    // ── FSM stub: "bright" when the top screen's blue channel is above mid-grey ──
+
+    class BrightnessFSM : public SH3DS::FSM::GameStateFSM
+    {
+    public:
+        BrightnessFSM() : states(std::make_shared<SH3DS::Core::StateRegistry>())
+        {
+            dark = states->Intern("dark");
+            bright = states->Intern("bright");
+            currentState = dark;
+        }
+
+        std::optional<SH3DS::Core::StateTransition> Update(const SH3DS::Core::ROISet &topRois,
+            const SH3DS::Core::ROISet &bottomRois) override
+        {
+            (void)bottomRois;
+            currentState = cv::mean(topRois.at("screen"))[0] > 128.0 ? bright : dark;
+            return std::nullopt;
+        }
+
+        void Reset() override
+        {
+            currentState = dark;
+        }
+
+        bool IsStuck() const override
+        {
+            return false;
+        }
+
+        SH3DS::Core::StateId GetCurrentState() const override
+        {
+            return currentState;
+        }
+
+        SH3DS::Core::StateId GetInitialState() const override
+        {
+            return dark;
+        }
+
+        std::shared_ptr<const SH3DS::Core::StateRegistry> GetStateRegistry() const override
+        {
+            return states;
+        }
+
+        std::chrono::milliseconds GetTimeInCurrentState() const override
+        {
+            return std::chrono::milliseconds(0);
+        }
+
+        const std::vector<SH3DS::Core::StateTransition> &GetTransitionHistory() const override
+        {
+            return history;
+        }
+
+        std::shared_ptr<SH3DS::Core::StateRegistry> states;
+        SH3DS::Core::StateId dark = SH3DS::Core::kInvalidStateId;
+        SH3DS::Core::StateId bright = SH3DS::Core::kInvalidStateId;
+        SH3DS::Core::StateId currentState = SH3DS::Core::kInvalidStateId;
+        std::vector<SH3DS::Core::StateTransition> history;
+    };
+
+    std::vector<cv::Mat> MakeFrames(const std::vector<int> &levels)
+    {
+        std::vector<cv::Mat> frames;
+        for (int level : levels)
+        {
+            frames.emplace_back(kHeight, kWidth, CV_8UC3, cv::Scalar(level, level, level));
+        }
+        return frames;
+    }
+
+    std::unique_ptr<SH3DS::Capture::FramePreprocessor> MakePreprocessor()
+    {
+        SH3DS::Core::ScreenCalibrationConfig calibration;
+        calibration.corners = {
+            cv::Point2f(0.0f, 0.0f),
+            cv::Point2f(static_cast<float>(kWidth), 0.0f),
+            cv::Point2f(static_cast<float>(kWidth), static_cast<float>(kHeight)),
+            cv::Point2f(0.0f, static_cast<float>(kHeight)),
+        };
+        std::vector<SH3DS::Core::RoiDefinition> rois = {
+            { .name = "screen", .x = 0.0, .y = 0.0, .w = 1.0, .h = 1.0 },
+        };
+        return std::make_unique<SH3DS::Capture::FramePreprocessor>(calibration, rois);
+    }
+
+    std::unique_ptr<SH3DS::App::FrameAnalysisWorker> MakeWorker(std::unique_ptr<StubSource> source,
+        size_t totalFrames,
+        size_t maxThumbnails = SH3DS::App::FrameAnalysisWorker::kMaxThumbnails)
+    {
+        std::shared_ptr<SH3DS::Capture::FrameSeeker> seeker(source.get(), [](SH3DS::Capture::FrameSeeker *) {});
+        return std::make_unique<SH3DS::App::FrameAnalysisWorker>(std::move(source),
+            seeker,
+            nullptr,
+            MakePreprocessor(),
+            std::make_unique<BrightnessFSM>(),
+            nullptr,
+            "",
+            "",
+            totalFrames,
+            maxThumbnails);
+    }
+
+    template<typename Predicate>
+    bool WaitFor(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+} // namespace
+
+TEST(FrameAnalysisWorker, TimelineCoversRecordingInOrder)
+{
+    auto source = std::make_unique<StubSource>(MakeFrames({ 20, 20, 20, 230, 230, 20 }));
+    StubSource *sourcePtr = source.get();
+    auto worker = MakeWorker(std::move(source), 6);
+
+    ASSERT_TRUE(WaitFor([&] { return worker->AnalysedFrames() == 6; }));
+
+    std::vector<SH3DS::Core::StateId> states;
+    worker->CollectTimelineStates(states);
+    const auto registry = worker->GetStateRegistry();
+    const SH3DS::Core::StateId dark = registry->Find("dark");
+    const SH3DS::Core::StateId bright = registry->Find("bright");
+    EXPECT_EQ(states, (std::vector<SH3DS::Core::StateId>{ dark, dark, dark, bright, bright, dark }));
+
+    // Nothing new since the last call
+    worker->CollectTimelineStates(states);
+    EXPECT_EQ(states.size(), 6u);
+
+    // The pass reads the recording front to back, seeking only once
+    EXPECT_EQ(sourcePtr->Grabbed(), (std::vector<size_t>{ 0, 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(sourcePtr->Seeks(), 1);
+
+    auto entry = worker->GetTimelineEntry(4);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->state, bright);
+    EXPECT_EQ(entry->stateEnteredFrame, 3u);
+    EXPECT_FALSE(entry->shinyResult.has_value());
+    EXPECT_EQ(entry->thumbnailFrame, 4u);
+    EXPECT_EQ(entry->topThumbnail.cols, kWidth / 4);
+    EXPECT_EQ(entry->topThumbnail.rows, kHeight / 4);
+    EXPECT_TRUE(entry->bottomThumbnail.empty()); // no bottom calibration
+
+    EXPECT_FALSE(worker->GetTimelineEntry(6).has_value());
+}
+
+TEST(FrameAnalysisWorker, ThumbnailCacheThinsOutWithinItsCap)
+{
+    const std::vector<int> levels = { 0, 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+    auto worker = MakeWorker(std::make_unique<StubSource>(MakeFrames(levels)), 10, 4);
+    auto uncapped = MakeWorker(std::make_unique<StubSource>(MakeFrames(levels)), 10);
+
+    ASSERT_TRUE(WaitFor([&] { return worker->AnalysedFrames() == 10 && uncapped->AnalysedFrames() == 10; }));
+
+    // Cap 4: frames 0-3 fill it, the stride doubles to 2 (0, 2, 4, 6), then to 4 (0, 4, 8)
+    const std::vector<std::pair<size_t, size_t>> expected = {
+        { 0, 0 }, { 3, 0 }, { 4, 4 }, { 7, 4 }, { 8, 8 }, { 9, 8 },
+    };
+    for (const auto &[frame, thumbnailFrame] : expected)
+    {
+        auto entry = worker->GetTimelineEntry(frame);
+        ASSERT_TRUE(entry.has_value());
+        EXPECT_EQ(entry->thumbnailFrame, thumbnailFrame) << "frame " << frame;
+
+        // The kept thumbnail is the one an uncapped cache holds for that frame
+        auto reference = uncapped->GetTimelineEntry(thumbnailFrame);
+        ASSERT_TRUE(reference.has_value());
+        EXPECT_EQ(reference->thumbnailFrame, thumbnailFrame);
+        ASSERT_FALSE(entry->topThumbnail.empty());
+        EXPECT_EQ(entry->topThumbnail.at<cv::Vec3b>(0, 0), reference->topThumbnail.at<cv::Vec3b>(0, 0))
+            << "frame " << frame;
+    }
+
+    // State is still kept for every frame
+    std::vector<SH3DS::Core::StateId> states;
+    worker->CollectTimelineStates(states);
+    EXPECT_EQ(states.size(), 10u);
+}
+
+TEST(FrameAnalysisWorker, RequestedFrameIsRenderedAtFullResolution)
+{
+    auto worker = MakeWorker(std::make_unique<StubSource>(MakeFrames({ 10, 60, 110 })), 0);
+
+    worker->RequestFrame(1, false);
+    std::optional<SH3DS::App::FrameImages> images;
+    ASSERT_TRUE(WaitFor([&] { return (images = worker->TakeFrameImages()).has_value(); }));
+
+    EXPECT_EQ(images->frameIndex, 1u);
+    EXPECT_EQ(images->rawFrame.size(), cv::Size(kWidth, kHeight));
+    EXPECT_EQ(images->rawFrame.at<cv::Vec3b>(0, 0), cv::Vec3b(60, 60, 60));
+    EXPECT_EQ(images->topScreen.size(), cv::Size(kWidth, kHeight));
+    EXPECT_TRUE(images->bottomScreen.empty());
+
+    // Taken results are not delivered twice
+    EXPECT_FALSE(worker->TakeFrameImages().has_value());
+    EXPECT_EQ(worker->AnalysedFrames(), 0u);
+}
+
+TEST(FrameAnalysisWorker, LatestRequestWins)
+{
+    auto source = std::make_unique<StubSource>(MakeFrames({ 10, 20, 30, 40 }));
+    StubSource *sourcePtr = source.get();
+    sourcePtr->CloseGate();
+    auto worker = MakeWorker(std::move(source), 0);
+
+    worker->RequestFrame(0, false);
+    sourcePtr->WaitUntilBlocked(); // worker is busy with frame 0
+
+    worker->RequestFrame(1, false);
+    worker->RequestFrame(2, false);
+    worker->RequestFrame(3, false);
+    sourcePtr->OpenGate();
+
+    std::optional<SH3DS::App::FrameImages> images;
+    ASSERT_TRUE(WaitFor([&] {
+        auto taken = worker->TakeFrameImages();
+        if (taken)
+        {
+            images = std::move(taken);
+        }
+        return images && images->frameIndex == 3;
+    }));
+
+    // Requests 1 and 2 were superseded before the worker got to them
+    EXPECT_EQ(sourcePtr->Grabbed(), (std::vector<size_t>{ 0, 3 }));
+}
@@ -1,4 +1,5 @@
 #include "Vision/ColorImprovement.h"
+#include "Vision/FrameStatistics.h"
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
@@ -121,3 +122,21 @@ TEST(ColorImprovement, CustomConfigIsRespected)
     double sumCorrected = meanCorrected[0] + meanCorrected[1] + meanCorrected[2];
     EXPECT_LT(sumCorrected, sumOrig);
 }
+
+TEST(ColorImprovement, SharedStatisticsMatchAndDescribeTheOutput)
+{
+    cv::Mat frame(120, 200, CV_8UC3);
+    cv::RNG(3).fill(frame, cv::RNG::UNIFORM, 0, 200);
+
+    SH3DS::Core::FrameStatistics statistics;
+    SH3DS::Vision::ComputeFrameStatistics(frame, statistics);
+    const cv::Mat shared = SH3DS::Vision::ImproveFrameColors(frame, statistics);
+    const cv::Mat measured = SH3DS::Vision::ImproveFrameColors(frame);
+    EXPECT_EQ(cv::norm(shared, measured, cv::NORM_INF), 0.0);
+
+    // On return the statistics describe the corrected image.
+    SH3DS::Core::FrameStatistics corrected;
+    SH3DS::Vision::ComputeFrameStatistics(shared, corrected);
+    EXPECT_EQ(statistics.channelMeans, corrected.channelMeans);
+    EXPECT_EQ(statistics.meanV, corrected.meanV);
+}
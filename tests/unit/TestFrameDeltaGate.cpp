@@ -0,0 +1,98 @@
+#include "Pipeline/FrameDeltaGate.h"
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    cv::Mat CreateScreen(int value)
+    {
+        return cv::Mat(240, 400, CV_8UC3, cv::Scalar(value, value, value));
+    }
+} // namespace
+
+TEST(FrameDeltaGate, FirstFrameIsChanged)
+{
+    SH3DS::Pipeline::FrameDeltaGate gate(4.0);
+    EXPECT_TRUE(gate.Update(CreateScreen(50), {}));
+    EXPECT_EQ(gate.Frames(), 1u);
+    EXPECT_EQ(gate.UnchangedFrames(), 0u);
+}
+
+TEST(FrameDeltaGate, IdenticalAndNoisyFramesAreUnchanged)
+{
+    SH3DS::Pipeline::FrameDeltaGate gate(4.0);
+    const cv::Mat screen = CreateScreen(50);
+    ASSERT_TRUE(gate.Update(screen, {}));
+    EXPECT_FALSE(gate.Update(screen.clone(), {}));
+
+    // Per-pixel noise of +-8 averages out in the 8x8 cells.
+    cv::Mat noisy = screen.clone();
+    for (int y = 0; y < noisy.rows; ++y)
+    {
+        for (int x = 0; x < noisy.cols; ++x)
+        {
+            const int delta = (x + y) % 2 == 0 ? 8 : -8;
+            noisy.at<cv::Vec3b>(y, x) = cv::Vec3b::all(static_cast<uchar>(50 + delta));
+        }
+    }
+    EXPECT_FALSE(gate.Update(noisy, {}));
+    EXPECT_EQ(gate.UnchangedFrames(), 2u);
+    EXPECT_DOUBLE_EQ(gate.SkipRate(), 2.0 / 3.0);
+}
+
+TEST(FrameDeltaGate, SmallLocalChangeIsDetected)
+{
+    SH3DS::Pipeline::FrameDeltaGate gate(4.0);
+    cv::Mat screen = CreateScreen(50);
+    ASSERT_TRUE(gate.Update(screen, {}));
+
+    // A sparkle covering a single 8x8 cell.
+    cv::Mat sparkle = screen.clone();
+    sparkle(cv::Rect(200, 120, 8, 8)).setTo(cv::Scalar(255, 255, 255));
+    EXPECT_TRUE(gate.Update(sparkle, {}));
+}
+
+TEST(FrameDeltaGate, SlowDriftTripsAgainstLastProcessedFrame)
+{
+    SH3DS::Pipeline::FrameDeltaGate gate(4.0);
+    ASSERT_TRUE(gate.Update(CreateScreen(50), {}));
+
+    // Each step is below the threshold, but the reference stays at the last changed frame.
+    EXPECT_FALSE(gate.Update(CreateScreen(53), {}));
+    EXPECT_TRUE(gate.Update(CreateScreen(56), {}));
+    EXPECT_FALSE(gate.Update(CreateScreen(58), {}));
+}
+
+TEST(FrameDeltaGate, BottomScreenChangeCounts)
+{
+    SH3DS::Pipeline::FrameDeltaGate gate(4.0);
+    const cv::Mat top = CreateScreen(50);
+    const cv::Mat bottom(240, 320, CV_8UC3, cv::Scalar(0, 0, 0));
+    ASSERT_TRUE(gate.Update(top, bottom));
+    EXPECT_FALSE(gate.Update(top, bottom));
+    EXPECT_TRUE(gate.Update(top, cv::Mat(240, 320, CV_8UC3, cv::Scalar(0, 0, 200))));
+    EXPECT_TRUE(gate.Update(top, {}));
+}
+
+TEST(FrameDeltaGate, ZeroThresholdDisablesGate)
+{
+    SH3DS::Pipeline::FrameDeltaGate gate(0.0);
+    const cv::Mat screen = CreateScreen(50);
+    EXPECT_TRUE(gate.Update(screen, {}));
+    EXPECT_TRUE(gate.Update(screen, {}));
+    EXPECT_DOUBLE_EQ(gate.SkipRate(), 0.0);
+}
+
+TEST(FrameDeltaGate, ResetForgetsReference)
+{
+    SH3DS::Pipeline::FrameDeltaGate gate(4.0);
+    const cv::Mat screen = CreateScreen(50);
+    ASSERT_TRUE(gate.Update(screen, {}));
+    ASSERT_FALSE(gate.Update(screen, {}));
+
+    gate.Reset();
+    EXPECT_EQ(gate.Frames(), 0u);
+    EXPECT_TRUE(gate.Update(screen, {}));
+}
@@ -98,6 +98,27 @@ TEST_F(DualScreenTest, ProcessDualScreenExtractsBottomRoisOnly)
     EXPECT_TRUE(result->bottomRois.contains("top_strip"));
 }
 
+TEST_F(DualScreenTest, ReextractedRoisAreViewsIntoWarpedTop)
+{
+    std::vector<SH3DS::Core::RoiDefinition> rois = {
+        { .name = "top_strip", .x = 0.1, .y = 0.05, .w = 0.8, .h = 0.12 },
+    };
+
+    SH3DS::Capture::FramePreprocessor preprocessor(topCalib, rois, bottomCalib);
+    auto result = preprocessor.ProcessDualScreen(cameraFrame);
+    ASSERT_TRUE(result.has_value());
+    preprocessor.ReextractRois(*result);
+
+    const cv::Mat &strip = result->topRois.at("top_strip");
+    cv::Size screenSize;
+    cv::Point offset;
+    strip.locateROI(screenSize, offset);
+    EXPECT_EQ(strip.datastart, result->warpedTop.datastart);
+    EXPECT_EQ(screenSize, result->warpedTop.size());
+    EXPECT_EQ(offset, cv::Point(40, 12));
+    EXPECT_EQ(strip.size(), cv::Size(320, 29));
+}
+
 TEST_F(DualScreenTest, ProcessDualScreenWithoutBottomCalibration)
 {
     std::vector<SH3DS::Core::RoiDefinition> rois = {
@@ -171,3 +192,37 @@ TEST_F(DualScreenTest, ProcessAndProcessDualScreenProduceSameTopROIs)
     EXPECT_EQ(singleRoi.cols, dualRoi.cols);
     EXPECT_EQ(singleRoi.rows, dualRoi.rows);
 }
+
+TEST_F(DualScreenTest, CroppedFrameWarpsLikeFullFrame)
+{
+    // Smooth ramps: a misplaced origin shifts the warp by the crop offset and changes every pixel
+    for (int y = 0; y < cameraFrame.rows; ++y)
+    {
+        for (int x = 0; x < cameraFrame.cols; ++x)
+        {
+            cameraFrame.at<cv::Vec3b>(y, x) = cv::Vec3b(static_cast<uchar>((x + y) / 5),
+                static_cast<uchar>(x / 3),
+                static_cast<uchar>(y / 2));
+        }
+    }
+    SH3DS::Capture::FramePreprocessor preprocessor(topCalib, {}, bottomCalib);
+    auto full = preprocessor.ProcessDualScreen(cameraFrame);
+    ASSERT_TRUE(full.has_value());
+
+    const cv::Rect bounds = preprocessor.ScreenBounds();
+    EXPECT_EQ(bounds, cv::Rect(100, 50, 441, 371));
+
+    // A source honouring a crop hint delivers only the screens plus a margin
+    const cv::Rect region(bounds.x - 16, bounds.y - 16, bounds.width + 32, bounds.height + 32);
+    preprocessor.SetFrameOrigin(region.tl());
+    auto cropped = preprocessor.ProcessDualScreen(cameraFrame(region).clone());
+    ASSERT_TRUE(cropped.has_value());
+
+    auto meanDifference = [](const cv::Mat &a, const cv::Mat &b) {
+        return cv::norm(a, b, cv::NORM_L1) / static_cast<double>(a.total() * static_cast<size_t>(a.channels()));
+    };
+    ASSERT_EQ(cropped->warpedTop.size(), full->warpedTop.size());
+    ASSERT_EQ(cropped->warpedBottom.size(), full->warpedBottom.size());
+    EXPECT_LT(meanDifference(cropped->warpedTop, full->warpedTop), 1.0);
+    EXPECT_LT(meanDifference(cropped->warpedBottom, full->warpedBottom), 1.0);
+}
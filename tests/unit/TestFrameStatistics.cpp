@@ -0,0 +1,105 @@
+#include "Core/Types.h"
+#include "Vision/FrameStatistics.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+    cv::Mat CreateRandomFrame(int width = 400, int height = 240)
+    {
+        cv::Mat frame(height, width, CV_8UC3);
+        cv::RNG(11).fill(frame, cv::RNG::UNIFORM, 0, 256);
+        return frame;
+    }
+} // namespace
+
+TEST(FrameStatistics, MatchesOpenCvMeans)
+{
+    const cv::Mat frame = CreateRandomFrame();
+    SH3DS::Core::FrameStatistics statistics;
+    SH3DS::Vision::ComputeFrameStatistics(frame, statistics);
+
+    const cv::Scalar means = cv::mean(frame);
+    EXPECT_EQ(statistics.pixelCount, frame.total());
+    EXPECT_EQ(statistics.source, frame.data);
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        EXPECT_NEAR(statistics.channelMeans[c], means[static_cast<int>(c)], 1e-9);
+    }
+
+    cv::Mat hsv;
+    cv::cvtColor(frame, hsv, cv::COLOR_BGR2HSV);
+    EXPECT_NEAR(statistics.meanV, cv::mean(hsv)[2] / 255.0, 1e-12);
+}
+
+TEST(FrameStatistics, HistogramCountsEveryPixelByLuma)
+{
+    cv::Mat frame(10, 10, CV_8UC3, cv::Scalar(0, 0, 0));
+    frame(cv::Rect(0, 0, 10, 4)).setTo(cv::Scalar(255, 255, 255));
+    frame(cv::Rect(0, 4, 10, 1)).setTo(cv::Scalar(0, 0, 255)); // pure red, luma 77
+
+    SH3DS::Core::FrameStatistics statistics;
+    SH3DS::Vision::ComputeFrameStatistics(frame, statistics);
+    const auto &histogram = statistics.luminanceHistogram;
+    EXPECT_EQ(std::accumulate(histogram.begin(), histogram.end(), 0u), 100u);
+    EXPECT_EQ(histogram[0], 50u);
+    EXPECT_EQ(histogram[255], 40u);
+    EXPECT_EQ(histogram[77], 10u);
+}
+
+TEST(FrameStatistics, WorksOnRoiViews)
+{
+    const cv::Mat frame = CreateRandomFrame();
+    const cv::Mat view = frame(cv::Rect(33, 17, 101, 59));
+
+    SH3DS::Core::FrameStatistics fromView;
+    SH3DS::Core::FrameStatistics fromCopy;
+    SH3DS::Vision::ComputeFrameStatistics(view, fromView);
+    SH3DS::Vision::ComputeFrameStatistics(view.clone(), fromCopy);
+    EXPECT_EQ(fromView.pixelCount, 101u * 59u);
+    EXPECT_EQ(fromView.channelMeans, fromCopy.channelMeans);
+    EXPECT_EQ(fromView.luminanceHistogram, fromCopy.luminanceHistogram);
+}
+
+TEST(FrameStatistics, UnsupportedImagesAreNotMeasured)
+{
+    SH3DS::Core::FrameStatistics statistics;
+    SH3DS::Vision::ComputeFrameStatistics(cv::Mat(), statistics);
+    EXPECT_EQ(statistics.pixelCount, 0u);
+    SH3DS::Vision::ComputeFrameStatistics(cv::Mat(8, 8, CV_8UC1, cv::Scalar(9)), statistics);
+    EXPECT_EQ(statistics.pixelCount, 0u);
+}
+
+TEST(FrameStatistics, ApplyLutMeasuresTheOutput)
+{
+    const cv::Mat frame = CreateRandomFrame();
+    cv::Mat lut(1, 256, CV_8U);
+    for (int i = 0; i < 256; ++i)
+    {
+        lut.at<uchar>(0, i) = static_cast<uchar>(255 - i);
+    }
+
+    cv::Mat output;
+    SH3DS::Core::FrameStatistics statistics;
+    SH3DS::Vision::ApplyLutWithStatistics(frame, lut, output, statistics);
+
+    cv::Mat expected;
+    cv::LUT(frame, lut, expected);
+    EXPECT_EQ(cv::norm(output, expected, cv::NORM_INF), 0.0);
+
+    SH3DS::Core::FrameStatistics measured;
+    SH3DS::Vision::ComputeFrameStatistics(output, measured);
+    EXPECT_EQ(statistics.channelMeans, measured.channelMeans);
+    EXPECT_EQ(statistics.meanV, measured.meanV);
+    EXPECT_EQ(statistics.luminanceHistogram, measured.luminanceHistogram);
+    EXPECT_EQ(statistics.source, output.data); // the statistics describe the output, not the input
+
+    EXPECT_THROW(SH3DS::Vision::ApplyLutWithStatistics(frame, cv::Mat(1, 10, CV_8U), output, statistics),
+        std::runtime_error);
+}
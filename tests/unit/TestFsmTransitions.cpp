@@ -11,6 +11,11 @@
 
 namespace
 {
+    const std::string &StateName(const SH3DS::FSM::GameStateFSM &fsm, SH3DS::Core::StateId id)
+    {
+        return fsm.GetStateRegistry()->Name(id);
+    }
+
     SH3DS::Core::StateDetectionParams MakeTopDetection(const std::string &roi,
         const std::string &method,
         const cv::Scalar &hsvLower,
@@ -167,7 +172,46 @@ namespace
 TEST(CXXStateTreeFSM, InitialStateIsFromProfile)
 {
     auto fsm = CreateTestFSM();
-    EXPECT_EQ(fsm->GetCurrentState(), "unknown");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "unknown");
+}
+
+TEST(CXXStateTreeFSM, StateIdsFollowDeclarationOrder)
+{
+    auto fsm = CreateTestFSM();
+    const auto states = fsm->GetStateRegistry();
+    EXPECT_EQ(states->Find("unknown"), 0u);
+    EXPECT_EQ(states->Find("dark_screen"), 1u);
+    EXPECT_EQ(states->Find("bright_screen"), 2u);
+    EXPECT_EQ(fsm->GetCurrentState(), states->Find("unknown"));
+}
+
+TEST(CXXStateTreeFSM, TransitionCarriesInternedIds)
+{
+    auto fsm = CreateTestFSM();
+    auto darkRoi = CreateDarkROI();
+
+    fsm->Update(darkRoi, {});
+    auto t = fsm->Update(darkRoi, {});
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(t->from, fsm->GetInitialState());
+    EXPECT_EQ(t->to, fsm->GetStateRegistry()->Find("dark_screen"));
+    EXPECT_EQ(fsm->GetCurrentState(), t->to);
+}
+
+TEST(CXXStateTreeFSM, UndeclaredTargetsAreInterned)
+{
+    SH3DS::FSM::CXXStateTreeFSM::Builder builder;
+    builder.SetInitialState("state_a");
+    builder.AddState({
+        .id = "state_a",
+        .transitionsTo = { "not_declared" },
+        .maxDurationS = 120,
+        .detectionParameters = MakeTopDetection(
+            "full_screen", "color_histogram", cv::Scalar(0, 0, 0), cv::Scalar(0, 0, 0), 0.0, 1.0, 999.0, {}),
+    });
+    auto fsm = builder.Build();
+
+    EXPECT_NE(fsm->GetStateRegistry()->Find("not_declared"), SH3DS::Core::kInvalidStateId);
 }
 
 TEST(CXXStateTreeFSM, DetectsDarkScreen)
@@ -182,9 +226,9 @@ TEST(CXXStateTreeFSM, DetectsDarkScreen)
 
     auto t2 = fsm->Update(darkRoi, {});
     ASSERT_TRUE(t2.has_value()); // Second frame — transition!
-    EXPECT_EQ(t2->from, "unknown");
-    EXPECT_EQ(t2->to, "dark_screen");
-    EXPECT_EQ(fsm->GetCurrentState(), "dark_screen");
+    EXPECT_EQ(StateName(*fsm, t2->from), "unknown");
+    EXPECT_EQ(StateName(*fsm, t2->to), "dark_screen");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "dark_screen");
 }
 
 TEST(CXXStateTreeFSM, DetectsBrightScreen)
@@ -196,7 +240,7 @@ TEST(CXXStateTreeFSM, DetectsBrightScreen)
     fsm->Update(brightRoi, {});
     auto t = fsm->Update(brightRoi, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "bright_screen");
+    EXPECT_EQ(StateName(*fsm, t->to), "bright_screen");
 }
 
 TEST(CXXStateTreeFSM, TransitionsFromDarkToBright)
@@ -209,14 +253,14 @@ TEST(CXXStateTreeFSM, TransitionsFromDarkToBright)
     // Transition to dark_screen
     fsm->Update(darkRoi, {});
     fsm->Update(darkRoi, {});
-    EXPECT_EQ(fsm->GetCurrentState(), "dark_screen");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "dark_screen");
 
     // Transition to bright_screen
     fsm->Update(brightRoi, {});
     auto t = fsm->Update(brightRoi, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->from, "dark_screen");
-    EXPECT_EQ(t->to, "bright_screen");
+    EXPECT_EQ(StateName(*fsm, t->from), "dark_screen");
+    EXPECT_EQ(StateName(*fsm, t->to), "bright_screen");
 }
 
 TEST(CXXStateTreeFSM, DebouncePreventsSingleFrameTransition)
@@ -250,7 +294,7 @@ TEST(CXXStateTreeFSM, StaysInCurrentStateWhenNoMatch)
     // Midtone ROI shouldn't match either dark or bright
     auto midRoi = CreateMidtoneROI();
     EXPECT_FALSE(fsm->Update(midRoi, {}).has_value());
-    EXPECT_EQ(fsm->GetCurrentState(), "unknown");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "unknown");
 }
 
 TEST(CXXStateTreeFSM, ResetGoesBackToInitialState)
@@ -261,10 +305,10 @@ TEST(CXXStateTreeFSM, ResetGoesBackToInitialState)
     fsm->Update(darkRoi, {});
     auto t = fsm->Update(darkRoi, {});
     ASSERT_TRUE(t.has_value());
-    ASSERT_EQ(fsm->GetCurrentState(), "dark_screen");
+    ASSERT_EQ(fsm->GetCurrentStateName(), "dark_screen");
 
     fsm->Reset();
-    EXPECT_EQ(fsm->GetCurrentState(), "unknown");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "unknown");
     EXPECT_TRUE(fsm->GetTransitionHistory().empty());
 }
 
@@ -281,10 +325,10 @@ TEST(CXXStateTreeFSM, HistoryRecordsTransitions)
     fsm->Update(brightRoi, {}); // -> bright_screen
 
     ASSERT_EQ(fsm->GetTransitionHistory().size(), 2u);
-    EXPECT_EQ(fsm->GetTransitionHistory()[0].from, "unknown");
-    EXPECT_EQ(fsm->GetTransitionHistory()[0].to, "dark_screen");
-    EXPECT_EQ(fsm->GetTransitionHistory()[1].from, "dark_screen");
-    EXPECT_EQ(fsm->GetTransitionHistory()[1].to, "bright_screen");
+    EXPECT_EQ(StateName(*fsm, fsm->GetTransitionHistory()[0].from), "unknown");
+    EXPECT_EQ(StateName(*fsm, fsm->GetTransitionHistory()[0].to), "dark_screen");
+    EXPECT_EQ(StateName(*fsm, fsm->GetTransitionHistory()[1].from), "dark_screen");
+    EXPECT_EQ(StateName(*fsm, fsm->GetTransitionHistory()[1].to), "bright_screen");
 }
 
 TEST(CXXStateTreeFSM, IsStuckWhenExceedingMaxDuration)
@@ -361,7 +405,7 @@ TEST(CXXStateTreeFSM, ReachabilityFilterBlocksUnreachableState)
     });
 
     auto fsm = builder.Build();
-    EXPECT_EQ(fsm->GetCurrentState(), "state_a");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "state_a");
 
     // Feed a blue frame: state_c would match with highest confidence,
     // but state_a can only transition to state_b, so state_c is filtered out.
@@ -375,7 +419,7 @@ TEST(CXXStateTreeFSM, ReachabilityFilterBlocksUnreachableState)
     fsm->Update(blueRoi, {});
     // Without reachability filter, FSM would try to transition to state_c.
     // With the filter, state_c is not a candidate, so no transition happens.
-    EXPECT_EQ(fsm->GetCurrentState(), "state_a");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "state_a");
 }
 
 TEST(CXXStateTreeFSM, ReachabilityFilterAllowsLegalTransition)
@@ -410,7 +454,7 @@ TEST(CXXStateTreeFSM, ReachabilityFilterAllowsLegalTransition)
     fsm->Update(greenRoi, {});
     auto t = fsm->Update(greenRoi, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "state_b");
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
 }
 
 TEST(CXXStateTreeFSM, IllegalTransitionResetsPendingState)
@@ -448,8 +492,8 @@ TEST(CXXStateTreeFSM, IllegalTransitionResetsPendingState)
     fsm->Update(greenRoi, {});
     auto t = fsm->Update(greenRoi, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->from, "state_a");
-    EXPECT_EQ(t->to, "state_b");
+    EXPECT_EQ(StateName(*fsm, t->from), "state_a");
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
 }
 
 TEST(CXXStateTreeFSM, ResetRebuildsSyncedTree)
@@ -461,10 +505,10 @@ TEST(CXXStateTreeFSM, ResetRebuildsSyncedTree)
     fsm->Update(brightRoi, {});
     auto toBright = fsm->Update(brightRoi, {});
     ASSERT_TRUE(toBright.has_value());
-    ASSERT_EQ(fsm->GetCurrentState(), "bright_screen");
+    ASSERT_EQ(fsm->GetCurrentStateName(), "bright_screen");
 
     fsm->Reset();
-    EXPECT_EQ(fsm->GetCurrentState(), "unknown");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "unknown");
     EXPECT_TRUE(fsm->GetTransitionHistory().empty());
 
     // After reset the tree is rebuilt; legal transitions from unknown should work.
@@ -472,7 +516,7 @@ TEST(CXXStateTreeFSM, ResetRebuildsSyncedTree)
     fsm->Update(darkRoi, {});
     auto t = fsm->Update(darkRoi, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "dark_screen");
+    EXPECT_EQ(StateName(*fsm, t->to), "dark_screen");
 }
 
 TEST(CXXStateTreeFSM, EmptyTransitionsToBlocksAllOutgoing)
@@ -509,30 +553,30 @@ TEST(CXXStateTreeFSM, EmptyTransitionsToBlocksAllOutgoing)
     fsm->Update(greenRoi, {});
     auto t = fsm->Update(greenRoi, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "state_b");
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
 
     // Now in state_b: green still matches state_b detection, but state_b has no transitions.
     // The FSM should not loop or crash — it stays in state_b.
     EXPECT_FALSE(fsm->Update(greenRoi, {}).has_value());
     EXPECT_FALSE(fsm->Update(greenRoi, {}).has_value());
-    EXPECT_EQ(fsm->GetCurrentState(), "state_b");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "state_b");
 }
 
 TEST(CXXStateTreeFSM, InitialStateReturnsBuilderInitialState)
 {
     // InitialState() must return exactly what was passed to SetInitialState().
     auto fsm = CreateTestFSM();
-    EXPECT_EQ(fsm->GetInitialState(), "unknown");
+    EXPECT_EQ(StateName(*fsm, fsm->GetInitialState()), "unknown");
 
     // Remains stable after transitions.
     auto darkRoi = CreateDarkROI();
     fsm->Update(darkRoi, {});
     fsm->Update(darkRoi, {});
-    EXPECT_EQ(fsm->GetInitialState(), "unknown");
+    EXPECT_EQ(StateName(*fsm, fsm->GetInitialState()), "unknown");
 
     // Remains stable after Reset.
     fsm->Reset();
-    EXPECT_EQ(fsm->GetInitialState(), "unknown");
+    EXPECT_EQ(StateName(*fsm, fsm->GetInitialState()), "unknown");
 }
 
 TEST(CXXStateTreeFSM, ResetToInitialStateAllowsNormalDetection)
@@ -544,18 +588,18 @@ TEST(CXXStateTreeFSM, ResetToInitialStateAllowsNormalDetection)
     auto darkRoi = CreateDarkROI();
     fsm->Update(darkRoi, {});
     fsm->Update(darkRoi, {});
-    ASSERT_EQ(fsm->GetCurrentState(), "dark_screen");
+    ASSERT_EQ(fsm->GetCurrentStateName(), "dark_screen");
 
     // Simulate watchdog abort path reset
     fsm->Reset();
-    EXPECT_EQ(fsm->GetCurrentState(), "unknown");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "unknown");
 
     // FSM should be able to transition again from unknown
     auto brightRoi = CreateBrightROI();
     fsm->Update(brightRoi, {});
     auto t = fsm->Update(brightRoi, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "bright_screen");
+    EXPECT_EQ(StateName(*fsm, t->to), "bright_screen");
 }
 
 TEST(CXXStateTreeFSM, DualScreenModeRequiresBothTopAndBottomToPass)
@@ -608,14 +652,14 @@ TEST(CXXStateTreeFSM, DualScreenModeRequiresBothTopAndBottomToPass)
     bottomRoisBright["bottom_roi"] = cv::Mat(240, 320, CV_8UC3, cv::Scalar(240, 240, 240));
 
     EXPECT_FALSE(fsm->Update(topRoisDark, bottomRoisBright).has_value());
-    EXPECT_EQ(fsm->GetCurrentState(), "unknown");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "unknown");
 
     SH3DS::Core::ROISet topRoisBright;
     topRoisBright["top_roi"] = cv::Mat(240, 400, CV_8UC3, cv::Scalar(240, 240, 240));
 
     auto t = fsm->Update(topRoisBright, bottomRoisBright);
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "target");
+    EXPECT_EQ(StateName(*fsm, t->to), "target");
 }
 
 TEST(CXXStateTreeFSM, SingleScreenModeSupportsTopOnlyStateDetection)
@@ -645,7 +689,7 @@ TEST(CXXStateTreeFSM, SingleScreenModeSupportsTopOnlyStateDetection)
 
     auto t = fsm->Update(topRoisBright, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "target");
+    EXPECT_EQ(StateName(*fsm, t->to), "target");
 }
 
 TEST(CXXStateTreeFSM, SingleScreenModeSupportsBottomOnlyStateDetection)
@@ -675,7 +719,7 @@ TEST(CXXStateTreeFSM, SingleScreenModeSupportsBottomOnlyStateDetection)
 
     auto t = fsm->Update(topRoisBright, {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "target");
+    EXPECT_EQ(StateName(*fsm, t->to), "target");
 }
 
 TEST(CXXStateTreeFSM, IntensityEventNoTransitionWithoutDropRaise)
@@ -687,7 +731,7 @@ TEST(CXXStateTreeFSM, IntensityEventNoTransitionWithoutDropRaise)
     {
         EXPECT_FALSE(fsm->Update(CreateVValueROI(0.9), {}).has_value());
     }
-    EXPECT_EQ(fsm->GetCurrentState(), "state_a");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "state_a");
 }
 
 TEST(CXXStateTreeFSM, IntensityEventTransitionsAfterDropRaise)
@@ -704,8 +748,8 @@ TEST(CXXStateTreeFSM, IntensityEventTransitionsAfterDropRaise)
     // Raise (screen recovers) — should fire the transition on this frame
     auto t = fsm->Update(CreateVValueROI(0.9), {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->from, "state_a");
-    EXPECT_EQ(t->to, "state_b");
+    EXPECT_EQ(StateName(*fsm, t->from), "state_a");
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
 }
 
 TEST(CXXStateTreeFSM, IntensityEventDoesNotFireAgainAfterTransition)
@@ -718,12 +762,12 @@ TEST(CXXStateTreeFSM, IntensityEventDoesNotFireAgainAfterTransition)
     fsm->Update(CreateVValueROI(0.02), {});
     auto t = fsm->Update(CreateVValueROI(0.9), {});
     ASSERT_TRUE(t.has_value());
-    ASSERT_EQ(fsm->GetCurrentState(), "state_b");
+    ASSERT_EQ(fsm->GetCurrentStateName(), "state_b");
 
     // state_b has no transitions — further Drop+Raise cycles must not fire
     fsm->Update(CreateVValueROI(0.02), {});
     EXPECT_FALSE(fsm->Update(CreateVValueROI(0.9), {}).has_value());
-    EXPECT_EQ(fsm->GetCurrentState(), "state_b");
+    EXPECT_EQ(fsm->GetCurrentStateName(), "state_b");
 }
 
 TEST(CXXStateTreeFSM, IntensityEventResetClearsBaseline)
@@ -738,7 +782,7 @@ TEST(CXXStateTreeFSM, IntensityEventResetClearsBaseline)
 
     // Reset returns to state_a with a fresh intensity detector
     fsm->Reset();
-    ASSERT_EQ(fsm->GetCurrentState(), "state_a");
+    ASSERT_EQ(fsm->GetCurrentStateName(), "state_a");
 
     // A fresh Drop+Raise from state_a should transition to state_b again
     fsm->Update(CreateVValueROI(0.9), {});
@@ -746,7 +790,7 @@ TEST(CXXStateTreeFSM, IntensityEventResetClearsBaseline)
     fsm->Update(CreateVValueROI(0.02), {});
     auto t = fsm->Update(CreateVValueROI(0.9), {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "state_b");
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
 }
 
 TEST(CXXStateTreeFSM, AlwaysTrueMethodAlwaysReturnsMaxConfidence)
@@ -788,5 +832,240 @@ TEST(CXXStateTreeFSM, AlwaysTrueMethodAlwaysReturnsMaxConfidence)
     // Any non-empty ROI should immediately satisfy always_true
     auto t = fsm->Update(CreateVValueROI(0.5), {});
     ASSERT_TRUE(t.has_value());
-    EXPECT_EQ(t->to, "state_b");
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
+}
+
+TEST(CXXStateTreeFSM, ExpensiveCandidateSkippedAfterPerfectCheapMatch)
+{
+    SH3DS::FSM::CXXStateTreeFSM::Builder builder;
+    builder.SetInitialState("state_a");
+    builder.SetDebounceFrames(1);
+
+    builder.AddState({
+        .id = "state_a",
+        .transitionsTo = { "state_fast", "state_slow" },
+        .maxDurationS = 120,
+        .detectionParameters = MakeTopDetection(
+            "top_full", "color_histogram", cv::Scalar(0, 0, 0), cv::Scalar(0, 0, 0), 0.0, 1.0, 999.0, {}),
+    });
+    builder.AddState({
+        .id = "state_fast",
+        .transitionsTo = {},
+        .maxDurationS = 120,
+        .detectionParameters = MakeTopDetection("top_full", "always_true", {}, {}, 0.0, 1.0, 0.5, {}),
+    });
+    builder.AddState({
+        .id = "state_slow",
+        .transitionsTo = {},
+        .maxDurationS = 120,
+        .detectionParameters =
+            MakeTopDetection("top_full", "template_match", {}, {}, 0.0, 1.0, 0.5, "templates/does_not_exist.png"),
+    });
+
+    auto fsm = builder.Build();
+    auto t = fsm->Update(CreateVValueROI(0.5), {});
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(StateName(*fsm, t->to), "state_fast");
+
+    // always_true scored the maximum first; state_a (lower ID) still runs because it could tie,
+    // state_slow (higher ID) cannot win and its template match is skipped.
+    const auto &stats = fsm->GetLastEvaluationStats();
+    EXPECT_EQ(stats.evaluated, 2u);
+    EXPECT_EQ(stats.skipped, 1u);
+    EXPECT_EQ(fsm->GetTotalEvaluationStats().skipped, 1u);
+
+    fsm->Reset();
+    EXPECT_EQ(fsm->GetTotalEvaluationStats().evaluated, 0u);
+    EXPECT_EQ(fsm->GetTotalEvaluationStats().skipped, 0u);
+}
+
+TEST(CXXStateTreeFSM, CostOrderingKeepsDeclarationOrderTieBreak)
+{
+    SH3DS::FSM::CXXStateTreeFSM::Builder builder;
+    builder.SetInitialState("state_a");
+    builder.SetDebounceFrames(1);
+
+    builder.AddState({
+        .id = "state_a",
+        .transitionsTo = { "state_first", "state_second" },
+        .maxDurationS = 120,
+        .detectionParameters = MakeTopDetection(
+            "top_full", "color_histogram", cv::Scalar(0, 0, 0), cv::Scalar(0, 0, 0), 0.0, 1.0, 999.0, {}),
+    });
+    // Matches every pixel with a zero-width ratio band -> confidence exactly 1.0, but evaluated after always_true.
+    builder.AddState({
+        .id = "state_first",
+        .transitionsTo = {},
+        .maxDurationS = 120,
+        .detectionParameters = MakeTopDetection(
+            "top_full", "color_histogram", cv::Scalar(0, 0, 0), cv::Scalar(180, 255, 255), 1.0, 1.0, 0.5, {}),
+    });
+    builder.AddState({
+        .id = "state_second",
+        .transitionsTo = {},
+        .maxDurationS = 120,
+        .detectionParameters = MakeTopDetection("top_full", "always_true", {}, {}, 0.0, 1.0, 0.5, {}),
+    });
+
+    auto fsm = builder.Build();
+    auto t = fsm->Update(CreateVValueROI(0.5), {});
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(StateName(*fsm, t->to), "state_first");
+}
+
+TEST(CXXStateTreeFSM, NestedRoiViewsMatchIndependentCopies)
+{
+    // Two colour ROIs of one screen: the FSM counts them from per-screen integral images when they are views.
+    auto build = [] {
+        SH3DS::FSM::CXXStateTreeFSM::Builder builder;
+        builder.SetInitialState("unknown");
+        builder.SetDebounceFrames(1);
+        builder.AddState({
+            .id = "unknown",
+            .transitionsTo = { "dark_screen", "bright_corner" },
+            .maxDurationS = 120,
+            .detectionParameters = MakeTopDetection(
+                "top_full", "color_histogram", cv::Scalar(0, 0, 0), cv::Scalar(0, 0, 0), 0.0, 1.0, 999.0, {}),
+        });
+        builder.AddState({
+            .id = "dark_screen",
+            .transitionsTo = { "bright_corner" },
+            .maxDurationS = 120,
+            .detectionParameters = MakeTopDetection(
+                "top_full", "color_histogram", cv::Scalar(0, 0, 0), cv::Scalar(180, 50, 50), 0.8, 1.0, 0.5, {}),
+        });
+        builder.AddState({
+            .id = "bright_corner",
+            .transitionsTo = { "dark_screen" },
+            .maxDurationS = 120,
+            .detectionParameters = MakeTopDetection("top_corner",
+                "color_histogram",
+                cv::Scalar(0, 0, 200),
+                cv::Scalar(180, 50, 255),
+                0.8,
+                1.0,
+                0.5,
+                {}),
+        });
+        return builder.Build();
+    };
+
+    auto makeRois = [](const cv::Mat &screen, bool views) {
+        SH3DS::Core::ROISet rois;
+        rois["top_full"] = views ? screen(cv::Rect(0, 0, 400, 240)) : screen.clone();
+        rois["top_corner"] = views ? screen(cv::Rect(0, 0, 100, 60)) : screen(cv::Rect(0, 0, 100, 60)).clone();
+        return rois;
+    };
+
+    // Frame 1: dark screen with a bright corner (dark ratio 0.9375 wins); frame 2: corner only.
+    cv::Mat darkWithCorner(240, 400, CV_8UC3, cv::Scalar(10, 10, 10));
+    darkWithCorner(cv::Rect(0, 0, 100, 60)).setTo(cv::Scalar(240, 240, 240));
+    cv::Mat brightCorner(240, 400, CV_8UC3, cv::Scalar(128, 0, 128));
+    brightCorner(cv::Rect(0, 0, 100, 60)).setTo(cv::Scalar(240, 240, 240));
+
+    auto viewFsm = build();
+    auto copyFsm = build();
+    for (const cv::Mat *screen : { &darkWithCorner, &brightCorner, &darkWithCorner })
+    {
+        const auto viewTransition = viewFsm->Update(makeRois(*screen, true), {});
+        const auto copyTransition = copyFsm->Update(makeRois(*screen, false), {});
+        ASSERT_EQ(viewTransition.has_value(), copyTransition.has_value());
+        EXPECT_EQ(viewFsm->GetCurrentState(), copyFsm->GetCurrentState());
+    }
+    EXPECT_EQ(viewFsm->GetCurrentStateName(), "dark_screen");
+    ASSERT_EQ(viewFsm->GetTransitionHistory().size(), 3u);
+    EXPECT_EQ(StateName(*viewFsm, viewFsm->GetTransitionHistory()[1].to), "bright_corner");
+}
+
+TEST(CXXStateTreeFSM, UnchangedFrameReusesScoresAndKeepsDebouncing)
+{
+    auto fsm = CreateTestFSM(2);
+
+    EXPECT_FALSE(fsm->Update(CreateDarkROI(), {}).has_value());
+    const uint64_t evaluated = fsm->GetLastEvaluationStats().evaluated;
+    ASSERT_GT(evaluated, 0u);
+
+    // The ROIs handed in are ignored for blocks scored last frame: the dark verdict is reused and debounce
+    // completes on the second frame.
+    auto t = fsm->UpdateUnchanged(CreateBrightROI(), {});
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(StateName(*fsm, t->to), "dark_screen");
+    EXPECT_EQ(fsm->GetLastEvaluationStats().evaluated, 0u);
+    EXPECT_EQ(fsm->GetLastEvaluationStats().reused, evaluated);
+
+    // A changed frame forgets the cached scores.
+    EXPECT_FALSE(fsm->Update(CreateBrightROI(), {}).has_value());
+    EXPECT_EQ(fsm->GetLastEvaluationStats().reused, 0u);
+    t = fsm->UpdateUnchanged(CreateBrightROI(), {});
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(StateName(*fsm, t->to), "bright_screen");
+    EXPECT_EQ(fsm->GetTotalEvaluationStats().reused, evaluated + fsm->GetLastEvaluationStats().reused);
+}
+
+TEST(CXXStateTreeFSM, IntensityEventUsesPublishedScreenStatistics)
+{
+    auto fsm = CreateIntensityFSM();
+    auto feed = [&](double publishedV) {
+        const auto rois = CreateVValueROI(0.9);
+        SH3DS::Core::FrameStatistics statistics;
+        statistics.meanV = publishedV;
+        statistics.pixelCount = 240 * 400;
+        statistics.source = rois.at("top_full").data;
+        fsm->SetFrameStatistics(statistics);
+        return fsm->Update(rois, {});
+    };
+
+    // The ROI is the whole screen, so the published mean V stands in for the (constant, bright) pixels.
+    feed(0.9);
+    feed(0.9);
+    feed(0.02);
+    auto t = feed(0.9);
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
+
+    // Statistics apply to one Update() only: the raise comes from measuring the ROI, not the stale dark value.
+    fsm->Reset();
+    feed(0.9);
+    feed(0.9);
+    feed(0.02);
+    t = fsm->Update(CreateVValueROI(0.9), {});
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(StateName(*fsm, t->to), "state_b");
+}
+
+TEST(CXXStateTreeFSM, PublishedStatisticsIgnoredForPartialRoi)
+{
+    auto fsm = CreateIntensityFSM();
+    const cv::Mat screen(240, 400, CV_8UC3, cv::Scalar(230, 230, 230));
+    SH3DS::Core::ROISet rois;
+    rois["top_full"] = screen(cv::Rect(20, 12, 360, 216));
+
+    SH3DS::Core::FrameStatistics dark;
+    dark.meanV = 0.02;
+    dark.pixelCount = 240 * 400;
+    dark.source = screen.data;
+    for (int i = 0; i < 4; ++i)
+    {
+        fsm->SetFrameStatistics(i == 2 ? dark : SH3DS::Core::FrameStatistics{});
+        EXPECT_FALSE(fsm->Update(rois, {}).has_value());
+    }
+}
+
+TEST(CXXStateTreeFSM, PublishedStatisticsIgnoredForCopyOfScreen)
+{
+    // Same size as the measured screen but other pixels: a clone, or a separately resized image.
+    auto fsm = CreateIntensityFSM();
+    const cv::Mat screen(240, 400, CV_8UC3, cv::Scalar(230, 230, 230));
+    SH3DS::Core::ROISet rois;
+    rois["top_full"] = screen.clone();
+
+    SH3DS::Core::FrameStatistics dark;
+    dark.meanV = 0.02;
+    dark.pixelCount = 240 * 400;
+    dark.source = screen.data;
+    for (int i = 0; i < 4; ++i)
+    {
+        fsm->SetFrameStatistics(i == 2 ? dark : SH3DS::Core::FrameStatistics{});
+        EXPECT_FALSE(fsm->Update(rois, {}).has_value());
+    }
 }
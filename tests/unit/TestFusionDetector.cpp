@@ -0,0 +1,299 @@
+#include "Core/Config.h"
+#include "Core/Types.h"
+#include "Vision/FusionDetector.h"
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using SH3DS::Core::ShinyVerdict;
+    using SH3DS::Vision::FusionDetector;
+
+    /// Always returns the same verdict and counts how often it ran.
+    class FixedDetector : public SH3DS::Vision::ShinyDetector
+    {
+    public:
+        FixedDetector(std::string_view method, ShinyVerdict verdict, double confidence, std::atomic<int> &calls)
+            : method(method),
+              verdict(verdict),
+              confidence(confidence),
+              calls(calls)
+        {
+        }
+
+        SH3DS::Core::ShinyResult Detect(const cv::Mat &) const override
+        {
+            ++calls;
+            return { .verdict = verdict, .confidence = confidence, .method = method };
+        }
+
+        SH3DS::Core::ShinyResult DetectSequence(std::span<const cv::Mat>) const override
+        {
+            return {};
+        }
+
+        std::string ProfileId() const override
+        {
+            return "stub";
+        }
+
+        void Reset() override
+        {
+        }
+
+    private:
+        std::string_view method;
+        ShinyVerdict verdict;
+        double confidence;
+        std::atomic<int> &calls;
+    };
+
+    /// Shiny for ROIs taller than kRoi, Uncertain otherwise; counts how often it ran.
+    class TallIsShinyDetector : public SH3DS::Vision::ShinyDetector
+    {
+    public:
+        explicit TallIsShinyDetector(std::atomic<int> &calls) : calls(calls)
+        {
+        }
+
+        SH3DS::Core::ShinyResult Detect(const cv::Mat &pokemonRoi) const override
+        {
+            ++calls;
+            const bool tall = pokemonRoi.rows > 8;
+            return { .verdict = tall ? ShinyVerdict::Shiny : ShinyVerdict::Uncertain,
+                .confidence = tall ? 1.0 : 0.0,
+                .method = "tall" };
+        }
+
+        SH3DS::Core::ShinyResult DetectSequence(std::span<const cv::Mat>) const override
+        {
+            return {};
+        }
+
+        std::string ProfileId() const override
+        {
+            return "stub";
+        }
+
+        void Reset() override
+        {
+        }
+
+    private:
+        std::atomic<int> &calls;
+    };
+
+    FusionDetector::Member Method(std::string_view name,
+        ShinyVerdict verdict,
+        double confidence,
+        double weight,
+        std::atomic<int> &calls)
+    {
+        return { .detector = std::make_unique<FixedDetector>(name, verdict, confidence, calls), .weight = weight };
+    }
+
+    std::unique_ptr<FusionDetector> Fuse(std::vector<FusionDetector::Member> members)
+    {
+        return std::make_unique<FusionDetector>(std::move(members), SH3DS::Core::FusionConfig{}, "test");
+    }
+
+    const cv::Mat kRoi(8, 8, CV_8UC3);
+} // namespace
+
+TEST(FusionDetector, AgreeingMethodsGiveShiny)
+{
+    std::atomic<int> colorCalls = 0;
+    std::atomic<int> histCalls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back(Method("dominant_color", ShinyVerdict::Shiny, 0.4, 1.0, colorCalls));
+    members.push_back(Method("histogram_compare", ShinyVerdict::Shiny, 0.4, 1.0, histCalls));
+    auto detector = Fuse(std::move(members));
+
+    const auto result = detector->Detect(kRoi);
+    EXPECT_EQ(result.verdict, ShinyVerdict::Shiny);
+    EXPECT_DOUBLE_EQ(result.confidence, 0.7);
+    EXPECT_EQ(result.method, "fusion");
+    EXPECT_EQ(colorCalls, 1);
+    EXPECT_EQ(histCalls, 1);
+}
+
+TEST(FusionDetector, HeavyShinyVerdictShortCircuits)
+{
+    std::atomic<int> heavyCalls = 0;
+    std::atomic<int> lightCalls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back(Method("light", ShinyVerdict::NotShiny, 1.0, 1.0, lightCalls));
+    members.push_back(Method("heavy", ShinyVerdict::Shiny, 1.0, 3.0, heavyCalls));
+    auto detector = Fuse(std::move(members));
+
+    // Heaviest runs first; 3/4 of the weight at score 1.0 already clears shiny_threshold 0.55.
+    const auto result = detector->Detect(kRoi);
+    EXPECT_EQ(result.verdict, ShinyVerdict::Shiny);
+    EXPECT_DOUBLE_EQ(result.confidence, 0.75);
+    EXPECT_EQ(heavyCalls, 1);
+    EXPECT_EQ(lightCalls, 0);
+    EXPECT_NE(result.Details().find("evaluated=1/2"), std::string::npos);
+}
+
+TEST(FusionDetector, HeavyNotShinyVerdictShortCircuits)
+{
+    std::atomic<int> heavyCalls = 0;
+    std::atomic<int> lightCalls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back(Method("heavy", ShinyVerdict::NotShiny, 1.0, 3.0, heavyCalls));
+    members.push_back(Method("light", ShinyVerdict::Shiny, 1.0, 1.0, lightCalls));
+    auto detector = Fuse(std::move(members));
+
+    // Even a fully shiny light method can only reach 0.25 < uncertain_threshold 0.35.
+    const auto result = detector->Detect(kRoi);
+    EXPECT_EQ(result.verdict, ShinyVerdict::NotShiny);
+    EXPECT_DOUBLE_EQ(result.confidence, 0.75);
+    EXPECT_EQ(lightCalls, 0);
+}
+
+TEST(FusionDetector, DisagreementIsUncertain)
+{
+    std::atomic<int> shinyCalls = 0;
+    std::atomic<int> normalCalls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back(Method("a", ShinyVerdict::Shiny, 1.0, 1.0, shinyCalls));
+    members.push_back(Method("b", ShinyVerdict::NotShiny, 1.0, 1.0, normalCalls));
+    auto detector = Fuse(std::move(members));
+
+    const auto result = detector->Detect(kRoi);
+    EXPECT_EQ(result.verdict, ShinyVerdict::Uncertain);
+    EXPECT_DOUBLE_EQ(result.confidence, 0.0);
+    EXPECT_EQ(shinyCalls + normalCalls, 2);
+}
+
+TEST(FusionDetector, DropsMembersWithoutWeightOrDetector)
+{
+    std::atomic<int> calls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back(Method("zero", ShinyVerdict::Shiny, 1.0, 0.0, calls));
+    members.push_back({ .detector = nullptr, .weight = 1.0 });
+    members.push_back(Method("kept", ShinyVerdict::NotShiny, 1.0, 0.5, calls));
+    auto detector = Fuse(std::move(members));
+
+    EXPECT_EQ(detector->MemberCount(), 1u);
+    EXPECT_EQ(detector->Detect(kRoi).verdict, ShinyVerdict::NotShiny);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(FusionDetector, NoMethodsOrEmptyRoiIsUncertain)
+{
+    auto detector = Fuse({});
+    const auto result = detector->Detect(kRoi);
+    EXPECT_EQ(result.verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(result.Details(), "no detection methods");
+
+    std::atomic<int> calls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back(Method("a", ShinyVerdict::Shiny, 1.0, 1.0, calls));
+    EXPECT_EQ(Fuse(std::move(members))->Detect(cv::Mat()).verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(FusionDetector, SequenceVotesOnFusedVerdicts)
+{
+    std::atomic<int> calls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back(Method("a", ShinyVerdict::Shiny, 1.0, 1.0, calls));
+    auto detector = Fuse(std::move(members));
+
+    const std::vector<cv::Mat> frames(5, kRoi);
+    const auto result = detector->DetectSequence(frames);
+    EXPECT_EQ(result.verdict, ShinyVerdict::Shiny);
+    EXPECT_EQ(result.method, "fusion");
+}
+
+TEST(FusionDetector, BatchSettlesSlotsIndependently)
+{
+    std::atomic<int> heavyCalls = 0;
+    std::atomic<int> lightCalls = 0;
+    std::vector<FusionDetector::Member> members;
+    members.push_back({ .detector = std::make_unique<TallIsShinyDetector>(heavyCalls), .weight = 3.0 });
+    members.push_back(Method("light", ShinyVerdict::NotShiny, 1.0, 1.0, lightCalls));
+    auto detector = Fuse(std::move(members));
+
+    // Slot 0 settles on the heavy method alone; slot 1 needs the light one; slot 2 is empty.
+    const std::vector<cv::Mat> slots = { cv::Mat(16, 8, CV_8UC3), kRoi, cv::Mat() };
+    const auto results = detector->DetectBatch(slots);
+    ASSERT_EQ(results.size(), slots.size());
+    EXPECT_EQ(heavyCalls, 2);
+    EXPECT_EQ(lightCalls, 1);
+
+    EXPECT_EQ(results[0].verdict, ShinyVerdict::Shiny);
+    EXPECT_DOUBLE_EQ(results[0].confidence, 0.75);
+    EXPECT_NE(results[0].Details().find("evaluated=1/2"), std::string::npos);
+    EXPECT_EQ(results[1].verdict, ShinyVerdict::Uncertain);
+    EXPECT_NE(results[1].Details().find("evaluated=2/2"), std::string::npos);
+    EXPECT_EQ(results[2].verdict, ShinyVerdict::Uncertain);
+
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        const auto single = detector->Detect(slots[i]);
+        EXPECT_EQ(results[i].verdict, single.verdict) << "slot=" << i;
+        EXPECT_EQ(results[i].Details(), single.Details()) << "slot=" << i;
+    }
+}
+
+TEST(FusionDetector, FactorySkipsUnknownMethods)
+{
+    SH3DS::Core::DetectionMethodConfig method;
+    method.method = "sparkle_v2";
+
+    EXPECT_EQ(FusionDetector::CreateMethodDetector(method, "test"), nullptr);
+
+    SH3DS::Core::DetectionProfile profile;
+    profile.profileId = "test";
+    profile.methods.push_back(method);
+    auto detector = FusionDetector::CreateFusionDetector(profile);
+    ASSERT_NE(detector, nullptr);
+    EXPECT_EQ(detector->ProfileId(), "test");
+    EXPECT_EQ(detector->Detect(kRoi).verdict, ShinyVerdict::Uncertain);
+}
+
+TEST(FusionDetector, FactoryBuildsSparkleOnItsOwnRoi)
+{
+    SH3DS::Core::DetectionMethodConfig method;
+    method.method = "sparkle";
+    method.roi = "pokemon_sprite";
+    method.sparkleRoi = "battle_sparkle";
+
+    auto detector = FusionDetector::CreateMethodDetector(method, "test");
+    ASSERT_NE(detector, nullptr);
+    EXPECT_EQ(detector->ProfileId(), "test");
+    EXPECT_EQ(detector->Detect(cv::Mat(8, 8, CV_8UC3, cv::Scalar(0, 0, 0))).method, "sparkle");
+
+    EXPECT_EQ(FusionDetector::MethodRoi(method), "battle_sparkle");
+    method.method = "dominant_color";
+    EXPECT_EQ(FusionDetector::MethodRoi(method), "pokemon_sprite");
+}
+
+TEST(FusionDetector, FusedDiagnosticsSurviveManyMembers)
+{
+    std::atomic<int> calls = 0;
+    std::vector<FusionDetector::Member> members;
+    for (const char *name : { "m1", "m2", "m3", "m4", "m5", "m6" })
+    {
+        members.push_back(Method(name, ShinyVerdict::Uncertain, 0.5, 1.0, calls));
+    }
+    auto detector = Fuse(std::move(members));
+
+    const auto result = detector->Detect(kRoi);
+    const std::string details = result.Details();
+    EXPECT_EQ(result.diagnostics.count, SH3DS::Core::ShinyDiagnostics::kCapacity);
+    EXPECT_NE(details.find("score_low="), std::string::npos) << details;
+    EXPECT_NE(details.find("score_high="), std::string::npos) << details;
+    EXPECT_NE(details.find("evaluated=" + std::to_string(calls.load()) + "/6"), std::string::npos) << details;
+}
@@ -0,0 +1,118 @@
+#include "Vision/HistogramUtils.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+    cv::Mat CreateNoiseImage(int width, int height, uint64_t seed)
+    {
+        cv::Mat image(height, width, CV_8UC3);
+        cv::RNG rng(seed);
+        rng.fill(image, cv::RNG::UNIFORM, 0, 256);
+        return image;
+    }
+
+    cv::Mat LegacyHistogram(const cv::Mat &bgr, int hBins, int sBins)
+    {
+        cv::Mat hsv;
+        cv::cvtColor(bgr, hsv, cv::COLOR_BGR2HSV);
+        cv::Mat hist;
+        int channels[] = { 0, 1 };
+        int histSize[] = { hBins, sBins };
+        float hRange[] = { 0, 180 };
+        float sRange[] = { 0, 256 };
+        const float *ranges[] = { hRange, sRange };
+        cv::calcHist(&hsv, 1, channels, cv::Mat(), hist, 2, histSize, ranges);
+        cv::normalize(hist, hist, 0, 1, cv::NORM_MINMAX);
+        return hist;
+    }
+} // namespace
+
+TEST(HistogramUtils, FusedHistogramMatchesCalcHist)
+{
+    for (int seed = 1; seed <= 5; ++seed)
+    {
+        const cv::Mat image = CreateNoiseImage(37 * seed, 23 * seed, static_cast<uint64_t>(seed));
+        cv::Mat fused;
+        SH3DS::Vision::ComputeHSHistogramInto(image, 30, 32, fused);
+
+        const cv::Mat legacy = LegacyHistogram(image, 30, 32);
+        ASSERT_EQ(fused.size(), legacy.size());
+        ASSERT_EQ(fused.type(), CV_32F);
+        EXPECT_LE(cv::norm(fused, legacy, cv::NORM_INF), 1e-6) << "seed " << seed;
+    }
+}
+
+TEST(HistogramUtils, FusedHistogramHandlesRoiViewsAndGrey)
+{
+    const cv::Mat image = CreateNoiseImage(120, 80, 9);
+    const cv::Mat roi = image(cv::Rect(10, 5, 50, 40));
+    cv::Mat fused;
+    SH3DS::Vision::ComputeHSHistogramInto(roi, 30, 32, fused);
+    EXPECT_LE(cv::norm(fused, LegacyHistogram(roi.clone(), 30, 32), cv::NORM_INF), 1e-6);
+
+    const cv::Mat grey(16, 16, CV_8UC3, cv::Scalar(128, 128, 128));
+    SH3DS::Vision::ComputeHSHistogramInto(grey, 30, 32, fused);
+    EXPECT_LE(cv::norm(fused, LegacyHistogram(grey, 30, 32), cv::NORM_INF), 1e-6);
+}
+
+TEST(HistogramUtils, FusedHistogramReusesBuffer)
+{
+    cv::Mat hist;
+    SH3DS::Vision::ComputeHSHistogramInto(CreateNoiseImage(40, 30, 1), 30, 32, hist);
+    const uchar *buffer = hist.data;
+    SH3DS::Vision::ComputeHSHistogramInto(CreateNoiseImage(60, 20, 2), 30, 32, hist);
+    EXPECT_EQ(hist.data, buffer);
+}
+
+TEST(HistogramUtils, BinaryHistogramRoundTrips)
+{
+    const cv::Mat hist = SH3DS::Vision::ComputeHSHistogram(CreateNoiseImage(50, 50, 4), 30, 32);
+    const auto path = (std::filesystem::temp_directory_path() / "sh3ds_test_hist.hist").string();
+
+    SH3DS::Vision::SaveHistogram(hist, path);
+    const cv::Mat loaded = SH3DS::Vision::LoadHistogram(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(loaded.size(), hist.size());
+    ASSERT_EQ(loaded.type(), CV_32F);
+    EXPECT_EQ(cv::norm(loaded, hist, cv::NORM_INF), 0.0);
+}
+
+TEST(HistogramUtils, MissingBinaryHistogramIsEmpty)
+{
+    EXPECT_TRUE(SH3DS::Vision::LoadHistogram("/nonexistent/reference.hist").empty());
+}
+
+TEST(HistogramUtils, ParsesCompareMethods)
+{
+    using SH3DS::Vision::HistogramCompareMethod;
+    using SH3DS::Vision::ParseHistogramCompareMethod;
+    EXPECT_EQ(ParseHistogramCompareMethod("correlation"), HistogramCompareMethod::Correlation);
+    EXPECT_EQ(ParseHistogramCompareMethod("chi_square"), HistogramCompareMethod::ChiSquare);
+    EXPECT_EQ(ParseHistogramCompareMethod("intersection"), HistogramCompareMethod::Intersection);
+    EXPECT_EQ(ParseHistogramCompareMethod("bhattacharyya"), HistogramCompareMethod::Bhattacharyya);
+    EXPECT_EQ(ParseHistogramCompareMethod("unknown"), HistogramCompareMethod::Correlation);
+}
+
+TEST(HistogramUtils, DistanceMetricsAreOrientedHigherIsMoreSimilar)
+{
+    const cv::Mat a = SH3DS::Vision::ComputeHSHistogram(CreateNoiseImage(50, 50, 1), 30, 32);
+    const cv::Mat b = SH3DS::Vision::ComputeHSHistogram(cv::Mat(50, 50, CV_8UC3, cv::Scalar(200, 30, 30)), 30, 32);
+
+    for (auto method : { SH3DS::Vision::HistogramCompareMethod::Correlation,
+             SH3DS::Vision::HistogramCompareMethod::ChiSquare,
+             SH3DS::Vision::HistogramCompareMethod::Intersection,
+             SH3DS::Vision::HistogramCompareMethod::Bhattacharyya })
+    {
+        EXPECT_GT(SH3DS::Vision::CompareHistograms(a, a, method), SH3DS::Vision::CompareHistograms(a, b, method))
+            << static_cast<int>(method);
+    }
+}
@@ -0,0 +1,240 @@
+#include "Core/HotLog.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compile-time stripping is checked below by raising the active level for the rest of this file.
+#undef SH3DS_HOT_LOG_ACTIVE_LEVEL
+#define SH3DS_HOT_LOG_ACTIVE_LEVEL 2
+
+using SH3DS::Core::HotLogger;
+using SH3DS::Core::HotLogLevel;
+
+namespace
+{
+    /// Records every message the logger writes, and the thread that wrote it.
+    struct CapturedMessages
+    {
+        std::mutex mutex;
+        std::vector<std::string> messages;
+        std::vector<std::thread::id> writers;
+
+        HotLogger::Sink Sink(HotLogLevel minLevel = HotLogLevel::Trace)
+        {
+            return [this, minLevel](HotLogLevel level, std::string_view message) {
+                if (level < minLevel)
+                {
+                    return;
+                }
+                std::lock_guard lock(mutex);
+                messages.emplace_back(message);
+                writers.push_back(std::this_thread::get_id());
+            };
+        }
+    };
+
+    int evaluations = 0;
+
+    int Evaluate()
+    {
+        return ++evaluations;
+    }
+} // namespace
+
+TEST(HotLog, SynchronousModeFormatsOnTheCallingThread)
+{
+    CapturedMessages captured;
+    HotLogger logger(captured.Sink());
+    logger.SetLevel(HotLogLevel::Debug);
+
+    const std::string roi = "pokemon_sprite";
+    const uint16_t buttons = 0x0A;
+    logger.Log(HotLogLevel::Debug,
+        "rule '{}' on {} ROI: confidence={:.3f} buttons=0x{:04X} unchanged={} frame={}",
+        roi,
+        "top",
+        0.12345,
+        buttons,
+        true,
+        -7);
+
+    ASSERT_EQ(captured.messages.size(), 1u);
+    EXPECT_EQ(captured.messages[0], "rule 'pokemon_sprite' on top ROI: confidence=0.123 buttons=0x000A unchanged=true "
+                                    "frame=-7");
+    EXPECT_EQ(captured.writers[0], std::this_thread::get_id());
+}
+
+TEST(HotLog, RuntimeLevelFiltersStatements)
+{
+    HotLogger logger;
+    logger.SetLevel(HotLogLevel::Info);
+    EXPECT_FALSE(logger.ShouldLog(HotLogLevel::Trace));
+    EXPECT_FALSE(logger.ShouldLog(HotLogLevel::Debug));
+    EXPECT_TRUE(logger.ShouldLog(HotLogLevel::Info));
+
+    logger.SetLevel(SH3DS::Core::ParseHotLogLevel("trace"));
+    EXPECT_TRUE(logger.ShouldLog(HotLogLevel::Trace));
+    EXPECT_EQ(SH3DS::Core::ParseHotLogLevel("nonsense"), HotLogLevel::Off);
+}
+
+TEST(HotLog, AsyncModeWritesOnTheWriterThreadInProducerOrder)
+{
+    constexpr int kThreads = 2;
+    constexpr int kMessagesPerThread = 200;
+
+    CapturedMessages captured;
+    HotLogger logger(captured.Sink());
+    logger.SetLevel(HotLogLevel::Debug);
+    logger.StartAsync();
+    ASSERT_TRUE(logger.IsAsync());
+
+    std::vector<std::thread> producers;
+    std::vector<std::thread::id> producerIds(kThreads);
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&logger, &producerIds, t] {
+            producerIds[static_cast<size_t>(t)] = std::this_thread::get_id();
+            for (int i = 0; i < kMessagesPerThread; ++i)
+            {
+                logger.Log(HotLogLevel::Debug, "{} {}", t, i);
+            }
+        });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    logger.Stop();
+    EXPECT_FALSE(logger.IsAsync());
+
+    ASSERT_EQ(logger.DroppedRecords(), 0u);
+    ASSERT_EQ(captured.messages.size(), static_cast<size_t>(kThreads * kMessagesPerThread));
+    std::vector<int> next(kThreads, 0);
+    for (size_t m = 0; m < captured.messages.size(); ++m)
+    {
+        const auto space = captured.messages[m].find(' ');
+        const int thread = std::stoi(captured.messages[m].substr(0, space));
+        const int index = std::stoi(captured.messages[m].substr(space + 1));
+        EXPECT_EQ(index, next[static_cast<size_t>(thread)]++) << captured.messages[m];
+        EXPECT_NE(captured.writers[m], producerIds[static_cast<size_t>(thread)]);
+    }
+}
+
+TEST(HotLog, IdleWriterWakesForEachNewRecord)
+{
+    constexpr int kRounds = 200;
+
+    CapturedMessages captured;
+    HotLogger logger(captured.Sink());
+    logger.SetLevel(HotLogLevel::Debug);
+    logger.StartAsync();
+
+    // Each record lands in a ring the writer has already emptied; it must be written without Stop() or Drain()
+    for (int i = 0; i < kRounds; ++i)
+    {
+        logger.Log(HotLogLevel::Debug, "record {}", i);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (true)
+        {
+            {
+                std::lock_guard lock(captured.mutex);
+                if (captured.messages.size() == static_cast<size_t>(i + 1))
+                {
+                    break;
+                }
+            }
+            ASSERT_LT(std::chrono::steady_clock::now(), deadline) << "record " << i << " was never written";
+            std::this_thread::yield();
+        }
+    }
+    logger.Stop();
+    EXPECT_EQ(captured.messages.back(), "record 199");
+}
+
+TEST(HotLog, FullRingDropsInsteadOfBlocking)
+{
+    constexpr size_t kCapacity = 4;
+
+    std::atomic<bool> writing{ false };
+    std::atomic<bool> release{ false };
+    std::vector<std::string> messages;
+    std::vector<std::string> warnings;
+    HotLogger logger(
+        [&](HotLogLevel level, std::string_view message) {
+            if (level == HotLogLevel::Warn)
+            {
+                warnings.emplace_back(message);
+                return;
+            }
+            writing = true;
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+            messages.emplace_back(message);
+        },
+        kCapacity);
+    logger.SetLevel(HotLogLevel::Debug);
+    logger.StartAsync();
+
+    // The writer takes the first record and blocks in the sink, so the ring holds exactly kCapacity more.
+    logger.Log(HotLogLevel::Debug, "first");
+    while (!writing)
+    {
+        std::this_thread::yield();
+    }
+    for (size_t i = 0; i < kCapacity + 3; ++i)
+    {
+        logger.Log(HotLogLevel::Debug, "queued {}", i);
+    }
+    EXPECT_EQ(logger.DroppedRecords(), 3u);
+
+    release = true;
+    logger.Stop();
+    EXPECT_EQ(messages.size(), kCapacity + 1);
+    EXPECT_EQ(messages.back(), "queued 3");
+    ASSERT_EQ(warnings.size(), 1u);
+    EXPECT_EQ(warnings[0], "HotLog: 3 records dropped (ring full)");
+}
+
+TEST(HotLog, LongStringArgumentsAreCut)
+{
+    CapturedMessages captured;
+    HotLogger logger(captured.Sink());
+    logger.SetLevel(HotLogLevel::Debug);
+
+    const std::string first(SH3DS::Core::HotLogRecord::kTextCapacity - 2, 'a');
+    logger.Log(HotLogLevel::Debug, "[{}][{}][{}]", first, "bcdef", "ghi");
+
+    ASSERT_EQ(captured.messages.size(), 1u);
+    EXPECT_EQ(captured.messages[0], "[" + first + "][bc][]");
+}
+
+TEST(HotLog, StatementsBelowTheActiveLevelAreCompiledOut)
+{
+    auto &logger = HotLogger::Get();
+    const HotLogLevel previous = logger.Level();
+    logger.SetLevel(HotLogLevel::Trace);
+    evaluations = 0;
+
+    // Below SH3DS_HOT_LOG_ACTIVE_LEVEL (info) for this file: gone even though the runtime level allows them.
+    HOT_LOG_TRACE("{}", Evaluate());
+    HOT_LOG_DEBUG("{}", Evaluate());
+    EXPECT_EQ(evaluations, 0);
+
+    HOT_LOG_INFO("{}", Evaluate());
+    EXPECT_EQ(evaluations, 1);
+
+    // Compiled in but disabled at runtime: the arguments are not evaluated either.
+    logger.SetLevel(HotLogLevel::Off);
+    HOT_LOG_INFO("{}", Evaluate());
+    EXPECT_EQ(evaluations, 1);
+    logger.SetLevel(previous);
+}
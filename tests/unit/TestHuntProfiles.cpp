@@ -43,10 +43,20 @@ TEST(HuntProfiles, CreateXYStarterSRSucceedsWithCompleteParams)
     auto params = MakeCompleteParams();
     EXPECT_NO_THROW({
         auto fsm = SH3DS::FSM::HuntProfiles::CreateXYStarterSR(params);
-        EXPECT_EQ(fsm->GetCurrentState(), "load_game");
+        EXPECT_EQ(fsm->GetCurrentStateName(), "load_game");
     });
 }
 
+TEST(HuntProfiles, CreateXYStarterSRGraphIsClean)
+{
+    // Every state is reachable from load_game and the cycle closes back to it.
+    auto fsm = SH3DS::FSM::HuntProfiles::CreateXYStarterSR(MakeCompleteParams());
+    const auto report = fsm->GetTransitionGraph().Validate(fsm->GetInitialState());
+    EXPECT_TRUE(report.unreachable.empty());
+    EXPECT_TRUE(report.deadEnds.empty());
+    EXPECT_TRUE(report.undeclared.empty());
+}
+
 TEST(HuntProfiles, CreateXYStarterSRThrowsDescriptiveErrorForMissingState)
 {
     auto params = MakeCompleteParams();
@@ -97,3 +107,27 @@ TEST(HuntProfiles, CreateXYStarterSRThrowsForRemovedStates)
             << "Error message should name the missing state; got: " << e.what();
     }
 }
+
+TEST(HuntProfiles, CreateDispatchesOnHuntProfile)
+{
+    auto fsm = SH3DS::FSM::HuntProfiles::Create("xy_starter_sr", MakeCompleteParams());
+    ASSERT_NE(fsm, nullptr);
+    EXPECT_EQ(fsm->GetCurrentStateName(), "load_game");
+}
+
+TEST(HuntProfiles, CreateRejectsMissingOrUnknownProfile)
+{
+    const auto params = MakeCompleteParams();
+    EXPECT_THROW(SH3DS::FSM::HuntProfiles::Create("", params), std::runtime_error);
+
+    try
+    {
+        SH3DS::FSM::HuntProfiles::Create("oras_wild_sr", params);
+        FAIL() << "Expected std::runtime_error for an unknown profile";
+    }
+    catch (const std::runtime_error &e)
+    {
+        EXPECT_NE(std::string(e.what()).find("oras_wild_sr"), std::string::npos) << e.what();
+        EXPECT_NE(std::string(e.what()).find("xy_starter_sr"), std::string::npos) << e.what();
+    }
+}
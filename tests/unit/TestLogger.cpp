@@ -0,0 +1,31 @@
+#include "Core/Logger.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST(Logger, RenameKeepsTheLevel)
+{
+    auto &logger = SH3DS::Core::Logger::Get();
+    logger.SetLevel(spdlog::level::warn);
+
+    SH3DS::Core::Logger::SetLoggerName("SH-3DS-Test");
+
+    EXPECT_EQ(&SH3DS::Core::Logger::Get(), &logger);
+    EXPECT_EQ(logger.GetLogger().name(), "SH-3DS-Test");
+    EXPECT_EQ(logger.GetLogger().level(), spdlog::level::warn);
+    EXPECT_FALSE(logger.GetLogger().should_log(spdlog::level::info));
+}
+
+TEST(Logger, MacrosRespectTheLevel)
+{
+    auto &logger = SH3DS::Core::Logger::Get();
+    logger.SetLevel(spdlog::level::err);
+    testing::internal::CaptureStdout();
+    LOG_INFO("filtered {}", 1);
+    LOG_ERROR("written {}", 2);
+    const std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(output.find("filtered 1"), std::string::npos);
+    EXPECT_NE(output.find("written 2"), std::string::npos);
+}
@@ -1,4 +1,5 @@
 #include "Core/Config.h"
+#include "Core/StateRegistry.h"
 #include "Core/Types.h"
 #include "FSM/GameStateFSM.h"
 #include "Pipeline/Orchestrator.h"
@@ -7,7 +8,15 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <memory>
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
 
 namespace
 {
@@ -34,13 +43,31 @@ namespace
     public:
         std::optional<SH3DS::Core::StateTransition> Update(const SH3DS::Core::ROISet &topRois,
             const SH3DS::Core::ROISet &bottomRois) override
+        {
+            (void)bottomRois;
+            ++updates;
+            if (const auto it = topRois.find("pokemon_sprite"); it != topRois.end())
+            {
+                spriteMeans.push_back(cv::mean(it->second)[0]);
+            }
+            return std::nullopt;
+        }
+
+        std::optional<SH3DS::Core::StateTransition> UpdateUnchanged(const SH3DS::Core::ROISet &topRois,
+            const SH3DS::Core::ROISet &bottomRois) override
         {
             (void)topRois;
             (void)bottomRois;
+            ++unchangedUpdates;
             return std::nullopt;
         }
 
-        const SH3DS::Core::GameState &GetCurrentState() const override
+        StubFSM() : states(std::make_shared<SH3DS::Core::StateRegistry>())
+        {
+            states->Intern("load_game");
+        }
+
+        SH3DS::Core::StateId GetCurrentState() const override
         {
             return currentState;
         }
@@ -57,7 +84,7 @@ namespace
 
         void Reset() override
         {
-            currentState = "load_game";
+            currentState = initialState;
         }
 
         const std::vector<SH3DS::Core::StateTransition> &GetTransitionHistory() const override
@@ -65,14 +92,23 @@ namespace
             return history;
         }
 
-        const SH3DS::Core::GameState &GetInitialState() const override
+        SH3DS::Core::StateId GetInitialState() const override
         {
             return initialState;
         }
 
+        std::shared_ptr<const SH3DS::Core::StateRegistry> GetStateRegistry() const override
+        {
+            return states;
+        }
+
         bool stuck = false;
-        std::string currentState = "load_game";
-        std::string initialState = "load_game";
+        int updates = 0;
+        int unchangedUpdates = 0;
+        std::vector<double> spriteMeans; ///< Mean blue of the sprite ROI per analysed frame
+        std::shared_ptr<SH3DS::Core::StateRegistry> states;
+        SH3DS::Core::StateId currentState = 0;
+        SH3DS::Core::StateId initialState = 0;
         std::vector<SH3DS::Core::StateTransition> history;
     };
 
@@ -86,12 +122,12 @@ namespace
         {
         }
 
-        SH3DS::Strategy::StrategyDecision Tick(const SH3DS::Core::GameState &,
+        SH3DS::Strategy::StrategyDecision Tick(SH3DS::Core::StateId,
             std::chrono::milliseconds,
             const std::optional<SH3DS::Core::ShinyResult> &) override
         {
             SH3DS::Strategy::StrategyDecision d;
-            d.decision.action = tickAction;
+            d.decision.action = ++ticks >= abortAfterTicks ? tickAction : SH3DS::Core::HuntAction::Wait;
             return d;
         }
 
@@ -118,6 +154,8 @@ namespace
 
         SH3DS::Core::HuntStatistics stats;
         SH3DS::Core::HuntAction tickAction = SH3DS::Core::HuntAction::Wait;
+        int abortAfterTicks = 0; ///< Ticks that Wait before tickAction is returned
+        int ticks = 0;
     };
 
     // ── Frame source stub that yields exactly one frame then exhausts ────────
@@ -159,6 +197,103 @@ namespace
         bool grabbed = false;
     };
 
+    // ── Frame source stub that yields a fixed list of frames then exhausts ───
+
+    class SequenceFrameSource : public SH3DS::Capture::FrameSource
+    {
+    public:
+        explicit SequenceFrameSource(std::vector<cv::Mat> images) : images(std::move(images))
+        {
+        }
+
+        bool Open() override
+        {
+            return true;
+        }
+
+        void Close() override
+        {
+        }
+
+        std::optional<SH3DS::Core::Frame> Grab() override
+        {
+            if (next >= images.size())
+            {
+                return std::nullopt;
+            }
+            SH3DS::Core::Frame frame;
+            frame.image = images[next++];
+            return frame;
+        }
+
+        bool IsOpen() const override
+        {
+            return true;
+        }
+
+        std::string Describe() const override
+        {
+            return "SequenceFrameSource";
+        }
+
+        std::vector<cv::Mat> images;
+        std::size_t next = 0;
+    };
+
+    // ── Frame source stub that honours crop hints ────────────────────────────
+
+    class CroppingFrameSource : public SequenceFrameSource
+    {
+    public:
+        using SequenceFrameSource::SequenceFrameSource;
+
+        std::optional<SH3DS::Core::Frame> Grab() override
+        {
+            auto frame = SequenceFrameSource::Grab();
+            if (frame && hints.size() > 0 && hints.back())
+            {
+                const cv::Rect region = *hints.back() & cv::Rect(0, 0, frame->image.cols, frame->image.rows);
+                frame->image = frame->image(region).clone();
+                frame->metadata.cropOrigin = region.tl();
+                ++croppedGrabs;
+            }
+            return frame;
+        }
+
+        void SetCropHint(std::optional<cv::Rect> region) override
+        {
+            hints.push_back(region);
+        }
+
+        std::vector<std::optional<cv::Rect>> hints;
+        int croppedGrabs = 0;
+    };
+
+    // ── Frame source stub that reports a larger uncropped source ────────────
+
+    class PartlyCroppedFrameSource : public SequenceFrameSource
+    {
+    public:
+        PartlyCroppedFrameSource(std::vector<cv::Mat> images, cv::Size source)
+            : SequenceFrameSource(std::move(images)),
+              source(source)
+        {
+        }
+
+        std::optional<SH3DS::Core::Frame> Grab() override
+        {
+            auto frame = SequenceFrameSource::Grab();
+            if (frame)
+            {
+                frame->metadata.sourceWidth = source.width;
+                frame->metadata.sourceHeight = source.height;
+            }
+            return frame;
+        }
+
+        cv::Size source;
+    };
+
 } // namespace
 
 // ── Tests ───────────────────────────────────────────────────────────────────
@@ -232,3 +367,161 @@ TEST(Orchestrator, StuckWatchdogAbortsWithoutRecoveryActions)
     EXPECT_NO_THROW(orchestrator.Run());
     EXPECT_EQ(orchestrator.Stats().watchdogRecoveries, 1u);
 }
+
+TEST(Orchestrator, UnchangedFramesSkipAnalysis)
+{
+    SH3DS::Core::OrchestratorConfig cfg;
+    cfg.targetFps = 30.0;
+    cfg.shinyRoi = "pokemon_sprite";
+
+    const cv::Mat dark(240, 400, CV_8UC3, cv::Scalar(10, 10, 10));
+    const cv::Mat bright(240, 400, CV_8UC3, cv::Scalar(200, 200, 200));
+    auto stubFsm = std::make_unique<StubFSM>();
+    auto *fsm = stubFsm.get();
+    auto strategy = std::make_unique<StubStrategy>(SH3DS::Core::HuntAction::Abort);
+    strategy->abortAfterTicks = 5;
+
+    SH3DS::Pipeline::Orchestrator orchestrator(
+        std::make_unique<SequenceFrameSource>(std::vector<cv::Mat>{ dark, dark, dark, bright, bright }),
+        nullptr,
+        MakeCalibratedPreprocessor(),
+        std::move(stubFsm),
+        nullptr,
+        std::move(strategy),
+        nullptr,
+        cfg);
+
+    orchestrator.Run();
+    EXPECT_EQ(fsm->updates, 2);
+    EXPECT_EQ(fsm->unchangedUpdates, 3);
+    EXPECT_EQ(orchestrator.Stats().frames, 5u);
+    EXPECT_EQ(orchestrator.Stats().unchangedFrames, 3u);
+}
+
+TEST(Orchestrator, CropsSourceToCalibratedScreens)
+{
+    SH3DS::Core::OrchestratorConfig cfg;
+    cfg.targetFps = 30.0;
+    cfg.frameDeltaThreshold = 0.0; // analyse every frame
+    cfg.cropMargin = 8;
+
+    // Screen at (40, 30)-(439, 269) of a 480x320 camera frame, with a ramp so a misplaced warp changes the ROI
+    cv::Mat image(320, 480, CV_8UC3, cv::Scalar(0, 0, 0));
+    for (int x = 40; x < 440; ++x)
+    {
+        image(cv::Rect(x, 30, 1, 240)).setTo(cv::Scalar(x / 2, 100, 100));
+    }
+    SH3DS::Core::ScreenCalibrationConfig calibration;
+    calibration.corners = {
+        cv::Point2f(40.0f, 30.0f),
+        cv::Point2f(439.0f, 30.0f),
+        cv::Point2f(439.0f, 269.0f),
+        cv::Point2f(40.0f, 269.0f),
+    };
+    std::vector<SH3DS::Core::RoiDefinition> rois = {
+        { .name = "pokemon_sprite", .x = 0.0, .y = 0.0, .w = 1.0, .h = 1.0 },
+    };
+
+    auto source = std::make_unique<CroppingFrameSource>(std::vector<cv::Mat>{ image, image, image });
+    auto *sourcePtr = source.get();
+    auto stubFsm = std::make_unique<StubFSM>();
+    auto *fsm = stubFsm.get();
+    auto strategy = std::make_unique<StubStrategy>(SH3DS::Core::HuntAction::Abort);
+    strategy->abortAfterTicks = 3;
+
+    SH3DS::Pipeline::Orchestrator orchestrator(std::move(source),
+        nullptr, // corners fixed by configuration
+        std::make_unique<SH3DS::Capture::FramePreprocessor>(calibration, rois),
+        std::move(stubFsm),
+        nullptr,
+        std::move(strategy),
+        nullptr,
+        cfg);
+    orchestrator.Run();
+
+    ASSERT_EQ(sourcePtr->hints.size(), 1u);
+    ASSERT_TRUE(sourcePtr->hints[0].has_value());
+    EXPECT_EQ(*sourcePtr->hints[0], cv::Rect(32, 22, 416, 256));
+    EXPECT_EQ(sourcePtr->croppedGrabs, 2);
+
+    // Cropped frames are warped through their origin, so the screen looks the same as in the full frame
+    ASSERT_EQ(fsm->spriteMeans.size(), 3u);
+    EXPECT_NEAR(fsm->spriteMeans[1], fsm->spriteMeans[0], 0.5);
+    EXPECT_NEAR(fsm->spriteMeans[2], fsm->spriteMeans[0], 0.5);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(Orchestrator, PublishesFramesToSharedMemory)
+{
+    SH3DS::Core::OrchestratorConfig cfg;
+    cfg.targetFps = 30.0;
+    cfg.sharedMemoryName = "/sh3ds_test_orchestrator_" + std::to_string(getpid());
+    cfg.sharedMemorySlots = 2;
+
+    const cv::Mat dark(240, 400, CV_8UC3, cv::Scalar(10, 10, 10));
+    const cv::Mat bright(240, 400, CV_8UC3, cv::Scalar(200, 200, 200));
+    auto strategy = std::make_unique<StubStrategy>(SH3DS::Core::HuntAction::Abort);
+    strategy->abortAfterTicks = 3;
+
+    SH3DS::Pipeline::Orchestrator orchestrator(
+        std::make_unique<SequenceFrameSource>(std::vector<cv::Mat>{ dark, bright, bright }),
+        nullptr,
+        MakeCalibratedPreprocessor(),
+        std::make_unique<StubFSM>(),
+        nullptr,
+        std::move(strategy),
+        nullptr,
+        cfg);
+    orchestrator.Run();
+
+    // The ring lives as long as the orchestrator
+    SH3DS::Pipeline::SharedFrameRingReader reader(cfg.sharedMemoryName);
+    EXPECT_EQ(reader.Published(), 3u);
+
+    auto snapshot = reader.CopyLatest();
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_STREQ(snapshot->telemetry.stateName.data(), "load_game");
+    EXPECT_EQ(snapshot->telemetry.unchanged, 1);
+    EXPECT_EQ(snapshot->telemetry.hasShinyResult, 0);
+
+    const cv::Mat &raw = snapshot->images[static_cast<size_t>(SH3DS::Pipeline::SharedImage::Raw)];
+    ASSERT_EQ(raw.size(), cv::Size(400, 240));
+    EXPECT_EQ(raw.at<cv::Vec3b>(120, 200), cv::Vec3b(200, 200, 200));
+    EXPECT_FALSE(snapshot->images[static_cast<size_t>(SH3DS::Pipeline::SharedImage::Top)].empty());
+    EXPECT_TRUE(snapshot->images[static_cast<size_t>(SH3DS::Pipeline::SharedImage::Bottom)].empty());
+}
+
+TEST(Orchestrator, SharedMemorySlotsFitTheUncroppedFrame)
+{
+    SH3DS::Core::OrchestratorConfig cfg;
+    cfg.targetFps = 30.0;
+    cfg.sharedMemoryName = "/sh3ds_test_orchestrator_uncropped_" + std::to_string(getpid());
+    cfg.sharedMemorySlots = 2;
+
+    // The first frame arrives cropped; the second is the full 640x480 source, larger than either warped screen
+    const cv::Mat cropped(120, 160, CV_8UC3, cv::Scalar(10, 10, 10));
+    const cv::Mat full(480, 640, CV_8UC3, cv::Scalar(200, 200, 200));
+    auto strategy = std::make_unique<StubStrategy>(SH3DS::Core::HuntAction::Abort);
+    strategy->abortAfterTicks = 2;
+
+    SH3DS::Pipeline::Orchestrator orchestrator(
+        std::make_unique<PartlyCroppedFrameSource>(std::vector<cv::Mat>{ cropped, full }, full.size()),
+        nullptr,
+        MakeCalibratedPreprocessor(),
+        std::make_unique<StubFSM>(),
+        nullptr,
+        std::move(strategy),
+        nullptr,
+        cfg);
+    orchestrator.Run();
+
+    SH3DS::Pipeline::SharedFrameRingReader reader(cfg.sharedMemoryName);
+    EXPECT_EQ(reader.Published(), 2u);
+
+    auto snapshot = reader.CopyLatest();
+    ASSERT_TRUE(snapshot.has_value());
+    const cv::Mat &raw = snapshot->images[static_cast<size_t>(SH3DS::Pipeline::SharedImage::Raw)];
+    ASSERT_EQ(raw.size(), full.size());
+    EXPECT_EQ(raw.at<cv::Vec3b>(240, 320), cv::Vec3b(200, 200, 200));
+}
+#endif
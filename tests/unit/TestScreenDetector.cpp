@@ -1,3 +1,4 @@
+#include "Capture/ScreenCalibrationCache.h"
 #include "Capture/ScreenDetector.h"
 
 #include <opencv2/core.hpp>
@@ -5,6 +6,9 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+
 namespace
 {
 
@@ -38,6 +42,54 @@ namespace
         cv::Point botBl = { 400, 820 };
     };
 
+    cv::Mat MakeDualScreenFrame(int offsetX = 0)
+    {
+        auto frame = MakeBlackFrame(1280, 960);
+        const int x = offsetX;
+        DrawBrightRect(frame, { 340 + x, 80 }, { 940 + x, 80 }, { 940 + x, 440 }, { 340 + x, 440 });   // top 5:3
+        DrawBrightRect(frame, { 400 + x, 460 }, { 880 + x, 460 }, { 880 + x, 820 }, { 400 + x, 820 }); // bottom 4:3
+        return frame;
+    }
+
+    // Calibration cache file in the temp directory, removed when the test ends
+    class CacheFile
+    {
+    public:
+        explicit CacheFile(const std::string &name)
+            : path(std::filesystem::temp_directory_path() / ("sh3ds_screen_cache_" + name + ".yaml"))
+        {
+            std::filesystem::remove(path);
+        }
+
+        ~CacheFile()
+        {
+            std::filesystem::remove(path);
+        }
+
+        SH3DS::Capture::ScreenDetectorConfig MakeConfig(const std::string &cameraId = "usb:0") const
+        {
+            SH3DS::Capture::ScreenDetectorConfig config;
+            config.calibrationFrames = 3;
+            config.calibrationCachePath = path.string();
+            config.cameraId = cameraId;
+            return config;
+        }
+
+        std::filesystem::path path;
+    };
+
+    void CalibrateInto(const CacheFile &cache)
+    {
+        SH3DS::Capture::ScreenDetector detector(cache.MakeConfig());
+        const auto frame = MakeDualScreenFrame();
+        for (int i = 0; i < 3; ++i)
+        {
+            detector.Detect(frame);
+        }
+        ASSERT_TRUE(detector.IsCalibrated());
+        ASSERT_FALSE(detector.IsRestoredFromCache());
+    }
+
 } // namespace
 
 TEST(ScreenDetector, DetectsWhiteRectangleOnBlackBackground)
@@ -361,3 +413,184 @@ TEST(ScreenDetector, HeldScreenMarkedAsHeld)
         EXPECT_DOUBLE_EQ(result.topScreen->confidence, 0.0);
     }
 }
+
+TEST(ScreenDetector, CalibrationCacheRoundTrips)
+{
+    CacheFile file("roundtrip");
+    SH3DS::Capture::ScreenCalibrationCache cache;
+    cache.cameraId = "mjpeg:http://camera/stream";
+    cache.frameWidth = 1280;
+    cache.frameHeight = 720;
+    cache.topCorners = {
+        cv::Point2f(1.5f, 2.0f), cv::Point2f(3.0f, 4.0f), cv::Point2f(5.0f, 6.0f), cv::Point2f(7.0f, 8.25f)
+    };
+    cache.bottomCorners = {
+        cv::Point2f(9.0f, 10.0f), cv::Point2f(11.0f, 12.0f), cv::Point2f(13.0f, 14.0f), cv::Point2f(15.0f, 16.0f)
+    };
+    ASSERT_TRUE(SH3DS::Capture::SaveScreenCalibrationCache(file.path, cache));
+
+    const auto loaded = SH3DS::Capture::LoadScreenCalibrationCache(file.path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->cameraId, cache.cameraId);
+    EXPECT_EQ(loaded->frameWidth, 1280);
+    EXPECT_EQ(loaded->frameHeight, 720);
+    EXPECT_EQ(loaded->topCorners, cache.topCorners);
+    EXPECT_EQ(loaded->bottomCorners, cache.bottomCorners);
+}
+
+TEST(ScreenDetector, CalibrationCacheRejectsMissingOrMalformedFiles)
+{
+    CacheFile file("malformed");
+    EXPECT_FALSE(SH3DS::Capture::LoadScreenCalibrationCache(file.path).has_value());
+
+    std::ofstream(file.path) << "camera_id: usb:0\nframe_width: 1280\nframe_height: 720\ntop_corners: [[1, 2]]\n";
+    EXPECT_FALSE(SH3DS::Capture::LoadScreenCalibrationCache(file.path).has_value());
+}
+
+TEST(ScreenDetector, LockedCornersAreRestoredOnFirstFrame)
+{
+    CacheFile cache("restore");
+    CalibrateInto(cache);
+    ASSERT_TRUE(std::filesystem::exists(cache.path));
+
+    SH3DS::Capture::ScreenDetector detector(cache.MakeConfig());
+    const auto result = detector.Detect(MakeDualScreenFrame());
+
+    EXPECT_TRUE(detector.IsCalibrated());
+    EXPECT_TRUE(detector.IsRestoredFromCache());
+    ASSERT_TRUE(result.topScreen.has_value());
+    ASSERT_TRUE(result.bottomScreen.has_value());
+    EXPECT_NEAR(result.topScreen->corners[0].x, 340.0f, 10.0f);
+    EXPECT_NEAR(result.bottomScreen->corners[2].y, 820.0f, 10.0f);
+}
+
+TEST(ScreenDetector, CacheIgnoredForOtherCameraOrResolution)
+{
+    CacheFile cache("identity");
+    CalibrateInto(cache);
+
+    SH3DS::Capture::ScreenDetector otherCamera(cache.MakeConfig("usb:1"));
+    otherCamera.Detect(MakeDualScreenFrame());
+    EXPECT_FALSE(otherCamera.IsCalibrated());
+
+    SH3DS::Capture::ScreenDetector otherResolution(cache.MakeConfig());
+    auto smallFrame = MakeBlackFrame(1280, 720);
+    DrawBrightRect(smallFrame, { 340, 80 }, { 940, 80 }, { 940, 440 }, { 340, 440 });
+    otherResolution.Detect(smallFrame);
+    EXPECT_FALSE(otherResolution.IsCalibrated());
+}
+
+TEST(ScreenDetector, MovedScreensFallBackToDetection)
+{
+    CacheFile cache("moved");
+    CalibrateInto(cache);
+
+    // The rig was bumped: the saved corners now frame mostly bezel
+    SH3DS::Capture::ScreenDetector detector(cache.MakeConfig());
+    const auto moved = MakeDualScreenFrame(200);
+    const auto result = detector.Detect(moved);
+
+    EXPECT_FALSE(detector.IsCalibrated());
+    EXPECT_FALSE(detector.IsRestoredFromCache());
+    ASSERT_TRUE(result.topScreen.has_value()); // detected in the same frame
+    EXPECT_NEAR(result.topScreen->corners[0].x, 540.0f, 10.0f);
+
+    // Recalibration overwrites the cache with the new position
+    detector.Detect(moved);
+    detector.Detect(moved);
+    ASSERT_TRUE(detector.IsCalibrated());
+    const auto saved = SH3DS::Capture::LoadScreenCalibrationCache(cache.path);
+    ASSERT_TRUE(saved.has_value());
+    EXPECT_NEAR(saved->topCorners[0].x, 540.0f, 10.0f);
+}
+
+TEST(ScreenDetector, DarkFrameDoesNotRestoreCache)
+{
+    CacheFile cache("dark");
+    CalibrateInto(cache);
+
+    SH3DS::Capture::ScreenDetector detector(cache.MakeConfig());
+    detector.Detect(MakeBlackFrame(1280, 960));
+    EXPECT_FALSE(detector.IsCalibrated());
+
+    // The cache is consulted once per start only
+    detector.Detect(MakeDualScreenFrame());
+    EXPECT_FALSE(detector.IsRestoredFromCache());
+}
+
+TEST(ScreenDetector, TrackingFollowsSmallShifts)
+{
+    SH3DS::Capture::ScreenDetectorConfig config;
+    config.calibrationFrames = 100; // keep detecting
+    SH3DS::Capture::ScreenDetector detector(config);
+
+    const auto seeded = detector.Detect(MakeDualScreenFrame());
+    ASSERT_TRUE(seeded.topScreen.has_value());
+    ASSERT_TRUE(seeded.bottomScreen.has_value());
+    EXPECT_TRUE(detector.IsTracking());
+
+    // A shaky mount: the screens wobble by a few pixels per frame
+    for (const int offset : { 3, 7, 4, -2 })
+    {
+        const auto result = detector.Detect(MakeDualScreenFrame(offset));
+        const auto dx = static_cast<float>(offset);
+        EXPECT_TRUE(detector.IsTracking());
+        ASSERT_TRUE(result.topScreen.has_value());
+        ASSERT_TRUE(result.bottomScreen.has_value());
+        EXPECT_FALSE(result.topScreen->held);
+        for (size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_NEAR(result.topScreen->corners[j].x, seeded.topScreen->corners[j].x + dx, 1.0f);
+            EXPECT_NEAR(result.topScreen->corners[j].y, seeded.topScreen->corners[j].y, 1.0f);
+            EXPECT_NEAR(result.bottomScreen->corners[j].x, seeded.bottomScreen->corners[j].x + dx, 1.0f);
+        }
+    }
+}
+
+TEST(ScreenDetector, TrackingFallsBackToDetectionWhenLost)
+{
+    SH3DS::Capture::ScreenDetectorConfig config;
+    config.calibrationFrames = 100;
+    SH3DS::Capture::ScreenDetector detector(config);
+
+    detector.Detect(MakeDualScreenFrame());
+    ASSERT_TRUE(detector.IsTracking());
+
+    // Too far for the patches: contour detection finds the screens again and reseeds from the raw corners
+    const auto moved = MakeDualScreenFrame(200);
+    const auto jumped = detector.Detect(moved);
+    ASSERT_TRUE(jumped.topScreen.has_value());
+    EXPECT_GT(jumped.topScreen->corners[0].x, 340.0f); // EMA catching up
+    EXPECT_TRUE(detector.IsTracking());
+
+    const auto tracked = detector.Detect(moved);
+    ASSERT_TRUE(tracked.topScreen.has_value());
+    EXPECT_NEAR(tracked.topScreen->corners[0].x, 540.0f, 10.0f);
+    EXPECT_TRUE(detector.IsTracking());
+
+    // Screens gone: tracking stops and the smoothed corners are held
+    const auto dark = detector.Detect(MakeBlackFrame(1280, 960));
+    EXPECT_FALSE(detector.IsTracking());
+    ASSERT_TRUE(dark.topScreen.has_value());
+    EXPECT_TRUE(dark.topScreen->held);
+}
+
+TEST(ScreenDetector, TrackingStopsOnCalibrationAndCanBeDisabled)
+{
+    SH3DS::Capture::ScreenDetectorConfig config;
+    config.calibrationFrames = 3;
+    SH3DS::Capture::ScreenDetector detector(config);
+    const auto frame = MakeDualScreenFrame();
+
+    detector.Detect(frame);
+    EXPECT_TRUE(detector.IsTracking());
+    detector.Detect(frame);
+    detector.Detect(frame);
+    EXPECT_TRUE(detector.IsCalibrated());
+    EXPECT_FALSE(detector.IsTracking());
+
+    config.trackCorners = false;
+    SH3DS::Capture::ScreenDetector untracked(config);
+    untracked.Detect(frame);
+    EXPECT_FALSE(untracked.IsTracking());
+}
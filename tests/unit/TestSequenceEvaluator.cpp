@@ -0,0 +1,219 @@
+#include "Core/Types.h"
+#include "Vision/SequenceEvaluator.h"
+#include "Vision/SequenceVoter.h"
+#include "Vision/ShinyDetector.h"
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using SH3DS::Core::ShinyVerdict;
+
+    SH3DS::Core::ShinyResult Vote(ShinyVerdict verdict, double confidence = 1.0)
+    {
+        return { .verdict = verdict, .confidence = confidence, .method = "stub" };
+    }
+
+    /// Returns the verdict encoded in each frame's row count: 1 = NotShiny, 2 = Shiny, 3 = Uncertain.
+    class RowCodedDetector : public SH3DS::Vision::ShinyDetector
+    {
+    public:
+        SH3DS::Core::ShinyResult Detect(const cv::Mat &pokemonRoi) const override
+        {
+            ++detectCalls;
+            if (pokemonRoi.rows == 0)
+            {
+                throw std::runtime_error("empty frame");
+            }
+            return Vote(static_cast<ShinyVerdict>(pokemonRoi.rows - 1));
+        }
+
+        SH3DS::Core::ShinyResult DetectSequence(std::span<const cv::Mat>) const override
+        {
+            return {};
+        }
+
+        std::string ProfileId() const override
+        {
+            return "stub";
+        }
+
+        void Reset() override
+        {
+        }
+
+        mutable std::atomic<int> detectCalls = 0;
+    };
+
+    std::vector<cv::Mat> Frames(const std::vector<ShinyVerdict> &verdicts)
+    {
+        std::vector<cv::Mat> frames;
+        for (const auto verdict : verdicts)
+        {
+            frames.emplace_back(static_cast<int>(verdict) + 1, 4, CV_8UC3);
+        }
+        return frames;
+    }
+} // namespace
+
+TEST(SequenceVoter, MajorityWinsWithMeanConfidence)
+{
+    SH3DS::Vision::SequenceVoter voter(3);
+    voter.Add(Vote(ShinyVerdict::Shiny, 0.8));
+    voter.Add(Vote(ShinyVerdict::NotShiny, 1.0));
+    voter.Add(Vote(ShinyVerdict::Shiny, 0.6));
+
+    const auto result = voter.Result();
+    EXPECT_EQ(result.verdict, ShinyVerdict::Shiny);
+    EXPECT_DOUBLE_EQ(result.confidence, 0.7);
+    EXPECT_EQ(result.method, "stub");
+    EXPECT_EQ(result.Details(), "sequence_majority_vote: count=2/3");
+}
+
+TEST(SequenceVoter, TieGoesToLowestVerdict)
+{
+    SH3DS::Vision::SequenceVoter voter(2);
+    voter.Add(Vote(ShinyVerdict::Shiny));
+    voter.Add(Vote(ShinyVerdict::NotShiny));
+
+    EXPECT_EQ(voter.Result().verdict, ShinyVerdict::NotShiny);
+}
+
+TEST(SequenceVoter, DecidedOnceRemainingFramesCannotChangeWinner)
+{
+    SH3DS::Vision::SequenceVoter voter(5);
+    voter.Add(Vote(ShinyVerdict::NotShiny));
+    voter.Add(Vote(ShinyVerdict::NotShiny));
+    EXPECT_FALSE(voter.IsDecided());
+    voter.Add(Vote(ShinyVerdict::NotShiny));
+    EXPECT_TRUE(voter.IsDecided());
+    EXPECT_EQ(voter.Result().Details(), "sequence_majority_vote: count=3/5 decided_after=3");
+}
+
+TEST(SequenceVoter, TieBreakCountsTowardsDecision)
+{
+    // Shiny leads 2-0 with 2 frames left: NotShiny could tie 2-2 and would win the tie-break.
+    SH3DS::Vision::SequenceVoter shinyLeads(4);
+    shinyLeads.Add(Vote(ShinyVerdict::Shiny));
+    shinyLeads.Add(Vote(ShinyVerdict::Shiny));
+    EXPECT_FALSE(shinyLeads.IsDecided());
+
+    // NotShiny leads 2-0 with 2 frames left: a 2-2 tie still goes to NotShiny.
+    SH3DS::Vision::SequenceVoter notShinyLeads(4);
+    notShinyLeads.Add(Vote(ShinyVerdict::NotShiny));
+    notShinyLeads.Add(Vote(ShinyVerdict::NotShiny));
+    EXPECT_TRUE(notShinyLeads.IsDecided());
+}
+
+TEST(SequenceVoter, EmptyIsUncertain)
+{
+    SH3DS::Vision::SequenceVoter voter(3);
+    EXPECT_FALSE(voter.IsDecided());
+    EXPECT_EQ(voter.Result().verdict, ShinyVerdict::Uncertain);
+    EXPECT_DOUBLE_EQ(voter.Result().confidence, 0.0);
+}
+
+TEST(SequenceEvaluator, MatchesSerialMajorityVote)
+{
+    const auto frames = Frames({ ShinyVerdict::Shiny,
+        ShinyVerdict::NotShiny,
+        ShinyVerdict::Shiny,
+        ShinyVerdict::Uncertain,
+        ShinyVerdict::Shiny,
+        ShinyVerdict::NotShiny });
+
+    RowCodedDetector detector;
+    for (unsigned workers : { 0u, 1u, 3u })
+    {
+        SH3DS::Vision::SequenceEvaluator evaluator(workers);
+        const auto result = evaluator.Evaluate(detector, frames);
+        EXPECT_EQ(result.verdict, ShinyVerdict::Shiny) << "workers=" << workers;
+    }
+}
+
+TEST(SequenceEvaluator, StopsOnceDecided)
+{
+    std::vector<ShinyVerdict> verdicts(15, ShinyVerdict::NotShiny);
+    const auto frames = Frames(verdicts);
+
+    RowCodedDetector detector;
+    SH3DS::Vision::SequenceEvaluator evaluator(0);
+    const auto result = evaluator.Evaluate(detector, frames);
+
+    EXPECT_EQ(result.verdict, ShinyVerdict::NotShiny);
+    EXPECT_EQ(detector.detectCalls, 8);
+}
+
+TEST(SequenceEvaluator, ReusesPoolAcrossSequences)
+{
+    const auto frames = Frames({ ShinyVerdict::Shiny, ShinyVerdict::Shiny, ShinyVerdict::NotShiny });
+
+    RowCodedDetector detector;
+    SH3DS::Vision::SequenceEvaluator evaluator(2);
+    for (int i = 0; i < 50; ++i)
+    {
+        ASSERT_EQ(evaluator.Evaluate(detector, frames).verdict, ShinyVerdict::Shiny);
+    }
+}
+
+TEST(SequenceEvaluator, PropagatesDetectorExceptions)
+{
+    std::vector<cv::Mat> frames = Frames({ ShinyVerdict::Shiny, ShinyVerdict::NotShiny, ShinyVerdict::Shiny });
+    frames.emplace_back();
+
+    RowCodedDetector detector;
+    SH3DS::Vision::SequenceEvaluator evaluator(0);
+    EXPECT_THROW(evaluator.Evaluate(detector, frames), std::runtime_error);
+}
+
+TEST(SequenceEvaluator, EvaluateEachKeepsEveryResult)
+{
+    const std::vector<ShinyVerdict> verdicts = { ShinyVerdict::NotShiny,
+        ShinyVerdict::NotShiny,
+        ShinyVerdict::Shiny,
+        ShinyVerdict::NotShiny,
+        ShinyVerdict::Uncertain };
+    const auto frames = Frames(verdicts);
+
+    for (unsigned workers : { 0u, 1u, 3u })
+    {
+        RowCodedDetector detector;
+        SH3DS::Vision::SequenceEvaluator evaluator(workers);
+        std::vector<SH3DS::Core::ShinyResult> results(frames.size());
+        evaluator.EvaluateEach(detector, frames, results);
+
+        EXPECT_EQ(detector.detectCalls, static_cast<int>(frames.size())) << "workers=" << workers;
+        for (std::size_t i = 0; i < verdicts.size(); ++i)
+        {
+            EXPECT_EQ(results[i].verdict, verdicts[i]) << "workers=" << workers << " slot=" << i;
+        }
+    }
+}
+
+TEST(SequenceEvaluator, EvaluateEachRejectsMismatchedOutput)
+{
+    const auto frames = Frames({ ShinyVerdict::Shiny, ShinyVerdict::NotShiny });
+
+    RowCodedDetector detector;
+    SH3DS::Vision::SequenceEvaluator evaluator(0);
+    std::vector<SH3DS::Core::ShinyResult> results(1);
+    EXPECT_THROW(evaluator.EvaluateEach(detector, frames, results), std::invalid_argument);
+}
+
+TEST(SequenceEvaluator, SharedIsOneEvaluatorForTheProcess)
+{
+    const auto shared = SH3DS::Vision::SequenceEvaluator::Shared();
+    ASSERT_NE(shared, nullptr);
+    EXPECT_EQ(SH3DS::Vision::SequenceEvaluator::Shared(), shared);
+
+    const auto frames = Frames({ ShinyVerdict::Shiny, ShinyVerdict::Shiny, ShinyVerdict::NotShiny });
+    RowCodedDetector detector;
+    EXPECT_EQ(shared->Evaluate(detector, frames).verdict, ShinyVerdict::Shiny);
+}
@@ -0,0 +1,211 @@
+#include "Pipeline/SharedFrameRing.h"
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+    using SH3DS::Pipeline::FrameTelemetry;
+    using SH3DS::Pipeline::kSharedImageCount;
+    using SH3DS::Pipeline::SharedFrameRingReader;
+    using SH3DS::Pipeline::SharedFrameRingWriter;
+    using SH3DS::Pipeline::SharedImage;
+
+    constexpr size_t kRaw = static_cast<size_t>(SharedImage::Raw);
+    constexpr size_t kTop = static_cast<size_t>(SharedImage::Top);
+    constexpr size_t kBottom = static_cast<size_t>(SharedImage::Bottom);
+
+    std::string RingName(const char *test)
+    {
+        return "/sh3ds_test_" + std::to_string(getpid()) + "_" + test;
+    }
+
+    FrameTelemetry MakeTelemetry(uint64_t sequenceNumber)
+    {
+        FrameTelemetry telemetry;
+        telemetry.sequenceNumber = sequenceNumber;
+        telemetry.stateId = 3;
+        std::strncpy(telemetry.stateName.data(), "battle_intro", telemetry.stateName.size() - 1);
+        telemetry.timeInStateMs = 1200;
+        telemetry.encounters = 42;
+        return telemetry;
+    }
+
+    std::array<cv::Mat, kSharedImageCount> MakeImages(int value)
+    {
+        return {
+            cv::Mat(48, 64, CV_8UC3, cv::Scalar(value, value, value)),
+            cv::Mat(24, 40, CV_8UC3, cv::Scalar(value, 0, 0)),
+            cv::Mat(24, 32, CV_8UC3, cv::Scalar(0, value, 0)),
+        };
+    }
+
+    bool SameImage(const cv::Mat &a, const cv::Mat &b)
+    {
+        return a.size() == b.size() && a.type() == b.type() && cv::norm(a, b, cv::NORM_INF) == 0.0;
+    }
+} // namespace
+
+TEST(SharedFrameRing, ReaderSeesLatestFrame)
+{
+    const std::string name = RingName("latest");
+    SharedFrameRingWriter writer(name, 4, 64 * 48 * 3);
+    SharedFrameRingReader reader(name);
+
+    EXPECT_EQ(reader.Published(), 0u);
+    EXPECT_FALSE(reader.Latest().has_value());
+
+    const auto images = MakeImages(100);
+    FrameTelemetry telemetry = MakeTelemetry(7);
+    telemetry.hasShinyResult = 1;
+    telemetry.verdict = SH3DS::Core::ShinyVerdict::Shiny;
+    telemetry.confidence = 0.9;
+    writer.Publish(telemetry, images);
+
+    auto view = reader.Latest();
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->publication, 1u);
+    EXPECT_EQ(view->telemetry.sequenceNumber, 7u);
+    EXPECT_STREQ(view->telemetry.stateName.data(), "battle_intro");
+    EXPECT_EQ(view->telemetry.verdict, SH3DS::Core::ShinyVerdict::Shiny);
+    EXPECT_DOUBLE_EQ(view->telemetry.confidence, 0.9);
+    EXPECT_EQ(view->telemetry.encounters, 42u);
+    EXPECT_TRUE(SameImage(view->images[kRaw], images[kRaw]));
+    EXPECT_TRUE(SameImage(view->images[kTop], images[kTop]));
+    EXPECT_TRUE(SameImage(view->images[kBottom], images[kBottom]));
+    EXPECT_TRUE(reader.IsCurrent(*view));
+
+    writer.Publish(MakeTelemetry(8), MakeImages(101));
+    auto snapshot = reader.CopyLatest();
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_EQ(snapshot->publication, 2u);
+    EXPECT_EQ(snapshot->telemetry.sequenceNumber, 8u);
+    EXPECT_TRUE(SameImage(snapshot->images[kRaw], MakeImages(101)[kRaw]));
+}
+
+TEST(SharedFrameRing, ViewExpiresWhenWriterWrapsAround)
+{
+    const std::string name = RingName("wrap");
+    SharedFrameRingWriter writer(name, 3, 64 * 48 * 3);
+    SharedFrameRingReader reader(name);
+
+    writer.Publish(MakeTelemetry(0), MakeImages(0));
+    auto view = reader.Latest();
+    ASSERT_TRUE(view.has_value());
+
+    writer.Publish(MakeTelemetry(1), MakeImages(1));
+    writer.Publish(MakeTelemetry(2), MakeImages(2));
+    EXPECT_TRUE(reader.IsCurrent(*view)); // other slots were written
+
+    writer.Publish(MakeTelemetry(3), MakeImages(3));
+    EXPECT_FALSE(reader.IsCurrent(*view)); // its slot was reused
+
+    auto latest = reader.Latest();
+    ASSERT_TRUE(latest.has_value());
+    EXPECT_EQ(latest->publication, 4u);
+    EXPECT_EQ(latest->telemetry.sequenceNumber, 3u);
+}
+
+TEST(SharedFrameRing, OversizedAndEmptyImagesArePublishedEmpty)
+{
+    const std::string name = RingName("oversized");
+    SharedFrameRingWriter writer(name, 2, 40 * 24 * 3);
+    SharedFrameRingReader reader(name);
+
+    auto images = MakeImages(50);
+    images[kBottom].release();
+    EXPECT_FALSE(writer.Publish(MakeTelemetry(1), images)); // the drop is reported (and logged)
+
+    auto view = reader.Latest();
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->telemetry.sequenceNumber, 1u);
+    EXPECT_TRUE(view->images[kRaw].empty()); // 64x48 does not fit
+    EXPECT_TRUE(SameImage(view->images[kTop], images[kTop]));
+    EXPECT_TRUE(view->images[kBottom].empty());
+}
+
+TEST(SharedFrameRing, RoiViewsArePacked)
+{
+    const std::string name = RingName("roi");
+    SharedFrameRingWriter writer(name, 2, 64 * 48 * 3);
+    SharedFrameRingReader reader(name);
+
+    cv::Mat large(100, 100, CV_8UC3);
+    cv::RNG(1).fill(large, cv::RNG::UNIFORM, 0, 256);
+    const cv::Mat roi = large(cv::Rect(10, 20, 30, 15));
+    EXPECT_TRUE(writer.Publish(MakeTelemetry(1), { roi, cv::Mat(), cv::Mat() }));
+
+    auto snapshot = reader.CopyLatest();
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_TRUE(SameImage(snapshot->images[kRaw], roi));
+}
+
+TEST(SharedFrameRing, OpeningMissingRingThrows)
+{
+    EXPECT_THROW(SharedFrameRingReader{ RingName("missing") }, std::runtime_error);
+}
+
+TEST(SharedFrameRing, WriterDestructionUnlinksSegment)
+{
+    const std::string name = RingName("unlink");
+    {
+        SharedFrameRingWriter writer(name, 2, 16);
+    }
+    EXPECT_THROW(SharedFrameRingReader{ name }, std::runtime_error);
+}
+
+TEST(SharedFrameRing, ConcurrentReaderNeverSeesTornFrames)
+{
+    const std::string name = RingName("concurrent");
+    SharedFrameRingWriter writer(name, 2, 64 * 48 * 3);
+    SharedFrameRingReader reader(name);
+
+    // Prepared up front so the writer laps the reader as often as possible
+    std::vector<std::array<cv::Mat, kSharedImageCount>> frames;
+    for (int value = 0; value < 256; ++value)
+    {
+        frames.push_back(MakeImages(value));
+    }
+
+    std::atomic<bool> done = false;
+    std::thread publisher([&] {
+        for (uint64_t i = 0; i < 20000; ++i)
+        {
+            writer.Publish(MakeTelemetry(i), frames[i % 256]);
+        }
+        done = true;
+    });
+
+    int checked = 0;
+    int torn = 0;
+    while (!done || checked == 0)
+    {
+        auto snapshot = reader.CopyLatest();
+        if (!snapshot.has_value())
+        {
+            continue;
+        }
+        // Pixels and telemetry always belong to the same publication
+        const int value = static_cast<int>(snapshot->telemetry.sequenceNumber % 256);
+        if (!SameImage(snapshot->images[kRaw], frames[static_cast<size_t>(value)][kRaw])
+            || snapshot->publication != snapshot->telemetry.sequenceNumber + 1)
+        {
+            ++torn;
+        }
+        ++checked;
+    }
+    publisher.join();
+    EXPECT_GT(checked, 0);
+    EXPECT_EQ(torn, 0);
+}
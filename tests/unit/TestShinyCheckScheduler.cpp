@@ -0,0 +1,167 @@
+#include "Core/Types.h"
+#include "Pipeline/ShinyCheckScheduler.h"
+#include "Vision/ShinyDetector.h"
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <span>
+#include <string>
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr SH3DS::Core::StateId kOtherState = 0;
+    constexpr SH3DS::Core::StateId kCheckState = 1;
+
+    class CountingDetector : public SH3DS::Vision::ShinyDetector
+    {
+    public:
+        SH3DS::Core::ShinyResult Detect(const cv::Mat &) const override
+        {
+            ++detectCalls;
+            return { .verdict = SH3DS::Core::ShinyVerdict::NotShiny,
+                .confidence = 1.0,
+                .method = "stub" };
+        }
+
+        SH3DS::Core::ShinyResult DetectSequence(std::span<const cv::Mat> rois) const override
+        {
+            ++sequenceCalls;
+            lastSequenceSize = rois.size();
+            return { .verdict = SH3DS::Core::ShinyVerdict::Shiny,
+                .confidence = 1.0,
+                .method = "stub" };
+        }
+
+        std::string ProfileId() const override
+        {
+            return "stub";
+        }
+
+        void Reset() override
+        {
+        }
+
+        mutable int detectCalls = 0;
+        mutable int sequenceCalls = 0;
+        mutable std::size_t lastSequenceSize = 0;
+    };
+
+    SH3DS::Core::ROISet MakeRois()
+    {
+        SH3DS::Core::ROISet rois;
+        rois["pokemon_sprite"] = cv::Mat(32, 32, CV_8UC3, cv::Scalar(10, 20, 30));
+        return rois;
+    }
+} // namespace
+
+TEST(ShinyCheckScheduler, SkipsDetectionOutsideCheckState)
+{
+    CountingDetector detector;
+    SH3DS::Pipeline::ShinyCheckScheduler scheduler("pokemon_sprite", kCheckState, 0ms, 3);
+    const auto rois = MakeRois();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_FALSE(scheduler.Update(detector, kOtherState, 5000ms, rois).has_value());
+    }
+    EXPECT_EQ(detector.detectCalls, 0);
+    EXPECT_EQ(detector.sequenceCalls, 0);
+    EXPECT_EQ(scheduler.DetectorRuns(), 0u);
+}
+
+TEST(ShinyCheckScheduler, WaitsForDelayBeforeCapturing)
+{
+    CountingDetector detector;
+    SH3DS::Pipeline::ShinyCheckScheduler scheduler("pokemon_sprite", kCheckState, 1500ms, 2);
+    const auto rois = MakeRois();
+
+    EXPECT_FALSE(scheduler.Update(detector, kCheckState, 100ms, rois).has_value());
+    EXPECT_EQ(scheduler.CapturedFrames(), 0u);
+    EXPECT_FALSE(scheduler.Update(detector, kCheckState, 1500ms, rois).has_value());
+    EXPECT_EQ(scheduler.CapturedFrames(), 1u);
+}
+
+TEST(ShinyCheckScheduler, BurstRunsDetectSequenceOnce)
+{
+    CountingDetector detector;
+    SH3DS::Pipeline::ShinyCheckScheduler scheduler("pokemon_sprite", kCheckState, 0ms, 3);
+    const auto rois = MakeRois();
+
+    EXPECT_FALSE(scheduler.Update(detector, kCheckState, 10ms, rois).has_value());
+    EXPECT_FALSE(scheduler.Update(detector, kCheckState, 20ms, rois).has_value());
+    const auto result = scheduler.Update(detector, kCheckState, 30ms, rois);
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->verdict, SH3DS::Core::ShinyVerdict::Shiny);
+    EXPECT_EQ(detector.sequenceCalls, 1);
+    EXPECT_EQ(detector.lastSequenceSize, 3u);
+    EXPECT_EQ(detector.detectCalls, 0);
+
+    // Verdict is held for the rest of the visit without re-running the detector.
+    const auto held = scheduler.Update(detector, kCheckState, 40ms, rois);
+    ASSERT_TRUE(held.has_value());
+    EXPECT_EQ(detector.sequenceCalls, 1);
+}
+
+TEST(ShinyCheckScheduler, StateChangeStartsNewBurst)
+{
+    CountingDetector detector;
+    SH3DS::Pipeline::ShinyCheckScheduler scheduler("pokemon_sprite", kCheckState, 0ms, 2);
+    const auto rois = MakeRois();
+
+    scheduler.Update(detector, kCheckState, 10ms, rois);
+    ASSERT_TRUE(scheduler.Update(detector, kCheckState, 20ms, rois).has_value());
+
+    EXPECT_FALSE(scheduler.Update(detector, kOtherState, 0ms, rois).has_value());
+    EXPECT_FALSE(scheduler.Update(detector, kCheckState, 10ms, rois).has_value());
+    EXPECT_EQ(scheduler.CapturedFrames(), 1u);
+    ASSERT_TRUE(scheduler.Update(detector, kCheckState, 20ms, rois).has_value());
+    EXPECT_EQ(detector.sequenceCalls, 2);
+}
+
+TEST(ShinyCheckScheduler, MissingRoiIsNotCaptured)
+{
+    CountingDetector detector;
+    SH3DS::Pipeline::ShinyCheckScheduler scheduler("pokemon_sprite", kCheckState, 0ms, 2);
+
+    EXPECT_FALSE(scheduler.Update(detector, kCheckState, 10ms, {}).has_value());
+    EXPECT_EQ(scheduler.CapturedFrames(), 0u);
+}
+
+TEST(ShinyCheckScheduler, NoCheckStateDetectsEveryFrame)
+{
+    CountingDetector detector;
+    SH3DS::Pipeline::ShinyCheckScheduler scheduler("pokemon_sprite", SH3DS::Core::kInvalidStateId, 1500ms, 15);
+    const auto rois = MakeRois();
+
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto result = scheduler.Update(detector, kOtherState, 0ms, rois);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->verdict, SH3DS::Core::ShinyVerdict::NotShiny);
+    }
+    EXPECT_EQ(detector.detectCalls, 4);
+    EXPECT_EQ(detector.sequenceCalls, 0);
+}
+
+TEST(ShinyCheckScheduler, NoCheckStateReusesVerdictOnUnchangedFrames)
+{
+    CountingDetector detector;
+    SH3DS::Pipeline::ShinyCheckScheduler scheduler("pokemon_sprite", SH3DS::Core::kInvalidStateId, 1500ms, 15);
+    const auto rois = MakeRois();
+
+    ASSERT_TRUE(scheduler.Update(detector, kOtherState, 0ms, rois).has_value());
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto result = scheduler.Update(detector, kOtherState, 0ms, rois, true);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->verdict, SH3DS::Core::ShinyVerdict::NotShiny);
+    }
+    EXPECT_EQ(detector.detectCalls, 1);
+    EXPECT_EQ(scheduler.DetectorRuns(), 1u);
+}
@@ -130,6 +130,26 @@ TEST(DominantColorDetector, DetectSequenceUsesMajorityVote)
     EXPECT_EQ(result.verdict, SH3DS::Core::ShinyVerdict::Shiny);
 }
 
+TEST(DominantColorDetector, DetectBatchGivesOneVerdictPerSlot)
+{
+    auto config = CreateFroakieConfig();
+    auto detector = SH3DS::Vision::DominantColorDetector::CreateDominantColorDetector(config, "test_froakie");
+
+    // Horde: five sprite slots of one frame, the fourth shiny
+    std::vector<cv::Mat> slots(5, CreateColoredImage(115, 180, 130, 40, 40));
+    slots[3] = CreateColoredImage(115, 60, 220, 40, 40);
+
+    const auto results = detector->DetectBatch(slots);
+    ASSERT_EQ(results.size(), slots.size());
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        EXPECT_EQ(results[i].verdict, detector->Detect(slots[i]).verdict) << "slot=" << i;
+        EXPECT_EQ(results[i].Details(), detector->Detect(slots[i]).Details()) << "slot=" << i;
+    }
+    EXPECT_EQ(results[3].verdict, SH3DS::Core::ShinyVerdict::Shiny);
+    EXPECT_EQ(results[0].verdict, SH3DS::Core::ShinyVerdict::NotShiny);
+}
+
 TEST(DominantColorDetector, NormalAndShinyAreDistinguishable)
 {
     auto config = CreateFroakieConfig();
@@ -1,10 +1,32 @@
+#include "Core/StateRegistry.h"
 #include "Input/InputCommand.h"
 #include "Strategy/SoftResetStrategy.h"
 
 #include <gtest/gtest.h>
 
+#include <memory>
+
 namespace
 {
+    /** @brief Registry standing in for the FSM's; holds every state name the tests tick with. */
+    std::shared_ptr<const SH3DS::Core::StateRegistry> TestStates()
+    {
+        static const auto states = [] {
+            auto registry = std::make_shared<SH3DS::Core::StateRegistry>();
+            for (const auto *name : { "check_state", "any_state", "nav_state", "soft_reset" })
+            {
+                registry->Intern(name);
+            }
+            return registry;
+        }();
+        return states;
+    }
+
+    SH3DS::Core::StateId Id(const std::string &name)
+    {
+        return TestStates()->Find(name);
+    }
+
     SH3DS::Core::HuntConfig MakeConfig(const std::string &shinyCheckState = "check_state", int shinyCheckFrames = 5)
     {
         SH3DS::Core::HuntConfig config;
@@ -35,7 +57,7 @@ TEST(SoftResetStrategy, NullDetectorWaitsWithoutCheckShinyLoop)
     // shinyCheckState is set, but no detector exists — orchestrator always passes nullopt.
     // Strategy should wait for a result and never spam explicit CheckShiny actions.
     auto config = MakeConfig("check_state", 3);
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
     auto noResult = std::optional<SH3DS::Core::ShinyResult>{};
 
@@ -43,7 +65,7 @@ TEST(SoftResetStrategy, NullDetectorWaitsWithoutCheckShinyLoop)
     int waitCount = 0;
     for (int i = 0; i < 20; ++i)
     {
-        auto decision = strategy.Tick("check_state", std::chrono::milliseconds(9999), noResult);
+        auto decision = strategy.Tick(Id("check_state"), std::chrono::milliseconds(9999), noResult);
         if (decision.decision.action == SH3DS::Core::HuntAction::CheckShiny)
         {
             ++checkShinyCount;
@@ -62,13 +84,13 @@ TEST(SoftResetStrategy, EmptyShinyCheckStateSkipsCheck)
 {
     // If shinyCheckState is empty, strategy should never return CheckShiny.
     auto config = MakeConfig("");
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
     auto noResult = std::optional<SH3DS::Core::ShinyResult>{};
 
     for (int i = 0; i < 5; ++i)
     {
-        auto decision = strategy.Tick("any_state", std::chrono::milliseconds(0), noResult);
+        auto decision = strategy.Tick(Id("any_state"), std::chrono::milliseconds(0), noResult);
         EXPECT_NE(decision.decision.action, SH3DS::Core::HuntAction::CheckShiny);
     }
 }
@@ -76,34 +98,30 @@ TEST(SoftResetStrategy, EmptyShinyCheckStateSkipsCheck)
 TEST(SoftResetStrategy, ShinyResultTriggersAlert)
 {
     auto config = MakeConfig("check_state");
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
     SH3DS::Core::ShinyResult shiny{
         .verdict = SH3DS::Core::ShinyVerdict::Shiny,
         .confidence = 0.9,
         .method = "dominant_color",
-        .details = "shiny detected",
-        .debugImage = {},
     };
 
-    auto decision = strategy.Tick("check_state", std::chrono::milliseconds(9999), shiny);
+    auto decision = strategy.Tick(Id("check_state"), std::chrono::milliseconds(9999), shiny);
     EXPECT_EQ(decision.decision.action, SH3DS::Core::HuntAction::AlertShiny);
 }
 
 TEST(SoftResetStrategy, NotShinyResultContinues)
 {
     auto config = MakeConfig("check_state");
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
     SH3DS::Core::ShinyResult notShiny{
         .verdict = SH3DS::Core::ShinyVerdict::NotShiny,
         .confidence = 0.95,
         .method = "dominant_color",
-        .details = "not shiny",
-        .debugImage = {},
     };
 
-    auto decision = strategy.Tick("check_state", std::chrono::milliseconds(9999), notShiny);
+    auto decision = strategy.Tick(Id("check_state"), std::chrono::milliseconds(9999), notShiny);
     // After NotShiny verdict, strategy falls through to action lookup (no actions -> Wait)
     EXPECT_NE(decision.decision.action, SH3DS::Core::HuntAction::CheckShiny);
     EXPECT_NE(decision.decision.action, SH3DS::Core::HuntAction::AlertShiny);
@@ -112,58 +130,50 @@ TEST(SoftResetStrategy, NotShinyResultContinues)
 TEST(SoftResetStrategy, ShinyCheckResolvesOncePerStateEntry)
 {
     auto config = MakeConfig("check_state");
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
     SH3DS::Core::ShinyResult notShiny{
         .verdict = SH3DS::Core::ShinyVerdict::NotShiny,
         .confidence = 0.95,
         .method = "dominant_color",
-        .details = "not shiny",
-        .debugImage = {},
     };
     SH3DS::Core::ShinyResult shiny{
         .verdict = SH3DS::Core::ShinyVerdict::Shiny,
         .confidence = 0.99,
         .method = "dominant_color",
-        .details = "shiny",
-        .debugImage = {},
     };
 
     // First result resolves check for this state entry.
-    auto first = strategy.Tick("check_state", std::chrono::milliseconds(9999), notShiny);
+    auto first = strategy.Tick(Id("check_state"), std::chrono::milliseconds(9999), notShiny);
     EXPECT_NE(first.decision.action, SH3DS::Core::HuntAction::AlertShiny);
 
     // Subsequent frames in the same state should not re-evaluate shiny result.
-    auto second = strategy.Tick("check_state", std::chrono::milliseconds(9999), shiny);
+    auto second = strategy.Tick(Id("check_state"), std::chrono::milliseconds(9999), shiny);
     EXPECT_NE(second.decision.action, SH3DS::Core::HuntAction::AlertShiny);
 }
 
 TEST(SoftResetStrategy, ResetClearsShinyCheckResolution)
 {
     auto config = MakeConfig("check_state");
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
     SH3DS::Core::ShinyResult shiny{
         .verdict = SH3DS::Core::ShinyVerdict::Shiny,
         .confidence = 0.99,
         .method = "dominant_color",
-        .details = "shiny",
-        .debugImage = {},
     };
     SH3DS::Core::ShinyResult notShiny{
         .verdict = SH3DS::Core::ShinyVerdict::NotShiny,
         .confidence = 0.95,
         .method = "dominant_color",
-        .details = "not shiny",
-        .debugImage = {},
     };
 
     // Resolve state once as NotShiny.
-    strategy.Tick("check_state", std::chrono::milliseconds(9999), notShiny);
+    strategy.Tick(Id("check_state"), std::chrono::milliseconds(9999), notShiny);
 
     // Reset should allow a fresh determination.
     strategy.Reset();
-    auto decision = strategy.Tick("check_state", std::chrono::milliseconds(9999), shiny);
+    auto decision = strategy.Tick(Id("check_state"), std::chrono::milliseconds(9999), shiny);
     EXPECT_EQ(decision.decision.action, SH3DS::Core::HuntAction::AlertShiny);
 }
 
@@ -171,20 +181,35 @@ TEST(SoftResetStrategy, KnownButtonNameProducesCorrectBits)
 {
     // D_RIGHT = 0x0010 (per InputCommand.h). A config using "D_RIGHT" must produce non-zero bits.
     auto config = MakeConfigWithAction("nav_state", { "D_RIGHT" });
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
-    auto decision = strategy.Tick("nav_state", std::chrono::milliseconds(0), std::nullopt);
+    auto decision = strategy.Tick(Id("nav_state"), std::chrono::milliseconds(0), std::nullopt);
     ASSERT_EQ(decision.decision.action, SH3DS::Core::HuntAction::SendInput);
     EXPECT_EQ(decision.command.buttonsPressed, static_cast<uint32_t>(SH3DS::Input::Button::DRight));
 }
 
+TEST(SoftResetStrategy, DecisionsReferToTheStateByIdNotByName)
+{
+    SH3DS::Strategy::SoftResetStrategy strategy(MakeConfigWithAction("nav_state", { "A" }), TestStates());
+
+    auto pressing = strategy.Tick(Id("nav_state"), std::chrono::milliseconds(0), std::nullopt);
+    ASSERT_EQ(pressing.decision.action, SH3DS::Core::HuntAction::SendInput);
+    EXPECT_EQ(pressing.decision.reason, "pressing buttons for state");
+    EXPECT_EQ(pressing.decision.state, Id("nav_state"));
+
+    auto idle = strategy.Tick(Id("any_state"), std::chrono::milliseconds(0), std::nullopt);
+    ASSERT_EQ(idle.decision.action, SH3DS::Core::HuntAction::Wait);
+    EXPECT_EQ(idle.decision.reason, "no actions for state");
+    EXPECT_EQ(idle.decision.state, Id("any_state"));
+}
+
 TEST(SoftResetStrategy, UnknownButtonNameProducesZeroBits)
 {
     // "DPAD_RIGHT" is the old wrong alias — should produce 0 bits (LOG_WARN emitted).
     auto config = MakeConfigWithAction("nav_state", { "DPAD_RIGHT" });
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
-    auto decision = strategy.Tick("nav_state", std::chrono::milliseconds(0), std::nullopt);
+    auto decision = strategy.Tick(Id("nav_state"), std::chrono::milliseconds(0), std::nullopt);
     ASSERT_EQ(decision.decision.action, SH3DS::Core::HuntAction::SendInput);
     EXPECT_EQ(decision.command.buttonsPressed, 0u);
 }
@@ -193,11 +218,24 @@ TEST(SoftResetStrategy, MultipleKnownButtonsCombineCorrectly)
 {
     // L + R + START used for soft reset = 0x0200 | 0x0100 | 0x0008 = 0x0308
     auto config = MakeConfigWithAction("soft_reset", { "L", "R", "START" });
-    SH3DS::Strategy::SoftResetStrategy strategy(config);
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
 
-    auto decision = strategy.Tick("soft_reset", std::chrono::milliseconds(0), std::nullopt);
+    auto decision = strategy.Tick(Id("soft_reset"), std::chrono::milliseconds(0), std::nullopt);
     ASSERT_EQ(decision.decision.action, SH3DS::Core::HuntAction::SendInput);
     EXPECT_EQ(decision.command.buttonsPressed,
         static_cast<uint32_t>(SH3DS::Input::Button::L) | static_cast<uint32_t>(SH3DS::Input::Button::R)
             | static_cast<uint32_t>(SH3DS::Input::Button::Start));
 }
+
+TEST(SoftResetStrategy, ActionsForUnknownStateAreIgnored)
+{
+    // Config names that the FSM never interned cannot be reached; they must not alias another state.
+    auto config = MakeConfigWithAction("not_in_fsm", { "A" });
+    SH3DS::Strategy::SoftResetStrategy strategy(config, TestStates());
+
+    for (const auto *name : { "check_state", "any_state", "nav_state", "soft_reset" })
+    {
+        auto decision = strategy.Tick(Id(name), std::chrono::milliseconds(0), std::nullopt);
+        EXPECT_EQ(decision.decision.action, SH3DS::Core::HuntAction::Wait) << name;
+    }
+}
@@ -0,0 +1,156 @@
+#include "Core/Config.h"
+#include "Vision/SparkleDetector.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using SH3DS::Core::ShinyVerdict;
+    using SH3DS::Vision::SparkleDetector;
+
+    SH3DS::Core::DetectionMethodConfig CreateSparkleConfig()
+    {
+        SH3DS::Core::DetectionMethodConfig config;
+        config.method = "sparkle";
+        config.brightnessThreshold = 240;
+        config.minBrightPixelRatio = 0.01;
+        config.minConsecutiveFrames = 3;
+        return config;
+    }
+
+    /// 100x100 dark frame; with `sparkle` a 16x16 white patch (2.56% of the pixels) is drawn in.
+    cv::Mat CreateFrame(bool sparkle)
+    {
+        cv::Mat frame(100, 100, CV_8UC3, cv::Scalar(40, 60, 80));
+        if (sparkle)
+        {
+            cv::rectangle(frame, cv::Rect(10, 10, 16, 16), cv::Scalar(255, 255, 255), cv::FILLED);
+        }
+        return frame;
+    }
+
+    uint32_t ReferenceCount(const cv::Mat &bgr, int threshold)
+    {
+        std::vector<cv::Mat> channels;
+        cv::split(bgr, channels);
+        cv::Mat value;
+        cv::max(channels[0], channels[1], value);
+        cv::max(value, channels[2], value);
+        return static_cast<uint32_t>(cv::countNonZero(value >= threshold));
+    }
+} // namespace
+
+TEST(SparkleDetector, CountBrightPixelsMatchesReference)
+{
+    // Wide enough to cross the kernel's 8-bit counter widening, plus a ragged tail and a non-continuous view.
+    cv::Mat image(37, 4133, CV_8UC3);
+    cv::RNG rng(11);
+    rng.fill(image, cv::RNG::UNIFORM, 200, 256);
+    const cv::Mat view = image(cv::Rect(3, 2, 4101, 31));
+
+    for (int threshold : { 0, 1, 200, 240, 255, 256 })
+    {
+        EXPECT_EQ(SparkleDetector::CountBrightPixels(image, threshold), ReferenceCount(image, threshold));
+        EXPECT_EQ(SparkleDetector::CountBrightPixels(view, threshold), ReferenceCount(view, threshold));
+    }
+}
+
+TEST(SparkleDetector, CountBrightPixelsRejectsNonBgr)
+{
+    EXPECT_EQ(SparkleDetector::CountBrightPixels(cv::Mat(), 240), 0u);
+    EXPECT_THROW(SparkleDetector::CountBrightPixels(cv::Mat(4, 4, CV_8UC1, cv::Scalar(255)), 240),
+        std::runtime_error);
+}
+
+TEST(SparkleDetector, ConsecutiveSparkleFramesLatchShiny)
+{
+    SparkleDetector detector(CreateSparkleConfig(), "test");
+
+    EXPECT_EQ(detector.Detect(CreateFrame(false)).verdict, ShinyVerdict::NotShiny);
+    EXPECT_EQ(detector.Detect(CreateFrame(true)).verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(detector.Detect(CreateFrame(true)).verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(detector.Detect(CreateFrame(true)).verdict, ShinyVerdict::Shiny);
+
+    // Latched after the sparkle has finished.
+    EXPECT_EQ(detector.Detect(CreateFrame(false)).verdict, ShinyVerdict::Shiny);
+
+    detector.Reset();
+    EXPECT_EQ(detector.Detect(CreateFrame(false)).verdict, ShinyVerdict::NotShiny);
+}
+
+TEST(SparkleDetector, BrokenRunDoesNotLatch)
+{
+    SparkleDetector detector(CreateSparkleConfig(), "test");
+
+    for (bool sparkle : { true, true, false, true, true, false })
+    {
+        EXPECT_NE(detector.Detect(CreateFrame(sparkle)).verdict, ShinyVerdict::Shiny);
+    }
+}
+
+TEST(SparkleDetector, SequenceFindsRunInOrder)
+{
+    SparkleDetector detector(CreateSparkleConfig(), "test");
+
+    std::vector<cv::Mat> shiny;
+    for (bool sparkle : { false, true, true, true, false })
+    {
+        shiny.push_back(CreateFrame(sparkle));
+    }
+    EXPECT_EQ(detector.DetectSequence(shiny).verdict, ShinyVerdict::Shiny);
+
+    std::vector<cv::Mat> normal;
+    for (bool sparkle : { true, true, false, true, true })
+    {
+        normal.push_back(CreateFrame(sparkle));
+    }
+    EXPECT_EQ(detector.DetectSequence(normal).verdict, ShinyVerdict::NotShiny);
+
+    const std::vector<cv::Mat> tooShort = { CreateFrame(false), CreateFrame(false) };
+    EXPECT_EQ(detector.DetectSequence(tooShort).verdict, ShinyVerdict::Uncertain);
+}
+
+TEST(SparkleDetector, BatchScoresSlotsWithoutTouchingTheRun)
+{
+    SparkleDetector detector(CreateSparkleConfig(), "test");
+    EXPECT_EQ(detector.Detect(CreateFrame(true)).verdict, ShinyVerdict::Uncertain); // run = 1
+
+    // Five bright horde slots in one frame: more than min_consecutive_frames, but not a run.
+    const std::vector<cv::Mat> slots(5, CreateFrame(true));
+    for (const auto &result : detector.DetectBatch(slots))
+    {
+        EXPECT_EQ(result.verdict, ShinyVerdict::Uncertain);
+    }
+    const std::vector<cv::Mat> mixed = { CreateFrame(false), cv::Mat(), CreateFrame(true) };
+    const auto mixedResults = detector.DetectBatch(mixed);
+    ASSERT_EQ(mixedResults.size(), mixed.size());
+    EXPECT_EQ(mixedResults[0].verdict, ShinyVerdict::NotShiny);
+    EXPECT_EQ(mixedResults[1].verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(mixedResults[2].verdict, ShinyVerdict::Uncertain);
+
+    // The run continues from where Detect() left it: two more frames complete it, not zero.
+    EXPECT_EQ(detector.Detect(CreateFrame(true)).verdict, ShinyVerdict::Uncertain);
+    EXPECT_EQ(detector.Detect(CreateFrame(true)).verdict, ShinyVerdict::Shiny);
+
+    detector.Reset();
+    EXPECT_EQ(detector.Detect(CreateFrame(false)).verdict, ShinyVerdict::NotShiny);
+}
+
+TEST(SparkleDetector, BatchGivesShinyWhenOneFrameIsARun)
+{
+    auto config = CreateSparkleConfig();
+    config.minConsecutiveFrames = 1;
+    SparkleDetector detector(config, "test");
+
+    const std::vector<cv::Mat> slots = { CreateFrame(false), CreateFrame(true) };
+    const auto results = detector.DetectBatch(slots);
+    EXPECT_EQ(results[0].verdict, ShinyVerdict::NotShiny);
+    EXPECT_EQ(results[1].verdict, ShinyVerdict::Shiny);
+    EXPECT_EQ(detector.Detect(CreateFrame(false)).verdict, ShinyVerdict::NotShiny);
+}
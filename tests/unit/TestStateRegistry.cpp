@@ -0,0 +1,45 @@
+#include "Core/StateRegistry.h"
+
+#include <gtest/gtest.h>
+
+TEST(StateRegistry, InternAssignsDenseIdsInOrder)
+{
+    SH3DS::Core::StateRegistry registry;
+    EXPECT_EQ(registry.Intern("load_game"), 0u);
+    EXPECT_EQ(registry.Intern("game_start"), 1u);
+    EXPECT_EQ(registry.Intern("starter_pick"), 2u);
+    EXPECT_EQ(registry.Size(), 3u);
+}
+
+TEST(StateRegistry, InternIsIdempotent)
+{
+    SH3DS::Core::StateRegistry registry;
+    const auto first = registry.Intern("party_menu");
+    const auto second = registry.Intern("party_menu");
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(registry.Size(), 1u);
+}
+
+TEST(StateRegistry, FindDoesNotIntern)
+{
+    SH3DS::Core::StateRegistry registry;
+    registry.Intern("load_game");
+    EXPECT_EQ(registry.Find("load_game"), 0u);
+    EXPECT_EQ(registry.Find("unknown_state"), SH3DS::Core::kInvalidStateId);
+    EXPECT_EQ(registry.Size(), 1u);
+}
+
+TEST(StateRegistry, NameRoundTrips)
+{
+    SH3DS::Core::StateRegistry registry;
+    const auto id = registry.Intern("pokemon_summary");
+    EXPECT_EQ(registry.Name(id), "pokemon_summary");
+}
+
+TEST(StateRegistry, NameOfInvalidIdIsPlaceholder)
+{
+    SH3DS::Core::StateRegistry registry;
+    registry.Intern("load_game");
+    EXPECT_EQ(registry.Name(SH3DS::Core::kInvalidStateId), "<invalid>");
+    EXPECT_EQ(registry.Name(5), "<invalid>");
+}
@@ -0,0 +1,106 @@
+#include "Vision/TemplateMatcher.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    cv::Mat CreateNoiseImage(int width, int height, uint64_t seed)
+    {
+        cv::Mat image(height, width, CV_8UC3);
+        cv::RNG rng(seed);
+        rng.fill(image, cv::RNG::UNIFORM, 0, 256);
+        return image;
+    }
+
+    double LegacyMatch(const cv::Mat &region, const cv::Mat &tmpl)
+    {
+        cv::Mat resized;
+        cv::resize(tmpl, resized, region.size());
+        cv::Mat result;
+        cv::matchTemplate(region, resized, result, cv::TM_CCORR_NORMED);
+        double maxVal;
+        cv::minMaxLoc(result, nullptr, &maxVal);
+        return maxVal;
+    }
+
+    class TemplateMatcherTest : public ::testing::Test
+    {
+    protected:
+        std::string WriteTemplate(const std::string &name, const cv::Mat &image)
+        {
+            auto path = std::filesystem::temp_directory_path() / ("sh3ds_test_template_" + name + ".png");
+            cv::imwrite(path.string(), image);
+            written.push_back(path);
+            return path.string();
+        }
+
+        void TearDown() override
+        {
+            for (const auto &path : written)
+            {
+                std::filesystem::remove(path);
+            }
+        }
+
+        std::vector<std::filesystem::path> written;
+    };
+
+} // namespace
+
+TEST_F(TemplateMatcherTest, EqualSizeFastPathMatchesOpenCV)
+{
+    const cv::Mat tmpl = CreateNoiseImage(120, 80, 1);
+    const cv::Mat region = CreateNoiseImage(120, 80, 2);
+    const auto path = WriteTemplate("equal", tmpl);
+
+    SH3DS::Vision::TemplateMatcher matcher;
+    EXPECT_NEAR(matcher.Match(region, path), LegacyMatch(region, tmpl), 1e-5);
+    EXPECT_NEAR(matcher.Match(tmpl, path), 1.0, 1e-9);
+}
+
+TEST_F(TemplateMatcherTest, LargerTemplateIsResizedOnceAndMatchesLegacy)
+{
+    const cv::Mat tmpl = CreateNoiseImage(200, 120, 3);
+    const cv::Mat region = CreateNoiseImage(100, 60, 4);
+    const auto path = WriteTemplate("larger", tmpl);
+
+    SH3DS::Vision::TemplateMatcher matcher;
+    const double expected = LegacyMatch(region, tmpl);
+    EXPECT_NEAR(matcher.Match(region, path), expected, 1e-5);
+    // Second call hits the (path, size) cache and must give the same answer.
+    EXPECT_NEAR(matcher.Match(region, path), expected, 1e-5);
+}
+
+TEST_F(TemplateMatcherTest, SmallerTemplateIsFoundBySlidingSearch)
+{
+    cv::Mat region = CreateNoiseImage(160, 100, 5);
+    const cv::Mat tmpl = region(cv::Rect(70, 30, 40, 30)).clone();
+    const auto path = WriteTemplate("smaller", tmpl);
+
+    SH3DS::Vision::TemplateMatcher matcher;
+    EXPECT_NEAR(matcher.Match(region, path), 1.0, 1e-5);
+}
+
+TEST_F(TemplateMatcherTest, MissingTemplateScoresZero)
+{
+    SH3DS::Vision::TemplateMatcher matcher;
+    const cv::Mat region = CreateNoiseImage(64, 48, 6);
+    EXPECT_DOUBLE_EQ(matcher.Match(region, "does/not/exist.png"), 0.0);
+    EXPECT_DOUBLE_EQ(matcher.Match(region, "does/not/exist.png"), 0.0);
+}
+
+TEST_F(TemplateMatcherTest, BlackRegionScoresZero)
+{
+    const auto path = WriteTemplate("black", CreateNoiseImage(64, 48, 7));
+    SH3DS::Vision::TemplateMatcher matcher;
+    EXPECT_DOUBLE_EQ(matcher.Match(cv::Mat(48, 64, CV_8UC3, cv::Scalar::all(0)), path), 0.0);
+}
@@ -0,0 +1,189 @@
+// Needs an OpenGL 3.3 context. Without a display the tests are skipped; in headless CI run them on Mesa's
+// software rasterizer, e.g. `LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ctest -R TestTextureUploader`.
+
+#include "App/TextureUploader.h"
+
+#include <opencv2/core.hpp>
+
+// clang-format off
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+// clang-format on
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    class TextureUploaderTest : public ::testing::Test
+    {
+    protected:
+        static void SetUpTestSuite()
+        {
+            if (!glfwInit())
+            {
+                return;
+            }
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+            window = glfwCreateWindow(16, 16, "TestTextureUploader", nullptr, nullptr);
+            if (!window)
+            {
+                return;
+            }
+            glfwMakeContextCurrent(window);
+            if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+            {
+                glfwDestroyWindow(window);
+                window = nullptr;
+            }
+        }
+
+        static void TearDownTestSuite()
+        {
+            if (window)
+            {
+                glfwDestroyWindow(window);
+                window = nullptr;
+            }
+            glfwTerminate();
+        }
+
+        void SetUp() override
+        {
+            if (!window)
+            {
+                GTEST_SKIP() << "No OpenGL 3.3 context available";
+            }
+        }
+
+        /**
+         * @brief Reads the texture back as tightly packed pixels in the given format.
+         */
+        static std::vector<uchar> ReadBack(const SH3DS::App::TextureUploader &texture, GLenum format, int channels)
+        {
+            std::vector<uchar> pixels(static_cast<size_t>(texture.GetWidth() * texture.GetHeight() * channels));
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glBindTexture(GL_TEXTURE_2D, texture.GetTextureId());
+            glGetTexImage(GL_TEXTURE_2D, 0, format, GL_UNSIGNED_BYTE, pixels.data());
+            glBindTexture(GL_TEXTURE_2D, 0);
+            return pixels;
+        }
+
+        static std::vector<uchar> Packed(const cv::Mat &mat)
+        {
+            const cv::Mat continuous = mat.isContinuous() ? mat : mat.clone();
+            return std::vector<uchar>(continuous.data, continuous.data + continuous.total() * continuous.elemSize());
+        }
+
+        static cv::Mat MakeImage(int width, int height, int type, int seed)
+        {
+            cv::Mat image(height, width, type);
+            cv::RNG(static_cast<uint64_t>(seed)).fill(image, cv::RNG::UNIFORM, 0, 256);
+            return image;
+        }
+
+        static inline GLFWwindow *window = nullptr;
+    };
+} // namespace
+
+TEST_F(TextureUploaderTest, UploadsBgrWithoutConversion)
+{
+    SH3DS::App::TextureUploader texture;
+    const cv::Mat image = MakeImage(7, 5, CV_8UC3, 1); // odd row length exercises unpack alignment
+
+    ASSERT_TRUE(texture.Upload(image));
+    EXPECT_EQ(texture.GetWidth(), 7);
+    EXPECT_EQ(texture.GetHeight(), 5);
+    EXPECT_EQ(ReadBack(texture, GL_BGR, 3), Packed(image));
+    EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+}
+
+TEST_F(TextureUploaderTest, UploadsBgraAndGray)
+{
+    SH3DS::App::TextureUploader bgra;
+    const cv::Mat colour = MakeImage(9, 4, CV_8UC4, 2);
+    ASSERT_TRUE(bgra.Upload(colour));
+    EXPECT_EQ(ReadBack(bgra, GL_BGRA, 4), Packed(colour));
+
+    SH3DS::App::TextureUploader gray;
+    const cv::Mat mono = MakeImage(5, 3, CV_8UC1, 3);
+    ASSERT_TRUE(gray.Upload(mono));
+    EXPECT_EQ(ReadBack(gray, GL_RED, 1), Packed(mono));
+}
+
+TEST_F(TextureUploaderTest, UploadsRoiViews)
+{
+    SH3DS::App::TextureUploader texture;
+    const cv::Mat image = MakeImage(40, 30, CV_8UC3, 4);
+    const cv::Mat view = image(cv::Rect(3, 5, 11, 7));
+
+    ASSERT_TRUE(texture.Upload(view));
+    EXPECT_EQ(ReadBack(texture, GL_BGR, 3), Packed(view));
+}
+
+TEST_F(TextureUploaderTest, SkipsUnchangedGeneration)
+{
+    SH3DS::App::TextureUploader texture;
+    const cv::Mat image = MakeImage(8, 8, CV_8UC3, 5);
+
+    EXPECT_TRUE(texture.Upload(image, 1));
+    EXPECT_FALSE(texture.Upload(image, 1));
+    EXPECT_FALSE(texture.Upload(cv::Mat(image), 1)); // another header on the same buffer
+
+    const cv::Mat copy = image.clone();
+    EXPECT_TRUE(texture.Upload(copy, 1));
+
+    texture.Invalidate();
+    EXPECT_TRUE(texture.Upload(copy, 1));
+}
+
+TEST_F(TextureUploaderTest, UploadsBufferRewrittenInPlace)
+{
+    SH3DS::App::TextureUploader texture;
+    cv::Mat image = MakeImage(8, 8, CV_8UC3, 9);
+
+    ASSERT_TRUE(texture.Upload(image, 1));
+    image.setTo(cv::Scalar(1, 2, 3));
+
+    // The producer bumps the generation after rewriting its buffer
+    ASSERT_TRUE(texture.Upload(image, 2));
+    EXPECT_EQ(ReadBack(texture, GL_BGR, 3), Packed(image));
+
+    // Without a generation every upload transfers
+    image.setTo(cv::Scalar(4, 5, 6));
+    ASSERT_TRUE(texture.Upload(image));
+    ASSERT_TRUE(texture.Upload(image));
+    EXPECT_EQ(ReadBack(texture, GL_BGR, 3), Packed(image));
+}
+
+TEST_F(TextureUploaderTest, FollowsSizeChangesAcrossBuffers)
+{
+    SH3DS::App::TextureUploader texture;
+    const cv::Mat small = MakeImage(4, 3, CV_8UC3, 6);
+    const cv::Mat large = MakeImage(32, 24, CV_8UC3, 7);
+    const cv::Mat other = MakeImage(32, 24, CV_8UC3, 8);
+
+    ASSERT_TRUE(texture.Upload(small));
+    ASSERT_TRUE(texture.Upload(large));
+    ASSERT_TRUE(texture.Upload(other));
+    ASSERT_TRUE(texture.Upload(small));
+    EXPECT_EQ(texture.GetWidth(), 4);
+    EXPECT_EQ(texture.GetHeight(), 3);
+    EXPECT_EQ(ReadBack(texture, GL_BGR, 3), Packed(small));
+
+    ASSERT_TRUE(texture.Upload(other));
+    EXPECT_EQ(ReadBack(texture, GL_BGR, 3), Packed(other));
+}
+
+TEST_F(TextureUploaderTest, RejectsUnsupportedImages)
+{
+    SH3DS::App::TextureUploader texture;
+    EXPECT_FALSE(texture.Upload(cv::Mat()));
+    EXPECT_FALSE(texture.Upload(cv::Mat(4, 4, CV_32FC3)));
+    EXPECT_FALSE(texture.Upload(cv::Mat(4, 4, CV_8UC2)));
+    EXPECT_EQ(texture.GetWidth(), 0);
+}
@@ -0,0 +1,514 @@
+#include "Capture/FramePreprocessor.h"
+#include "Capture/FrameSource.h"
+#include "Core/Config.h"
+#include "Core/Constants.h"
+#include "Core/StateRegistry.h"
+#include "Core/Types.h"
+#include "FSM/CXXStateTreeFSM.h"
+#include "FSM/GameStateFSM.h"
+#include "Pipeline/Orchestrator.h"
+#include "Strategy/HuntStrategy.h"
+
+#include <gtest/gtest.h>
+#include <opencv2/core/utility.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ── Counting allocator hooks ────────────────────────────────────────────────
+
+namespace
+{
+    thread_local bool countHeap = false;     ///< Count operator new on this thread
+    std::atomic<uint64_t> heapAllocations{}; ///< operator new calls while counting
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    if (countHeap)
+    {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    /**
+     * @brief Counts every operator new on the calling thread while alive.
+     */
+    class HeapCounter
+    {
+    public:
+        HeapCounter() : start(heapAllocations.load())
+        {
+            countHeap = true;
+        }
+
+        ~HeapCounter()
+        {
+            countHeap = false;
+        }
+
+        uint64_t Count() const
+        {
+            return heapAllocations.load() - start;
+        }
+
+    private:
+        uint64_t start;
+    };
+
+    /**
+     * @brief cv::Mat allocator that counts image buffers of at least minBytes and forwards to the previous default.
+     *
+     * Installed as the default allocator while alive. The size floor separates per-frame images from the small
+     * scratch OpenCV itself allocates inside warpPerspective, CLAHE and friends, which the tick cannot own.
+     */
+    class CountingMatAllocator : public cv::MatAllocator
+    {
+    public:
+        explicit CountingMatAllocator(std::size_t minBytes)
+            : inner(cv::Mat::getDefaultAllocator()),
+              minBytes(minBytes)
+        {
+            cv::Mat::setDefaultAllocator(this);
+        }
+
+        ~CountingMatAllocator() override
+        {
+            cv::Mat::setDefaultAllocator(inner);
+        }
+
+        CountingMatAllocator(const CountingMatAllocator &) = delete;
+        CountingMatAllocator &operator=(const CountingMatAllocator &) = delete;
+
+        cv::UMatData *allocate(int dims,
+            const int *sizes,
+            int type,
+            void *data,
+            size_t *step,
+            cv::AccessFlag flags,
+            cv::UMatUsageFlags usageFlags) const override
+        {
+            auto bytes = static_cast<std::size_t>(CV_ELEM_SIZE(type));
+            for (int i = 0; i < dims; ++i)
+            {
+                bytes *= static_cast<std::size_t>(sizes[i]);
+            }
+            if (!data && bytes >= minBytes)
+            {
+                allocations.fetch_add(1, std::memory_order_relaxed);
+            }
+            return inner->allocate(dims, sizes, type, data, step, flags, usageFlags);
+        }
+
+        bool allocate(cv::UMatData *data, cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override
+        {
+            return inner->allocate(data, flags, usageFlags);
+        }
+
+        void deallocate(cv::UMatData *data) const override
+        {
+            inner->deallocate(data);
+        }
+
+        uint64_t Count() const
+        {
+            return allocations.load();
+        }
+
+    private:
+        cv::MatAllocator *inner;                       ///< Allocator that owns the buffers
+        std::size_t minBytes;                          ///< Smallest buffer counted
+        mutable std::atomic<uint64_t> allocations = 0; ///< Counted buffer allocations
+    };
+
+    /// One 8-bit plane of the smaller (bottom) screen: every per-frame image is at least this large.
+    constexpr auto kFrameBufferBytes =
+        static_cast<std::size_t>(SH3DS::Core::kBottomScreenWidth * SH3DS::Core::kBottomScreenHeight);
+
+    /// Ticks that may still size buffers: both results of the warp/analysis swap are sized after two changed frames.
+    constexpr std::size_t kWarmupTicks = 4;
+
+    /// Ticks of the replay.
+    constexpr std::size_t kReplayTicks = 24;
+
+    // ── Dual-screen camera layout (400x480: top screen above bottom screen) ──
+
+    std::unique_ptr<SH3DS::Capture::FramePreprocessor> MakeDualScreenPreprocessor()
+    {
+        SH3DS::Core::ScreenCalibrationConfig top;
+        top.corners = {
+            cv::Point2f(0.0f, 0.0f),
+            cv::Point2f(399.0f, 0.0f),
+            cv::Point2f(399.0f, 239.0f),
+            cv::Point2f(0.0f, 239.0f),
+        };
+        SH3DS::Core::ScreenCalibrationConfig bottom;
+        bottom.targetWidth = SH3DS::Core::kBottomScreenWidth;
+        bottom.targetHeight = SH3DS::Core::kBottomScreenHeight;
+        bottom.corners = {
+            cv::Point2f(40.0f, 240.0f),
+            cv::Point2f(359.0f, 240.0f),
+            cv::Point2f(359.0f, 479.0f),
+            cv::Point2f(40.0f, 479.0f),
+        };
+        std::vector<SH3DS::Core::RoiDefinition> rois = {
+            { .name = "pokemon_sprite", .x = 0.25, .y = 0.25, .w = 0.5, .h = 0.5 },
+            { .name = "dialogue_box", .x = 0.0, .y = 0.75, .w = 1.0, .h = 0.25 },
+        };
+        return std::make_unique<SH3DS::Capture::FramePreprocessor>(top, rois, bottom);
+    }
+
+    cv::Mat MakeCameraFrame(int shade)
+    {
+        cv::Mat image(480, 400, CV_8UC3, cv::Scalar(0, 0, 0));
+        for (int x = 0; x < 400; ++x)
+        {
+            image(cv::Rect(x, 0, 1, 240)).setTo(cv::Scalar(shade, x / 2, 255 - shade));
+        }
+        image(cv::Rect(40, 240, 320, 240)).setTo(cv::Scalar(shade / 2, shade, 90));
+        return image;
+    }
+
+    // ── Replay source: copies recorded frames into the caller's frame ────────
+
+    class ReplayFrameSource : public SH3DS::Capture::FrameSource
+    {
+    public:
+        explicit ReplayFrameSource(std::vector<cv::Mat> images) : images(std::move(images))
+        {
+        }
+
+        bool Open() override
+        {
+            return true;
+        }
+
+        void Close() override
+        {
+        }
+
+        std::optional<SH3DS::Core::Frame> Grab() override
+        {
+            SH3DS::Core::Frame frame;
+            if (!GrabInto(frame))
+            {
+                return std::nullopt;
+            }
+            return frame;
+        }
+
+        bool GrabInto(SH3DS::Core::Frame &frame) override
+        {
+            images[next % images.size()].copyTo(frame.image);
+            frame.metadata = {};
+            frame.metadata.sequenceNumber = next++;
+            frame.metadata.sourceWidth = frame.image.cols;
+            frame.metadata.sourceHeight = frame.image.rows;
+            return true;
+        }
+
+        bool IsOpen() const override
+        {
+            return true;
+        }
+
+        std::string Describe() const override
+        {
+            return "ReplayFrameSource";
+        }
+
+    private:
+        std::vector<cv::Mat> images;
+        uint64_t next = 0;
+    };
+
+    // ── FSM stub that stays in one state ─────────────────────────────────────
+
+    class IdleFSM : public SH3DS::FSM::GameStateFSM
+    {
+    public:
+        IdleFSM() : states(std::make_shared<SH3DS::Core::StateRegistry>())
+        {
+            states->Intern("battle_wait");
+        }
+
+        std::optional<SH3DS::Core::StateTransition> Update(const SH3DS::Core::ROISet &topRois,
+            const SH3DS::Core::ROISet &bottomRois) override
+        {
+            (void)bottomRois;
+            spriteFound = topRois.contains("pokemon_sprite");
+            return std::nullopt;
+        }
+
+        void Reset() override
+        {
+        }
+
+        bool IsStuck() const override
+        {
+            return false;
+        }
+
+        SH3DS::Core::StateId GetCurrentState() const override
+        {
+            return 0;
+        }
+
+        SH3DS::Core::StateId GetInitialState() const override
+        {
+            return 0;
+        }
+
+        std::shared_ptr<const SH3DS::Core::StateRegistry> GetStateRegistry() const override
+        {
+            return states;
+        }
+
+        std::chrono::milliseconds GetTimeInCurrentState() const override
+        {
+            return std::chrono::milliseconds(0);
+        }
+
+        const std::vector<SH3DS::Core::StateTransition> &GetTransitionHistory() const override
+        {
+            return history;
+        }
+
+        bool spriteFound = false;
+
+    private:
+        std::shared_ptr<SH3DS::Core::StateRegistry> states;
+        std::vector<SH3DS::Core::StateTransition> history;
+    };
+
+    // ── Real FSM: colour rules on two ROIs, ranges the replay never fills ────
+
+    std::unique_ptr<SH3DS::FSM::CXXStateTreeFSM> MakeColourFsm()
+    {
+        const auto colourBlock = [](const std::string &roi, const cv::Scalar &lower, const cv::Scalar &upper) {
+            return SH3DS::Core::StateDetectionParams{ .top =
+                                                          SH3DS::Core::RoiDetectionParams{
+                                                              .roi = roi,
+                                                              .method = "color_histogram",
+                                                              .hsvLower = lower,
+                                                              .hsvUpper = upper,
+                                                              .pixelRatioMin = 0.9,
+                                                              .pixelRatioMax = 1.0,
+                                                              .threshold = 0.5,
+                                                              .templatePath = {},
+                                                          },
+                .bottom = std::nullopt };
+        };
+
+        SH3DS::FSM::CXXStateTreeFSM::Builder builder;
+        builder.SetInitialState("battle_wait");
+        builder.SetDebounceFrames(2);
+        builder.SetScreenMode(SH3DS::Core::ScreenMode::Dual);
+        builder.AddState({
+            .id = "battle_wait",
+            .transitionsTo = { "encounter" },
+            .detectionParameters =
+                colourBlock("pokemon_sprite", cv::Scalar(0, 0, 250), cv::Scalar(180, 10, 255)),
+        });
+        builder.AddState({
+            .id = "encounter",
+            .transitionsTo = { "battle_wait" },
+            .detectionParameters =
+                colourBlock("dialogue_box", cv::Scalar(50, 200, 200), cv::Scalar(70, 255, 255)),
+        });
+        return builder.Build();
+    }
+
+    // ── Strategy stub that samples an allocation counter once per tick ───────
+
+    class ProbeStrategy : public SH3DS::Strategy::HuntStrategy
+    {
+    public:
+        explicit ProbeStrategy(std::function<uint64_t()> sample) : sample(std::move(sample))
+        {
+            samples.reserve(kReplayTicks);
+        }
+
+        SH3DS::Strategy::StrategyDecision Tick(SH3DS::Core::StateId,
+            std::chrono::milliseconds,
+            const std::optional<SH3DS::Core::ShinyResult> &) override
+        {
+            samples.push_back(sample());
+            SH3DS::Strategy::StrategyDecision d;
+            d.decision.action =
+                samples.size() >= kReplayTicks ? SH3DS::Core::HuntAction::Abort : SH3DS::Core::HuntAction::Wait;
+            return d;
+        }
+
+        SH3DS::Strategy::StrategyDecision OnStuck() override
+        {
+            return {};
+        }
+
+        const SH3DS::Core::HuntStatistics &Stats() const override
+        {
+            return stats;
+        }
+
+        void Reset() override
+        {
+        }
+
+        std::string Describe() const override
+        {
+            return "ProbeStrategy";
+        }
+
+        std::vector<uint64_t> samples; ///< Counter value when each tick reached the strategy
+
+    private:
+        std::function<uint64_t()> sample; ///< Reads the counter
+        SH3DS::Core::HuntStatistics stats;
+    };
+} // namespace
+
+// ── Tests ───────────────────────────────────────────────────────────────────
+
+TEST(TickAllocations, SteadyStateTickAllocatesNoFrameBuffers)
+{
+    CountingMatAllocator allocator(kFrameBufferBytes);
+
+    SH3DS::Core::OrchestratorConfig cfg;
+    cfg.targetFps = 1000.0;
+    cfg.shinyRoi = "pokemon_sprite";
+
+    // A, A, B repeating: changed frames run colour correction, the repeated A takes the unchanged path
+    const cv::Mat first = MakeCameraFrame(40);
+    const cv::Mat second = MakeCameraFrame(200);
+    auto fsm = std::make_unique<IdleFSM>();
+    auto *fsmPtr = fsm.get();
+    auto strategy = std::make_unique<ProbeStrategy>([&allocator] { return allocator.Count(); });
+    auto *strategyPtr = strategy.get();
+
+    SH3DS::Pipeline::Orchestrator orchestrator(
+        std::make_unique<ReplayFrameSource>(std::vector<cv::Mat>{ first, first, second }),
+        nullptr,
+        MakeDualScreenPreprocessor(),
+        std::move(fsm),
+        nullptr,
+        std::move(strategy),
+        nullptr,
+        cfg);
+    orchestrator.Run();
+
+    const auto &samples = strategyPtr->samples;
+    ASSERT_EQ(samples.size(), kReplayTicks);
+    EXPECT_TRUE(fsmPtr->spriteFound);
+    EXPECT_GT(orchestrator.Stats().unchangedFrames, 0u);
+    for (std::size_t tick = kWarmupTicks + 1; tick < samples.size(); ++tick)
+    {
+        EXPECT_EQ(samples[tick] - samples[tick - 1], 0u) << "tick " << tick << " allocated a frame buffer";
+    }
+}
+
+TEST(TickAllocations, SteadyStateTickWithTheRealFsmCallsNoOperatorNew)
+{
+    // Serial OpenCV: the parallel backend allocates a job object per parallel_for_ call, outside the tick's control
+    const int threads = cv::getNumThreads();
+    cv::setNumThreads(1);
+
+    SH3DS::Core::OrchestratorConfig cfg;
+    cfg.targetFps = 1000.0;
+    cfg.shinyRoi = "pokemon_sprite";
+
+    auto fsm = MakeColourFsm();
+    auto *fsmPtr = fsm.get();
+    auto strategy = std::make_unique<ProbeStrategy>([] { return heapAllocations.load(); });
+    auto *strategyPtr = strategy.get();
+
+    const cv::Mat first = MakeCameraFrame(40);
+    const cv::Mat second = MakeCameraFrame(200);
+    SH3DS::Pipeline::Orchestrator orchestrator(
+        std::make_unique<ReplayFrameSource>(std::vector<cv::Mat>{ first, first, second }),
+        nullptr,
+        MakeDualScreenPreprocessor(),
+        std::move(fsm),
+        nullptr,
+        std::move(strategy),
+        nullptr,
+        cfg);
+    {
+        // Every operator new on the orchestrator thread: grab, warp, colour correction, the FSM's colour
+        // classification and rule evaluation, and the strategy tick
+        const HeapCounter counter;
+        orchestrator.Run();
+    }
+    cv::setNumThreads(threads);
+
+    const auto &samples = strategyPtr->samples;
+    ASSERT_EQ(samples.size(), kReplayTicks);
+    EXPECT_EQ(fsmPtr->GetStateRegistry()->Name(fsmPtr->GetCurrentState()), "battle_wait");
+    EXPECT_GT(orchestrator.Stats().unchangedFrames, 0u);
+    for (std::size_t tick = kWarmupTicks + 1; tick < samples.size(); ++tick)
+    {
+        EXPECT_EQ(samples[tick] - samples[tick - 1], 0u) << "tick " << tick << " called operator new";
+    }
+}
+
+TEST(TickAllocations, RefillingTheWorkspaceAllocatesNothing)
+{
+    const auto preprocessor = MakeDualScreenPreprocessor();
+    ReplayFrameSource source({ MakeCameraFrame(40), MakeCameraFrame(200) });
+    SH3DS::Core::Frame frame;
+    SH3DS::Capture::DualScreenResult screens;
+    SH3DS::Capture::DualScreenResult lastScreens;
+
+    // Warm-up: size the frame and both results, and fill their ROI maps
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_TRUE(source.GrabInto(frame));
+        ASSERT_TRUE(preprocessor->ProcessDualScreen(frame.image, screens));
+        preprocessor->ReextractRois(screens);
+        std::swap(screens, lastScreens);
+    }
+    const uchar *frameBuffer = frame.image.data;
+
+    // Grabbing into the kept frame, re-extracting ROIs into filled maps and swapping results touch no heap
+    // (the warp itself is left out: OpenCV may use scratch memory inside warpPerspective)
+    uint64_t allocations = 0;
+    {
+        const HeapCounter counter;
+        ASSERT_TRUE(source.GrabInto(frame));
+        preprocessor->ReextractRois(screens);
+        std::swap(screens, lastScreens);
+        preprocessor->ReextractRois(screens);
+        allocations = counter.Count();
+    }
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(frame.image.data, frameBuffer);
+    EXPECT_EQ(screens.topRois.size(), 2u);
+    EXPECT_EQ(screens.bottomRois.size(), 2u);
+    EXPECT_EQ(screens.topRois.at("pokemon_sprite").datastart, screens.warpedTop.data);
+}
@@ -0,0 +1,76 @@
+#include "FSM/TransitionGraph.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    // 0 -> 1 -> 2 -> 0 cycle, 3 is declared but unreachable and terminal, 4 is an undeclared target of 2.
+    SH3DS::FSM::TransitionGraph MakeGraph()
+    {
+        const std::vector<bool> declared = { true, true, true, true, false };
+        const std::vector<std::vector<SH3DS::Core::StateId>> successors = {
+            { 1 },
+            { 2 },
+            { 0, 4 },
+            {},
+            {},
+        };
+        return SH3DS::FSM::TransitionGraph(declared, successors);
+    }
+
+    std::vector<SH3DS::Core::StateId> ToVector(std::span<const SH3DS::Core::StateId> ids)
+    {
+        return { ids.begin(), ids.end() };
+    }
+
+} // namespace
+
+TEST(TransitionGraph, HasEdgeMatchesSuccessorLists)
+{
+    const auto graph = MakeGraph();
+    EXPECT_TRUE(graph.HasEdge(0, 1));
+    EXPECT_TRUE(graph.HasEdge(2, 4));
+    EXPECT_FALSE(graph.HasEdge(1, 0));
+    EXPECT_FALSE(graph.HasEdge(3, 0));
+    EXPECT_FALSE(graph.HasEdge(0, SH3DS::Core::kInvalidStateId));
+}
+
+TEST(TransitionGraph, SuccessorsPreserveDeclarationOrder)
+{
+    const auto graph = MakeGraph();
+    EXPECT_EQ(ToVector(graph.Successors(2)), (std::vector<SH3DS::Core::StateId>{ 0, 4 }));
+    EXPECT_TRUE(graph.Successors(3).empty());
+}
+
+TEST(TransitionGraph, CandidatesAreSelfPlusDeclaredSuccessors)
+{
+    const auto graph = MakeGraph();
+    EXPECT_EQ(ToVector(graph.Candidates(0)), (std::vector<SH3DS::Core::StateId>{ 0, 1 }));
+    // Undeclared target 4 has no detection config, so it is never a candidate.
+    EXPECT_EQ(ToVector(graph.Candidates(2)), (std::vector<SH3DS::Core::StateId>{ 0, 2 }));
+    // Terminal state only re-detects itself.
+    EXPECT_EQ(ToVector(graph.Candidates(3)), (std::vector<SH3DS::Core::StateId>{ 3 }));
+}
+
+TEST(TransitionGraph, UndeclaredStateIsUnconstrained)
+{
+    const auto graph = MakeGraph();
+    EXPECT_EQ(ToVector(graph.Candidates(4)), (std::vector<SH3DS::Core::StateId>{ 0, 1, 2, 3 }));
+}
+
+TEST(TransitionGraph, ValidateReportsStructuralProblems)
+{
+    const auto report = MakeGraph().Validate(0);
+    EXPECT_FALSE(report.IsClean());
+    EXPECT_EQ(report.unreachable, (std::vector<SH3DS::Core::StateId>{ 3 }));
+    EXPECT_EQ(report.deadEnds, (std::vector<SH3DS::Core::StateId>{ 3 }));
+    EXPECT_EQ(report.undeclared, (std::vector<SH3DS::Core::StateId>{ 4 }));
+}
+
+TEST(TransitionGraph, CycleIsClean)
+{
+    const SH3DS::FSM::TransitionGraph graph({ true, true }, { { 1 }, { 0 } });
+    EXPECT_TRUE(graph.Validate(0).IsClean());
+}
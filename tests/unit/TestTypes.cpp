@@ -3,6 +3,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <limits>
+
 // --- Frame ---
 TEST(FrameMetadata, DefaultConstructionHasZeroSequence)
 {
@@ -53,31 +56,59 @@ TEST(ShinyResult, ConstructWithVerdict)
         .verdict = SH3DS::Core::ShinyVerdict::Shiny,
         .confidence = 0.95,
         .method = "dominant_color",
-        .details = "shiny ratio: 0.25",
-        .debugImage = {},
     };
     EXPECT_EQ(result.verdict, SH3DS::Core::ShinyVerdict::Shiny);
     EXPECT_DOUBLE_EQ(result.confidence, 0.95);
     EXPECT_EQ(result.method, "dominant_color");
+    EXPECT_EQ(result.Details(), "");
 }
 
-// --- GameState ---
+TEST(ShinyResult, DetailsFormatsNoteAndDiagnostics)
+{
+    SH3DS::Core::ShinyResult result{ .method = "stub", .note = "sequence_majority_vote" };
+    result.diagnostics.Add("count", 2.0, 3.0);
+    result.diagnostics.Add("ratio", 0.25);
+    EXPECT_EQ(result.Details(), "sequence_majority_vote: count=2/3 ratio=0.250");
+
+    result.note = {};
+    EXPECT_EQ(result.Details(), "count=2/3 ratio=0.250");
+}
 
-TEST(GameState, IsStringAlias)
+TEST(ShinyResult, DiagnosticsDropEntriesPastCapacity)
 {
-    SH3DS::Core::GameState state = "title_screen";
-    EXPECT_EQ(state, "title_screen");
+    SH3DS::Core::ShinyResult result;
+    for (std::size_t i = 0; i <= SH3DS::Core::ShinyDiagnostics::kCapacity; ++i)
+    {
+        result.diagnostics.Add("n", static_cast<double>(i));
+    }
+    constexpr std::size_t kCapacity = SH3DS::Core::ShinyDiagnostics::kCapacity;
+    EXPECT_EQ(result.diagnostics.count, kCapacity);
+    EXPECT_DOUBLE_EQ(result.diagnostics.entries.back().value, static_cast<double>(kCapacity - 1));
+}
+
+// --- StateId ---
+
+TEST(StateId, InvalidSentinelIsMaxValue)
+{
+    EXPECT_EQ(SH3DS::Core::kInvalidStateId, std::numeric_limits<SH3DS::Core::StateId>::max());
 }
 
 TEST(StateTransition, StoresFromAndTo)
 {
     SH3DS::Core::StateTransition transition{
-        .from = "title_screen",
-        .to = "intro_cutscene",
+        .from = 0,
+        .to = 1,
         .timestamp = std::chrono::steady_clock::now(),
     };
-    EXPECT_EQ(transition.from, "title_screen");
-    EXPECT_EQ(transition.to, "intro_cutscene");
+    EXPECT_EQ(transition.from, 0u);
+    EXPECT_EQ(transition.to, 1u);
+}
+
+TEST(StateTransition, DefaultsToInvalidStates)
+{
+    SH3DS::Core::StateTransition transition;
+    EXPECT_EQ(transition.from, SH3DS::Core::kInvalidStateId);
+    EXPECT_EQ(transition.to, SH3DS::Core::kInvalidStateId);
 }
 
 // --- InputCommand ---
@@ -135,6 +166,8 @@ TEST(HuntStatistics, DefaultZeroed)
     EXPECT_DOUBLE_EQ(stats.avgCycleSeconds, 0.0);
     EXPECT_EQ(stats.errors, 0u);
     EXPECT_EQ(stats.watchdogRecoveries, 0u);
+    EXPECT_EQ(stats.frames, 0u);
+    EXPECT_EQ(stats.unchangedFrames, 0u);
 }
 
 // --- HuntDecision ---
@@ -148,4 +181,5 @@ TEST(HuntDecision, ConstructWithAction)
     };
     EXPECT_EQ(decision.action, SH3DS::Core::HuntAction::SendInput);
     EXPECT_EQ(decision.reason, "press A on title screen");
+    EXPECT_EQ(decision.state, SH3DS::Core::kInvalidStateId);
 }
@@ -85,6 +85,29 @@ TEST_F(VideoFrameSourceTest, GrabReturnsFrameWithCorrectDimensions)
     EXPECT_EQ(frame->metadata.sequenceNumber, 0u);
 }
 
+TEST_F(VideoFrameSourceTest, CropHintCropsOnGrab)
+{
+    SH3DS::Capture::VideoFrameSource source(videoPath);
+    source.Open();
+
+    source.SetCropHint(cv::Rect(8, 4, 32, 24));
+    auto first = source.Grab();
+    auto second = source.Grab();
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->image.size(), cv::Size(32, 24));
+    EXPECT_EQ(first->metadata.cropOrigin, cv::Point(8, 4));
+    EXPECT_EQ(first->metadata.sourceWidth, 64);
+    EXPECT_EQ(first->metadata.sourceHeight, 48);
+    EXPECT_NE(first->image.data, second->image.data); // each frame owns its pixels
+
+    source.SetCropHint(std::nullopt);
+    auto full = source.Grab();
+    ASSERT_TRUE(full.has_value());
+    EXPECT_EQ(full->image.size(), cv::Size(64, 48));
+    EXPECT_EQ(full->metadata.cropOrigin, cv::Point(0, 0));
+}
+
 TEST_F(VideoFrameSourceTest, SeekToValidIndex)
 {
     SH3DS::Capture::VideoFrameSource source(videoPath);